@@ -239,6 +239,100 @@ void xnnpack_batch_matrix_multiply_qd8_f32_qc8w(benchmark::State& state,
   pthreadpool_destroy(threadpool);
 }
 
+void xnnpack_batch_matrix_multiply_bf16_f32(benchmark::State& state,
+                                            const char* net) {
+  const size_t batch_size = state.range(0);
+  const size_t m = state.range(1);
+  const size_t k = state.range(2);
+  const size_t n = state.range(3);
+  const bool transpose_b = state.range(4);
+  const size_t num_threads = state.range(5);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto f32rng = std::bind(std::uniform_real_distribution<float>(0.0f, 1.0f),
+                          std::ref(rng));
+
+  const size_t input1_elements = batch_size * m * k;
+  const size_t input2_elements = batch_size * k * n;
+  const size_t output_elements = batch_size * m * n;
+
+  xnnpack::Buffer<xnn_bfloat16> input1(input1_elements +
+                                       XNN_EXTRA_BYTES / sizeof(xnn_bfloat16));
+  std::generate(input1.begin(), input1.end(), std::ref(f32rng));
+  xnnpack::Buffer<xnn_bfloat16> input2(input2_elements);
+  std::generate(input2.begin(), input2.end(), std::ref(f32rng));
+  xnnpack::Buffer<float> output(output_elements);
+
+  xnn_status status = xnn_initialize(nullptr /* allocator */);
+  if (status != xnn_status_success) {
+    state.SkipWithError("failed to initialize XNNPACK");
+    return;
+  }
+
+  xnn_operator_t op;
+
+  uint32_t flags = transpose_b ? XNN_FLAG_TRANSPOSE_B : 0;
+  status = xnn_create_batch_matrix_multiply_nc_bf16_f32(flags, &op);
+  if (status != xnn_status_success) {
+    state.SkipWithError("failed to create BF16_F32 BatchMatrixMultiply operator");
+    return;
+  }
+
+  pthreadpool_t threadpool = pthreadpool_create(num_threads);
+
+  size_t workspace_size = 0;
+  size_t workspace_alignment = 0;
+  status = xnn_reshape_batch_matrix_multiply_nc_bf16_f32(
+      op, /*num_batch_dims=*/1, /*batch_dims_a=*/&batch_size,
+      /*batch_dims_b=*/&batch_size, m, k, n, &workspace_size,
+      &workspace_alignment, threadpool);
+
+  if (status != xnn_status_success) {
+    state.SkipWithError(
+        "failed to reshape BF16_F32 BatchMatrixMultiply operator");
+    return;
+  }
+
+  xnnpack::Buffer<char, XNN_ALLOCATION_ALIGNMENT> workspace(workspace_size);
+  status = xnn_setup_batch_matrix_multiply_nc_bf16_f32(
+      op, workspace.data(), input1.data(), input2.data(), output.data());
+
+  if (status != xnn_status_success) {
+    state.SkipWithError("failed to setup BF16_F32 BatchMatrixMultiply operator");
+    return;
+  }
+
+  while (state.KeepRunningBatch(kMinIterations)) {
+    for (int iter = 0; iter < kMinIterations; iter++) {
+      benchmark::utils::WipePthreadpoolL2Caches(state, threadpool);
+
+      status = xnn_run_operator(op, threadpool);
+      if (status != xnn_status_success) {
+        state.SkipWithError("failed to run BF16_F32 BatchMatrixMultiply operator");
+        return;
+      }
+    }
+  }
+
+  status = xnn_delete_operator(op);
+  if (status != xnn_status_success) {
+    state.SkipWithError("failed to delete BF16_F32 BatchMatrixMultiply operator");
+    return;
+  }
+
+  const uint64_t cpu_frequency = benchmark::utils::GetCurrentCpuFrequency();
+  if (cpu_frequency != 0) {
+    state.counters["cpufreq"] = cpu_frequency;
+  }
+
+  state.counters["FLOPS"] = benchmark::Counter(
+      static_cast<uint64_t>(state.iterations()) * batch_size * m * k * n,
+      benchmark::Counter::kIsRate);
+
+  pthreadpool_destroy(threadpool);
+}
+
 #ifdef BENCHMARK_TENSORFLOW_LITE
 void tflite_batch_matrix_multiply_f32(benchmark::State& state,
                                       const char* net) {
@@ -375,6 +469,29 @@ void tflite_batch_matrix_multiply_f32(benchmark::State& state,
 }
 #endif  // BENCHMARK_TENSORFLOW_LITE
 
+// Attention matmuls: Q*K^T and P*V for the heads of a transformer layer.
+static void AttentionArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"B", "M", "K", "N", "TB", "T"});
+  //       heads, sequence, head_dim, sequence, transpose_b, threads
+  b->Args({12, 128, 64, 128, 1, 1});
+  b->Args({12, 128, 128, 64, 0, 1});
+  b->Args({16, 512, 64, 512, 1, 1});
+  b->Args({16, 512, 512, 64, 0, 1});
+  b->Args({32, 1024, 128, 1024, 1, 1});
+  b->Args({32, 1024, 1024, 128, 0, 1});
+}
+
+BENCHMARK_CAPTURE(xnnpack_batch_matrix_multiply_f32, attention, "Attention")
+    ->Apply(AttentionArguments)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(xnnpack_batch_matrix_multiply_bf16_f32, attention, "Attention")
+    ->Apply(AttentionArguments)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(xnnpack_batch_matrix_multiply_qd8_f32_qc8w, attention,
+                  "Attention")
+    ->Apply(AttentionArguments)
+    ->UseRealTime();
+
 #ifndef XNNPACK_BENCHMARK_NO_MAIN
 BENCHMARK_MAIN();
 #endif
@@ -231,6 +231,20 @@ static void f16_spmm(benchmark::State& state,
   BENCHMARK_SPMM(spmm80_32x1__neonfp16arith_x2)
 #endif  // XNN_ENABLE_ARM_FP16_VECTOR && (XNN_ARCH_ARM || XNN_ARCH_ARM64)
 
+#if XNN_ENABLE_AVX512FP16 && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void spmm80_32x1__avx512fp16(benchmark::State& state, const char* net) {
+    f16_spmm(state, xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, 32, 1, 0.8f,
+      xnn_init_f16_minmax_scalar_params, benchmark::utils::CheckAVX512FP16);
+  }
+  static void spmm80_64x1__avx512fp16(benchmark::State& state, const char* net) {
+    f16_spmm(state, xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, 64, 1, 0.8f,
+      xnn_init_f16_minmax_scalar_params, benchmark::utils::CheckAVX512FP16);
+  }
+
+  BENCHMARK_SPMM(spmm80_32x1__avx512fp16)
+  BENCHMARK_SPMM(spmm80_64x1__avx512fp16)
+#endif  // XNN_ENABLE_AVX512FP16 && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
 #ifndef XNNPACK_BENCHMARK_NO_MAIN
 BENCHMARK_MAIN();
 #endif
@@ -1347,6 +1347,90 @@
 #endif  // XNN_ARCH_ARM || XNN_ARCH_ARM64
 
 
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_16x1__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_16x1__avx512f, 16, 1,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_16x1__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_32x1__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_32x1__avx512f, 32, 1,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_32x1__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_64x1__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_64x1__avx512f, 64, 1,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_64x1__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_32x2__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_32x2__avx512f, 32, 2,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_32x2__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_64x2__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_64x2__avx512f, 64, 2,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_64x2__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_32x4__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_32x4__avx512f, 32, 4,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_32x4__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  static void f32_spmm_minmax_ukernel_64x4__avx512f(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_64x4__avx512f, 64, 4,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckAVX512F
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_64x4__avx512f)
+#endif  // XNN_ENABLE_AVX512F && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
 #if XNN_ARCH_ARM || XNN_ARCH_ARM64
   static void f32_spmm_minmax_ukernel_4x1__neonfma(benchmark::State& state, const char* net) {
     f32_spmm(state, xnn_f32_spmm_minmax_ukernel_4x1__neonfma, 4, 1,
@@ -1671,6 +1755,78 @@
 #endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
 
 
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  static void f32_spmm_minmax_ukernel_8x1__fma3(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_8x1__fma3, 8, 1,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckFMA3
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_8x1__fma3)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  static void f32_spmm_minmax_ukernel_16x1__fma3(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_16x1__fma3, 16, 1,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckFMA3
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_16x1__fma3)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  static void f32_spmm_minmax_ukernel_32x1__fma3(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_32x1__fma3, 32, 1,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckFMA3
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_32x1__fma3)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  static void f32_spmm_minmax_ukernel_16x2__fma3(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_16x2__fma3, 16, 2,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckFMA3
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_16x2__fma3)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  static void f32_spmm_minmax_ukernel_32x2__fma3(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_32x2__fma3, 32, 2,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckFMA3
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_32x2__fma3)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  static void f32_spmm_minmax_ukernel_16x4__fma3(benchmark::State& state, const char* net) {
+    f32_spmm(state, xnn_f32_spmm_minmax_ukernel_16x4__fma3, 16, 4,
+      /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
+    benchmark::utils::CheckFMA3
+    );
+  }
+
+  BENCHMARK_SPMM(f32_spmm_minmax_ukernel_16x4__fma3)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+
 static void f32_spmm_minmax_ukernel_1x1__scalar(benchmark::State& state, const char* net) {
   f32_spmm(state, xnn_f32_spmm_minmax_ukernel_1x1__scalar, 1, 1,
     /*sparsity=*/0.8f, xnn_init_f32_minmax_scalar_params,
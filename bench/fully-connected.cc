@@ -226,6 +226,24 @@ void xnnpack_dynamic_fully_connected_f32(benchmark::State& state, const char* ne
     benchmark::Counter::kIsRate);
 }
 
+// Fully Connected layers of language models. With K from 4096 to 16384, the packed weights of a tile do not fit in L2
+// cache, and F32 weights are blocked along K.
+static void LanguageModel(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "K", "N"});
+
+  /*       M      K      N  */
+  for (int64_t m : {1, 16, 64, 256}) {
+    b->Args({m,  4096,  4096});
+    b->Args({m,  4096, 11008});
+    b->Args({m, 11008,  4096});
+    b->Args({m, 16384,  4096});
+  }
+}
+
+BENCHMARK_CAPTURE(xnnpack_fully_connected_f32, language_model, "Language model")->Apply(LanguageModel)->UseRealTime();
+BENCHMARK_CAPTURE(xnnpack_dynamic_fully_connected_f32, language_model, "Language model")
+  ->Apply(LanguageModel)->UseRealTime();
+
 #ifndef XNNPACK_BENCHMARK_NO_MAIN
 BENCHMARK_MAIN();
 #endif
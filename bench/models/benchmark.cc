@@ -199,6 +199,35 @@ static void QS8MobileNetV2(benchmark::State& state) {
   BenchmarkInvoke(state, models::QS8MobileNetV2);
 }
 
+// Activation blocks are memory bound: report the bandwidth of reading the input
+// and writing the output once, with and without fusion of the elementwise
+// chains.
+static void BenchmarkActivationBlock(
+    benchmark::State& state,
+    xnn_subgraph_t (*model_factory)(size_t batch_size, size_t channels)) {
+  const size_t batch_size = state.range(0);
+  const size_t channels = state.range(1);
+  const bool fusion = state.range(2) != 0;
+  BenchmarkInvoke(
+      state,
+      [=]() { return model_factory(batch_size, channels); },
+      fusion ? 0 : XNN_FLAG_NO_OPERATOR_FUSION);
+  state.SetBytesProcessed(int64_t(state.iterations()) * 2 * batch_size *
+                          channels * sizeof(float));
+}
+
+static void FP32SiLU(benchmark::State& state) {
+  BenchmarkActivationBlock(state, models::FP32SiLU);
+}
+
+static void FP32BiasGELU(benchmark::State& state) {
+  BenchmarkActivationBlock(state, models::FP32BiasGELU);
+}
+
+static void FP32GELUTanh(benchmark::State& state) {
+  BenchmarkActivationBlock(state, models::FP32GELUTanh);
+}
+
 static void AttentionArguments(benchmark::internal::Benchmark* b) {
   b->ArgNames({"B", "T", "H", "N", "S"});
   b->Args({1, 16, 25, 24, 4});
@@ -212,6 +241,15 @@ static void AttentionArguments(benchmark::internal::Benchmark* b) {
   b->Args({1, 2048, 64, 32, 24});
 }
 
+static void ActivationBlockArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"B", "C", "Fusion"});
+  for (int fusion : {0, 1}) {
+    b->Args({64, 1024, fusion});
+    b->Args({512, 3072, fusion});
+    b->Args({2048, 4096, fusion});
+  }
+}
+
 BENCHMARK(FP32Attention)
     ->Unit(benchmark::kMicrosecond)
     ->UseRealTime()
@@ -239,6 +277,21 @@ BENCHMARK(QD8Attention)
 
 BENCHMARK(QS8MobileNetV2)->Unit(benchmark::kMicrosecond)->UseRealTime();
 
+BENCHMARK(FP32SiLU)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(ActivationBlockArguments);
+
+BENCHMARK(FP32BiasGELU)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(ActivationBlockArguments);
+
+BENCHMARK(FP32GELUTanh)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(ActivationBlockArguments);
+
 int ProcessArgs(int& argc, char**& argv) {
   for (int i = 1; i < argc;) {
     if (strncmp(argv[i], "--num_threads=", 14) == 0) {
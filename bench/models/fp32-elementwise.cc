@@ -0,0 +1,166 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "models.h"
+#include "xnnpack.h"
+
+// Activation blocks made of chains of elementwise operators, which are fused
+// into a single pass over memory unless XNN_FLAG_NO_OPERATOR_FUSION is set.
+
+namespace models {
+
+namespace {
+
+class ElementwiseBuilder {
+ public:
+  ElementwiseBuilder(size_t batch_size, size_t channels)
+      : batch_size_(batch_size), channels_(channels) {}
+
+  ~ElementwiseBuilder() {
+    if (subgraph_ != nullptr) {
+      xnn_delete_subgraph(subgraph_);
+    }
+  }
+
+  bool Create() {
+    return xnn_create_subgraph(/*external_value_ids=*/2, 0, &subgraph_) ==
+               xnn_status_success &&
+           DefineTensor({batch_size_, channels_}, nullptr, 0,
+                        XNN_VALUE_FLAG_EXTERNAL_INPUT) == 0;
+  }
+
+  // Static operands broadcast to the input.
+  uint32_t Scalar(const float* value) { return DefineTensor({1}, value); }
+  uint32_t Channels(const float* values) {
+    return DefineTensor({channels_}, values);
+  }
+
+  uint32_t Output() {
+    return DefineTensor({batch_size_, channels_}, nullptr, 1,
+                        XNN_VALUE_FLAG_EXTERNAL_OUTPUT);
+  }
+
+  uint32_t Unary(xnn_unary_operator op, uint32_t input_id,
+                 uint32_t output_id = XNN_INVALID_VALUE_ID) {
+    if (output_id == XNN_INVALID_VALUE_ID) {
+      output_id = DefineTensor({batch_size_, channels_});
+    }
+    if (output_id != XNN_INVALID_VALUE_ID &&
+        xnn_define_unary(subgraph_, op, /*params=*/nullptr, input_id, output_id,
+                         /*flags=*/0) != xnn_status_success) {
+      std::cerr << "failed to create unary node" << std::endl;
+      ok_ = false;
+    }
+    return output_id;
+  }
+
+  uint32_t Binary(xnn_binary_operator op, uint32_t input1_id,
+                  uint32_t input2_id,
+                  uint32_t output_id = XNN_INVALID_VALUE_ID) {
+    if (output_id == XNN_INVALID_VALUE_ID) {
+      output_id = DefineTensor({batch_size_, channels_});
+    }
+    if (output_id != XNN_INVALID_VALUE_ID &&
+        xnn_define_binary(subgraph_, op, /*params=*/nullptr, input1_id,
+                          input2_id, output_id,
+                          /*flags=*/0) != xnn_status_success) {
+      std::cerr << "failed to create binary node" << std::endl;
+      ok_ = false;
+    }
+    return output_id;
+  }
+
+  xnn_subgraph_t Finish() {
+    if (!ok_) {
+      return nullptr;
+    }
+    xnn_subgraph_t subgraph = subgraph_;
+    subgraph_ = nullptr;
+    return subgraph;
+  }
+
+ private:
+  uint32_t DefineTensor(std::vector<size_t> dims, const void* data = nullptr,
+                        uint32_t external_id = XNN_INVALID_VALUE_ID,
+                        uint32_t flags = 0) {
+    uint32_t id = XNN_INVALID_VALUE_ID;
+    if (xnn_define_tensor_value(subgraph_, xnn_datatype_fp32, dims.size(),
+                                dims.data(), data, external_id, flags,
+                                &id) != xnn_status_success) {
+      std::cerr << "failed to create tensor" << std::endl;
+      ok_ = false;
+    }
+    return id;
+  }
+
+  size_t batch_size_;
+  size_t channels_;
+  xnn_subgraph_t subgraph_ = nullptr;
+  bool ok_ = true;
+};
+
+}  // namespace
+
+xnn_subgraph_t FP32SiLU(size_t batch_size, size_t channels) {
+  ElementwiseBuilder b(batch_size, channels);
+  if (!b.Create()) {
+    return nullptr;
+  }
+  const uint32_t x = 0;
+  const uint32_t sigmoid = b.Unary(xnn_unary_sigmoid, x);
+  b.Binary(xnn_binary_multiply, x, sigmoid, b.Output());
+  return b.Finish();
+}
+
+xnn_subgraph_t FP32BiasGELU(size_t batch_size, size_t channels) {
+  static std::vector<float> bias;
+  bias.resize(channels);
+  std::mt19937 rng(channels);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (float& value : bias) {
+    value = dist(rng);
+  }
+
+  ElementwiseBuilder b(batch_size, channels);
+  if (!b.Create()) {
+    return nullptr;
+  }
+  const uint32_t x = 0;
+  const uint32_t biased = b.Binary(xnn_binary_add, x, b.Channels(bias.data()));
+  b.Unary(xnn_unary_gelu, biased, b.Output());
+  return b.Finish();
+}
+
+xnn_subgraph_t FP32GELUTanh(size_t batch_size, size_t channels) {
+  static const float half = 0.5f;
+  static const float one = 1.0f;
+  static const float cubic = 0.044715f;
+  static const float sqrt_2_over_pi = 0.7978845608f;
+
+  // 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+  ElementwiseBuilder b(batch_size, channels);
+  if (!b.Create()) {
+    return nullptr;
+  }
+  const uint32_t x = 0;
+  uint32_t y = b.Binary(xnn_binary_multiply, x, x);
+  y = b.Binary(xnn_binary_multiply, y, x);
+  y = b.Binary(xnn_binary_multiply, y, b.Scalar(&cubic));
+  y = b.Binary(xnn_binary_add, y, x);
+  y = b.Binary(xnn_binary_multiply, y, b.Scalar(&sqrt_2_over_pi));
+  y = b.Unary(xnn_unary_tanh, y);
+  y = b.Binary(xnn_binary_add, y, b.Scalar(&one));
+  y = b.Binary(xnn_binary_multiply, b.Scalar(&half), y);
+  b.Binary(xnn_binary_multiply, y, x, b.Output());
+  return b.Finish();
+}
+
+}  // namespace models
@@ -21,10 +21,13 @@ struct QD8AttentionWeights {
 };
 
 xnn_subgraph_t FP32Attention(size_t b, size_t t, size_t h, size_t n, size_t s);
+xnn_subgraph_t FP32BiasGELU(size_t batch_size, size_t channels);
+xnn_subgraph_t FP32GELUTanh(size_t batch_size, size_t channels);
 xnn_subgraph_t FP32MobileNetV1();
 xnn_subgraph_t FP32MobileNetV2();
 xnn_subgraph_t FP32MobileNetV3Large();
 xnn_subgraph_t FP32MobileNetV3Small();
+xnn_subgraph_t FP32SiLU(size_t batch_size, size_t channels);
 xnn_subgraph_t QD8Attention(size_t batch_size, size_t seq_len,
                             size_t embedding_dim, size_t num_heads,
                             size_t head_dim, QD8AttentionWeights &weights);
@@ -282,7 +282,8 @@ void xnnpack_multihead_scaled_batch_matrix_multiply_cap_tanh_f32(benchmark::Stat
     benchmark::Counter::kIsRate);
 }
 
-void xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32(benchmark::State& state, const char* net) {
+void xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32(
+    benchmark::State& state, const char* net, uint32_t flags) {
   const size_t batch_size = state.range(0);
   const size_t heads = state.range(1);
   const size_t query_tokens = state.range(2);
@@ -321,7 +322,7 @@ void xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32(benchmark::Stat
   status = xnn_create_scaled_dot_product_attention_nhtc_f32(
       cap_type,
       &cap_tanh_params,
-      /*flags=*/0,
+      flags,
       &attention_op);
 
   if (status != xnn_status_success) {
@@ -340,6 +341,7 @@ void xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32(benchmark::Stat
   if (status != xnn_status_success) {
     state.SkipWithError("failed to reshape Scaled Dot Attention operator");
   }
+  state.counters["workspace"] = workspace_size;
 
   xnnpack::Buffer<char> workspace(workspace_size, 0);
 
@@ -397,9 +399,31 @@ static void Bert(benchmark::internal::Benchmark* b) {
   b->Args({1, 16, 128, 128, 64});
 }
 
-BENCHMARK_CAPTURE(xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32, bert, "BERT")->Apply(Bert)->UseRealTime();
+static void LongContext(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"BatchSize", "Heads", "QueryTokens", "KeyValueTokens", "Channels"});
+  // Prefill and decode steps over long key/value sequences, where logits for all key/value tokens no longer fit in
+  // cache.
+  b->Args({1, 8, 128, 1024, 64});
+  b->Args({1, 8, 128, 4096, 64});
+  b->Args({1, 8, 1, 4096, 64});
+  b->Args({1, 8, 1, 16384, 64});
+  b->Args({1, 8, 16, 16384, 128});
+}
+
+BENCHMARK_CAPTURE(xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32, bert, "BERT", /*flags=*/0)
+  ->Apply(Bert)->UseRealTime();
+BENCHMARK_CAPTURE(xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32, bert_online_softmax, "BERT",
+                  XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+  ->Apply(Bert)->UseRealTime();
 BENCHMARK_CAPTURE(xnnpack_multihead_scaled_batch_matrix_multiply_cap_tanh_f32, bert, "BERT")->Apply(Bert)->UseRealTime();
 
+BENCHMARK_CAPTURE(xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32, long_context, "LongContext",
+                  /*flags=*/0)
+  ->Apply(LongContext)->UseRealTime();
+BENCHMARK_CAPTURE(xnnpack_multihead_scaled_dot_product_attention_cap_tanh_f32, long_context_online_softmax,
+                  "LongContext", XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+  ->Apply(LongContext)->UseRealTime();
+
 #ifndef XNNPACK_BENCHMARK_NO_MAIN
 BENCHMARK_MAIN();
 #endif
@@ -198,6 +198,10 @@ bool CheckAVX512VNNI(benchmark::State& state);
 // If VNNI or GFNI or SKX-level AVX512 extensions are unsupported, report error in benchmark state, and return false.
 bool CheckAVX512VNNIGFNI(benchmark::State& state);
 
+// Check if x86 BF16 + SKX-level AVX512 extensions (AVX512F, AVX512CD, AVX512BW, AVX512DQ, AVX512VL, and BF16) are supported.
+// If BF16 or SKX-level AVX512 extensions are unsupported, report error in benchmark state, and return false.
+bool CheckAVX512BF16(benchmark::State& state);
+
 // Check if x86 VNNI + GFNI + SKX-level + AMX AVX512 extensions (AAVX512F, AVX512CD, AVX512BW, AVX512DQ, AVX512VL, GFNI and AMX) are supported.
 // If AVX512 or AMX are unsupported, report error in benchmark state, and return false.
 bool CheckAVX512AMX(benchmark::State& state);
@@ -83,6 +83,10 @@ def xnnpack_configurable_defines():
         ":riscv_fp16_vector_enabled",
         ["XNN_ENABLE_RISCV_FP16_VECTOR=1"],
         ["XNN_ENABLE_RISCV_FP16_VECTOR=0"],
+    ) + xnnpack_select_if(
+        ":avx512bf16_enabled",
+        ["XNN_ENABLE_AVX512BF16=1"],
+        ["XNN_ENABLE_AVX512BF16=0"],
     ) + xnnpack_select_if(
         ":avx512amx_enabled",
         ["XNN_ENABLE_AVX512AMX=1"],
@@ -724,6 +728,23 @@ XNNPACK_PARAMS_FOR_ARCH = {
         mingw_copts = ["-fno-asynchronous-unwind-tables"],
         msys_copts = ["-fno-asynchronous-unwind-tables"],
     ),
+    "avx512bf16": _create_params(
+        cond = "//:avx512bf16_enabled",
+        gcc_x86_copts = [
+            "-mf16c",
+            "-mfma",
+            "-mavx512f",
+            "-mavx512cd",
+            "-mavx512bw",
+            "-mavx512dq",
+            "-mavx512vl",
+            "-mavx512bf16",
+        ],
+        msvc_x86_32_copts = ["/arch:AVX512"],
+        msvc_x86_64_copts = ["/arch:AVX512"],
+        mingw_copts = ["-fno-asynchronous-unwind-tables"],
+        msys_copts = ["-fno-asynchronous-unwind-tables"],
+    ),
     "avx512amx": _create_params(
         cond = "//:avx512amx_enabled",
         gcc_x86_copts = [
@@ -738,6 +759,7 @@ XNNPACK_PARAMS_FOR_ARCH = {
             "-mgfni",
             "-mamx-tile",
             "-mamx-int8",
+            "-mamx-bf16",
         ],
         msvc_x86_32_copts = ["/arch:AVX512"],
         msvc_x86_64_copts = ["/arch:AVX512"],
@@ -7,6 +7,7 @@
 #   XNNPACK - optimized floating-point neural network operators library
 
 OPERATOR_SRCS = [
+    "src/gemm-tuning.c",
     "src/operator-delete.c",
     "src/operator-run.c",
     "src/operators/argmax-pooling-nhwc.c",
@@ -19,6 +20,7 @@ OPERATOR_SRCS = [
     "src/operators/deconvolution-nhwc.c",
     "src/operators/dynamic-fully-connected-nc.c",
     "src/operators/fully-connected-nc.c",
+    "src/operators/fused-elementwise-nc.c",
     "src/operators/max-pooling-nhwc.c",
     "src/operators/pack-lh.c",
     "src/operators/reduce-nd.c",
@@ -31,10 +33,13 @@ OPERATOR_SRCS = [
     "src/operators/transpose-nd.c",
     "src/operators/unary-elementwise-nc.c",
     "src/operators/unpooling-nhwc.c",
+    "src/trace.c",
 ]
 
 SUBGRAPH_SRCS = [
     "src/memory-planner.c",
+    "src/perf-counters.c",
+    "src/reshape-cache.c",
     "src/runtime.c",
     "src/subgraph.c",
     "src/subgraph/argmax-pooling-2d.c",
@@ -51,6 +56,7 @@ SUBGRAPH_SRCS = [
     "src/subgraph/even-split.c",
     "src/subgraph/fully-connected-sparse.c",
     "src/subgraph/fully-connected.c",
+    "src/subgraph/fused-elementwise.c",
     "src/subgraph/max-pooling-2d.c",
     "src/subgraph/pack-lh.c",
     "src/subgraph/reshape-helpers.c",
@@ -104,6 +110,7 @@ XNNPACK_SRCS = [
     "src/configs/unary-elementwise-config.c",
     "src/configs/unpool-config.c",
     "src/configs/vmulcaddc-config.c",
+    "src/configs/winograd-config.c",
     "src/configs/x8-lut-config.c",
     "src/configs/xx-fill-config.c",
     "src/configs/xx-pad-config.c",
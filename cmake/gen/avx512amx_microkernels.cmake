@@ -10,6 +10,8 @@
 
 
 SET(PROD_AVX512AMX_MICROKERNEL_SRCS
+  src/bf16-f32-gemm/gen/bf16-f32-gemm-1x32c2-minmax-avx512amx.c
+  src/bf16-f32-gemm/gen/bf16-f32-gemm-16x32c2-minmax-avx512amx.c
   src/qd8-f16-qc8w-gemm/gen/qd8-f16-qc8w-gemm-1x64c4-minmax-avx512amx.c
   src/qd8-f16-qc8w-gemm/gen/qd8-f16-qc8w-gemm-16x64c4-minmax-avx512amx.c
   src/qd8-f16-qc8w-igemm/gen/qd8-f16-qc8w-igemm-1x64c4-minmax-avx512amx.c
@@ -26,6 +28,10 @@ SET(PROD_AVX512AMX_MICROKERNEL_SRCS
   src/qs8-qc8w-igemm/gen/qs8-qc8w-igemm-16x64c4-minmax-fp32-avx512amx.c)
 
 SET(NON_PROD_AVX512AMX_MICROKERNEL_SRCS
+  src/bf16-f32-gemm/gen/bf16-f32-gemm-1x16c2-minmax-avx512amx.c
+  src/bf16-f32-gemm/gen/bf16-f32-gemm-1x64c2-minmax-avx512amx.c
+  src/bf16-f32-gemm/gen/bf16-f32-gemm-16x16c2-minmax-avx512amx.c
+  src/bf16-f32-gemm/gen/bf16-f32-gemm-16x64c2-minmax-avx512amx.c
   src/qd8-f16-qc8w-gemm/gen/qd8-f16-qc8w-gemm-7x64c4-minmax-avx512amx.c
   src/qd8-f16-qc8w-gemm/gen/qd8-f16-qc8w-gemm-16x64c4-minmax-avx512amx-prfm.c
   src/qd8-f16-qc8w-igemm/gen/qd8-f16-qc8w-igemm-7x64c4-minmax-avx512amx.c
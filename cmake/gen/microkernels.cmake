@@ -18,6 +18,7 @@ INCLUDE(cmake/gen/avx256skx_microkernels.cmake)
 INCLUDE(cmake/gen/avx256vnni_microkernels.cmake)
 INCLUDE(cmake/gen/avx256vnnigfni_microkernels.cmake)
 INCLUDE(cmake/gen/avx512amx_microkernels.cmake)
+INCLUDE(cmake/gen/avx512bf16_microkernels.cmake)
 INCLUDE(cmake/gen/avx512f_microkernels.cmake)
 INCLUDE(cmake/gen/avx512fp16_microkernels.cmake)
 INCLUDE(cmake/gen/avx512skx_microkernels.cmake)
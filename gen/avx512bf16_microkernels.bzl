@@ -0,0 +1,24 @@
+"""
+Microkernel filenames lists for avx512bf16.
+
+Auto-generated file. Do not edit!
+  Generator: tools/update-microkernels.py
+"""
+
+PROD_AVX512BF16_MICROKERNEL_SRCS = [
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-1x32c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-4x32c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-5x32c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-6x32c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-7x32c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-8x32c2-minmax-avx512bf16-broadcast.c",
+]
+
+NON_PROD_AVX512BF16_MICROKERNEL_SRCS = [
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-1x16c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-4x16c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-7x16c2-minmax-avx512bf16-broadcast.c",
+    "src/bf16-f32-gemm/gen/bf16-f32-gemm-8x16c2-minmax-avx512bf16-broadcast.c",
+]
+
+ALL_AVX512BF16_MICROKERNEL_SRCS = PROD_AVX512BF16_MICROKERNEL_SRCS + NON_PROD_AVX512BF16_MICROKERNEL_SRCS
@@ -12,7 +12,11 @@ PROD_AVX512F_MICROKERNEL_SRCS = [
     "src/f32-dwconv/gen/f32-dwconv-9p16c-minmax-avx512f.c",
     "src/f32-dwconv/gen/f32-dwconv-25p16c-minmax-avx512f.c",
     "src/f32-gemm/gen/f32-gemm-1x32-minmax-avx512f-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-4x32-minmax-avx512f-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-5x32-minmax-avx512f-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-6x32-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-7x32-minmax-avx512f-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-8x32-minmax-avx512f-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-1x32-minmax-avx512f-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-7x32-minmax-avx512f-broadcast.c",
     "src/f32-raddstoreexpminusmax/gen/f32-raddstoreexpminusmax-avx512f-rr2-p5-u64-acc2.c",
@@ -20,6 +24,9 @@ PROD_AVX512F_MICROKERNEL_SRCS = [
     "src/f32-rminmax/gen/f32-rmax-avx512f-u64-acc4.c",
     "src/f32-rminmax/gen/f32-rminmax-avx512f-u64-acc4.c",
     "src/f32-rsum/gen/f32-rsum-avx512f-u64-acc4.c",
+    "src/f32-spmm/gen/f32-spmm-32x1-minmax-avx512f.c",
+    "src/f32-spmm/gen/f32-spmm-32x2-minmax-avx512f.c",
+    "src/f32-spmm/gen/f32-spmm-32x4-minmax-avx512f.c",
     "src/f32-vbinary/gen/f32-vadd-avx512f-u32.c",
     "src/f32-vbinary/gen/f32-vaddc-avx512f-u32.c",
     "src/f32-vbinary/gen/f32-vdiv-avx512f-u32.c",
@@ -83,18 +90,14 @@ NON_PROD_AVX512F_MICROKERNEL_SRCS = [
     "src/f32-gemm/gen/f32-gemm-1x16-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-1x64-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-4x16-minmax-avx512f-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-4x32-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-4x64-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-5x16-minmax-avx512f-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-5x32-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-5x64-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-6x16-minmax-avx512f-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-6x32-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-6x64-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-7x16-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-7x64-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-8x16-minmax-avx512f-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-8x32-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-8x64-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-9x16-minmax-avx512f-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-9x32-minmax-avx512f-broadcast.c",
@@ -193,6 +196,10 @@ NON_PROD_AVX512F_MICROKERNEL_SRCS = [
     "src/f32-rsum/gen/f32-rsum-avx512f-u32-acc2.c",
     "src/f32-rsum/gen/f32-rsum-avx512f-u48-acc3.c",
     "src/f32-rsum/gen/f32-rsum-avx512f-u64-acc2.c",
+    "src/f32-spmm/gen/f32-spmm-16x1-minmax-avx512f.c",
+    "src/f32-spmm/gen/f32-spmm-64x1-minmax-avx512f.c",
+    "src/f32-spmm/gen/f32-spmm-64x2-minmax-avx512f.c",
+    "src/f32-spmm/gen/f32-spmm-64x4-minmax-avx512f.c",
     "src/f32-vbinary/gen/f32-vadd-avx512f-u16.c",
     "src/f32-vbinary/gen/f32-vaddc-avx512f-u16.c",
     "src/f32-vbinary/gen/f32-vdiv-avx512f-u16.c",
@@ -14,7 +14,10 @@ PROD_AVX_MICROKERNEL_SRCS = [
     "src/f32-dwconv/gen/f32-dwconv-25p8c-minmax-avx.c",
     "src/f32-f16-vcvt/gen/f32-f16-vcvt-avx-u24.c",
     "src/f32-gemm/gen/f32-gemm-1x16-minmax-avx-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-3x16-minmax-avx-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-4x16-minmax-avx-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-5x16-minmax-avx-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-6x16-minmax-avx-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-1x16-minmax-avx-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-5x16-minmax-avx-broadcast.c",
     "src/f32-qc4w-gemm/gen/f32-qc4w-gemm-1x16-minmax-avx-broadcast.c",
@@ -139,12 +142,9 @@ NON_PROD_AVX_MICROKERNEL_SRCS = [
     "src/f32-f16-vcvt/gen/f32-f16-vcvt-avx-u16.c",
     "src/f32-f16-vcvt/gen/f32-f16-vcvt-avx-u32.c",
     "src/f32-gemm/gen/f32-gemm-1x8-minmax-avx-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-3x16-minmax-avx-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-4x8-minmax-avx-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-4x16-minmax-avx-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-5x8-minmax-avx-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-6x8-minmax-avx-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-6x16-minmax-avx-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-7x8-minmax-avx-broadcast.c",
     "src/f32-gemminc/gen/f32-gemminc-1x8-minmax-avx-broadcast.c",
     "src/f32-gemminc/gen/f32-gemminc-1x16-minmax-avx-broadcast.c",
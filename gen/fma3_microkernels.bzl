@@ -20,8 +20,14 @@ PROD_FMA3_MICROKERNEL_SRCS = [
     "src/f32-dwconv/gen/f32-dwconv-25p8c-minmax-fma3.c",
     "src/f32-gemm/gen/f32-gemm-1x16-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-1x16s4-minmax-fma3-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-3x16-minmax-fma3-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-3x16s4-minmax-fma3-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-4x16-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-4x16s4-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-5x16-minmax-fma3-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-5x16s4-minmax-fma3-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-6x16-minmax-fma3-broadcast.c",
+    "src/f32-gemm/gen/f32-gemm-6x16s4-minmax-fma3-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-1x16-minmax-fma3-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-1x16s4-minmax-fma3-broadcast.c",
     "src/f32-igemm/gen/f32-igemm-4x16s4-minmax-fma3-broadcast.c",
@@ -30,6 +36,9 @@ PROD_FMA3_MICROKERNEL_SRCS = [
     "src/f32-qc4w-gemm/gen/f32-qc4w-gemm-3x16-minmax-fma3-broadcast.c",
     "src/f32-qc8w-gemm/gen/f32-qc8w-gemm-1x16-minmax-fma3-broadcast.c",
     "src/f32-qc8w-gemm/gen/f32-qc8w-gemm-5x16-minmax-fma3-broadcast.c",
+    "src/f32-spmm/gen/f32-spmm-16x4-minmax-fma3.c",
+    "src/f32-spmm/gen/f32-spmm-32x1-minmax-fma3.c",
+    "src/f32-spmm/gen/f32-spmm-32x2-minmax-fma3.c",
     "src/f32-vcmul/gen/f32-vcmul-fma3-u16.c",
     "src/f32-vgelu/gen/f32-vgelu-fma3-rational-12-10-div.c",
     "src/f32-vhswish/gen/f32-vhswish-fma3-u16.c",
@@ -115,15 +124,9 @@ NON_PROD_FMA3_MICROKERNEL_SRCS = [
     "src/f32-dwconv/gen/f32-dwconv-25p16c-minmax-fma3-acc2.c",
     "src/f32-dwconv/gen/f32-dwconv-25p16c-minmax-fma3.c",
     "src/f32-gemm/gen/f32-gemm-1x8-minmax-fma3-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-3x16-minmax-fma3-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-3x16s4-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-4x8-minmax-fma3-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-4x16-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-5x8-minmax-fma3-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-5x16s4-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-6x8-minmax-fma3-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-6x16-minmax-fma3-broadcast.c",
-    "src/f32-gemm/gen/f32-gemm-6x16s4-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-7x8-minmax-fma3-broadcast.c",
     "src/f32-gemm/gen/f32-gemm-8x8-minmax-fma3-broadcast.c",
     "src/f32-gemminc/gen/f32-gemminc-1x8-minmax-fma3-broadcast.c",
@@ -168,6 +171,9 @@ NON_PROD_FMA3_MICROKERNEL_SRCS = [
     "src/f32-qc8w-gemm/gen/f32-qc8w-gemm-6x16-minmax-fma3-broadcast.c",
     "src/f32-qc8w-gemm/gen/f32-qc8w-gemm-7x16-minmax-fma3-broadcast.c",
     "src/f32-qc8w-gemm/gen/f32-qc8w-gemm-8x16-minmax-fma3-broadcast.c",
+    "src/f32-spmm/gen/f32-spmm-8x1-minmax-fma3.c",
+    "src/f32-spmm/gen/f32-spmm-16x1-minmax-fma3.c",
+    "src/f32-spmm/gen/f32-spmm-16x2-minmax-fma3.c",
     "src/f32-vcmul/gen/f32-vcmul-fma3-u8.c",
     "src/f32-vcmul/gen/f32-vcmul-fma3-u32.c",
     "src/f32-vcmul/gen/f32-vcmul-fma3-u64.c",
@@ -14,6 +14,7 @@ load("avx256vnni_microkernels.bzl", _ALL_AVX256VNNI_MICROKERNEL_SRCS = "ALL_AVX2
 load("avx256vnnigfni_microkernels.bzl", _ALL_AVX256VNNIGFNI_MICROKERNEL_SRCS = "ALL_AVX256VNNIGFNI_MICROKERNEL_SRCS", _NON_PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS = "NON_PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS", _PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS = "PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS")
 load("avx2_microkernels.bzl", _ALL_AVX2_MICROKERNEL_SRCS = "ALL_AVX2_MICROKERNEL_SRCS", _NON_PROD_AVX2_MICROKERNEL_SRCS = "NON_PROD_AVX2_MICROKERNEL_SRCS", _PROD_AVX2_MICROKERNEL_SRCS = "PROD_AVX2_MICROKERNEL_SRCS")
 load("avx512amx_microkernels.bzl", _ALL_AVX512AMX_MICROKERNEL_SRCS = "ALL_AVX512AMX_MICROKERNEL_SRCS", _NON_PROD_AVX512AMX_MICROKERNEL_SRCS = "NON_PROD_AVX512AMX_MICROKERNEL_SRCS", _PROD_AVX512AMX_MICROKERNEL_SRCS = "PROD_AVX512AMX_MICROKERNEL_SRCS")
+load("avx512bf16_microkernels.bzl", _ALL_AVX512BF16_MICROKERNEL_SRCS = "ALL_AVX512BF16_MICROKERNEL_SRCS", _NON_PROD_AVX512BF16_MICROKERNEL_SRCS = "NON_PROD_AVX512BF16_MICROKERNEL_SRCS", _PROD_AVX512BF16_MICROKERNEL_SRCS = "PROD_AVX512BF16_MICROKERNEL_SRCS")
 load("avx512f_microkernels.bzl", _ALL_AVX512F_MICROKERNEL_SRCS = "ALL_AVX512F_MICROKERNEL_SRCS", _NON_PROD_AVX512F_MICROKERNEL_SRCS = "NON_PROD_AVX512F_MICROKERNEL_SRCS", _PROD_AVX512F_MICROKERNEL_SRCS = "PROD_AVX512F_MICROKERNEL_SRCS")
 load("avx512fp16_microkernels.bzl", _ALL_AVX512FP16_MICROKERNEL_SRCS = "ALL_AVX512FP16_MICROKERNEL_SRCS", _NON_PROD_AVX512FP16_MICROKERNEL_SRCS = "NON_PROD_AVX512FP16_MICROKERNEL_SRCS", _PROD_AVX512FP16_MICROKERNEL_SRCS = "PROD_AVX512FP16_MICROKERNEL_SRCS")
 load("avx512skx_microkernels.bzl", _ALL_AVX512SKX_MICROKERNEL_SRCS = "ALL_AVX512SKX_MICROKERNEL_SRCS", _NON_PROD_AVX512SKX_MICROKERNEL_SRCS = "NON_PROD_AVX512SKX_MICROKERNEL_SRCS", _PROD_AVX512SKX_MICROKERNEL_SRCS = "PROD_AVX512SKX_MICROKERNEL_SRCS")
@@ -65,6 +66,7 @@ ALL_AVX256VNNIGFNI_MICROKERNEL_SRCS = _ALL_AVX256VNNIGFNI_MICROKERNEL_SRCS
 ALL_AVX256VNNI_MICROKERNEL_SRCS = _ALL_AVX256VNNI_MICROKERNEL_SRCS
 ALL_AVX2_MICROKERNEL_SRCS = _ALL_AVX2_MICROKERNEL_SRCS
 ALL_AVX512AMX_MICROKERNEL_SRCS = _ALL_AVX512AMX_MICROKERNEL_SRCS
+ALL_AVX512BF16_MICROKERNEL_SRCS = _ALL_AVX512BF16_MICROKERNEL_SRCS
 ALL_AVX512FP16_MICROKERNEL_SRCS = _ALL_AVX512FP16_MICROKERNEL_SRCS
 ALL_AVX512F_MICROKERNEL_SRCS = _ALL_AVX512F_MICROKERNEL_SRCS
 ALL_AVX512SKX_MICROKERNEL_SRCS = _ALL_AVX512SKX_MICROKERNEL_SRCS
@@ -114,6 +116,7 @@ NON_PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS = _NON_PROD_AVX256VNNIGFNI_MICROKERNEL_
 NON_PROD_AVX256VNNI_MICROKERNEL_SRCS = _NON_PROD_AVX256VNNI_MICROKERNEL_SRCS
 NON_PROD_AVX2_MICROKERNEL_SRCS = _NON_PROD_AVX2_MICROKERNEL_SRCS
 NON_PROD_AVX512AMX_MICROKERNEL_SRCS = _NON_PROD_AVX512AMX_MICROKERNEL_SRCS
+NON_PROD_AVX512BF16_MICROKERNEL_SRCS = _NON_PROD_AVX512BF16_MICROKERNEL_SRCS
 NON_PROD_AVX512FP16_MICROKERNEL_SRCS = _NON_PROD_AVX512FP16_MICROKERNEL_SRCS
 NON_PROD_AVX512F_MICROKERNEL_SRCS = _NON_PROD_AVX512F_MICROKERNEL_SRCS
 NON_PROD_AVX512SKX_MICROKERNEL_SRCS = _NON_PROD_AVX512SKX_MICROKERNEL_SRCS
@@ -165,6 +168,7 @@ PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS = _PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS
 PROD_AVX256VNNI_MICROKERNEL_SRCS = _PROD_AVX256VNNI_MICROKERNEL_SRCS
 PROD_AVX2_MICROKERNEL_SRCS = _PROD_AVX2_MICROKERNEL_SRCS
 PROD_AVX512AMX_MICROKERNEL_SRCS = _PROD_AVX512AMX_MICROKERNEL_SRCS
+PROD_AVX512BF16_MICROKERNEL_SRCS = _PROD_AVX512BF16_MICROKERNEL_SRCS
 PROD_AVX512FP16_MICROKERNEL_SRCS = _PROD_AVX512FP16_MICROKERNEL_SRCS
 PROD_AVX512F_MICROKERNEL_SRCS = _PROD_AVX512F_MICROKERNEL_SRCS
 PROD_AVX512SKX_MICROKERNEL_SRCS = _PROD_AVX512SKX_MICROKERNEL_SRCS
@@ -218,6 +222,7 @@ PROD_C_SRCS_FOR_ARCH = {
     "avx256vnnigfni": PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS,
     "avx2": PROD_AVX2_MICROKERNEL_SRCS,
     "avx512amx": PROD_AVX512AMX_MICROKERNEL_SRCS,
+    "avx512bf16": PROD_AVX512BF16_MICROKERNEL_SRCS,
     "avx512f": PROD_AVX512F_MICROKERNEL_SRCS,
     "avx512fp16": PROD_AVX512FP16_MICROKERNEL_SRCS,
     "avx512skx": PROD_AVX512SKX_MICROKERNEL_SRCS,
@@ -266,6 +271,7 @@ NON_PROD_C_SRCS_FOR_ARCH = {
     "avx256vnnigfni": NON_PROD_AVX256VNNIGFNI_MICROKERNEL_SRCS,
     "avx2": NON_PROD_AVX2_MICROKERNEL_SRCS,
     "avx512amx": NON_PROD_AVX512AMX_MICROKERNEL_SRCS,
+    "avx512bf16": NON_PROD_AVX512BF16_MICROKERNEL_SRCS,
     "avx512f": NON_PROD_AVX512F_MICROKERNEL_SRCS,
     "avx512fp16": NON_PROD_AVX512FP16_MICROKERNEL_SRCS,
     "avx512skx": NON_PROD_AVX512SKX_MICROKERNEL_SRCS,
@@ -528,6 +528,7 @@ NON_PROD_SCALAR_MICROKERNEL_SRCS = [
     "src/f32-vsigmoid/gen/f32-vsigmoid-scalar-rr2-p5-div-u4.c",
     "src/f32-vsqrt/gen/f32-vsqrt-scalar-sqrt-u2.c",
     "src/f32-vsqrt/gen/f32-vsqrt-scalar-sqrt-u4.c",
+    "src/f32-winograd/f32-winograd-f4x4k3x3-scalar.c",
     "src/qd8-f16-qb4w-gemm/gen/qd8-f16-qb4w-gemm-1x2-minmax-scalar.c",
     "src/qd8-f16-qb4w-gemm/gen/qd8-f16-qb4w-gemm-1x4-minmax-scalar.c",
     "src/qd8-f16-qb4w-gemm/gen/qd8-f16-qb4w-gemm-1x8-minmax-scalar.c",
@@ -19,8 +19,11 @@ PROD_SSE_MICROKERNEL_SRCS = [
     "src/f32-dwconv2d-chw/gen/f32-dwconv2d-chw-5x5p2-minmax-sse-4x4.c",
     "src/f32-dwconv2d-chw/gen/f32-dwconv2d-chw-5x5s2p2-minmax-sse-2x4.c",
     "src/f32-gemm/gen/f32-gemm-1x8-minmax-sse-load1.c",
+    "src/f32-gemm/gen/f32-gemm-3x8-minmax-sse-load1.c",
     "src/f32-gemm/gen/f32-gemm-4x2c4-minmax-sse.c",
     "src/f32-gemm/gen/f32-gemm-4x8-minmax-sse-load1.c",
+    "src/f32-gemm/gen/f32-gemm-5x8-minmax-sse-load1.c",
+    "src/f32-gemm/gen/f32-gemm-6x8-minmax-sse-load1.c",
     "src/f32-ibilinear-chw/gen/f32-ibilinear-chw-sse-p8.c",
     "src/f32-ibilinear/gen/f32-ibilinear-sse-c8.c",
     "src/f32-igemm/gen/f32-igemm-1x8-minmax-sse-load1.c",
@@ -57,6 +60,7 @@ PROD_SSE_MICROKERNEL_SRCS = [
     "src/f32-vmulcaddc/gen/f32-vmulcaddc-c4-minmax-sse-2x.c",
     "src/f32-vrsqrt/gen/f32-vrsqrt-sse-rsqrt-u8.c",
     "src/f32-vsqrt/gen/f32-vsqrt-sse-rsqrt-u12.c",
+    "src/f32-winograd/f32-winograd-f4x4k3x3-sse.c",
     "src/x32-transposec/x32-transposec-4x4-sse.c",
 ]
 
@@ -131,16 +135,13 @@ NON_PROD_SSE_MICROKERNEL_SRCS = [
     "src/f32-gemm/gen/f32-gemm-1x8-minmax-sse-dup.c",
     "src/f32-gemm/gen/f32-gemm-1x8s4-minmax-sse.c",
     "src/f32-gemm/gen/f32-gemm-3x8-minmax-sse-dup.c",
-    "src/f32-gemm/gen/f32-gemm-3x8-minmax-sse-load1.c",
     "src/f32-gemm/gen/f32-gemm-3x8s4-minmax-sse.c",
     "src/f32-gemm/gen/f32-gemm-4x8-minmax-sse-dup.c",
     "src/f32-gemm/gen/f32-gemm-4x8s4-minmax-sse.c",
     "src/f32-gemm/gen/f32-gemm-5x8-minmax-sse-dup.c",
-    "src/f32-gemm/gen/f32-gemm-5x8-minmax-sse-load1.c",
     "src/f32-gemm/gen/f32-gemm-5x8s4-minmax-sse.c",
     "src/f32-gemm/gen/f32-gemm-6x2c4-minmax-sse.c",
     "src/f32-gemm/gen/f32-gemm-6x8-minmax-sse-dup.c",
-    "src/f32-gemm/gen/f32-gemm-6x8-minmax-sse-load1.c",
     "src/f32-gemm/gen/f32-gemm-6x8s4-minmax-sse.c",
     "src/f32-gemminc/gen/f32-gemminc-1x8-minmax-sse-dup.c",
     "src/f32-gemminc/gen/f32-gemminc-1x8-minmax-sse-load1.c",
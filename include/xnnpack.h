@@ -53,8 +53,10 @@ extern "C" {
 /// Enable timing of each operator's runtime.
 #define XNN_FLAG_BASIC_PROFILING 0x00000008
 
-/// Enable the just-in-time compiler.
-#define XNN_FLAG_JIT 0x00000010
+/// Enable the just-in-time compiler: F32 Fully Connected operators of the runtime use GEMM microkernels generated for
+/// their number of input channels, strides and output range. Only supported on x86-64 with AVX2 and FMA3 or AVX512F,
+/// other operators and platforms, or shapes that code can not be generated for, use the static microkernels.
+#define XNN_FLAG_JIT 0x00002000
 
 /// The convolution operator represents a depthwise convolution, and use HWGo layout for filters.
 #define XNN_FLAG_DEPTHWISE_CONVOLUTION 0x00000001
@@ -98,7 +100,39 @@ extern "C" {
 /// Retain reduced dimensions with length 1.
 #define XNN_FLAG_KEEP_DIMS 0x00000040
 
-// Next unused flag value: 0x00000200.
+/// Run mutually independent operators of a Runtime concurrently, each on a disjoint subset of the threadpool's threads.
+///
+/// Note: this flag trades a larger workspace for better thread utilization on graphs with parallel branches.
+#define XNN_FLAG_INTER_OP_PARALLELISM 0x00000200
+
+/// Compute attention over tiles of keys and values with an online softmax, rather than over complete rows of logits.
+///
+/// Note: this flag bounds the workspace for logits by the tile size rather than by the number of key/value tokens.
+#define XNN_FLAG_ATTENTION_ONLINE_SOFTMAX 0x00000400
+
+/// Collect hardware performance counters of each operator, in addition to its runtime. Implies
+/// XNN_FLAG_BASIC_PROFILING.
+///
+/// Note: counters are only supported on Linux and Android, and require perf_event_open to be permitted. Otherwise the
+/// Runtime is created without them, and xnn_get_runtime_profiling_info fails with xnn_status_unsupported_hardware for
+/// counters. Counters include the events of the threads of the thread pool, and of other operators that run
+/// concurrently.
+#define XNN_FLAG_HARDWARE_COUNTER_PROFILING 0x00000800
+
+/// Record the start, end, and thread of every parallelized task of each operator, see @ref xnn_write_runtime_trace.
+///
+/// Note: timing each task adds overhead to operators with many small tasks.
+#define XNN_FLAG_PARALLEL_TRACING 0x00001000
+
+/// Time the GEMM microkernels of different MR for the shape of each Fully Connected operator when it is reshaped, and
+/// use the fastest. Choices are recorded per shape and hardware, and can be kept across processes with
+/// xnn_save_gemm_tuning_file and xnn_load_gemm_tuning_file.
+///
+/// Note: tuning runs the microkernels on a sub-problem of every new shape, which makes the first reshape to each shape
+/// slower.
+#define XNN_FLAG_AUTOTUNE 0x00004000
+
+// Next unused flag value: 0x00008000.
 
 /// The number of entries in an array of xnn_quantization_params that XNNPACK may read beyond array bounds.
 /// The caller must allocate at least this many extra xnn_quantization_params before passing the array to XNNPACK.
@@ -1237,6 +1271,50 @@ enum xnn_status xnn_define_scaled_dot_product_attention(
   uint32_t output_id,
   uint32_t flags);
 
+/// Define a Scaled Dot-Product Attention Node with a key/value cache and add it to a Subgraph.
+///
+/// This operator is experimental.
+///
+/// The Node appends the new key and value tokens to persistent key and value caches, and computes a multi-head or
+/// multi-query scaled dot attention of the query over the valid prefix of the caches. The number of valid tokens in
+/// the caches after the append is given by the second dimension of the mask, which is expected to be reshaped (e.g.
+/// with xnn_reshape_external_value) before every step. The new tokens are written at the positions immediately
+/// preceding this length, so a decoding step only writes the new tokens into the caches and never copies the history.
+///
+/// @param subgraph - a Subgraph object that will own the created Node.
+/// @param cap_type - type of cap to be applied to the logits.
+/// @param cap_params - parameters for the cap. Must be a pointer to xnn_attention_logits_cap_tanh_params if cap_type
+///                     is xnn_attention_logits_cap_type_tanh.
+/// @param query_id - Value ID for the query tensor, as in xnn_define_scaled_dot_product_attention.
+/// @param key_id - Value ID for the new key tokens, with dimensions [*, H, N, C] (multi-head) or [*, N, C]
+///                 (multi-query), where N is the number of new tokens.
+/// @param value_id - Value ID for the new value tokens, with dimensions [*, H, N, D] (multi-head) or [*, N, D]
+///                   (multi-query).
+/// @param scale_id - Value ID for the scale tensor, as in xnn_define_scaled_dot_product_attention.
+/// @param mask_id - Value ID for the mask tensor. The mask tensor must be a 2D tensor defined in the @a subgraph with
+///                  [T, U] dimensions, where U is the number of valid cache tokens including the N new tokens.
+/// @param key_cache_id - Value ID for the key cache. The key cache must be a persistent tensor (defined with
+///                       XNN_VALUE_FLAG_PERSISTENT) with the dimensions of the key tensor, except for the tokens
+///                       dimension, which is the maximum number of cached tokens.
+/// @param value_cache_id - Value ID for the value cache. The value cache must be a persistent tensor with the
+///                         dimensions of the value tensor, except for the tokens dimension, which must match the key
+///                         cache.
+/// @param output_id - Value ID for the output tensor, as in xnn_define_scaled_dot_product_attention.
+/// @param flags - binary features of the Scaled Dot Product Attention Node. No supported flags are currently defined.
+enum xnn_status xnn_define_scaled_dot_product_attention_with_kv_cache(
+  xnn_subgraph_t subgraph,
+  enum xnn_attention_logits_cap_type cap_type,
+  const void* cap_params,
+  uint32_t query_id,
+  uint32_t key_id,
+  uint32_t value_id,
+  uint32_t scale_id,
+  uint32_t mask_id,
+  uint32_t key_cache_id,
+  uint32_t value_cache_id,
+  uint32_t output_id,
+  uint32_t flags);
+
 /// Define a Subtract Node and add it to a Subgraph.
 ///
 /// The Subtract Node computes elementwise subtraction of two tensor inputs with numpy broadcasting rules.
@@ -2227,10 +2305,65 @@ enum xnn_status xnn_finalize_weights_cache(
 // Wrapper function of the function pointers in `xnn_weights_cache_t`.
 bool xnn_weights_cache_is_finalized(xnn_weights_cache_t cache);
 
+/// Sets the buffer holding the original (unpacked) weights of the model, e.g. a memory-mapped model file.
+///
+/// Packed weights of kernels and biases inside this buffer are recorded by their offset in the buffer, and are found
+/// by xnn_weights_cache_look_up without packing them again. Together with xnn_save_weights_cache and
+/// xnn_create_weights_cache_from_file this allows reusing packed weights in another process, as long as the source
+/// buffer has the same contents there.
+///
+/// @param weights_cache - a weights cache object created with xnn_create_weights_cache or
+///                        xnn_create_weights_cache_from_file.
+/// @param data - pointer to the start of the buffer with the original weights, or NULL to stop recording keys.
+/// @param size - size of the buffer in bytes.
+enum xnn_status xnn_set_weights_cache_source(
+  xnn_weights_cache_t weights_cache,
+  const void* data,
+  size_t size);
+
+/// Saves the packed weights in the weights cache to a file, which can be loaded with
+/// xnn_create_weights_cache_from_file.
+///
+/// The file records the processor features that the weights were packed for, and can only be loaded on processors with
+/// the same features. The weights cache must not be hard finalized.
+///
+/// @param weights_cache - the weights cache object to save.
+/// @param path - path of the file to write.
+enum xnn_status xnn_save_weights_cache(
+  xnn_weights_cache_t weights_cache,
+  const char* path);
+
+/// Create a weights cache object from a file written by xnn_save_weights_cache.
+///
+/// The packed weights are mapped from the file without copying, so processes that load the same file share the pages
+/// in the page cache. The weights cache is soft finalized: operators with cached weights reuse them, and creating
+/// operators with other weights fails. Call xnn_set_weights_cache_source with the original weights before creating
+/// operators to look up packed weights without packing them.
+///
+/// @param path - path of the file to load.
+/// @param weights_cache_out - pointer to the variable that will be initialized to a handle to the weights cache provider
+///                            upon successful return.
+/// @retval xnn_status_unsupported_hardware - the file was written for a processor with different features.
+/// @retval xnn_status_unsupported_platform - the platform does not support memory-mapped files.
+enum xnn_status xnn_create_weights_cache_from_file(
+  const char* path,
+  xnn_weights_cache_t* weights_cache_out);
+
 /// Destroy a weights cache object, as well as memory used for the cache.
 /// @param weights_cache - the weights cache object to destroy.
 enum xnn_status xnn_delete_weights_cache(xnn_weights_cache_t weights_cache);
 
+/// Loads GEMM microkernel choices of XNN_FLAG_AUTOTUNE from a file written by xnn_save_gemm_tuning_file. Shapes in the
+/// file are not tuned again. Choices made on different hardware are kept but not used.
+///
+/// @param path - path of the file to load.
+enum xnn_status xnn_load_gemm_tuning_file(const char* path);
+
+/// Saves the GEMM microkernel choices of XNN_FLAG_AUTOTUNE made and loaded by this process to a file.
+///
+/// @param path - path of the file to write.
+enum xnn_status xnn_save_gemm_tuning_file(const char* path);
+
 typedef struct xnn_workspace* xnn_workspace_t;
 
 /// Create a workspace object.
@@ -2253,6 +2386,24 @@ enum xnn_profile_info {
   xnn_profile_info_operator_name,
   /// Returns a uint64_t[] with the runtimes of all operators in the same order as xnn_profile_info_operator_name.
   xnn_profile_info_operator_timing,
+  /// Returns a uint64_t[] with the CPU cycles spent in all operators, in the same order as
+  /// xnn_profile_info_operator_name. Requires XNN_FLAG_HARDWARE_COUNTER_PROFILING.
+  xnn_profile_info_operator_cycles,
+  /// Returns a uint64_t[] with the instructions retired in all operators. Requires
+  /// XNN_FLAG_HARDWARE_COUNTER_PROFILING.
+  xnn_profile_info_operator_instructions,
+  /// Returns a uint64_t[] with the L1 data cache read misses of all operators. Requires
+  /// XNN_FLAG_HARDWARE_COUNTER_PROFILING.
+  xnn_profile_info_operator_l1d_cache_misses,
+  /// Returns a uint64_t[] with the last level cache misses of all operators. Requires
+  /// XNN_FLAG_HARDWARE_COUNTER_PROFILING.
+  xnn_profile_info_operator_llc_misses,
+  /// Returns a uint64_t[] with an estimate of the arithmetic operations of all operators, computed from the shapes of
+  /// their inputs and outputs: two per multiply-accumulate for convolutions and matrix multiplications, and one per
+  /// output element otherwise.
+  xnn_profile_info_operator_flops,
+  /// Returns a uint64_t[] with the bytes of all inputs and outputs of all operators, including static weights.
+  xnn_profile_info_operator_bytes,
 };
 
 /// Return profile information for all operators.
@@ -2272,6 +2423,17 @@ enum xnn_status xnn_get_runtime_profiling_info(xnn_runtime_t runtime,
                                                void* param_value,
                                                size_t* param_value_size_ret);
 
+/// Write the tasks recorded since the runtime was created, or since the last call, in the Chrome trace event format.
+///
+/// The trace has one event for each parallelized computation of an operator on the thread that invoked the runtime,
+/// and one event per thread of the thread pool that ran tasks of the computation, with the number of tasks, the busy
+/// and idle time of the thread, and the time of its slowest task. The trace can be viewed with chrome://tracing or
+/// Perfetto. Recorded tasks are discarded once written.
+///
+/// @param runtime - a Runtime object created with XNN_FLAG_PARALLEL_TRACING.
+/// @param filename - path of the file to write the trace to.
+enum xnn_status xnn_write_runtime_trace(xnn_runtime_t runtime, const char* filename);
+
 /// Create a Runtime object from a subgraph.
 ///
 /// @param subgraph - a Subgraph object with all Values and Nodes that would be handled by the runtime. No Values or
@@ -2289,7 +2451,13 @@ enum xnn_status xnn_get_runtime_profiling_info(xnn_runtime_t runtime,
 ///                specified, worker threads would be yielded to the system scheduler after processing the last operator
 ///                in the Runtime. If XNN_FLAG_TRANSIENT_INDIRECTION_BUFFER is specified, convolution operators will
 ///                initialize indirection buffers on each inference run using temporary memory in the workspace, instead
-///                of initializing persistent indirection buffers once.
+///                of initializing persistent indirection buffers once. If XNN_FLAG_INTER_OP_PARALLELISM is
+///                specified, operators without data dependencies between them are grouped into stages and run
+///                concurrently, splitting the threads of the thread pool between them. If
+///                XNN_FLAG_HARDWARE_COUNTER_PROFILING is specified, hardware performance counters are read around each
+///                operator, see @ref xnn_get_runtime_profiling_info. If XNN_FLAG_PARALLEL_TRACING is specified, the
+///                tasks of each operator are recorded, see @ref xnn_write_runtime_trace. If XNN_FLAG_AUTOTUNE is
+///                specified, fully connected operators pick their GEMM microkernels by timing them.
 /// @param runtime_out - pointer to the variable that will be initialized with a handle to the Runtime object upon
 ///                      successful return. Once constructed, the Runtime object is independent of the Subgraph object
 ///                      used to create it.
@@ -2359,6 +2527,68 @@ enum xnn_status xnn_get_external_value_shape(
 enum xnn_status xnn_reshape_runtime(
   xnn_runtime_t runtime);
 
+/// Strategies to assign offsets in the workspace to the internal tensors of a Runtime object.
+enum xnn_memory_planner_strategy {
+  /// Allocate tensors in order of decreasing size, each in the smallest gap between live tensors that fits it.
+  xnn_memory_planner_strategy_greedy_by_size = 0,
+  /// Visit operators in order of decreasing total size of the tensors live while they run, and allocate the tensors of
+  /// each operator in order of decreasing size in the smallest gap that fits them.
+  xnn_memory_planner_strategy_greedy_by_breadth,
+  /// Allocate as greedy_by_size, then repeatedly move each tensor to the lowest offset that does not overlap with
+  /// other live tensors, until no tensor can be moved.
+  xnn_memory_planner_strategy_best_fit,
+  /// Search all allocation orders for the smallest arena. The search is only done for runtimes with few internal
+  /// tensors, larger runtimes fall back to best_fit.
+  xnn_memory_planner_strategy_exhaustive,
+};
+
+/// Select the strategy used to plan the memory of the internal tensors of a Runtime object.
+///
+/// The memory is replanned on the next call to xnn_reshape_runtime, after which xnn_setup_runtime_v2 must be called.
+///
+/// @param runtime - a Runtime object created with @ref xnn_create_runtime or @ref xnn_create_runtime_v2.
+/// @param strategy - the strategy to use for all subsequent memory planning of the runtime.
+enum xnn_status xnn_set_runtime_memory_planner(
+  xnn_runtime_t runtime,
+  enum xnn_memory_planner_strategy strategy);
+
+/// Get the size of the memory planned for the internal tensors of a Runtime object.
+///
+/// @param runtime - a Runtime object whose memory was planned by xnn_reshape_runtime or xnn_setup_runtime.
+/// @param arena_size_out - pointer to the variable that will be set to the size in bytes of the arena holding the
+///                         internal tensors and operator workspaces. The workspace additionally holds the persistent
+///                         tensors.
+/// @param lower_bound_out - pointer to the variable that will be set to the largest total size in bytes of the tensors
+///                          live at the same time, which no memory plan can improve on.
+enum xnn_status xnn_get_runtime_memory_plan_info(
+  xnn_runtime_t runtime,
+  size_t* arena_size_out,
+  size_t* lower_bound_out);
+
+/// Policies to choose which entry to evict from a full reshape cache.
+enum xnn_reshape_cache_eviction_policy {
+  /// Evict the entry that was least recently used by xnn_reshape_runtime.
+  xnn_reshape_cache_eviction_policy_lru = 0,
+  /// Evict the entry that was inserted first.
+  xnn_reshape_cache_eviction_policy_fifo,
+};
+
+/// Enable caching of the results of xnn_reshape_runtime for a Runtime object.
+///
+/// The cache is keyed by the shapes of the external inputs. When xnn_reshape_runtime is called with shapes seen before,
+/// the shapes of all tensors and the state of the operators are restored from the cache instead of reshaping the
+/// operators. Operators that allocate shape-dependent buffers, such as indirection buffers, are still reshaped. As
+/// before, xnn_setup_runtime_v2 must be called after xnn_reshape_runtime.
+///
+/// @param runtime - a Runtime object created with @ref xnn_create_runtime or @ref xnn_create_runtime_v2.
+/// @param max_entries - maximum number of input shapes to cache, or 0 to disable caching. Existing entries are
+///                      discarded.
+/// @param eviction_policy - the entry to evict when the cache is full and a new input shape is reshaped.
+enum xnn_status xnn_set_runtime_reshape_cache(
+  xnn_runtime_t runtime,
+  size_t max_entries,
+  enum xnn_reshape_cache_eviction_policy eviction_policy);
+
 /// Deprecated. Use xnn_reshape_runtime and xnn_setup_runtime_v2.
 ///
 /// Setup data pointers for external inputs and outputs in a Runtime object and
@@ -2634,6 +2864,21 @@ enum xnn_status xnn_setup_average_pooling2d_nhwc_qu8(
   const uint8_t* input,
   uint8_t* output);
 
+/// Create a Batch Matrix Multiply operator with BF16 inputs and FP32 output. Products are accumulated in FP32.
+enum xnn_status xnn_create_batch_matrix_multiply_nc_bf16_f32(
+  uint32_t flags,
+  xnn_operator_t* batch_matrix_multiply_op);
+
+enum xnn_status xnn_reshape_batch_matrix_multiply_nc_bf16_f32(
+    xnn_operator_t batch_matrix_multiply_op, size_t num_batch_dims,
+    const size_t* batch_dims_a, const size_t* batch_dims_b, size_t m, size_t k,
+    size_t n, size_t* workspace_size, size_t* workspace_alignment,
+    pthreadpool_t threadpool);
+
+enum xnn_status xnn_setup_batch_matrix_multiply_nc_bf16_f32(
+    xnn_operator_t batch_matrix_multiply_op, void* workspace,
+    const void* input_a, const void* input_b, float* output);
+
 enum xnn_status xnn_create_batch_matrix_multiply_nc_f16(
   uint32_t flags,
   xnn_operator_t* batch_matrix_multiply_op);
@@ -3724,6 +3969,32 @@ enum xnn_status xnn_setup_dynamic_fully_connected_nc_f32(
   const float* bias,
   float* output);
 
+/// Create a Fully Connected operator with BF16 input and weights, FP32 bias and FP32 output. Products are accumulated
+/// in FP32.
+enum xnn_status xnn_create_fully_connected_nc_bf16_f32(
+  size_t input_channels,
+  size_t output_channels,
+  size_t input_stride,
+  size_t output_stride,
+  const void* kernel,
+  const float* bias,
+  float output_min,
+  float output_max,
+  uint32_t flags,
+  xnn_code_cache_t code_cache,
+  xnn_weights_cache_t weights_cache,
+  xnn_operator_t* fully_connected_op_out);
+
+enum xnn_status xnn_reshape_fully_connected_nc_bf16_f32(
+  xnn_operator_t fully_connected_op,
+  size_t batch_size,
+  pthreadpool_t threadpool);
+
+enum xnn_status xnn_setup_fully_connected_nc_bf16_f32(
+  xnn_operator_t fully_connected_op,
+  const void* input,
+  float* output);
+
 enum xnn_status xnn_create_fully_connected_nc_f16(
   size_t input_channels,
   size_t output_channels,
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Copyright 2024 Google LLC
+#
+# This source code is licensed under the BSD-style license found in the
+# LICENSE file in the root directory of this source tree.
+
+################################## x86 AVX512-BF16 ###############################
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=1 -D NR=16 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-1x16c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=4 -D NR=16 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-4x16c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=7 -D NR=16 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-7x16c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=8 -D NR=16 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-8x16c2-minmax-avx512bf16-broadcast.c &
+
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=1 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-1x32c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=4 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-4x32c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=5 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-5x32c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=6 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-6x32c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=7 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-7x32c2-minmax-avx512bf16-broadcast.c &
+tools/xngen src/bf16-f32-gemm/avx512bf16-broadcast.c.in -D MR=8 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-8x32c2-minmax-avx512bf16-broadcast.c &
+
+################################## x86 AVX512-AMX ################################
+tools/xngen src/bf16-f32-gemm/c2-avx512amx.c.in -D MR=1  -D NR=16 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-1x16c2-minmax-avx512amx.c &
+tools/xngen src/bf16-f32-gemm/c2-avx512amx.c.in -D MR=16 -D NR=16 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-16x16c2-minmax-avx512amx.c &
+tools/xngen src/bf16-f32-gemm/c2-avx512amx.c.in -D MR=1  -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-1x32c2-minmax-avx512amx.c &
+tools/xngen src/bf16-f32-gemm/c2-avx512amx.c.in -D MR=16 -D NR=32 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-16x32c2-minmax-avx512amx.c &
+tools/xngen src/bf16-f32-gemm/c2-avx512amx.c.in -D MR=1  -D NR=64 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-1x64c2-minmax-avx512amx.c &
+tools/xngen src/bf16-f32-gemm/c2-avx512amx.c.in -D MR=16 -D NR=64 -o src/bf16-f32-gemm/gen/bf16-f32-gemm-16x64c2-minmax-avx512amx.c &
+
+wait
@@ -22,4 +22,8 @@ tools/xngen src/f16-spmm/neonfp16arith-pipelined.c.in -D MR=16 -D NR=1 -o src/f1
 tools/xngen src/f16-spmm/neonfp16arith-pipelined.c.in -D MR=24 -D NR=1 -o src/f16-spmm/gen/f16-spmm-24x1-minmax-neonfp16arith-pipelined.c &
 tools/xngen src/f16-spmm/neonfp16arith-pipelined.c.in -D MR=32 -D NR=1 -o src/f16-spmm/gen/f16-spmm-32x1-minmax-neonfp16arith-pipelined.c &
 
+################################ x86 AVX512FP16 ###############################
+tools/xngen src/f16-spmm/avx512fp16.c.in -D MR=32 -D NR=1 -o src/f16-spmm/gen/f16-spmm-32x1-minmax-avx512fp16.c &
+tools/xngen src/f16-spmm/avx512fp16.c.in -D MR=64 -D NR=1 -o src/f16-spmm/gen/f16-spmm-64x1-minmax-avx512fp16.c &
+
 wait
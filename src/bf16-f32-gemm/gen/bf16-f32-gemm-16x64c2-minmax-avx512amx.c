@@ -0,0 +1,571 @@
+// Auto-generated file. Do not edit!
+//   Template: src/bf16-f32-gemm/c2-avx512amx.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__has_feature)
+  #if __has_feature(memory_sanitizer)
+    #include <sanitizer/msan_interface.h>
+  #endif
+#endif
+
+#include <immintrin.h>
+
+#include "xnnpack/amx.h"
+#include "xnnpack/common.h"
+#include "xnnpack/gemm.h"
+#include "xnnpack/intrinsics-polyfill.h"
+#include "xnnpack/math.h"
+
+
+void xnn_bf16_f32_gemm_minmax_ukernel_16x64c2__avx512amx(
+    size_t mr,
+    size_t nc,
+    size_t kc,
+    const xnn_bfloat16* restrict a,
+    size_t a_stride,
+    const void* restrict w,
+    float* restrict c,
+    size_t cm_stride,
+    size_t cn_stride,
+    const union xnn_f32_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mr != 0);
+  assert(mr <= 16);
+  assert(nc != 0);
+  assert(kc != 0);
+  assert(kc % sizeof(xnn_bfloat16) == 0);
+  assert(a != NULL);
+  assert(w != NULL);
+  assert(c != NULL);
+
+// TODO: amxintrin.h only provide intrinsics for __x86_64__
+// Update if amxintrin changes
+#if defined(__x86_64__)
+  __attribute__((aligned(64))) float res[4][16 * 16];
+  // Rows of A in the last, partial, block of 32 input channels, padded with zeros to a pair of input channels.
+  __attribute__((aligned(64))) uint16_t a_remainder[16 * 32];
+
+  const size_t kfull = kc & -(32 * sizeof(xnn_bfloat16));
+  const size_t kremainder = kc - kfull;
+  const size_t kremainder_padded = round_up_po2(kremainder, 2 * sizeof(xnn_bfloat16));
+  if (kremainder != 0) {
+    memset(a_remainder, 0, sizeof(a_remainder));
+  }
+
+  // Load tile configuration
+  __attribute__((aligned(64))) struct xnn_amx_tile_config tile_data = {0};
+  tile_data.palette_id = 1;
+  tile_data.rows[0] = mr;                          // tmm0 = res[0]
+  tile_data.rows[1] = mr;                          // tmm1 = res[1]
+  tile_data.rows[2] = mr;                          // tmm2 = res[2]
+  tile_data.rows[3] = mr;                          // tmm3 = res[3]
+  tile_data.rows[4] = mr;                          // tmm4 = input
+  tile_data.rows[5] = 16;                          // tmm5 = weights
+  tile_data.rows[6] = mr;                          // tmm6 = input remainder
+  tile_data.rows[7] = kremainder_padded ? kremainder_padded >> 2 : 16;  // tmm7 = weights remainder
+
+  tile_data.colsb[0] = 64;                         // tmm0 = res[0]
+  tile_data.colsb[1] = 64;                         // tmm1 = res[1]
+  tile_data.colsb[2] = 64;                         // tmm2 = res[2]
+  tile_data.colsb[3] = 64;                         // tmm3 = res[3]
+  tile_data.colsb[4] = 64;                         // tmm4 = input
+  tile_data.colsb[5] = 64;                         // tmm5 = weights
+  tile_data.colsb[6] = kremainder_padded ? kremainder_padded : 64;  // tmm6 = input remainder
+  tile_data.colsb[7] = 64;                         // tmm7 = weights remainder
+
+  // The tiles stay configured on return, for the next call from this thread.
+  xnn_amx_load_tile_config(&tile_data);
+
+  float* c0 = c;
+  float* c1 = (float*) ((uintptr_t) c0 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 2) {
+    c1 = c0;
+  }
+  float* c2 = (float*) ((uintptr_t) c1 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 2) {
+    c2 = c1;
+  }
+  float* c3 = (float*) ((uintptr_t) c2 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 4) {
+    c3 = c2;
+  }
+  float* c4 = (float*) ((uintptr_t) c3 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 4) {
+    c4 = c3;
+  }
+  float* c5 = (float*) ((uintptr_t) c4 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 6) {
+    c5 = c4;
+  }
+  float* c6 = (float*) ((uintptr_t) c5 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 6) {
+    c6 = c5;
+  }
+  float* c7 = (float*) ((uintptr_t) c6 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 8) {
+    c7 = c6;
+  }
+  float* c8 = (float*) ((uintptr_t) c7 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 8) {
+    c8 = c7;
+  }
+  float* c9 = (float*) ((uintptr_t) c8 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 10) {
+    c9 = c8;
+  }
+  float* c10 = (float*) ((uintptr_t) c9 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 10) {
+    c10 = c9;
+  }
+  float* c11 = (float*) ((uintptr_t) c10 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 12) {
+    c11 = c10;
+  }
+  float* c12 = (float*) ((uintptr_t) c11 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 12) {
+    c12 = c11;
+  }
+  float* c13 = (float*) ((uintptr_t) c12 + cm_stride);
+  if XNN_UNPREDICTABLE(mr < 14) {
+    c13 = c12;
+  }
+  float* c14 = (float*) ((uintptr_t) c13 + cm_stride);
+  if XNN_UNPREDICTABLE(mr <= 14) {
+    c14 = c13;
+  }
+  float* c15 = (float*) ((uintptr_t) c14 + cm_stride);
+  if XNN_UNPREDICTABLE(mr != 16) {
+    c15 = c14;
+  }
+
+  if (kremainder != 0) {
+    for (size_t m = 0; m < mr; m++) {
+      memcpy(a_remainder + m * 32, (const void*) ((uintptr_t) a + kfull + m * a_stride), kremainder);
+    }
+  }
+
+  const __m512 voutput_min = _mm512_set1_ps(params->scalar.min);
+  const __m512 voutput_max = _mm512_set1_ps(params->scalar.max);
+
+  do {
+    const __m512 vbias0 = _mm512_loadu_ps((const float*) w + 0);
+    const __m512 vbias1 = _mm512_loadu_ps((const float*) w + 16);
+    const __m512 vbias2 = _mm512_loadu_ps((const float*) w + 32);
+    const __m512 vbias3 = _mm512_loadu_ps((const float*) w + 48);
+    w = (const float*) w + 64;
+
+    // Zero tile accumulator
+    __asm__ volatile (
+      "tilezero %%tmm0\n"
+      "tilezero %%tmm1\n"
+      "tilezero %%tmm2\n"
+      "tilezero %%tmm3\n"
+      ::);
+
+    const uint16_t* a0 = (const uint16_t*) a;
+    size_t k = kfull;
+    while (k != 0) {
+      _tile_loadd(4, a0, a_stride);
+      a0 += 32;
+      _tile_loadd(5, (const uint16_t*) w + 0, 256);
+      _tile_dpbf16ps(0, 4, 5);
+      _tile_loadd(5, (const uint16_t*) w + 32, 256);
+      _tile_dpbf16ps(1, 4, 5);
+      _tile_loadd(5, (const uint16_t*) w + 64, 256);
+      _tile_dpbf16ps(2, 4, 5);
+      _tile_loadd(5, (const uint16_t*) w + 96, 256);
+      _tile_dpbf16ps(3, 4, 5);
+
+      w = (const uint16_t*) w + 2048;
+      k -= 32 * sizeof(xnn_bfloat16);
+    }
+
+    if XNN_UNLIKELY(kremainder != 0) {
+      _tile_loadd(6, a_remainder, 64);
+      _tile_loadd(7, (const uint16_t*) w + 0, 256);
+      _tile_dpbf16ps(0, 6, 7);
+      _tile_loadd(7, (const uint16_t*) w + 32, 256);
+      _tile_dpbf16ps(1, 6, 7);
+      _tile_loadd(7, (const uint16_t*) w + 64, 256);
+      _tile_dpbf16ps(2, 6, 7);
+      _tile_loadd(7, (const uint16_t*) w + 96, 256);
+      _tile_dpbf16ps(3, 6, 7);
+
+      w = (const uint16_t*) w + (kremainder_padded >> 2) * 128;
+    }
+
+    _tile_stored(0, &res[0][0], 64);
+    _tile_stored(1, &res[1][0], 64);
+    _tile_stored(2, &res[2][0], 64);
+    _tile_stored(3, &res[3][0], 64);
+
+    // TODO: Fix msan for AMX
+    #if defined(__has_feature)
+      #if __has_feature(memory_sanitizer)
+        __msan_unpoison(res, sizeof(res));
+      #endif
+    #endif
+
+    // Add tile to bias
+    __m512 vacc0x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 0));
+    __m512 vacc0x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 0));
+    __m512 vacc0x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 0));
+    __m512 vacc0x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 0));
+    __m512 vacc1x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 16));
+    __m512 vacc1x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 16));
+    __m512 vacc1x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 16));
+    __m512 vacc1x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 16));
+    __m512 vacc2x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 32));
+    __m512 vacc2x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 32));
+    __m512 vacc2x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 32));
+    __m512 vacc2x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 32));
+    __m512 vacc3x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 48));
+    __m512 vacc3x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 48));
+    __m512 vacc3x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 48));
+    __m512 vacc3x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 48));
+    __m512 vacc4x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 64));
+    __m512 vacc4x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 64));
+    __m512 vacc4x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 64));
+    __m512 vacc4x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 64));
+    __m512 vacc5x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 80));
+    __m512 vacc5x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 80));
+    __m512 vacc5x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 80));
+    __m512 vacc5x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 80));
+    __m512 vacc6x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 96));
+    __m512 vacc6x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 96));
+    __m512 vacc6x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 96));
+    __m512 vacc6x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 96));
+    __m512 vacc7x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 112));
+    __m512 vacc7x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 112));
+    __m512 vacc7x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 112));
+    __m512 vacc7x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 112));
+    __m512 vacc8x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 128));
+    __m512 vacc8x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 128));
+    __m512 vacc8x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 128));
+    __m512 vacc8x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 128));
+    __m512 vacc9x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 144));
+    __m512 vacc9x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 144));
+    __m512 vacc9x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 144));
+    __m512 vacc9x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 144));
+    __m512 vacc10x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 160));
+    __m512 vacc10x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 160));
+    __m512 vacc10x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 160));
+    __m512 vacc10x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 160));
+    __m512 vacc11x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 176));
+    __m512 vacc11x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 176));
+    __m512 vacc11x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 176));
+    __m512 vacc11x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 176));
+    __m512 vacc12x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 192));
+    __m512 vacc12x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 192));
+    __m512 vacc12x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 192));
+    __m512 vacc12x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 192));
+    __m512 vacc13x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 208));
+    __m512 vacc13x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 208));
+    __m512 vacc13x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 208));
+    __m512 vacc13x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 208));
+    __m512 vacc14x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 224));
+    __m512 vacc14x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 224));
+    __m512 vacc14x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 224));
+    __m512 vacc14x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 224));
+    __m512 vacc15x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 240));
+    __m512 vacc15x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 240));
+    __m512 vacc15x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 240));
+    __m512 vacc15x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 240));
+
+    vacc0x0 = _mm512_max_ps(vacc0x0, voutput_min);
+    vacc0x1 = _mm512_max_ps(vacc0x1, voutput_min);
+    vacc0x2 = _mm512_max_ps(vacc0x2, voutput_min);
+    vacc0x3 = _mm512_max_ps(vacc0x3, voutput_min);
+    vacc1x0 = _mm512_max_ps(vacc1x0, voutput_min);
+    vacc1x1 = _mm512_max_ps(vacc1x1, voutput_min);
+    vacc1x2 = _mm512_max_ps(vacc1x2, voutput_min);
+    vacc1x3 = _mm512_max_ps(vacc1x3, voutput_min);
+    vacc2x0 = _mm512_max_ps(vacc2x0, voutput_min);
+    vacc2x1 = _mm512_max_ps(vacc2x1, voutput_min);
+    vacc2x2 = _mm512_max_ps(vacc2x2, voutput_min);
+    vacc2x3 = _mm512_max_ps(vacc2x3, voutput_min);
+    vacc3x0 = _mm512_max_ps(vacc3x0, voutput_min);
+    vacc3x1 = _mm512_max_ps(vacc3x1, voutput_min);
+    vacc3x2 = _mm512_max_ps(vacc3x2, voutput_min);
+    vacc3x3 = _mm512_max_ps(vacc3x3, voutput_min);
+    vacc4x0 = _mm512_max_ps(vacc4x0, voutput_min);
+    vacc4x1 = _mm512_max_ps(vacc4x1, voutput_min);
+    vacc4x2 = _mm512_max_ps(vacc4x2, voutput_min);
+    vacc4x3 = _mm512_max_ps(vacc4x3, voutput_min);
+    vacc5x0 = _mm512_max_ps(vacc5x0, voutput_min);
+    vacc5x1 = _mm512_max_ps(vacc5x1, voutput_min);
+    vacc5x2 = _mm512_max_ps(vacc5x2, voutput_min);
+    vacc5x3 = _mm512_max_ps(vacc5x3, voutput_min);
+    vacc6x0 = _mm512_max_ps(vacc6x0, voutput_min);
+    vacc6x1 = _mm512_max_ps(vacc6x1, voutput_min);
+    vacc6x2 = _mm512_max_ps(vacc6x2, voutput_min);
+    vacc6x3 = _mm512_max_ps(vacc6x3, voutput_min);
+    vacc7x0 = _mm512_max_ps(vacc7x0, voutput_min);
+    vacc7x1 = _mm512_max_ps(vacc7x1, voutput_min);
+    vacc7x2 = _mm512_max_ps(vacc7x2, voutput_min);
+    vacc7x3 = _mm512_max_ps(vacc7x3, voutput_min);
+    vacc8x0 = _mm512_max_ps(vacc8x0, voutput_min);
+    vacc8x1 = _mm512_max_ps(vacc8x1, voutput_min);
+    vacc8x2 = _mm512_max_ps(vacc8x2, voutput_min);
+    vacc8x3 = _mm512_max_ps(vacc8x3, voutput_min);
+    vacc9x0 = _mm512_max_ps(vacc9x0, voutput_min);
+    vacc9x1 = _mm512_max_ps(vacc9x1, voutput_min);
+    vacc9x2 = _mm512_max_ps(vacc9x2, voutput_min);
+    vacc9x3 = _mm512_max_ps(vacc9x3, voutput_min);
+    vacc10x0 = _mm512_max_ps(vacc10x0, voutput_min);
+    vacc10x1 = _mm512_max_ps(vacc10x1, voutput_min);
+    vacc10x2 = _mm512_max_ps(vacc10x2, voutput_min);
+    vacc10x3 = _mm512_max_ps(vacc10x3, voutput_min);
+    vacc11x0 = _mm512_max_ps(vacc11x0, voutput_min);
+    vacc11x1 = _mm512_max_ps(vacc11x1, voutput_min);
+    vacc11x2 = _mm512_max_ps(vacc11x2, voutput_min);
+    vacc11x3 = _mm512_max_ps(vacc11x3, voutput_min);
+    vacc12x0 = _mm512_max_ps(vacc12x0, voutput_min);
+    vacc12x1 = _mm512_max_ps(vacc12x1, voutput_min);
+    vacc12x2 = _mm512_max_ps(vacc12x2, voutput_min);
+    vacc12x3 = _mm512_max_ps(vacc12x3, voutput_min);
+    vacc13x0 = _mm512_max_ps(vacc13x0, voutput_min);
+    vacc13x1 = _mm512_max_ps(vacc13x1, voutput_min);
+    vacc13x2 = _mm512_max_ps(vacc13x2, voutput_min);
+    vacc13x3 = _mm512_max_ps(vacc13x3, voutput_min);
+    vacc14x0 = _mm512_max_ps(vacc14x0, voutput_min);
+    vacc14x1 = _mm512_max_ps(vacc14x1, voutput_min);
+    vacc14x2 = _mm512_max_ps(vacc14x2, voutput_min);
+    vacc14x3 = _mm512_max_ps(vacc14x3, voutput_min);
+    vacc15x0 = _mm512_max_ps(vacc15x0, voutput_min);
+    vacc15x1 = _mm512_max_ps(vacc15x1, voutput_min);
+    vacc15x2 = _mm512_max_ps(vacc15x2, voutput_min);
+    vacc15x3 = _mm512_max_ps(vacc15x3, voutput_min);
+
+    vacc0x0 = _mm512_min_ps(vacc0x0, voutput_max);
+    vacc0x1 = _mm512_min_ps(vacc0x1, voutput_max);
+    vacc0x2 = _mm512_min_ps(vacc0x2, voutput_max);
+    vacc0x3 = _mm512_min_ps(vacc0x3, voutput_max);
+    vacc1x0 = _mm512_min_ps(vacc1x0, voutput_max);
+    vacc1x1 = _mm512_min_ps(vacc1x1, voutput_max);
+    vacc1x2 = _mm512_min_ps(vacc1x2, voutput_max);
+    vacc1x3 = _mm512_min_ps(vacc1x3, voutput_max);
+    vacc2x0 = _mm512_min_ps(vacc2x0, voutput_max);
+    vacc2x1 = _mm512_min_ps(vacc2x1, voutput_max);
+    vacc2x2 = _mm512_min_ps(vacc2x2, voutput_max);
+    vacc2x3 = _mm512_min_ps(vacc2x3, voutput_max);
+    vacc3x0 = _mm512_min_ps(vacc3x0, voutput_max);
+    vacc3x1 = _mm512_min_ps(vacc3x1, voutput_max);
+    vacc3x2 = _mm512_min_ps(vacc3x2, voutput_max);
+    vacc3x3 = _mm512_min_ps(vacc3x3, voutput_max);
+    vacc4x0 = _mm512_min_ps(vacc4x0, voutput_max);
+    vacc4x1 = _mm512_min_ps(vacc4x1, voutput_max);
+    vacc4x2 = _mm512_min_ps(vacc4x2, voutput_max);
+    vacc4x3 = _mm512_min_ps(vacc4x3, voutput_max);
+    vacc5x0 = _mm512_min_ps(vacc5x0, voutput_max);
+    vacc5x1 = _mm512_min_ps(vacc5x1, voutput_max);
+    vacc5x2 = _mm512_min_ps(vacc5x2, voutput_max);
+    vacc5x3 = _mm512_min_ps(vacc5x3, voutput_max);
+    vacc6x0 = _mm512_min_ps(vacc6x0, voutput_max);
+    vacc6x1 = _mm512_min_ps(vacc6x1, voutput_max);
+    vacc6x2 = _mm512_min_ps(vacc6x2, voutput_max);
+    vacc6x3 = _mm512_min_ps(vacc6x3, voutput_max);
+    vacc7x0 = _mm512_min_ps(vacc7x0, voutput_max);
+    vacc7x1 = _mm512_min_ps(vacc7x1, voutput_max);
+    vacc7x2 = _mm512_min_ps(vacc7x2, voutput_max);
+    vacc7x3 = _mm512_min_ps(vacc7x3, voutput_max);
+    vacc8x0 = _mm512_min_ps(vacc8x0, voutput_max);
+    vacc8x1 = _mm512_min_ps(vacc8x1, voutput_max);
+    vacc8x2 = _mm512_min_ps(vacc8x2, voutput_max);
+    vacc8x3 = _mm512_min_ps(vacc8x3, voutput_max);
+    vacc9x0 = _mm512_min_ps(vacc9x0, voutput_max);
+    vacc9x1 = _mm512_min_ps(vacc9x1, voutput_max);
+    vacc9x2 = _mm512_min_ps(vacc9x2, voutput_max);
+    vacc9x3 = _mm512_min_ps(vacc9x3, voutput_max);
+    vacc10x0 = _mm512_min_ps(vacc10x0, voutput_max);
+    vacc10x1 = _mm512_min_ps(vacc10x1, voutput_max);
+    vacc10x2 = _mm512_min_ps(vacc10x2, voutput_max);
+    vacc10x3 = _mm512_min_ps(vacc10x3, voutput_max);
+    vacc11x0 = _mm512_min_ps(vacc11x0, voutput_max);
+    vacc11x1 = _mm512_min_ps(vacc11x1, voutput_max);
+    vacc11x2 = _mm512_min_ps(vacc11x2, voutput_max);
+    vacc11x3 = _mm512_min_ps(vacc11x3, voutput_max);
+    vacc12x0 = _mm512_min_ps(vacc12x0, voutput_max);
+    vacc12x1 = _mm512_min_ps(vacc12x1, voutput_max);
+    vacc12x2 = _mm512_min_ps(vacc12x2, voutput_max);
+    vacc12x3 = _mm512_min_ps(vacc12x3, voutput_max);
+    vacc13x0 = _mm512_min_ps(vacc13x0, voutput_max);
+    vacc13x1 = _mm512_min_ps(vacc13x1, voutput_max);
+    vacc13x2 = _mm512_min_ps(vacc13x2, voutput_max);
+    vacc13x3 = _mm512_min_ps(vacc13x3, voutput_max);
+    vacc14x0 = _mm512_min_ps(vacc14x0, voutput_max);
+    vacc14x1 = _mm512_min_ps(vacc14x1, voutput_max);
+    vacc14x2 = _mm512_min_ps(vacc14x2, voutput_max);
+    vacc14x3 = _mm512_min_ps(vacc14x3, voutput_max);
+    vacc15x0 = _mm512_min_ps(vacc15x0, voutput_max);
+    vacc15x1 = _mm512_min_ps(vacc15x1, voutput_max);
+    vacc15x2 = _mm512_min_ps(vacc15x2, voutput_max);
+    vacc15x3 = _mm512_min_ps(vacc15x3, voutput_max);
+
+    if XNN_LIKELY(nc >= 64) {
+      _mm512_storeu_ps(c15 + 0, vacc15x0);
+      _mm512_storeu_ps(c15 + 16, vacc15x1);
+      _mm512_storeu_ps(c15 + 32, vacc15x2);
+      _mm512_storeu_ps(c15 + 48, vacc15x3);
+      c15 = (float*) ((uintptr_t) c15 + cn_stride);
+      _mm512_storeu_ps(c14 + 0, vacc14x0);
+      _mm512_storeu_ps(c14 + 16, vacc14x1);
+      _mm512_storeu_ps(c14 + 32, vacc14x2);
+      _mm512_storeu_ps(c14 + 48, vacc14x3);
+      c14 = (float*) ((uintptr_t) c14 + cn_stride);
+      _mm512_storeu_ps(c13 + 0, vacc13x0);
+      _mm512_storeu_ps(c13 + 16, vacc13x1);
+      _mm512_storeu_ps(c13 + 32, vacc13x2);
+      _mm512_storeu_ps(c13 + 48, vacc13x3);
+      c13 = (float*) ((uintptr_t) c13 + cn_stride);
+      _mm512_storeu_ps(c12 + 0, vacc12x0);
+      _mm512_storeu_ps(c12 + 16, vacc12x1);
+      _mm512_storeu_ps(c12 + 32, vacc12x2);
+      _mm512_storeu_ps(c12 + 48, vacc12x3);
+      c12 = (float*) ((uintptr_t) c12 + cn_stride);
+      _mm512_storeu_ps(c11 + 0, vacc11x0);
+      _mm512_storeu_ps(c11 + 16, vacc11x1);
+      _mm512_storeu_ps(c11 + 32, vacc11x2);
+      _mm512_storeu_ps(c11 + 48, vacc11x3);
+      c11 = (float*) ((uintptr_t) c11 + cn_stride);
+      _mm512_storeu_ps(c10 + 0, vacc10x0);
+      _mm512_storeu_ps(c10 + 16, vacc10x1);
+      _mm512_storeu_ps(c10 + 32, vacc10x2);
+      _mm512_storeu_ps(c10 + 48, vacc10x3);
+      c10 = (float*) ((uintptr_t) c10 + cn_stride);
+      _mm512_storeu_ps(c9 + 0, vacc9x0);
+      _mm512_storeu_ps(c9 + 16, vacc9x1);
+      _mm512_storeu_ps(c9 + 32, vacc9x2);
+      _mm512_storeu_ps(c9 + 48, vacc9x3);
+      c9 = (float*) ((uintptr_t) c9 + cn_stride);
+      _mm512_storeu_ps(c8 + 0, vacc8x0);
+      _mm512_storeu_ps(c8 + 16, vacc8x1);
+      _mm512_storeu_ps(c8 + 32, vacc8x2);
+      _mm512_storeu_ps(c8 + 48, vacc8x3);
+      c8 = (float*) ((uintptr_t) c8 + cn_stride);
+      _mm512_storeu_ps(c7 + 0, vacc7x0);
+      _mm512_storeu_ps(c7 + 16, vacc7x1);
+      _mm512_storeu_ps(c7 + 32, vacc7x2);
+      _mm512_storeu_ps(c7 + 48, vacc7x3);
+      c7 = (float*) ((uintptr_t) c7 + cn_stride);
+      _mm512_storeu_ps(c6 + 0, vacc6x0);
+      _mm512_storeu_ps(c6 + 16, vacc6x1);
+      _mm512_storeu_ps(c6 + 32, vacc6x2);
+      _mm512_storeu_ps(c6 + 48, vacc6x3);
+      c6 = (float*) ((uintptr_t) c6 + cn_stride);
+      _mm512_storeu_ps(c5 + 0, vacc5x0);
+      _mm512_storeu_ps(c5 + 16, vacc5x1);
+      _mm512_storeu_ps(c5 + 32, vacc5x2);
+      _mm512_storeu_ps(c5 + 48, vacc5x3);
+      c5 = (float*) ((uintptr_t) c5 + cn_stride);
+      _mm512_storeu_ps(c4 + 0, vacc4x0);
+      _mm512_storeu_ps(c4 + 16, vacc4x1);
+      _mm512_storeu_ps(c4 + 32, vacc4x2);
+      _mm512_storeu_ps(c4 + 48, vacc4x3);
+      c4 = (float*) ((uintptr_t) c4 + cn_stride);
+      _mm512_storeu_ps(c3 + 0, vacc3x0);
+      _mm512_storeu_ps(c3 + 16, vacc3x1);
+      _mm512_storeu_ps(c3 + 32, vacc3x2);
+      _mm512_storeu_ps(c3 + 48, vacc3x3);
+      c3 = (float*) ((uintptr_t) c3 + cn_stride);
+      _mm512_storeu_ps(c2 + 0, vacc2x0);
+      _mm512_storeu_ps(c2 + 16, vacc2x1);
+      _mm512_storeu_ps(c2 + 32, vacc2x2);
+      _mm512_storeu_ps(c2 + 48, vacc2x3);
+      c2 = (float*) ((uintptr_t) c2 + cn_stride);
+      _mm512_storeu_ps(c1 + 0, vacc1x0);
+      _mm512_storeu_ps(c1 + 16, vacc1x1);
+      _mm512_storeu_ps(c1 + 32, vacc1x2);
+      _mm512_storeu_ps(c1 + 48, vacc1x3);
+      c1 = (float*) ((uintptr_t) c1 + cn_stride);
+      _mm512_storeu_ps(c0 + 0, vacc0x0);
+      _mm512_storeu_ps(c0 + 16, vacc0x1);
+      _mm512_storeu_ps(c0 + 32, vacc0x2);
+      _mm512_storeu_ps(c0 + 48, vacc0x3);
+      c0 = (float*) ((uintptr_t) c0 + cn_stride);
+
+      nc -= 64;
+    } else {
+      // Prepare mask for valid 32-bit elements (depends on nc).
+      const __mmask16 vmask0 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 0) & 0xFFFF));
+      const __mmask16 vmask1 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 16) & 0xFFFF));
+      const __mmask16 vmask2 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 32) & 0xFFFF));
+      const __mmask16 vmask3 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 48) & 0xFFFF));
+      _mm512_mask_storeu_ps(c15 + 0, vmask0, vacc15x0);
+      _mm512_mask_storeu_ps(c15 + 16, vmask1, vacc15x1);
+      _mm512_mask_storeu_ps(c15 + 32, vmask2, vacc15x2);
+      _mm512_mask_storeu_ps(c15 + 48, vmask3, vacc15x3);
+      _mm512_mask_storeu_ps(c14 + 0, vmask0, vacc14x0);
+      _mm512_mask_storeu_ps(c14 + 16, vmask1, vacc14x1);
+      _mm512_mask_storeu_ps(c14 + 32, vmask2, vacc14x2);
+      _mm512_mask_storeu_ps(c14 + 48, vmask3, vacc14x3);
+      _mm512_mask_storeu_ps(c13 + 0, vmask0, vacc13x0);
+      _mm512_mask_storeu_ps(c13 + 16, vmask1, vacc13x1);
+      _mm512_mask_storeu_ps(c13 + 32, vmask2, vacc13x2);
+      _mm512_mask_storeu_ps(c13 + 48, vmask3, vacc13x3);
+      _mm512_mask_storeu_ps(c12 + 0, vmask0, vacc12x0);
+      _mm512_mask_storeu_ps(c12 + 16, vmask1, vacc12x1);
+      _mm512_mask_storeu_ps(c12 + 32, vmask2, vacc12x2);
+      _mm512_mask_storeu_ps(c12 + 48, vmask3, vacc12x3);
+      _mm512_mask_storeu_ps(c11 + 0, vmask0, vacc11x0);
+      _mm512_mask_storeu_ps(c11 + 16, vmask1, vacc11x1);
+      _mm512_mask_storeu_ps(c11 + 32, vmask2, vacc11x2);
+      _mm512_mask_storeu_ps(c11 + 48, vmask3, vacc11x3);
+      _mm512_mask_storeu_ps(c10 + 0, vmask0, vacc10x0);
+      _mm512_mask_storeu_ps(c10 + 16, vmask1, vacc10x1);
+      _mm512_mask_storeu_ps(c10 + 32, vmask2, vacc10x2);
+      _mm512_mask_storeu_ps(c10 + 48, vmask3, vacc10x3);
+      _mm512_mask_storeu_ps(c9 + 0, vmask0, vacc9x0);
+      _mm512_mask_storeu_ps(c9 + 16, vmask1, vacc9x1);
+      _mm512_mask_storeu_ps(c9 + 32, vmask2, vacc9x2);
+      _mm512_mask_storeu_ps(c9 + 48, vmask3, vacc9x3);
+      _mm512_mask_storeu_ps(c8 + 0, vmask0, vacc8x0);
+      _mm512_mask_storeu_ps(c8 + 16, vmask1, vacc8x1);
+      _mm512_mask_storeu_ps(c8 + 32, vmask2, vacc8x2);
+      _mm512_mask_storeu_ps(c8 + 48, vmask3, vacc8x3);
+      _mm512_mask_storeu_ps(c7 + 0, vmask0, vacc7x0);
+      _mm512_mask_storeu_ps(c7 + 16, vmask1, vacc7x1);
+      _mm512_mask_storeu_ps(c7 + 32, vmask2, vacc7x2);
+      _mm512_mask_storeu_ps(c7 + 48, vmask3, vacc7x3);
+      _mm512_mask_storeu_ps(c6 + 0, vmask0, vacc6x0);
+      _mm512_mask_storeu_ps(c6 + 16, vmask1, vacc6x1);
+      _mm512_mask_storeu_ps(c6 + 32, vmask2, vacc6x2);
+      _mm512_mask_storeu_ps(c6 + 48, vmask3, vacc6x3);
+      _mm512_mask_storeu_ps(c5 + 0, vmask0, vacc5x0);
+      _mm512_mask_storeu_ps(c5 + 16, vmask1, vacc5x1);
+      _mm512_mask_storeu_ps(c5 + 32, vmask2, vacc5x2);
+      _mm512_mask_storeu_ps(c5 + 48, vmask3, vacc5x3);
+      _mm512_mask_storeu_ps(c4 + 0, vmask0, vacc4x0);
+      _mm512_mask_storeu_ps(c4 + 16, vmask1, vacc4x1);
+      _mm512_mask_storeu_ps(c4 + 32, vmask2, vacc4x2);
+      _mm512_mask_storeu_ps(c4 + 48, vmask3, vacc4x3);
+      _mm512_mask_storeu_ps(c3 + 0, vmask0, vacc3x0);
+      _mm512_mask_storeu_ps(c3 + 16, vmask1, vacc3x1);
+      _mm512_mask_storeu_ps(c3 + 32, vmask2, vacc3x2);
+      _mm512_mask_storeu_ps(c3 + 48, vmask3, vacc3x3);
+      _mm512_mask_storeu_ps(c2 + 0, vmask0, vacc2x0);
+      _mm512_mask_storeu_ps(c2 + 16, vmask1, vacc2x1);
+      _mm512_mask_storeu_ps(c2 + 32, vmask2, vacc2x2);
+      _mm512_mask_storeu_ps(c2 + 48, vmask3, vacc2x3);
+      _mm512_mask_storeu_ps(c1 + 0, vmask0, vacc1x0);
+      _mm512_mask_storeu_ps(c1 + 16, vmask1, vacc1x1);
+      _mm512_mask_storeu_ps(c1 + 32, vmask2, vacc1x2);
+      _mm512_mask_storeu_ps(c1 + 48, vmask3, vacc1x3);
+      _mm512_mask_storeu_ps(c0 + 0, vmask0, vacc0x0);
+      _mm512_mask_storeu_ps(c0 + 16, vmask1, vacc0x1);
+      _mm512_mask_storeu_ps(c0 + 32, vmask2, vacc0x2);
+      _mm512_mask_storeu_ps(c0 + 48, vmask3, vacc0x3);
+      nc = 0;
+    }
+  } while (nc != 0);
+#endif  // defined(__x86_64__)
+}
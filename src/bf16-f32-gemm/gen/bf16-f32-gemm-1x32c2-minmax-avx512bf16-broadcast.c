@@ -0,0 +1,110 @@
+// Auto-generated file. Do not edit!
+//   Template: src/bf16-f32-gemm/avx512bf16-broadcast.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/gemm.h"
+#include "xnnpack/intrinsics-polyfill.h"
+#include "xnnpack/math.h"
+#include "xnnpack/unaligned.h"
+
+
+void xnn_bf16_f32_gemm_minmax_ukernel_1x32c2__avx512bf16_broadcast(
+    size_t mr,
+    size_t nc,
+    size_t kc,
+    const xnn_bfloat16* restrict a,
+    size_t a_stride,
+    const void* restrict w,
+    float* restrict c,
+    size_t cm_stride,
+    size_t cn_stride,
+    const union xnn_f32_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mr != 0);
+  assert(mr <= 1);
+  assert(nc != 0);
+  assert(kc != 0);
+  assert(kc % sizeof(xnn_bfloat16) == 0);
+  assert(a != NULL);
+  assert(w != NULL);
+  assert(c != NULL);
+
+  const uint16_t* a0 = (const uint16_t*) a;
+  float* c0 = c;
+
+  const __m512 vmin = _mm512_set1_ps(params->scalar.min);
+  const __m512 vmax = _mm512_set1_ps(params->scalar.max);
+  XNN_FORCE_REALIZATION(vmin);
+  XNN_FORCE_REALIZATION(vmax);
+
+  do {
+    __m512 vacc0x0 = _mm512_loadu_ps((const float*) w);
+    __m512 vacc0x1 = _mm512_loadu_ps((const float*) w + 16);
+    w = (const float*) w + 32;
+
+    // Weights are packed in pairs of input channels, each broadcast pair of A is multiplied with 32 pairs of weights.
+    size_t k = kc;
+    while (k >= 2 * sizeof(xnn_bfloat16)) {
+      const __m512i vb0 = _mm512_loadu_si512((const uint16_t*) w + 0);
+      const __m512i vb1 = _mm512_loadu_si512((const uint16_t*) w + 32);
+      w = (const uint16_t*) w + 64;
+
+      const __m512i va0 = _mm512_set1_epi32((int) unaligned_load_u32(a0));
+      a0 += 2;
+      vacc0x0 = _mm512_dpbf16_ps(vacc0x0, (__m512bh) va0, (__m512bh) vb0);
+      vacc0x1 = _mm512_dpbf16_ps(vacc0x1, (__m512bh) va0, (__m512bh) vb1);
+
+      k -= 2 * sizeof(xnn_bfloat16);
+    }
+    if XNN_UNLIKELY(k != 0) {
+      // The odd input channel is paired with zero, and with the zero padding of the packed weights.
+      const __m512i vb0 = _mm512_loadu_si512((const uint16_t*) w + 0);
+      const __m512i vb1 = _mm512_loadu_si512((const uint16_t*) w + 32);
+      w = (const uint16_t*) w + 64;
+
+      const __m512i va0 = _mm512_set1_epi32((int) (uint32_t) *a0);
+      a0 += 1;
+      vacc0x0 = _mm512_dpbf16_ps(vacc0x0, (__m512bh) va0, (__m512bh) vb0);
+      vacc0x1 = _mm512_dpbf16_ps(vacc0x1, (__m512bh) va0, (__m512bh) vb1);
+    }
+
+    vacc0x0 = _mm512_max_ps(vmin, vacc0x0);
+    vacc0x1 = _mm512_max_ps(vmin, vacc0x1);
+
+    vacc0x0 = _mm512_min_ps(vmax, vacc0x0);
+    vacc0x1 = _mm512_min_ps(vmax, vacc0x1);
+
+    if XNN_LIKELY(nc >= 32) {
+      _mm512_storeu_ps(c0, vacc0x0);
+      _mm512_storeu_ps(c0 + 16, vacc0x1);
+      c0 = (float*) ((uintptr_t) c0 + cn_stride);
+
+      a0 = (const uint16_t*) ((uintptr_t) a0 - kc);
+
+      nc -= 32;
+    } else {
+      // NC remainder (1..31)
+      assert(nc >= 1);
+      assert(nc <= 31);
+      // Prepare mask for valid 32-bit elements (depends on nc).
+      const __mmask16 vmask0 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 0) & 0xFFFF));
+      const __mmask16 vmask1 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 16) & 0xFFFF));
+
+      _mm512_mask_storeu_ps(c0 + 0, vmask0, vacc0x0);
+      _mm512_mask_storeu_ps(c0 + 16, vmask1, vacc0x1);
+      nc = 0;
+    }
+  } while (nc != 0);
+}
@@ -0,0 +1,196 @@
+// Auto-generated file. Do not edit!
+//   Template: src/bf16-f32-gemm/c2-avx512amx.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__has_feature)
+  #if __has_feature(memory_sanitizer)
+    #include <sanitizer/msan_interface.h>
+  #endif
+#endif
+
+#include <immintrin.h>
+
+#include "xnnpack/amx.h"
+#include "xnnpack/common.h"
+#include "xnnpack/gemm.h"
+#include "xnnpack/intrinsics-polyfill.h"
+#include "xnnpack/math.h"
+
+
+void xnn_bf16_f32_gemm_minmax_ukernel_1x64c2__avx512amx(
+    size_t mr,
+    size_t nc,
+    size_t kc,
+    const xnn_bfloat16* restrict a,
+    size_t a_stride,
+    const void* restrict w,
+    float* restrict c,
+    size_t cm_stride,
+    size_t cn_stride,
+    const union xnn_f32_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mr != 0);
+  assert(mr <= 1);
+  assert(nc != 0);
+  assert(kc != 0);
+  assert(kc % sizeof(xnn_bfloat16) == 0);
+  assert(a != NULL);
+  assert(w != NULL);
+  assert(c != NULL);
+
+// TODO: amxintrin.h only provide intrinsics for __x86_64__
+// Update if amxintrin changes
+#if defined(__x86_64__)
+  __attribute__((aligned(64))) float res[4][1 * 16];
+  // Rows of A in the last, partial, block of 32 input channels, padded with zeros to a pair of input channels.
+  __attribute__((aligned(64))) uint16_t a_remainder[1 * 32];
+
+  const size_t kfull = kc & -(32 * sizeof(xnn_bfloat16));
+  const size_t kremainder = kc - kfull;
+  const size_t kremainder_padded = round_up_po2(kremainder, 2 * sizeof(xnn_bfloat16));
+  if (kremainder != 0) {
+    memset(a_remainder, 0, sizeof(a_remainder));
+  }
+
+  // Load tile configuration
+  __attribute__((aligned(64))) struct xnn_amx_tile_config tile_data = {0};
+  tile_data.palette_id = 1;
+  tile_data.rows[0] = mr;                          // tmm0 = res[0]
+  tile_data.rows[1] = mr;                          // tmm1 = res[1]
+  tile_data.rows[2] = mr;                          // tmm2 = res[2]
+  tile_data.rows[3] = mr;                          // tmm3 = res[3]
+  tile_data.rows[4] = mr;                          // tmm4 = input
+  tile_data.rows[5] = 16;                          // tmm5 = weights
+  tile_data.rows[6] = mr;                          // tmm6 = input remainder
+  tile_data.rows[7] = kremainder_padded ? kremainder_padded >> 2 : 16;  // tmm7 = weights remainder
+
+  tile_data.colsb[0] = 64;                         // tmm0 = res[0]
+  tile_data.colsb[1] = 64;                         // tmm1 = res[1]
+  tile_data.colsb[2] = 64;                         // tmm2 = res[2]
+  tile_data.colsb[3] = 64;                         // tmm3 = res[3]
+  tile_data.colsb[4] = 64;                         // tmm4 = input
+  tile_data.colsb[5] = 64;                         // tmm5 = weights
+  tile_data.colsb[6] = kremainder_padded ? kremainder_padded : 64;  // tmm6 = input remainder
+  tile_data.colsb[7] = 64;                         // tmm7 = weights remainder
+
+  // The tiles stay configured on return, for the next call from this thread.
+  xnn_amx_load_tile_config(&tile_data);
+
+  float* c0 = c;
+
+  if (kremainder != 0) {
+    for (size_t m = 0; m < mr; m++) {
+      memcpy(a_remainder + m * 32, (const void*) ((uintptr_t) a + kfull + m * a_stride), kremainder);
+    }
+  }
+
+  const __m512 voutput_min = _mm512_set1_ps(params->scalar.min);
+  const __m512 voutput_max = _mm512_set1_ps(params->scalar.max);
+
+  do {
+    const __m512 vbias0 = _mm512_loadu_ps((const float*) w + 0);
+    const __m512 vbias1 = _mm512_loadu_ps((const float*) w + 16);
+    const __m512 vbias2 = _mm512_loadu_ps((const float*) w + 32);
+    const __m512 vbias3 = _mm512_loadu_ps((const float*) w + 48);
+    w = (const float*) w + 64;
+
+    // Zero tile accumulator
+    __asm__ volatile (
+      "tilezero %%tmm0\n"
+      "tilezero %%tmm1\n"
+      "tilezero %%tmm2\n"
+      "tilezero %%tmm3\n"
+      ::);
+
+    const uint16_t* a0 = (const uint16_t*) a;
+    size_t k = kfull;
+    while (k != 0) {
+      _tile_loadd(4, a0, a_stride);
+      a0 += 32;
+      _tile_loadd(5, (const uint16_t*) w + 0, 256);
+      _tile_dpbf16ps(0, 4, 5);
+      _tile_loadd(5, (const uint16_t*) w + 32, 256);
+      _tile_dpbf16ps(1, 4, 5);
+      _tile_loadd(5, (const uint16_t*) w + 64, 256);
+      _tile_dpbf16ps(2, 4, 5);
+      _tile_loadd(5, (const uint16_t*) w + 96, 256);
+      _tile_dpbf16ps(3, 4, 5);
+
+      w = (const uint16_t*) w + 2048;
+      k -= 32 * sizeof(xnn_bfloat16);
+    }
+
+    if XNN_UNLIKELY(kremainder != 0) {
+      _tile_loadd(6, a_remainder, 64);
+      _tile_loadd(7, (const uint16_t*) w + 0, 256);
+      _tile_dpbf16ps(0, 6, 7);
+      _tile_loadd(7, (const uint16_t*) w + 32, 256);
+      _tile_dpbf16ps(1, 6, 7);
+      _tile_loadd(7, (const uint16_t*) w + 64, 256);
+      _tile_dpbf16ps(2, 6, 7);
+      _tile_loadd(7, (const uint16_t*) w + 96, 256);
+      _tile_dpbf16ps(3, 6, 7);
+
+      w = (const uint16_t*) w + (kremainder_padded >> 2) * 128;
+    }
+
+    _tile_stored(0, &res[0][0], 64);
+    _tile_stored(1, &res[1][0], 64);
+    _tile_stored(2, &res[2][0], 64);
+    _tile_stored(3, &res[3][0], 64);
+
+    // TODO: Fix msan for AMX
+    #if defined(__has_feature)
+      #if __has_feature(memory_sanitizer)
+        __msan_unpoison(res, sizeof(res));
+      #endif
+    #endif
+
+    // Add tile to bias
+    __m512 vacc0x0 = _mm512_add_ps(vbias0, _mm512_load_ps(&res[0][0] + 0));
+    __m512 vacc0x1 = _mm512_add_ps(vbias1, _mm512_load_ps(&res[1][0] + 0));
+    __m512 vacc0x2 = _mm512_add_ps(vbias2, _mm512_load_ps(&res[2][0] + 0));
+    __m512 vacc0x3 = _mm512_add_ps(vbias3, _mm512_load_ps(&res[3][0] + 0));
+
+    vacc0x0 = _mm512_max_ps(vacc0x0, voutput_min);
+    vacc0x1 = _mm512_max_ps(vacc0x1, voutput_min);
+    vacc0x2 = _mm512_max_ps(vacc0x2, voutput_min);
+    vacc0x3 = _mm512_max_ps(vacc0x3, voutput_min);
+
+    vacc0x0 = _mm512_min_ps(vacc0x0, voutput_max);
+    vacc0x1 = _mm512_min_ps(vacc0x1, voutput_max);
+    vacc0x2 = _mm512_min_ps(vacc0x2, voutput_max);
+    vacc0x3 = _mm512_min_ps(vacc0x3, voutput_max);
+
+    if XNN_LIKELY(nc >= 64) {
+      _mm512_storeu_ps(c0 + 0, vacc0x0);
+      _mm512_storeu_ps(c0 + 16, vacc0x1);
+      _mm512_storeu_ps(c0 + 32, vacc0x2);
+      _mm512_storeu_ps(c0 + 48, vacc0x3);
+      c0 = (float*) ((uintptr_t) c0 + cn_stride);
+
+      nc -= 64;
+    } else {
+      // Prepare mask for valid 32-bit elements (depends on nc).
+      const __mmask16 vmask0 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 0) & 0xFFFF));
+      const __mmask16 vmask1 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 16) & 0xFFFF));
+      const __mmask16 vmask2 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 32) & 0xFFFF));
+      const __mmask16 vmask3 = _cvtu32_mask16((uint32_t) ((((UINT64_C(1) << nc) - 1) >> 48) & 0xFFFF));
+      _mm512_mask_storeu_ps(c0 + 0, vmask0, vacc0x0);
+      _mm512_mask_storeu_ps(c0 + 16, vmask1, vacc0x1);
+      _mm512_mask_storeu_ps(c0 + 32, vmask2, vacc0x2);
+      _mm512_mask_storeu_ps(c0 + 48, vmask3, vacc0x3);
+      nc = 0;
+    }
+  } while (nc != 0);
+#endif  // defined(__x86_64__)
+}
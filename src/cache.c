@@ -3,15 +3,32 @@
 // This source code is licensed under the BSD-style license found in the
 // LICENSE file in the root directory of this source tree.
 
+// Include first for the platform detection macros.
+#include "xnnpack/common.h"
+
+#if XNN_HAS_MMAP
+// Needed for the file and mmap functions in strict C mode.
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // XNN_HAS_MMAP
+
 #include <assert.h>  // For assert.
 #include <stddef.h>  // For size_t.
 #include <stdint.h>  // For uint32_t.
+#include <stdio.h>   // For FILE.
 #include <string.h>
 
 #include "xnnpack.h"
 #include "xnnpack/allocator.h"
 #include "xnnpack/cache.h"
-#include "xnnpack/common.h"
+#include "xnnpack/hardware-config.h"
 #include "xnnpack/log.h"
 #include "xnnpack/math.h"
 #include "xnnpack/memory.h"
@@ -24,6 +41,48 @@
 #define XNN_CACHE_MAX_LOAD_ENTRIES_MULTIPLIER 4
 #define XNN_CACHE_MAX_LOAD_BUCKETS_MULTIPLIER 3
 #define XNN_CACHE_GROWTH_FACTOR 2
+#define XNN_CACHE_INITIAL_KEYS 32
+
+// Layout of weights cache files:
+// - struct xnn_weights_cache_file_header,
+// - `num_buckets` struct xnn_weights_cache_file_bucket (the hash table, including empty buckets),
+// - `num_keys` struct xnn_weights_cache_file_key,
+// - zero padding up to `weights_offset`, which is a multiple of XNN_WEIGHTS_CACHE_FILE_ALIGNMENT,
+// - `weights_size` bytes of packed weights,
+// - zeroed space for writing packed weights to check for cache hits, up to `weights_capacity` bytes.
+// Files use the native byte order and are only valid on hardware with the same fingerprint.
+#define XNN_WEIGHTS_CACHE_FILE_MAGIC "XNNWCACH"
+#define XNN_WEIGHTS_CACHE_FILE_VERSION 1
+#define XNN_WEIGHTS_CACHE_FILE_ALIGNMENT 4096
+
+struct xnn_weights_cache_file_header {
+  char magic[8];
+  uint32_t version;
+  // Hash of the architecture and features of the processor the weights were packed for.
+  uint32_t hardware_fingerprint;
+  uint64_t num_buckets;
+  uint64_t num_entries;
+  uint64_t num_keys;
+  uint64_t max_weights_size;
+  uint64_t weights_offset;
+  uint64_t weights_size;
+  uint64_t weights_capacity;
+};
+
+struct xnn_weights_cache_file_bucket {
+  uint32_t hash;
+  uint32_t reserved;
+  uint64_t size;
+  uint64_t offset;
+};
+
+struct xnn_weights_cache_file_key {
+  uint32_t seed;
+  uint32_t reserved;
+  uint64_t kernel_offset;
+  uint64_t bias_offset;
+  uint64_t offset;
+};
 
 // MurmurHash3 implementation, copied from smhasher, with minor modifications in
 // style and main loop.
@@ -320,10 +379,21 @@ enum xnn_status xnn_internal_release_weights_cache(struct xnn_internal_weights_c
 {
   if XNN_LIKELY(cache != NULL) {
     assert(cache->cache.type == xnn_cache_type_weights);
-    xnn_release_weights_memory(&cache->cache.weights);
+    if (cache->mapping != NULL) {
+      #if XNN_HAS_MMAP
+        if (munmap(cache->mapping, cache->mapping_size) == -1) {
+          xnn_log_error("failed to unmap weights cache file, error code: %d", errno);
+        }
+      #endif
+      cache->mapping = NULL;
+    } else {
+      xnn_release_weights_memory(&cache->cache.weights);
+    }
     if (cache->cache.buckets != NULL) {
       xnn_release_memory(cache->cache.buckets);
     }
+    xnn_release_memory(cache->keys);
+    cache->keys = NULL;
     const enum xnn_status status = xnn_mutex_destroy(&cache->mutex);
     if (status != xnn_status_success) {
       return status;
@@ -372,6 +442,76 @@ void* xnn_internal_reserve_space_in_weights_cache(struct xnn_internal_weights_ca
   return (void*) ((uintptr_t) buffer->start + buffer->size);
 }
 
+// Converts `cache_key` to offsets into the source buffer, returns false if the
+// key can not be recorded in the cache.
+static bool make_key_entry(
+  const struct xnn_internal_weights_cache* cache,
+  const struct xnn_weights_cache_look_up_key* cache_key,
+  struct xnn_weights_cache_key_entry* entry)
+{
+  if (cache_key == NULL || cache->source_data == NULL || cache_key->kernel == NULL) {
+    return false;
+  }
+  const uintptr_t source_start = (uintptr_t) cache->source_data;
+  const uintptr_t source_end = source_start + cache->source_size;
+  const uintptr_t kernel = (uintptr_t) cache_key->kernel;
+  const uintptr_t bias = (uintptr_t) cache_key->bias;
+  if (kernel < source_start || kernel >= source_end) {
+    return false;
+  }
+  if (cache_key->bias != NULL && (bias < source_start || bias >= source_end)) {
+    return false;
+  }
+  entry->seed = cache_key->seed;
+  entry->kernel_offset = kernel - source_start;
+  entry->bias_offset = cache_key->bias != NULL ? bias - source_start : SIZE_MAX;
+  entry->offset = XNN_CACHE_NOT_FOUND;
+  return true;
+}
+
+// Returns the offset of packed weights recorded for `entry`, XNN_CACHE_NOT_FOUND otherwise. The number of keys is
+// bounded by the number of operators with static weights, so a linear scan is cheap compared to packing.
+static size_t find_key_entry(
+  const struct xnn_internal_weights_cache* cache,
+  const struct xnn_weights_cache_key_entry* entry)
+{
+  for (size_t i = 0; i < cache->num_keys; i++) {
+    const struct xnn_weights_cache_key_entry* key = &cache->keys[i];
+    if (key->seed == entry->seed && key->kernel_offset == entry->kernel_offset &&
+        key->bias_offset == entry->bias_offset) {
+      return key->offset;
+    }
+  }
+  return XNN_CACHE_NOT_FOUND;
+}
+
+// Records that `cache_key` maps to packed weights at `offset`. Mutex must already be locked.
+static void record_key(
+  struct xnn_internal_weights_cache* cache,
+  const struct xnn_weights_cache_look_up_key* cache_key,
+  size_t offset)
+{
+  struct xnn_weights_cache_key_entry entry;
+  if (!make_key_entry(cache, cache_key, &entry) || find_key_entry(cache, &entry) != XNN_CACHE_NOT_FOUND) {
+    return;
+  }
+
+  if (cache->num_keys == cache->keys_capacity) {
+    const size_t new_capacity = max(XNN_CACHE_INITIAL_KEYS, cache->keys_capacity * XNN_CACHE_GROWTH_FACTOR);
+    struct xnn_weights_cache_key_entry* keys = (struct xnn_weights_cache_key_entry*) xnn_reallocate_memory(
+      cache->keys, new_capacity * sizeof(struct xnn_weights_cache_key_entry));
+    if (keys == NULL) {
+      xnn_log_warning("failed to grow weights cache look up keys, packed weights will not be found by key");
+      return;
+    }
+    cache->keys = keys;
+    cache->keys_capacity = new_capacity;
+  }
+
+  entry.offset = offset;
+  cache->keys[cache->num_keys++] = entry;
+}
+
 size_t xnn_internal_get_or_insert_weights_cache(
   struct xnn_internal_weights_cache* cache, const struct xnn_weights_cache_look_up_key* cache_key, void* ptr, size_t size)
 {
@@ -412,6 +552,10 @@ size_t xnn_internal_get_or_insert_weights_cache(
     }
   }
 
+  if (offset != XNN_CACHE_NOT_FOUND) {
+    record_key(cache, cache_key, offset);
+  }
+
   // Mutex is locked in xnn_reserve_space_in_weights_cache when it returns non-NULL, i.e. when cache is not finalized,
   // or if it is xnn_cache_state_soft_finalized and has sufficient space.
   const enum xnn_status status = xnn_mutex_unlock(&cache->mutex);
@@ -428,8 +572,19 @@ bool xnn_internal_weights_cache_is_finalized(struct xnn_internal_weights_cache*
 size_t xnn_internal_weights_cache_look_up(
   struct xnn_internal_weights_cache* cache, const struct xnn_weights_cache_look_up_key* cache_key)
 {
-  // The default implementation does not support this query.
-  return XNN_CACHE_NOT_FOUND;
+  // Only keys into the source buffer are recorded, other weights are found by their packed bytes in
+  // xnn_internal_get_or_insert_weights_cache.
+  struct xnn_weights_cache_key_entry entry;
+  if (!make_key_entry(cache, cache_key, &entry)) {
+    return XNN_CACHE_NOT_FOUND;
+  }
+
+  if (xnn_mutex_lock(&cache->mutex) != xnn_status_success) {
+    return XNN_CACHE_NOT_FOUND;
+  }
+  const size_t offset = find_key_entry(cache, &entry);
+  xnn_mutex_unlock(&cache->mutex);
+  return offset;
 }
 
 void* xnn_internal_weights_cache_offset_to_addr(struct xnn_internal_weights_cache* weights_cache, size_t offset)
@@ -437,6 +592,265 @@ void* xnn_internal_weights_cache_offset_to_addr(struct xnn_internal_weights_cach
   return (void*) ((uintptr_t)weights_cache->cache.weights.start + offset);
 }
 
+enum xnn_status xnn_internal_set_weights_cache_source(
+  struct xnn_internal_weights_cache* cache, const void* data, size_t size)
+{
+  if (data == NULL && size != 0) {
+    xnn_log_error("failed to set weights cache source: NULL data with %zu bytes", size);
+    return xnn_status_invalid_parameter;
+  }
+
+  enum xnn_status status = xnn_mutex_lock(&cache->mutex);
+  if (status != xnn_status_success) {
+    return status;
+  }
+  cache->source_data = data;
+  cache->source_size = size;
+  return xnn_mutex_unlock(&cache->mutex);
+}
+
+static uint32_t hardware_fingerprint(void)
+{
+  const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+  uint64_t words[4] = {
+    XNN_WEIGHTS_CACHE_FILE_VERSION,
+    sizeof(void*),
+    (uint64_t) XNN_ARCH_X86 | (uint64_t) XNN_ARCH_X86_64 << 1 | (uint64_t) XNN_ARCH_ARM << 2 |
+      (uint64_t) XNN_ARCH_ARM64 << 3 | (uint64_t) XNN_ARCH_PPC64 << 4 | (uint64_t) XNN_ARCH_RISCV << 5 |
+      (uint64_t) XNN_ARCH_HEXAGON << 6 | (uint64_t) XNN_ARCH_WASM << 7 | (uint64_t) XNN_ARCH_WASMSIMD << 8 |
+      (uint64_t) XNN_ARCH_WASMRELAXEDSIMD << 9,
+    0,
+  };
+  if (hardware_config != NULL) {
+    words[3] = hardware_config->arch_flags;
+    #if XNN_ARCH_RISCV
+      // The packing of some microkernels depends on the vector length.
+      words[3] ^= (uint64_t) hardware_config->vlenb << 32;
+    #endif
+  }
+  return murmur_hash3(words, sizeof(words), /*seed=*/XNN_CACHE_HASH_SEED);
+}
+
+static bool write_bytes(FILE* file, const void* data, size_t size)
+{
+  return size == 0 || fwrite(data, 1, size, file) == size;
+}
+
+static bool write_zeros(FILE* file, size_t size)
+{
+  static const char zeros[XNN_WEIGHTS_CACHE_FILE_ALIGNMENT];
+  while (size != 0) {
+    const size_t chunk = min(size, sizeof(zeros));
+    if (!write_bytes(file, zeros, chunk)) {
+      return false;
+    }
+    size -= chunk;
+  }
+  return true;
+}
+
+enum xnn_status xnn_internal_save_weights_cache(struct xnn_internal_weights_cache* cache, const char* path)
+{
+  if (cache->finalization_state == xnn_cache_state_hard_finalized) {
+    xnn_log_error("failed to save weights cache to %s: hard finalized weights cache has no hash table", path);
+    return xnn_status_invalid_state;
+  }
+
+  enum xnn_status status = xnn_mutex_lock(&cache->mutex);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
+  FILE* file = fopen(path, "wb");
+  if (file == NULL) {
+    xnn_log_error("failed to open %s for writing weights cache", path);
+    status = xnn_status_invalid_parameter;
+    goto unlock;
+  }
+
+  const size_t keys_offset =
+    sizeof(struct xnn_weights_cache_file_header) + cache->cache.num_buckets * sizeof(struct xnn_weights_cache_file_bucket);
+  const size_t weights_offset = round_up_po2(
+    keys_offset + cache->num_keys * sizeof(struct xnn_weights_cache_file_key), XNN_WEIGHTS_CACHE_FILE_ALIGNMENT);
+  const size_t weights_size = cache->cache.weights.size;
+  // Keep room to write the largest packed weights after the cached weights, so that a loaded cache can check for
+  // cache hits like a soft finalized cache.
+  const size_t scratch_size = round_up_po2(cache->max_weights_size, XNN_WEIGHTS_CACHE_FILE_ALIGNMENT);
+
+  struct xnn_weights_cache_file_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, XNN_WEIGHTS_CACHE_FILE_MAGIC, sizeof(header.magic));
+  header.version = XNN_WEIGHTS_CACHE_FILE_VERSION;
+  header.hardware_fingerprint = hardware_fingerprint();
+  header.num_buckets = cache->cache.num_buckets;
+  header.num_entries = cache->cache.num_entries;
+  header.num_keys = cache->num_keys;
+  header.max_weights_size = cache->max_weights_size;
+  header.weights_offset = weights_offset;
+  header.weights_size = weights_size;
+  header.weights_capacity = weights_size + scratch_size;
+
+  bool written = write_bytes(file, &header, sizeof(header));
+  for (size_t i = 0; written && i < cache->cache.num_buckets; i++) {
+    const struct xnn_cache_bucket* bucket = &cache->cache.buckets[i];
+    struct xnn_weights_cache_file_bucket file_bucket;
+    memset(&file_bucket, 0, sizeof(file_bucket));
+    file_bucket.hash = bucket->hash;
+    file_bucket.size = bucket->size;
+    file_bucket.offset = bucket->offset;
+    written = write_bytes(file, &file_bucket, sizeof(file_bucket));
+  }
+  for (size_t i = 0; written && i < cache->num_keys; i++) {
+    const struct xnn_weights_cache_key_entry* key = &cache->keys[i];
+    struct xnn_weights_cache_file_key file_key;
+    memset(&file_key, 0, sizeof(file_key));
+    file_key.seed = key->seed;
+    file_key.kernel_offset = key->kernel_offset;
+    file_key.bias_offset = key->bias_offset == SIZE_MAX ? UINT64_MAX : (uint64_t) key->bias_offset;
+    file_key.offset = key->offset;
+    written = write_bytes(file, &file_key, sizeof(file_key));
+  }
+  written = written && write_zeros(file, weights_offset - keys_offset - cache->num_keys * sizeof(struct xnn_weights_cache_file_key));
+  written = written && write_bytes(file, cache->cache.weights.start, weights_size);
+  written = written && write_zeros(file, scratch_size);
+
+  if (fclose(file) != 0 || !written) {
+    xnn_log_error("failed to write weights cache to %s", path);
+    status = xnn_status_invalid_state;
+    goto unlock;
+  }
+  status = xnn_status_success;
+
+unlock:
+  xnn_mutex_unlock(&cache->mutex);
+  return status;
+}
+
+enum xnn_status xnn_internal_init_weights_cache_from_file(struct xnn_internal_weights_cache* cache, const char* path)
+{
+  memset(cache, 0, sizeof(struct xnn_internal_weights_cache));
+  cache->cache.type = xnn_cache_type_weights;
+
+#if XNN_HAS_MMAP
+  enum xnn_status status = xnn_mutex_init(&cache->mutex);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
+  const int fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    xnn_log_error("failed to open weights cache file %s, error code: %d", path, errno);
+    status = xnn_status_invalid_parameter;
+    goto error;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1 || (size_t) file_stat.st_size < sizeof(struct xnn_weights_cache_file_header)) {
+    xnn_log_error("failed to load weights cache file %s: file is too small", path);
+    close(fd);
+    status = xnn_status_invalid_parameter;
+    goto error;
+  }
+  const size_t file_size = (size_t) file_stat.st_size;
+
+  // The mapping is private and writable so that the cache can write packed weights past the cached weights to check
+  // for cache hits. Pages that are never written stay shared with the page cache and with other processes.
+  void* mapping = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    xnn_log_error("failed to map weights cache file %s, error code: %d", path, errno);
+    status = xnn_status_out_of_memory;
+    goto error;
+  }
+  cache->mapping = mapping;
+  cache->mapping_size = file_size;
+
+  struct xnn_weights_cache_file_header header;
+  memcpy(&header, mapping, sizeof(header));
+  if (memcmp(header.magic, XNN_WEIGHTS_CACHE_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != XNN_WEIGHTS_CACHE_FILE_VERSION) {
+    xnn_log_error("failed to load weights cache file %s: unsupported file format", path);
+    status = xnn_status_invalid_parameter;
+    goto error;
+  }
+  if (header.hardware_fingerprint != hardware_fingerprint()) {
+    xnn_log_error("failed to load weights cache file %s: weights were packed for a different processor", path);
+    status = xnn_status_unsupported_hardware;
+    goto error;
+  }
+
+  const uint64_t keys_offset = sizeof(struct xnn_weights_cache_file_header) +
+    header.num_buckets * sizeof(struct xnn_weights_cache_file_bucket);
+  const uint64_t keys_end = keys_offset + header.num_keys * sizeof(struct xnn_weights_cache_file_key);
+  if (header.num_buckets == 0 || !is_po2(header.num_buckets) || header.num_entries > header.num_buckets ||
+      header.num_buckets > file_size || header.num_keys > file_size || keys_end > header.weights_offset ||
+      header.weights_offset % XNN_WEIGHTS_CACHE_FILE_ALIGNMENT != 0 || header.weights_size > header.weights_capacity ||
+      header.weights_capacity - header.weights_size < header.max_weights_size ||
+      header.weights_offset + header.weights_capacity != file_size) {
+    xnn_log_error("failed to load weights cache file %s: corrupted header", path);
+    status = xnn_status_invalid_parameter;
+    goto error;
+  }
+
+  status = xnn_init_cache_with_size(&cache->cache, header.num_buckets, xnn_cache_type_weights);
+  if (status != xnn_status_success) {
+    goto error;
+  }
+  const struct xnn_weights_cache_file_bucket* file_buckets =
+    (const struct xnn_weights_cache_file_bucket*) ((uintptr_t) mapping + sizeof(struct xnn_weights_cache_file_header));
+  for (size_t i = 0; i < header.num_buckets; i++) {
+    if (file_buckets[i].size > header.weights_size ||
+        file_buckets[i].offset > header.weights_size - file_buckets[i].size) {
+      xnn_log_error("failed to load weights cache file %s: packed weights out of bounds", path);
+      status = xnn_status_invalid_parameter;
+      goto error;
+    }
+    cache->cache.buckets[i].hash = file_buckets[i].hash;
+    cache->cache.buckets[i].size = file_buckets[i].size;
+    cache->cache.buckets[i].offset = file_buckets[i].offset;
+  }
+  cache->cache.num_entries = header.num_entries;
+
+  if (header.num_keys != 0) {
+    cache->keys = (struct xnn_weights_cache_key_entry*) xnn_allocate_memory(
+      header.num_keys * sizeof(struct xnn_weights_cache_key_entry));
+    if (cache->keys == NULL) {
+      xnn_log_error("failed to allocate memory for weights cache look up keys");
+      status = xnn_status_out_of_memory;
+      goto error;
+    }
+    cache->keys_capacity = header.num_keys;
+  }
+  const struct xnn_weights_cache_file_key* file_keys =
+    (const struct xnn_weights_cache_file_key*) ((uintptr_t) mapping + keys_offset);
+  for (size_t i = 0; i < header.num_keys; i++) {
+    if (file_keys[i].offset >= header.weights_size) {
+      xnn_log_error("failed to load weights cache file %s: look up key out of bounds", path);
+      status = xnn_status_invalid_parameter;
+      goto error;
+    }
+    struct xnn_weights_cache_key_entry* key = &cache->keys[cache->num_keys++];
+    key->seed = file_keys[i].seed;
+    key->kernel_offset = file_keys[i].kernel_offset;
+    key->bias_offset = file_keys[i].bias_offset == UINT64_MAX ? SIZE_MAX : (size_t) file_keys[i].bias_offset;
+    key->offset = file_keys[i].offset;
+  }
+
+  cache->cache.weights.start = (void*) ((uintptr_t) mapping + header.weights_offset);
+  cache->cache.weights.size = header.weights_size;
+  cache->cache.weights.capacity = header.weights_capacity;
+  cache->max_weights_size = header.max_weights_size;
+  cache->finalization_state = xnn_cache_state_soft_finalized;
+  return xnn_status_success;
+
+error:
+  xnn_internal_release_weights_cache(cache);
+  return status;
+#else
+  xnn_log_error("failed to load weights cache file %s: memory mapping is not supported on this platform", path);
+  return xnn_status_unsupported_platform;
+#endif  // XNN_HAS_MMAP
+}
+
 enum xnn_status xnn_internal_delete_weights_cache(struct xnn_internal_weights_cache* weights_cache)
 {
   enum xnn_status status = xnn_internal_release_weights_cache(weights_cache);
@@ -469,3 +883,114 @@ size_t xnn_weights_cache_look_up(
 {
   return cache->look_up(cache->context, cache_key);
 }
+
+enum xnn_status xnn_set_weights_cache_source(xnn_weights_cache_t weights_cache, const void* data, size_t size)
+{
+  return xnn_internal_set_weights_cache_source(weights_cache->context, data, size);
+}
+
+enum xnn_status xnn_save_weights_cache(xnn_weights_cache_t weights_cache, const char* path)
+{
+  return xnn_internal_save_weights_cache(weights_cache->context, path);
+}
+
+enum xnn_status xnn_init_code_cache(struct xnn_code_cache* cache)
+{
+  memset(cache, 0, sizeof(struct xnn_code_cache));
+  return xnn_mutex_init(&cache->mutex);
+}
+
+enum xnn_status xnn_release_code_cache(struct xnn_code_cache* cache)
+{
+  if XNN_LIKELY(cache != NULL) {
+    for (size_t i = 0; i < cache->num_entries; i++) {
+      xnn_release_code_memory(&cache->entries[i].code);
+      xnn_release_memory(cache->entries[i].key);
+    }
+    xnn_release_memory(cache->entries);
+    const enum xnn_status status = xnn_mutex_destroy(&cache->mutex);
+    memset(cache, 0, sizeof(struct xnn_code_cache));
+    return status;
+  }
+  return xnn_status_success;
+}
+
+// Returns the code of the entry for `key`, NULL if there is none. Mutex must be locked.
+static const void* find_code(struct xnn_code_cache* cache, const void* key, size_t key_size, uint32_t hash)
+{
+  for (size_t i = 0; i < cache->num_entries; i++) {
+    const struct xnn_code_cache_entry* entry = &cache->entries[i];
+    if (entry->hash == hash && entry->key_size == key_size && memcmp(entry->key, key, key_size) == 0) {
+      return entry->code.start;
+    }
+  }
+  return NULL;
+}
+
+const void* xnn_code_cache_look_up(struct xnn_code_cache* cache, const void* key, size_t key_size)
+{
+  const uint32_t hash = murmur_hash3(key, key_size, /*seed=*/7);
+  xnn_mutex_lock(&cache->mutex);
+  const void* code = find_code(cache, key, key_size, hash);
+  if (code != NULL) {
+    cache->hits++;
+  }
+  xnn_mutex_unlock(&cache->mutex);
+  return code;
+}
+
+const void* xnn_code_cache_insert(
+  struct xnn_code_cache* cache, const void* key, size_t key_size, const void* code, size_t size)
+{
+  const uint32_t hash = murmur_hash3(key, key_size, /*seed=*/7);
+  xnn_mutex_lock(&cache->mutex);
+  const void* existing_code = find_code(cache, key, key_size, hash);
+  if (existing_code != NULL) {
+    cache->hits++;
+    xnn_mutex_unlock(&cache->mutex);
+    return existing_code;
+  }
+
+  if (cache->num_entries == cache->entries_capacity) {
+    const size_t capacity = cache->entries_capacity == 0 ? 8 : cache->entries_capacity * 2;
+    struct xnn_code_cache_entry* entries =
+      xnn_reallocate_memory(cache->entries, capacity * sizeof(struct xnn_code_cache_entry));
+    if (entries == NULL) {
+      xnn_log_error("failed to allocate %zu entries for code cache", capacity);
+      goto error;
+    }
+    cache->entries = entries;
+    cache->entries_capacity = capacity;
+  }
+
+  struct xnn_code_cache_entry* entry = &cache->entries[cache->num_entries];
+  entry->hash = hash;
+  entry->key_size = key_size;
+  entry->key = xnn_allocate_memory(key_size);
+  if (entry->key == NULL) {
+    xnn_log_error("failed to allocate %zu bytes for code cache key", key_size);
+    goto error;
+  }
+  memcpy(entry->key, key, key_size);
+
+  if (xnn_allocate_code_memory(&entry->code, size) != xnn_status_success) {
+    xnn_release_memory(entry->key);
+    goto error;
+  }
+  memcpy(entry->code.start, code, size);
+  entry->code.size = size;
+  if (xnn_finalize_code_memory(&entry->code) != xnn_status_success) {
+    xnn_release_code_memory(&entry->code);
+    xnn_release_memory(entry->key);
+    goto error;
+  }
+
+  cache->num_entries++;
+  cache->misses++;
+  xnn_mutex_unlock(&cache->mutex);
+  return entry->code.start;
+
+error:
+  xnn_mutex_unlock(&cache->mutex);
+  return NULL;
+}
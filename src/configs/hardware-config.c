@@ -145,13 +145,19 @@ static void init_hardware_config(void) {
 #else
     hardware_config.use_x86_avx512vnnigfni = 0;
 #endif
+#if XNN_ENABLE_AVX512BF16
+    hardware_config.use_x86_avx512bf16 = hardware_config.use_x86_avx512skx && cpuinfo_has_x86_avx512bf16();
+#else
+    hardware_config.use_x86_avx512bf16 = 0;
+#endif
 #if XNN_ENABLE_AVX512FP16
     hardware_config.use_x86_avx512fp16 = cpuinfo_has_x86_avx512fp16();
 #else
     hardware_config.use_x86_avx512fp16 = 0;
 #endif
 #if XNN_ENABLE_AVX512AMX
-    hardware_config.use_x86_avx512amx = hardware_config.use_x86_avx512vnnigfni && cpuinfo_has_x86_amx_int8();
+    hardware_config.use_x86_avx512amx = hardware_config.use_x86_avx512vnnigfni && cpuinfo_has_x86_amx_int8() &&
+      cpuinfo_has_x86_amx_bf16();
 #if XNN_ARCH_X86_64 && defined(__linux__) && !defined(CHROMIUM)
     if (hardware_config.use_x86_avx512amx) {
       size_t status = xnn_syscall(SYS_arch_prctl, ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA, 0);
@@ -351,6 +357,7 @@ static void init_hardware_config(void) {
     if (hardware_config.use_x86_avx512vnnigfni) hardware_config.arch_flags |= xnn_arch_x86_avx512vnnigfni;
     if (hardware_config.use_x86_avx512amx) hardware_config.arch_flags |= xnn_arch_x86_avx512amx;
     if (hardware_config.use_x86_avx512fp16) hardware_config.arch_flags |= xnn_arch_x86_avx512fp16;
+    if (hardware_config.use_x86_avx512bf16) hardware_config.arch_flags |= xnn_arch_x86_avx512bf16;
   #endif
   #if XNN_ARCH_RISCV
     if (hardware_config.use_riscv_vector) hardware_config.arch_flags |= xnn_arch_riscv_vector;
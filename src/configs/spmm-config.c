@@ -42,6 +42,15 @@ static void init_f16_spmm_config(void) {
       f16_spmm_config.mr = 32;
       f16_spmm_config.nr = 1;
     }
+  #elif (XNN_ARCH_X86 || XNN_ARCH_X86_64) && XNN_ENABLE_AVX512FP16
+    const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+    assert(hardware_config != NULL);
+    if (hardware_config->use_x86_avx512fp16) {
+      f16_spmm_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16;
+      f16_spmm_config.init.f16 = xnn_init_f16_minmax_scalar_params;
+      f16_spmm_config.mr = 64;
+      f16_spmm_config.nr = 1;
+    }
   #endif
 }
 
@@ -66,10 +75,27 @@ static void init_f32_spmm_config(void) {
     f32_spmm_config.mr = 32;
     f32_spmm_config.nr = 1;
   #elif XNN_ARCH_X86 || XNN_ARCH_X86_64
-    f32_spmm_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x1__sse;
-    f32_spmm_config.init.f32 = xnn_init_f32_minmax_scalar_params;
-    f32_spmm_config.mr = 32;
-    f32_spmm_config.nr = 1;
+    const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+    assert(hardware_config != NULL);
+    #if XNN_ENABLE_AVX512F
+      if (hardware_config->use_x86_avx512f) {
+        f32_spmm_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x1__avx512f;
+        f32_spmm_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+        f32_spmm_config.mr = 32;
+        f32_spmm_config.nr = 1;
+      } else
+    #endif
+    if (hardware_config->use_x86_fma3) {
+      f32_spmm_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x1__fma3;
+      f32_spmm_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+      f32_spmm_config.mr = 32;
+      f32_spmm_config.nr = 1;
+    } else {
+      f32_spmm_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x1__sse;
+      f32_spmm_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+      f32_spmm_config.mr = 32;
+      f32_spmm_config.nr = 1;
+    }
   #elif XNN_ARCH_WASMRELAXEDSIMD
     const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
     assert(hardware_config != NULL);
@@ -121,6 +147,23 @@ static void init_f32_spmm2_config(void) {
     f32_spmm2_config.init.f32 = xnn_init_f32_minmax_scalar_params;
     f32_spmm2_config.mr = 32;
     f32_spmm2_config.nr = 2;
+  #elif XNN_ARCH_X86 || XNN_ARCH_X86_64
+    const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+    assert(hardware_config != NULL);
+    #if XNN_ENABLE_AVX512F
+      if (hardware_config->use_x86_avx512f) {
+        f32_spmm2_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x2__avx512f;
+        f32_spmm2_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+        f32_spmm2_config.mr = 32;
+        f32_spmm2_config.nr = 2;
+      } else
+    #endif
+    if (hardware_config->use_x86_fma3) {
+      f32_spmm2_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x2__fma3;
+      f32_spmm2_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+      f32_spmm2_config.mr = 32;
+      f32_spmm2_config.nr = 2;
+    }
   #elif XNN_ARCH_WASM
     f32_spmm2_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_8x2__scalar;
     f32_spmm2_config.init.f32 = xnn_init_f32_minmax_scalar_params;
@@ -142,6 +185,23 @@ static void init_f32_spmm4_config(void) {
     f32_spmm4_config.init.f32 = xnn_init_f32_minmax_scalar_params;
     f32_spmm4_config.mr = 32;
     f32_spmm4_config.nr = 4;
+  #elif XNN_ARCH_X86 || XNN_ARCH_X86_64
+    const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+    assert(hardware_config != NULL);
+    #if XNN_ENABLE_AVX512F
+      if (hardware_config->use_x86_avx512f) {
+        f32_spmm4_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_32x4__avx512f;
+        f32_spmm4_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+        f32_spmm4_config.mr = 32;
+        f32_spmm4_config.nr = 4;
+      } else
+    #endif
+    if (hardware_config->use_x86_fma3) {
+      f32_spmm4_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_16x4__fma3;
+      f32_spmm4_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+      f32_spmm4_config.mr = 16;
+      f32_spmm4_config.nr = 4;
+    }
   #elif XNN_ARCH_WASM
     f32_spmm4_config.ukernel = (xnn_spmm_ukernel_fn) xnn_f32_spmm_minmax_ukernel_8x4__scalar;
     f32_spmm4_config.init.f32 = xnn_init_f32_minmax_scalar_params;
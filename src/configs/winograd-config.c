@@ -0,0 +1,38 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/config.h"
+#include "xnnpack/init-once.h"
+#include "xnnpack/microfnptr.h"
+#include "xnnpack/microparams-init.h"
+#include "xnnpack/winograd.h"
+
+static struct xnn_winograd_config f32_winograd_config = {0};
+
+XNN_INIT_ONCE_GUARD(f32_winograd);
+
+static void init_f32_winograd_config(void) {
+  #if XNN_ARCH_X86 || XNN_ARCH_X86_64
+    f32_winograd_config.input_transform =
+      (xnn_winograd_input_transform_ukernel_fn) xnn_f32_winograd_f4x4k3x3_input_ukernel__sse_c4;
+    f32_winograd_config.output_transform =
+      (xnn_winograd_output_transform_ukernel_fn) xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__sse_c4;
+    f32_winograd_config.init.f32 = xnn_init_f32_minmax_scalar_params;
+    f32_winograd_config.channel_tile = 4;
+  #endif
+}
+
+const struct xnn_winograd_config* xnn_init_f32_winograd_config() {
+  const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+  if (hardware_config == NULL) {
+    return NULL;
+  }
+  XNN_INIT_ONCE(f32_winograd);
+  return f32_winograd_config.input_transform != NULL ? &f32_winograd_config : NULL;
+}
@@ -0,0 +1,138 @@
+// Auto-generated file. Do not edit!
+//   Template: src/f16-spmm/avx512fp16.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/intrinsics-polyfill.h"
+#include "xnnpack/spmm.h"
+
+
+void xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16(
+    size_t mc,
+    size_t nc,
+    const xnn_float16* input,
+    const xnn_float16* weights,
+    const int32_t* widx_dmap,
+    const uint32_t* nidx_nnzmap,
+    xnn_float16* output,
+    size_t output_stride,
+    const union xnn_f16_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mc != 0);
+  assert(mc % sizeof(uint16_t) == 0);
+  assert(nc != 0);
+
+#if defined(__AVX512FP16__)
+  const uint16_t* i = (const uint16_t*) input;
+  uint16_t* o = (uint16_t*) output;
+
+  const __m512h vmin = _mm512_castsi512_ph(_mm512_set1_epi16(*(const uint16_t*) &params->scalar.min));
+  const __m512h vmax = _mm512_castsi512_ph(_mm512_set1_epi16(*(const uint16_t*) &params->scalar.max));
+  XNN_FORCE_REALIZATION(vmin);
+  XNN_FORCE_REALIZATION(vmax);
+
+  const size_t output_decrement = output_stride * nc;
+  while XNN_LIKELY(mc >= 64 * sizeof(uint16_t)) {
+    const uint16_t* w = (const uint16_t*) weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    do {
+      uint32_t nnz = *nnzmap++;
+      __m512h vacc0n0 = _mm512_castsi512_ph(_mm512_set1_epi16(w[0]));
+      __m512h vacc1n0 = vacc0n0;
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512h vi0 = _mm512_loadu_ph(i);
+          const __m512h vi1 = _mm512_loadu_ph(i + 32);
+          i = (const uint16_t*) ((uintptr_t) i + (uintptr_t) diff);
+          const __m512h vw0 = _mm512_castsi512_ph(_mm512_set1_epi16(w[0]));
+          w += 1;
+          vacc0n0 = _mm512_fmadd_ph(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm512_fmadd_ph(vi1, vw0, vacc1n0);
+        } while (--nnz != 0);
+      }
+      __m512h vout0n0 = _mm512_min_ph(vacc0n0, vmax);
+      __m512h vout1n0 = _mm512_min_ph(vacc1n0, vmax);
+      vout0n0 = _mm512_max_ph(vout0n0, vmin);
+      vout1n0 = _mm512_max_ph(vout1n0, vmin);
+      _mm512_storeu_ph(o, vout0n0);
+      _mm512_storeu_ph(o + 32, vout1n0);
+      o = (uint16_t*) ((uintptr_t) o + output_stride);
+    } while (--n != 0);
+    o = (uint16_t*) ((uintptr_t) o - output_decrement);
+    o += 64;
+    i += 64;
+    mc -= 64 * sizeof(uint16_t);
+  }
+  if (mc & (32 * sizeof(uint16_t))) {
+    const uint16_t* w = (const uint16_t*) weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    do {
+      uint32_t nnz = *nnzmap++;
+      __m512h vacc0n0 = _mm512_castsi512_ph(_mm512_set1_epi16(w[0]));
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512h vi0 = _mm512_loadu_ph(i);
+          i = (const uint16_t*) ((uintptr_t) i + (uintptr_t) diff);
+          const __m512h vw0 = _mm512_castsi512_ph(_mm512_set1_epi16(w[0]));
+          w += 1;
+          vacc0n0 = _mm512_fmadd_ph(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m512h vout0n0 = _mm512_min_ph(vacc0n0, vmax);
+      vout0n0 = _mm512_max_ph(vout0n0, vmin);
+      _mm512_storeu_ph(o, vout0n0);
+      o = (uint16_t*) ((uintptr_t) o + output_stride);
+    } while (--n != 0);
+    o = (uint16_t*) ((uintptr_t) o - output_decrement);
+    o += 32;
+    i += 32;
+  }
+  mc &= 31 * sizeof(uint16_t);
+  if XNN_UNLIKELY(mc != 0) {
+    // Prepare mask for valid 16-bit elements (depends on mc).
+    const __mmask32 vmask = _cvtu32_mask32((uint32_t) ((UINT32_C(1) << (mc >> XNN_LOG2_SIZEOF_HALF)) - UINT32_C(1)));
+    const uint16_t* w = (const uint16_t*) weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    do {
+      uint32_t nnz = *nnzmap++;
+      __m512h vacc0n0 = _mm512_castsi512_ph(_mm512_set1_epi16(w[0]));
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512h vi0 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(vmask, i));
+          i = (const uint16_t*) ((uintptr_t) i + (uintptr_t) diff);
+          const __m512h vw0 = _mm512_castsi512_ph(_mm512_set1_epi16(w[0]));
+          w += 1;
+          vacc0n0 = _mm512_fmadd_ph(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m512h vout0n0 = _mm512_min_ph(vacc0n0, vmax);
+      vout0n0 = _mm512_max_ph(vout0n0, vmin);
+      _mm512_mask_storeu_epi16(o, vmask, _mm512_castph_si512(vout0n0));
+      o = (uint16_t*) ((uintptr_t) o + output_stride);
+    } while (--n != 0);
+  }
+#endif  // defined(__AVX512FP16__)
+}
@@ -0,0 +1,283 @@
+// Auto-generated file. Do not edit!
+//   Template: src/f32-spmm/fma3.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/spmm.h"
+
+
+void xnn_f32_spmm_minmax_ukernel_16x4__fma3(
+    size_t mc,
+    size_t nc,
+    const float* input,
+    const float* weights,
+    const int32_t* widx_dmap,
+    const uint32_t* nidx_nnzmap,
+    float* output,
+    size_t output_stride,
+    const union xnn_f32_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mc != 0);
+  assert(mc % sizeof(float) == 0);
+  assert(nc != 0);
+
+  static const int32_t mask_table[14] = {-1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0};
+
+  const __m256 vmin = _mm256_set1_ps(params->scalar.min);
+  const __m256 vmax = _mm256_set1_ps(params->scalar.max);
+  XNN_FORCE_REALIZATION(vmin);
+  XNN_FORCE_REALIZATION(vmax);
+
+  const size_t output_decrement = output_stride * nc;
+  while XNN_LIKELY(mc >= 16 * sizeof(float)) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 4) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc1n0 = vacc0n0;
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      __m256 vacc1n1 = vacc0n1;
+      __m256 vacc0n2 = _mm256_set1_ps(w[2]);
+      __m256 vacc1n2 = vacc0n2;
+      __m256 vacc0n3 = _mm256_set1_ps(w[3]);
+      __m256 vacc1n3 = vacc0n3;
+      w += 4;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          const __m256 vi1 = _mm256_loadu_ps(input + 8);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          const __m256 vw2 = _mm256_set1_ps(w[2]);
+          const __m256 vw3 = _mm256_set1_ps(w[3]);
+          w += 4;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm256_fmadd_ps(vi1, vw0, vacc1n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc1n1 = _mm256_fmadd_ps(vi1, vw1, vacc1n1);
+          vacc0n2 = _mm256_fmadd_ps(vi0, vw2, vacc0n2);
+          vacc1n2 = _mm256_fmadd_ps(vi1, vw2, vacc1n2);
+          vacc0n3 = _mm256_fmadd_ps(vi0, vw3, vacc0n3);
+          vacc1n3 = _mm256_fmadd_ps(vi1, vw3, vacc1n3);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout1n0 = _mm256_min_ps(vacc1n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      __m256 vout1n1 = _mm256_min_ps(vacc1n1, vmax);
+      __m256 vout0n2 = _mm256_min_ps(vacc0n2, vmax);
+      __m256 vout1n2 = _mm256_min_ps(vacc1n2, vmax);
+      __m256 vout0n3 = _mm256_min_ps(vacc0n3, vmax);
+      __m256 vout1n3 = _mm256_min_ps(vacc1n3, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout1n0 = _mm256_max_ps(vout1n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      vout1n1 = _mm256_max_ps(vout1n1, vmin);
+      vout0n2 = _mm256_max_ps(vout0n2, vmin);
+      vout1n2 = _mm256_max_ps(vout1n2, vmin);
+      vout0n3 = _mm256_max_ps(vout0n3, vmin);
+      vout1n3 = _mm256_max_ps(vout1n3, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      _mm256_storeu_ps(output + 8, vout1n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n1);
+      _mm256_storeu_ps(output + 8, vout1n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n2);
+      _mm256_storeu_ps(output + 8, vout1n2);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n3);
+      _mm256_storeu_ps(output + 8, vout1n3);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 4;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc1n0 = vacc0n0;
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          const __m256 vi1 = _mm256_loadu_ps(input + 8);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm256_fmadd_ps(vi1, vw0, vacc1n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout1n0 = _mm256_min_ps(vacc1n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout1n0 = _mm256_max_ps(vout1n0, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      _mm256_storeu_ps(output + 8, vout1n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 16;
+    input += 16;
+    mc -= 16 * sizeof(float);
+  }
+  if (mc & (8 * sizeof(float))) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 4) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      __m256 vacc0n2 = _mm256_set1_ps(w[2]);
+      __m256 vacc0n3 = _mm256_set1_ps(w[3]);
+      w += 4;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          const __m256 vw2 = _mm256_set1_ps(w[2]);
+          const __m256 vw3 = _mm256_set1_ps(w[3]);
+          w += 4;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc0n2 = _mm256_fmadd_ps(vi0, vw2, vacc0n2);
+          vacc0n3 = _mm256_fmadd_ps(vi0, vw3, vacc0n3);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      __m256 vout0n2 = _mm256_min_ps(vacc0n2, vmax);
+      __m256 vout0n3 = _mm256_min_ps(vacc0n3, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      vout0n2 = _mm256_max_ps(vout0n2, vmin);
+      vout0n3 = _mm256_max_ps(vout0n3, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n2);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n3);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 4;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 8;
+    input += 8;
+  }
+  mc &= 7 * sizeof(float);
+  if XNN_UNLIKELY(mc != 0) {
+    const __m256i vmask = _mm256_loadu_si256((const __m256i*) ((uintptr_t) &mask_table[7] - mc));
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 4) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      __m256 vacc0n2 = _mm256_set1_ps(w[2]);
+      __m256 vacc0n3 = _mm256_set1_ps(w[3]);
+      w += 4;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_maskload_ps(input, vmask);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          const __m256 vw2 = _mm256_set1_ps(w[2]);
+          const __m256 vw3 = _mm256_set1_ps(w[3]);
+          w += 4;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc0n2 = _mm256_fmadd_ps(vi0, vw2, vacc0n2);
+          vacc0n3 = _mm256_fmadd_ps(vi0, vw3, vacc0n3);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      __m256 vout0n2 = _mm256_min_ps(vacc0n2, vmax);
+      __m256 vout0n3 = _mm256_min_ps(vacc0n3, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      vout0n2 = _mm256_max_ps(vout0n2, vmin);
+      vout0n3 = _mm256_max_ps(vout0n3, vmin);
+      _mm256_maskstore_ps(output, vmask, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_maskstore_ps(output, vmask, vout0n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_maskstore_ps(output, vmask, vout0n2);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_maskstore_ps(output, vmask, vout0n3);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 4;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_maskload_ps(input, vmask);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      _mm256_maskstore_ps(output, vmask, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+  }
+}
@@ -0,0 +1,339 @@
+// Auto-generated file. Do not edit!
+//   Template: src/f32-spmm/fma3.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/spmm.h"
+
+
+void xnn_f32_spmm_minmax_ukernel_32x2__fma3(
+    size_t mc,
+    size_t nc,
+    const float* input,
+    const float* weights,
+    const int32_t* widx_dmap,
+    const uint32_t* nidx_nnzmap,
+    float* output,
+    size_t output_stride,
+    const union xnn_f32_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mc != 0);
+  assert(mc % sizeof(float) == 0);
+  assert(nc != 0);
+
+  static const int32_t mask_table[14] = {-1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0};
+
+  const __m256 vmin = _mm256_set1_ps(params->scalar.min);
+  const __m256 vmax = _mm256_set1_ps(params->scalar.max);
+  XNN_FORCE_REALIZATION(vmin);
+  XNN_FORCE_REALIZATION(vmax);
+
+  const size_t output_decrement = output_stride * nc;
+  while XNN_LIKELY(mc >= 32 * sizeof(float)) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 2) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc1n0 = vacc0n0;
+      __m256 vacc2n0 = vacc0n0;
+      __m256 vacc3n0 = vacc0n0;
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      __m256 vacc1n1 = vacc0n1;
+      __m256 vacc2n1 = vacc0n1;
+      __m256 vacc3n1 = vacc0n1;
+      w += 2;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          const __m256 vi1 = _mm256_loadu_ps(input + 8);
+          const __m256 vi2 = _mm256_loadu_ps(input + 16);
+          const __m256 vi3 = _mm256_loadu_ps(input + 24);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          w += 2;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm256_fmadd_ps(vi1, vw0, vacc1n0);
+          vacc2n0 = _mm256_fmadd_ps(vi2, vw0, vacc2n0);
+          vacc3n0 = _mm256_fmadd_ps(vi3, vw0, vacc3n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc1n1 = _mm256_fmadd_ps(vi1, vw1, vacc1n1);
+          vacc2n1 = _mm256_fmadd_ps(vi2, vw1, vacc2n1);
+          vacc3n1 = _mm256_fmadd_ps(vi3, vw1, vacc3n1);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout1n0 = _mm256_min_ps(vacc1n0, vmax);
+      __m256 vout2n0 = _mm256_min_ps(vacc2n0, vmax);
+      __m256 vout3n0 = _mm256_min_ps(vacc3n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      __m256 vout1n1 = _mm256_min_ps(vacc1n1, vmax);
+      __m256 vout2n1 = _mm256_min_ps(vacc2n1, vmax);
+      __m256 vout3n1 = _mm256_min_ps(vacc3n1, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout1n0 = _mm256_max_ps(vout1n0, vmin);
+      vout2n0 = _mm256_max_ps(vout2n0, vmin);
+      vout3n0 = _mm256_max_ps(vout3n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      vout1n1 = _mm256_max_ps(vout1n1, vmin);
+      vout2n1 = _mm256_max_ps(vout2n1, vmin);
+      vout3n1 = _mm256_max_ps(vout3n1, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      _mm256_storeu_ps(output + 8, vout1n0);
+      _mm256_storeu_ps(output + 16, vout2n0);
+      _mm256_storeu_ps(output + 24, vout3n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n1);
+      _mm256_storeu_ps(output + 8, vout1n1);
+      _mm256_storeu_ps(output + 16, vout2n1);
+      _mm256_storeu_ps(output + 24, vout3n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 2;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc1n0 = vacc0n0;
+      __m256 vacc2n0 = vacc0n0;
+      __m256 vacc3n0 = vacc0n0;
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          const __m256 vi1 = _mm256_loadu_ps(input + 8);
+          const __m256 vi2 = _mm256_loadu_ps(input + 16);
+          const __m256 vi3 = _mm256_loadu_ps(input + 24);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm256_fmadd_ps(vi1, vw0, vacc1n0);
+          vacc2n0 = _mm256_fmadd_ps(vi2, vw0, vacc2n0);
+          vacc3n0 = _mm256_fmadd_ps(vi3, vw0, vacc3n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout1n0 = _mm256_min_ps(vacc1n0, vmax);
+      __m256 vout2n0 = _mm256_min_ps(vacc2n0, vmax);
+      __m256 vout3n0 = _mm256_min_ps(vacc3n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout1n0 = _mm256_max_ps(vout1n0, vmin);
+      vout2n0 = _mm256_max_ps(vout2n0, vmin);
+      vout3n0 = _mm256_max_ps(vout3n0, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      _mm256_storeu_ps(output + 8, vout1n0);
+      _mm256_storeu_ps(output + 16, vout2n0);
+      _mm256_storeu_ps(output + 24, vout3n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 32;
+    input += 32;
+    mc -= 32 * sizeof(float);
+  }
+  if (mc & (16 * sizeof(float))) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 2) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc1n0 = vacc0n0;
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      __m256 vacc1n1 = vacc0n1;
+      w += 2;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          const __m256 vi1 = _mm256_loadu_ps(input + 8);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          w += 2;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm256_fmadd_ps(vi1, vw0, vacc1n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc1n1 = _mm256_fmadd_ps(vi1, vw1, vacc1n1);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout1n0 = _mm256_min_ps(vacc1n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      __m256 vout1n1 = _mm256_min_ps(vacc1n1, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout1n0 = _mm256_max_ps(vout1n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      vout1n1 = _mm256_max_ps(vout1n1, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      _mm256_storeu_ps(output + 8, vout1n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n1);
+      _mm256_storeu_ps(output + 8, vout1n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 2;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc1n0 = vacc0n0;
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          const __m256 vi1 = _mm256_loadu_ps(input + 8);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm256_fmadd_ps(vi1, vw0, vacc1n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout1n0 = _mm256_min_ps(vacc1n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout1n0 = _mm256_max_ps(vout1n0, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      _mm256_storeu_ps(output + 8, vout1n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 16;
+    input += 16;
+  }
+  if (mc & (8 * sizeof(float))) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 2) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      w += 2;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          w += 2;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_storeu_ps(output, vout0n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 2;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_loadu_ps(input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      _mm256_storeu_ps(output, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 8;
+    input += 8;
+  }
+  mc &= 7 * sizeof(float);
+  if XNN_UNLIKELY(mc != 0) {
+    const __m256i vmask = _mm256_loadu_si256((const __m256i*) ((uintptr_t) &mask_table[7] - mc));
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 2) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      __m256 vacc0n1 = _mm256_set1_ps(w[1]);
+      w += 2;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_maskload_ps(input, vmask);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          const __m256 vw1 = _mm256_set1_ps(w[1]);
+          w += 2;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc0n1 = _mm256_fmadd_ps(vi0, vw1, vacc0n1);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      __m256 vout0n1 = _mm256_min_ps(vacc0n1, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      vout0n1 = _mm256_max_ps(vout0n1, vmin);
+      _mm256_maskstore_ps(output, vmask, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm256_maskstore_ps(output, vmask, vout0n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 2;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m256 vacc0n0 = _mm256_set1_ps(w[0]);
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m256 vi0 = _mm256_maskload_ps(input, vmask);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m256 vw0 = _mm256_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm256_fmadd_ps(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m256 vout0n0 = _mm256_min_ps(vacc0n0, vmax);
+      vout0n0 = _mm256_max_ps(vout0n0, vmin);
+      _mm256_maskstore_ps(output, vmask, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+  }
+}
@@ -0,0 +1,283 @@
+// Auto-generated file. Do not edit!
+//   Template: src/f32-spmm/avx512f.c.in
+//   Generator: tools/xngen
+//
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/intrinsics-polyfill.h"
+#include "xnnpack/spmm.h"
+
+
+void xnn_f32_spmm_minmax_ukernel_32x4__avx512f(
+    size_t mc,
+    size_t nc,
+    const float* input,
+    const float* weights,
+    const int32_t* widx_dmap,
+    const uint32_t* nidx_nnzmap,
+    float* output,
+    size_t output_stride,
+    const union xnn_f32_minmax_params params[restrict XNN_MIN_ELEMENTS(1)])
+{
+  assert(mc != 0);
+  assert(mc % sizeof(float) == 0);
+  assert(nc != 0);
+
+  const __m512 vmin = _mm512_set1_ps(params->scalar.min);
+  const __m512 vmax = _mm512_set1_ps(params->scalar.max);
+  XNN_FORCE_REALIZATION(vmin);
+  XNN_FORCE_REALIZATION(vmax);
+
+  const size_t output_decrement = output_stride * nc;
+  while XNN_LIKELY(mc >= 32 * sizeof(float)) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 4) {
+      uint32_t nnz = *nnzmap++;
+      __m512 vacc0n0 = _mm512_set1_ps(w[0]);
+      __m512 vacc1n0 = vacc0n0;
+      __m512 vacc0n1 = _mm512_set1_ps(w[1]);
+      __m512 vacc1n1 = vacc0n1;
+      __m512 vacc0n2 = _mm512_set1_ps(w[2]);
+      __m512 vacc1n2 = vacc0n2;
+      __m512 vacc0n3 = _mm512_set1_ps(w[3]);
+      __m512 vacc1n3 = vacc0n3;
+      w += 4;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512 vi0 = _mm512_loadu_ps(input);
+          const __m512 vi1 = _mm512_loadu_ps(input + 16);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m512 vw0 = _mm512_set1_ps(w[0]);
+          const __m512 vw1 = _mm512_set1_ps(w[1]);
+          const __m512 vw2 = _mm512_set1_ps(w[2]);
+          const __m512 vw3 = _mm512_set1_ps(w[3]);
+          w += 4;
+          vacc0n0 = _mm512_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm512_fmadd_ps(vi1, vw0, vacc1n0);
+          vacc0n1 = _mm512_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc1n1 = _mm512_fmadd_ps(vi1, vw1, vacc1n1);
+          vacc0n2 = _mm512_fmadd_ps(vi0, vw2, vacc0n2);
+          vacc1n2 = _mm512_fmadd_ps(vi1, vw2, vacc1n2);
+          vacc0n3 = _mm512_fmadd_ps(vi0, vw3, vacc0n3);
+          vacc1n3 = _mm512_fmadd_ps(vi1, vw3, vacc1n3);
+        } while (--nnz != 0);
+      }
+      __m512 vout0n0 = _mm512_min_ps(vacc0n0, vmax);
+      __m512 vout1n0 = _mm512_min_ps(vacc1n0, vmax);
+      __m512 vout0n1 = _mm512_min_ps(vacc0n1, vmax);
+      __m512 vout1n1 = _mm512_min_ps(vacc1n1, vmax);
+      __m512 vout0n2 = _mm512_min_ps(vacc0n2, vmax);
+      __m512 vout1n2 = _mm512_min_ps(vacc1n2, vmax);
+      __m512 vout0n3 = _mm512_min_ps(vacc0n3, vmax);
+      __m512 vout1n3 = _mm512_min_ps(vacc1n3, vmax);
+      vout0n0 = _mm512_max_ps(vout0n0, vmin);
+      vout1n0 = _mm512_max_ps(vout1n0, vmin);
+      vout0n1 = _mm512_max_ps(vout0n1, vmin);
+      vout1n1 = _mm512_max_ps(vout1n1, vmin);
+      vout0n2 = _mm512_max_ps(vout0n2, vmin);
+      vout1n2 = _mm512_max_ps(vout1n2, vmin);
+      vout0n3 = _mm512_max_ps(vout0n3, vmin);
+      vout1n3 = _mm512_max_ps(vout1n3, vmin);
+      _mm512_storeu_ps(output, vout0n0);
+      _mm512_storeu_ps(output + 16, vout1n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_storeu_ps(output, vout0n1);
+      _mm512_storeu_ps(output + 16, vout1n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_storeu_ps(output, vout0n2);
+      _mm512_storeu_ps(output + 16, vout1n2);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_storeu_ps(output, vout0n3);
+      _mm512_storeu_ps(output + 16, vout1n3);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 4;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m512 vacc0n0 = _mm512_set1_ps(w[0]);
+      __m512 vacc1n0 = vacc0n0;
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512 vi0 = _mm512_loadu_ps(input);
+          const __m512 vi1 = _mm512_loadu_ps(input + 16);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m512 vw0 = _mm512_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm512_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc1n0 = _mm512_fmadd_ps(vi1, vw0, vacc1n0);
+        } while (--nnz != 0);
+      }
+      __m512 vout0n0 = _mm512_min_ps(vacc0n0, vmax);
+      __m512 vout1n0 = _mm512_min_ps(vacc1n0, vmax);
+      vout0n0 = _mm512_max_ps(vout0n0, vmin);
+      vout1n0 = _mm512_max_ps(vout1n0, vmin);
+      _mm512_storeu_ps(output, vout0n0);
+      _mm512_storeu_ps(output + 16, vout1n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 32;
+    input += 32;
+    mc -= 32 * sizeof(float);
+  }
+  if (mc & (16 * sizeof(float))) {
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 4) {
+      uint32_t nnz = *nnzmap++;
+      __m512 vacc0n0 = _mm512_set1_ps(w[0]);
+      __m512 vacc0n1 = _mm512_set1_ps(w[1]);
+      __m512 vacc0n2 = _mm512_set1_ps(w[2]);
+      __m512 vacc0n3 = _mm512_set1_ps(w[3]);
+      w += 4;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512 vi0 = _mm512_loadu_ps(input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m512 vw0 = _mm512_set1_ps(w[0]);
+          const __m512 vw1 = _mm512_set1_ps(w[1]);
+          const __m512 vw2 = _mm512_set1_ps(w[2]);
+          const __m512 vw3 = _mm512_set1_ps(w[3]);
+          w += 4;
+          vacc0n0 = _mm512_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc0n1 = _mm512_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc0n2 = _mm512_fmadd_ps(vi0, vw2, vacc0n2);
+          vacc0n3 = _mm512_fmadd_ps(vi0, vw3, vacc0n3);
+        } while (--nnz != 0);
+      }
+      __m512 vout0n0 = _mm512_min_ps(vacc0n0, vmax);
+      __m512 vout0n1 = _mm512_min_ps(vacc0n1, vmax);
+      __m512 vout0n2 = _mm512_min_ps(vacc0n2, vmax);
+      __m512 vout0n3 = _mm512_min_ps(vacc0n3, vmax);
+      vout0n0 = _mm512_max_ps(vout0n0, vmin);
+      vout0n1 = _mm512_max_ps(vout0n1, vmin);
+      vout0n2 = _mm512_max_ps(vout0n2, vmin);
+      vout0n3 = _mm512_max_ps(vout0n3, vmin);
+      _mm512_storeu_ps(output, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_storeu_ps(output, vout0n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_storeu_ps(output, vout0n2);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_storeu_ps(output, vout0n3);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 4;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m512 vacc0n0 = _mm512_set1_ps(w[0]);
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512 vi0 = _mm512_loadu_ps(input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m512 vw0 = _mm512_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm512_fmadd_ps(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m512 vout0n0 = _mm512_min_ps(vacc0n0, vmax);
+      vout0n0 = _mm512_max_ps(vout0n0, vmin);
+      _mm512_storeu_ps(output, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+    output = (float*) ((uintptr_t) output - output_decrement);
+    output += 16;
+    input += 16;
+  }
+  mc &= 15 * sizeof(float);
+  if XNN_UNLIKELY(mc != 0) {
+    // Prepare mask for valid 32-bit elements (depends on mc).
+    const __mmask16 vmask = _cvtu32_mask16((uint32_t) ((UINT32_C(1) << (mc >> XNN_LOG2_SIZEOF_FLOAT)) - UINT32_C(1)));
+    const float* w = weights;
+    const int32_t* dmap = widx_dmap;
+    const uint32_t* nnzmap = nidx_nnzmap;
+    size_t n = nc;
+    while (n >= 4) {
+      uint32_t nnz = *nnzmap++;
+      __m512 vacc0n0 = _mm512_set1_ps(w[0]);
+      __m512 vacc0n1 = _mm512_set1_ps(w[1]);
+      __m512 vacc0n2 = _mm512_set1_ps(w[2]);
+      __m512 vacc0n3 = _mm512_set1_ps(w[3]);
+      w += 4;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512 vi0 = _mm512_maskz_loadu_ps(vmask, input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m512 vw0 = _mm512_set1_ps(w[0]);
+          const __m512 vw1 = _mm512_set1_ps(w[1]);
+          const __m512 vw2 = _mm512_set1_ps(w[2]);
+          const __m512 vw3 = _mm512_set1_ps(w[3]);
+          w += 4;
+          vacc0n0 = _mm512_fmadd_ps(vi0, vw0, vacc0n0);
+          vacc0n1 = _mm512_fmadd_ps(vi0, vw1, vacc0n1);
+          vacc0n2 = _mm512_fmadd_ps(vi0, vw2, vacc0n2);
+          vacc0n3 = _mm512_fmadd_ps(vi0, vw3, vacc0n3);
+        } while (--nnz != 0);
+      }
+      __m512 vout0n0 = _mm512_min_ps(vacc0n0, vmax);
+      __m512 vout0n1 = _mm512_min_ps(vacc0n1, vmax);
+      __m512 vout0n2 = _mm512_min_ps(vacc0n2, vmax);
+      __m512 vout0n3 = _mm512_min_ps(vacc0n3, vmax);
+      vout0n0 = _mm512_max_ps(vout0n0, vmin);
+      vout0n1 = _mm512_max_ps(vout0n1, vmin);
+      vout0n2 = _mm512_max_ps(vout0n2, vmin);
+      vout0n3 = _mm512_max_ps(vout0n3, vmin);
+      _mm512_mask_storeu_ps(output, vmask, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_mask_storeu_ps(output, vmask, vout0n1);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_mask_storeu_ps(output, vmask, vout0n2);
+      output = (float*) ((uintptr_t) output + output_stride);
+      _mm512_mask_storeu_ps(output, vmask, vout0n3);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 4;
+    }
+    // Remaining output channels are packed one at a time.
+    while (n != 0) {
+      uint32_t nnz = *nnzmap++;
+      __m512 vacc0n0 = _mm512_set1_ps(w[0]);
+      w += 1;
+      if XNN_LIKELY(nnz != 0) {
+        do {
+          const intptr_t diff = *dmap++;
+          const __m512 vi0 = _mm512_maskz_loadu_ps(vmask, input);
+          input = (const float*) ((uintptr_t) input + (uintptr_t) diff);
+          const __m512 vw0 = _mm512_set1_ps(w[0]);
+          w += 1;
+          vacc0n0 = _mm512_fmadd_ps(vi0, vw0, vacc0n0);
+        } while (--nnz != 0);
+      }
+      __m512 vout0n0 = _mm512_min_ps(vacc0n0, vmax);
+      vout0n0 = _mm512_max_ps(vout0n0, vmin);
+      _mm512_mask_storeu_ps(output, vmask, vout0n0);
+      output = (float*) ((uintptr_t) output + output_stride);
+      n -= 1;
+    }
+  }
+}
@@ -0,0 +1,132 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack/math.h"
+#include "xnnpack/winograd.h"
+
+
+// Multiplies 6 elements by B^T of Winograd F(4, 3).
+static inline void input_transform_6(
+    float d0, float d1, float d2, float d3, float d4, float d5, float v[6])
+{
+  v[0] = 4.0f * d0 - 5.0f * d2 + d4;
+  v[1] = -4.0f * (d1 + d2) + d3 + d4;
+  v[2] = 4.0f * (d1 - d2) - d3 + d4;
+  v[3] = 2.0f * (d3 - d1) - d2 + d4;
+  v[4] = 2.0f * (d1 - d3) - d2 + d4;
+  v[5] = 4.0f * d1 - 5.0f * d3 + d5;
+}
+
+// Multiplies 6 elements by A^T of Winograd F(4, 3).
+static inline void output_transform_6(
+    float m0, float m1, float m2, float m3, float m4, float m5, float y[4])
+{
+  const float vsum12 = m1 + m2;
+  const float vdiff12 = m1 - m2;
+  const float vsum34 = m3 + m4;
+  const float vdiff34 = m3 - m4;
+  y[0] = m0 + vsum12 + vsum34;
+  y[1] = vdiff12 + 2.0f * vdiff34;
+  y[2] = vsum12 + 4.0f * vsum34;
+  y[3] = vdiff12 + 8.0f * vdiff34 + m5;
+}
+
+void xnn_f32_winograd_f4x4k3x3_input_ukernel__scalar_c1(
+    size_t channels,
+    const float** input,
+    float* output,
+    size_t output_stride)
+{
+  assert(channels != 0);
+  assert(channels % sizeof(float) == 0);
+  assert(input != NULL);
+  assert(output != NULL);
+
+  for (size_t c = 0; c < channels; c += sizeof(float)) {
+    float d[6][6];
+    for (size_t i = 0; i < 6; i++) {
+      for (size_t j = 0; j < 6; j++) {
+        d[i][j] = *((const float*) ((uintptr_t) input[i * 6 + j] + c));
+      }
+    }
+
+    // B^T d, column by column.
+    float t[6][6];
+    for (size_t j = 0; j < 6; j++) {
+      float v[6];
+      input_transform_6(d[0][j], d[1][j], d[2][j], d[3][j], d[4][j], d[5][j], v);
+      for (size_t i = 0; i < 6; i++) {
+        t[i][j] = v[i];
+      }
+    }
+
+    // (B^T d) B, row by row.
+    for (size_t i = 0; i < 6; i++) {
+      float v[6];
+      input_transform_6(t[i][0], t[i][1], t[i][2], t[i][3], t[i][4], t[i][5], v);
+      for (size_t j = 0; j < 6; j++) {
+        *((float*) ((uintptr_t) output + (i * 6 + j) * output_stride + c)) = v[j];
+      }
+    }
+  }
+}
+
+void xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__scalar_c1(
+    size_t channels,
+    const float* input,
+    size_t input_stride,
+    const float* bias,
+    float* output,
+    size_t output_row_stride,
+    size_t output_pixel_stride,
+    size_t rows,
+    size_t columns,
+    const union xnn_f32_minmax_params params[XNN_RESTRICT XNN_MIN_ELEMENTS(1)])
+{
+  assert(channels != 0);
+  assert(channels % sizeof(float) == 0);
+  assert(rows != 0);
+  assert(rows <= 4);
+  assert(columns != 0);
+  assert(columns <= 4);
+
+  const float vmin = params->scalar.min;
+  const float vmax = params->scalar.max;
+  for (size_t c = 0; c < channels; c += sizeof(float)) {
+    float m[6][6];
+    for (size_t i = 0; i < 6; i++) {
+      for (size_t j = 0; j < 6; j++) {
+        m[i][j] = *((const float*) ((uintptr_t) input + (i * 6 + j) * input_stride + c));
+      }
+    }
+
+    // A^T m, column by column.
+    float t[4][6];
+    for (size_t j = 0; j < 6; j++) {
+      float y[4];
+      output_transform_6(m[0][j], m[1][j], m[2][j], m[3][j], m[4][j], m[5][j], y);
+      for (size_t i = 0; i < 4; i++) {
+        t[i][j] = y[i];
+      }
+    }
+
+    // (A^T m) A, row by row.
+    const float vbias = *((const float*) ((uintptr_t) bias + c));
+    for (size_t i = 0; i < rows; i++) {
+      float y[4];
+      output_transform_6(t[i][0], t[i][1], t[i][2], t[i][3], t[i][4], t[i][5], y);
+      for (size_t j = 0; j < columns; j++) {
+        float vout = y[j] + vbias;
+        vout = math_max_f32(vout, vmin);
+        vout = math_min_f32(vout, vmax);
+        *((float*) ((uintptr_t) output + i * output_row_stride + j * output_pixel_stride + c)) = vout;
+      }
+    }
+  }
+}
@@ -0,0 +1,167 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <xmmintrin.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/winograd.h"
+
+
+// Multiplies 6 vectors by B^T of Winograd F(4, 3).
+static XNN_INLINE void input_transform_6(
+    __m128 vd0, __m128 vd1, __m128 vd2, __m128 vd3, __m128 vd4, __m128 vd5, __m128 vv[6])
+{
+  const __m128 vfour = _mm_set1_ps(4.0f);
+  const __m128 vfive = _mm_set1_ps(5.0f);
+  const __m128 vsum12 = _mm_add_ps(vd1, vd2);
+  const __m128 vdiff12 = _mm_sub_ps(vd1, vd2);
+  const __m128 vdiff31 = _mm_sub_ps(vd3, vd1);
+  const __m128 vd4m2 = _mm_sub_ps(vd4, vd2);
+  vv[0] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vfour, vd0), _mm_mul_ps(vfive, vd2)), vd4);
+  vv[1] = _mm_sub_ps(_mm_add_ps(vd3, vd4), _mm_mul_ps(vfour, vsum12));
+  vv[2] = _mm_add_ps(_mm_mul_ps(vfour, vdiff12), _mm_sub_ps(vd4, vd3));
+  vv[3] = _mm_add_ps(_mm_add_ps(vdiff31, vdiff31), vd4m2);
+  vv[4] = _mm_sub_ps(vd4m2, _mm_add_ps(vdiff31, vdiff31));
+  vv[5] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vfour, vd1), _mm_mul_ps(vfive, vd3)), vd5);
+}
+
+// Multiplies 6 vectors by A^T of Winograd F(4, 3).
+static XNN_INLINE void output_transform_6(
+    __m128 vm0, __m128 vm1, __m128 vm2, __m128 vm3, __m128 vm4, __m128 vm5, __m128 vy[4])
+{
+  const __m128 vsum12 = _mm_add_ps(vm1, vm2);
+  const __m128 vdiff12 = _mm_sub_ps(vm1, vm2);
+  const __m128 vsum34 = _mm_add_ps(vm3, vm4);
+  const __m128 vdiff34 = _mm_sub_ps(vm3, vm4);
+  vy[0] = _mm_add_ps(_mm_add_ps(vm0, vsum12), vsum34);
+  vy[1] = _mm_add_ps(vdiff12, _mm_mul_ps(_mm_set1_ps(2.0f), vdiff34));
+  vy[2] = _mm_add_ps(vsum12, _mm_mul_ps(_mm_set1_ps(4.0f), vsum34));
+  vy[3] = _mm_add_ps(_mm_add_ps(vdiff12, _mm_mul_ps(_mm_set1_ps(8.0f), vdiff34)), vm5);
+}
+
+// Stores the first `channels` bytes, less than 4 floats, of `v`.
+static XNN_INLINE void store_partial(float* output, __m128 v, size_t channels)
+{
+  if (channels & (2 * sizeof(float))) {
+    _mm_storel_pi((__m64*) output, v);
+    v = _mm_movehl_ps(v, v);
+    output += 2;
+  }
+  if (channels & (1 * sizeof(float))) {
+    _mm_store_ss(output, v);
+  }
+}
+
+void xnn_f32_winograd_f4x4k3x3_input_ukernel__sse_c4(
+    size_t channels,
+    const float** input,
+    float* output,
+    size_t output_stride) XNN_OOB_READS
+{
+  assert(channels != 0);
+  assert(channels % sizeof(float) == 0);
+  assert(input != NULL);
+  assert(output != NULL);
+
+  for (size_t c = 0; c < channels; c += 4 * sizeof(float)) {
+    // B^T d, column by column.
+    __m128 vt[6][6];
+    for (size_t j = 0; j < 6; j++) {
+      __m128 vv[6];
+      input_transform_6(
+        _mm_loadu_ps((const float*) ((uintptr_t) input[0 * 6 + j] + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input[1 * 6 + j] + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input[2 * 6 + j] + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input[3 * 6 + j] + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input[4 * 6 + j] + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input[5 * 6 + j] + c)),
+        vv);
+      for (size_t i = 0; i < 6; i++) {
+        vt[i][j] = vv[i];
+      }
+    }
+
+    // (B^T d) B, row by row.
+    const size_t channels_left = channels - c;
+    for (size_t i = 0; i < 6; i++) {
+      __m128 vv[6];
+      input_transform_6(vt[i][0], vt[i][1], vt[i][2], vt[i][3], vt[i][4], vt[i][5], vv);
+      for (size_t j = 0; j < 6; j++) {
+        float* o = (float*) ((uintptr_t) output + (i * 6 + j) * output_stride + c);
+        if XNN_LIKELY(channels_left >= 4 * sizeof(float)) {
+          _mm_storeu_ps(o, vv[j]);
+        } else {
+          store_partial(o, vv[j], channels_left);
+        }
+      }
+    }
+  }
+}
+
+void xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__sse_c4(
+    size_t channels,
+    const float* input,
+    size_t input_stride,
+    const float* bias,
+    float* output,
+    size_t output_row_stride,
+    size_t output_pixel_stride,
+    size_t rows,
+    size_t columns,
+    const union xnn_f32_minmax_params params[XNN_RESTRICT XNN_MIN_ELEMENTS(1)]) XNN_OOB_READS
+{
+  assert(channels != 0);
+  assert(channels % sizeof(float) == 0);
+  assert(rows != 0);
+  assert(rows <= 4);
+  assert(columns != 0);
+  assert(columns <= 4);
+
+  const __m128 vmin = _mm_set1_ps(params->scalar.min);
+  const __m128 vmax = _mm_set1_ps(params->scalar.max);
+  XNN_FORCE_REALIZATION(vmin);
+  XNN_FORCE_REALIZATION(vmax);
+  for (size_t c = 0; c < channels; c += 4 * sizeof(float)) {
+    // A^T m, column by column.
+    __m128 vt[4][6];
+    for (size_t j = 0; j < 6; j++) {
+      __m128 vy[4];
+      output_transform_6(
+        _mm_loadu_ps((const float*) ((uintptr_t) input + (0 * 6 + j) * input_stride + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input + (1 * 6 + j) * input_stride + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input + (2 * 6 + j) * input_stride + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input + (3 * 6 + j) * input_stride + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input + (4 * 6 + j) * input_stride + c)),
+        _mm_loadu_ps((const float*) ((uintptr_t) input + (5 * 6 + j) * input_stride + c)),
+        vy);
+      for (size_t i = 0; i < 4; i++) {
+        vt[i][j] = vy[i];
+      }
+    }
+
+    // (A^T m) A, row by row.
+    const __m128 vbias = _mm_loadu_ps((const float*) ((uintptr_t) bias + c));
+    const size_t channels_left = channels - c;
+    for (size_t i = 0; i < rows; i++) {
+      __m128 vy[4];
+      output_transform_6(vt[i][0], vt[i][1], vt[i][2], vt[i][3], vt[i][4], vt[i][5], vy);
+      for (size_t j = 0; j < columns; j++) {
+        __m128 vout = _mm_add_ps(vy[j], vbias);
+        vout = _mm_max_ps(vout, vmin);
+        vout = _mm_min_ps(vout, vmax);
+        float* o = (float*) ((uintptr_t) output + i * output_row_stride + j * output_pixel_stride + c);
+        if XNN_LIKELY(channels_left >= 4 * sizeof(float)) {
+          _mm_storeu_ps(o, vout);
+        } else {
+          store_partial(o, vout, channels_left);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,364 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef __MACH__
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/allocator.h"
+#include "xnnpack/cache.h"
+#include "xnnpack/common.h"
+#include "xnnpack/gemm-tuning.h"
+#include "xnnpack/hardware-config.h"
+#include "xnnpack/init-once.h"
+#include "xnnpack/log.h"
+#include "xnnpack/math.h"
+#include "xnnpack/microfnptr.h"
+#include "xnnpack/mutex.h"
+#include "xnnpack/operator-type.h"
+
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/emscripten.h>
+#elif XNN_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// First line of tuning files. Each following line is an entry:
+//   <hardware fingerprint> <M> <N> <K> <MR> <operator type>
+#define TUNING_FILE_HEADER "XNNPACK GEMM tuning v1"
+
+struct tuning_entry {
+  uint32_t hardware;
+  enum xnn_operator_type operator_type;
+  size_t m;
+  size_t n;
+  size_t k;
+  uint32_t mr;
+};
+
+// Process-wide table of tuned shapes. Entries of other hardware are kept, so that saving a table loaded from a file
+// shared by several machines does not drop their choices.
+static struct {
+  struct xnn_mutex mutex;
+  struct tuning_entry* entries;
+  size_t num_entries;
+  size_t capacity;
+} tuning_table;
+
+XNN_INIT_ONCE_GUARD(gemm_tuning);
+
+static void init_gemm_tuning_config(void)
+{
+  xnn_mutex_init(&tuning_table.mutex);
+}
+
+uint32_t xnn_gemm_tuning_hardware_fingerprint(void)
+{
+  const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+  // Instruction set extensions and the cache size tell apart the microarchitectures that favour different MR.
+  struct {
+    uint64_t arch_flags;
+    uint64_t l2_data_cache_bytes;
+    uint64_t l2_data_cache_associativity;
+  } hardware;
+  memset(&hardware, 0, sizeof(hardware));
+  if (hardware_config != NULL) {
+    hardware.arch_flags = hardware_config->arch_flags;
+    hardware.l2_data_cache_bytes = hardware_config->l2_data_cache_bytes;
+    hardware.l2_data_cache_associativity = hardware_config->l2_data_cache_associativity;
+  }
+  return murmur_hash3(&hardware, sizeof(hardware), /*seed=*/11);
+}
+
+// Returns the entry of the shape, NULL if there is none. The table must be locked.
+static struct tuning_entry* find_entry(
+  uint32_t hardware, enum xnn_operator_type operator_type, size_t m, size_t n, size_t k)
+{
+  for (size_t i = 0; i < tuning_table.num_entries; i++) {
+    struct tuning_entry* entry = &tuning_table.entries[i];
+    if (entry->hardware == hardware && entry->operator_type == operator_type && entry->m == m && entry->n == n &&
+        entry->k == k) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+// Adds or replaces the entry of the shape. The table must be locked.
+static enum xnn_status insert_entry(const struct tuning_entry* new_entry)
+{
+  struct tuning_entry* entry =
+    find_entry(new_entry->hardware, new_entry->operator_type, new_entry->m, new_entry->n, new_entry->k);
+  if (entry == NULL) {
+    if (tuning_table.num_entries == tuning_table.capacity) {
+      const size_t capacity = max(tuning_table.capacity * 2, 16);
+      struct tuning_entry* entries =
+        xnn_reallocate_memory(tuning_table.entries, capacity * sizeof(struct tuning_entry));
+      if (entries == NULL) {
+        xnn_log_error("failed to allocate %zu bytes for GEMM tuning table", capacity * sizeof(struct tuning_entry));
+        return xnn_status_out_of_memory;
+      }
+      tuning_table.entries = entries;
+      tuning_table.capacity = capacity;
+    }
+    entry = &tuning_table.entries[tuning_table.num_entries++];
+  }
+  *entry = *new_entry;
+  return xnn_status_success;
+}
+
+uint32_t xnn_gemm_tuning_look_up(enum xnn_operator_type operator_type, size_t m, size_t n, size_t k)
+{
+  XNN_INIT_ONCE(gemm_tuning);
+  const uint32_t hardware = xnn_gemm_tuning_hardware_fingerprint();
+  xnn_mutex_lock(&tuning_table.mutex);
+  const struct tuning_entry* entry = find_entry(hardware, operator_type, m, n, k);
+  const uint32_t mr = entry != NULL ? entry->mr : 0;
+  xnn_mutex_unlock(&tuning_table.mutex);
+  return mr;
+}
+
+enum xnn_status xnn_gemm_tuning_record(
+  enum xnn_operator_type operator_type, size_t m, size_t n, size_t k, uint32_t mr)
+{
+  XNN_INIT_ONCE(gemm_tuning);
+  const struct tuning_entry entry = {
+    .hardware = xnn_gemm_tuning_hardware_fingerprint(),
+    .operator_type = operator_type,
+    .m = m,
+    .n = n,
+    .k = k,
+    .mr = mr,
+  };
+  xnn_mutex_lock(&tuning_table.mutex);
+  const enum xnn_status status = insert_entry(&entry);
+  xnn_mutex_unlock(&tuning_table.mutex);
+  return status;
+}
+
+void xnn_gemm_tuning_clear(void)
+{
+  XNN_INIT_ONCE(gemm_tuning);
+  xnn_mutex_lock(&tuning_table.mutex);
+  xnn_release_memory(tuning_table.entries);
+  tuning_table.entries = NULL;
+  tuning_table.num_entries = 0;
+  tuning_table.capacity = 0;
+  xnn_mutex_unlock(&tuning_table.mutex);
+}
+
+static uint64_t read_timer_ns(void)
+{
+#if defined(__EMSCRIPTEN__)
+  return (uint64_t) (emscripten_get_now() * 1.0e6);
+#elif XNN_PLATFORM_WINDOWS
+  LARGE_INTEGER counter, frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (uint64_t) ((double) counter.QuadPart * 1.0e9 / (double) frequency.QuadPart);
+#else
+  struct timespec timestamp;
+  if (clock_gettime(CLOCK_MONOTONIC, &timestamp) != 0) {
+    return 0;
+  }
+  return (uint64_t) timestamp.tv_sec * UINT64_C(1000000000) + (uint64_t) timestamp.tv_nsec;
+#endif
+}
+
+// Returns the fastest of XNN_GEMM_TUNING_REPETITIONS runs of `ukernel` over `rows` x `columns` of the problem, in
+// nanoseconds.
+static uint64_t time_gemm_ukernel(
+  const struct xnn_gemm_tuning_problem* problem,
+  xnn_gemm_ukernel_fn ukernel,
+  uint32_t mr,
+  size_t rows,
+  size_t columns,
+  const void* input,
+  void* output)
+{
+  const size_t cm_stride = columns << problem->log2_output_element_size;
+  uint64_t best_time = UINT64_MAX;
+  // The first run warms up the caches and is not counted.
+  for (size_t r = 0; r <= XNN_GEMM_TUNING_REPETITIONS; r++) {
+    const uint64_t start = read_timer_ns();
+    for (size_t row = 0; row < rows; row += mr) {
+      ukernel(
+        min(mr, rows - row), columns, problem->k_scaled,
+        (const void*) ((uintptr_t) input + row * problem->k_scaled), problem->k_scaled,
+        problem->packed_weights,
+        (void*) ((uintptr_t) output + row * cm_stride), cm_stride,
+        problem->nr << problem->log2_output_element_size,
+        problem->params);
+    }
+    const uint64_t elapsed = read_timer_ns() - start;
+    if (r != 0 && elapsed < best_time) {
+      best_time = elapsed;
+    }
+  }
+  return best_time;
+}
+
+uint32_t xnn_gemm_tuning_select_mr(
+  const struct xnn_gemm_tuning_problem* problem,
+  const struct xnn_hmp_gemm_ukernel gemm_cases[XNN_MAX_MR],
+  uint32_t default_mr)
+{
+  const uint32_t tuned_mr = xnn_gemm_tuning_look_up(problem->operator_type, problem->m, problem->n, problem->k);
+  if (tuned_mr != 0 && tuned_mr <= XNN_MAX_MR && gemm_cases[tuned_mr - 1].function[XNN_UARCH_DEFAULT] != NULL) {
+    return tuned_mr;
+  }
+
+  size_t num_candidates = 0;
+  for (size_t i = 0; i < XNN_MAX_MR; i++) {
+    num_candidates += gemm_cases[i].function[XNN_UARCH_DEFAULT] != NULL;
+  }
+  if (num_candidates < 2) {
+    return default_mr;
+  }
+
+  const size_t rows = min(problem->m, XNN_GEMM_TUNING_MAX_ROWS);
+  const size_t columns = min(problem->n, XNN_GEMM_TUNING_MAX_COLUMNS);
+  const size_t input_size = rows * problem->k_scaled + XNN_EXTRA_BYTES;
+  const size_t output_size = (rows * columns) << problem->log2_output_element_size;
+  void* input = xnn_allocate_zero_memory(input_size);
+  void* output = xnn_allocate_memory(output_size);
+  if (input == NULL || output == NULL) {
+    xnn_log_warning("failed to allocate %zu bytes for GEMM tuning, using MR %" PRIu32,
+                    input_size + output_size, default_mr);
+    xnn_release_memory(input);
+    xnn_release_memory(output);
+    return default_mr;
+  }
+
+  uint32_t best_mr = default_mr;
+  uint64_t best_time = UINT64_MAX;
+  for (uint32_t mr = 1; mr <= XNN_MAX_MR; mr++) {
+    const xnn_gemm_ukernel_fn ukernel = gemm_cases[mr - 1].function[XNN_UARCH_DEFAULT];
+    if (ukernel == NULL) {
+      continue;
+    }
+    const uint64_t time = time_gemm_ukernel(problem, ukernel, mr, rows, columns, input, output);
+    xnn_log_debug("%s with M %zu, N %zu, K %zu: MR %" PRIu32 " takes %" PRIu64 " ns",
+                  xnn_operator_type_to_string(problem->operator_type), problem->m, problem->n, problem->k, mr, time);
+    if (time < best_time) {
+      best_time = time;
+      best_mr = mr;
+    }
+  }
+  xnn_release_memory(input);
+  xnn_release_memory(output);
+
+  xnn_log_info("tuned %s with M %zu, N %zu, K %zu: using MR %" PRIu32,
+               xnn_operator_type_to_string(problem->operator_type), problem->m, problem->n, problem->k, best_mr);
+  xnn_gemm_tuning_record(problem->operator_type, problem->m, problem->n, problem->k, best_mr);
+  return best_mr;
+}
+
+static bool operator_type_from_string(const char* string, enum xnn_operator_type* operator_type)
+{
+  #define XNN_ENUM_ITEM(enum_name, enum_string) \
+    if (strcmp(string, enum_string) == 0) {     \
+      *operator_type = enum_name;               \
+      return true;                              \
+    }
+  #include "xnnpack/operator-type-defs.h"
+  #undef XNN_ENUM_ITEM
+  return false;
+}
+
+enum xnn_status xnn_load_gemm_tuning_file(const char* path)
+{
+  if (path == NULL) {
+    xnn_log_error("failed to load GEMM tuning file: path is NULL");
+    return xnn_status_invalid_parameter;
+  }
+  XNN_INIT_ONCE(gemm_tuning);
+
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    xnn_log_error("failed to open GEMM tuning file %s", path);
+    return xnn_status_invalid_parameter;
+  }
+
+  enum xnn_status status = xnn_status_success;
+  char line[256];
+  if (fgets(line, sizeof(line), file) == NULL || strncmp(line, TUNING_FILE_HEADER, strlen(TUNING_FILE_HEADER)) != 0) {
+    xnn_log_error("failed to load GEMM tuning file %s: unsupported format", path);
+    status = xnn_status_invalid_parameter;
+    goto error;
+  }
+
+  size_t line_number = 1;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    line_number += 1;
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[0] == '\0') {
+      continue;
+    }
+    struct tuning_entry entry;
+    int operator_type_offset = 0;
+    if (sscanf(line, "%" SCNx32 " %zu %zu %zu %" SCNu32 " %n", &entry.hardware, &entry.m, &entry.n, &entry.k,
+               &entry.mr, &operator_type_offset) != 5 || operator_type_offset == 0 ||
+        !operator_type_from_string(line + operator_type_offset, &entry.operator_type) ||
+        entry.mr == 0 || entry.mr > XNN_MAX_MR) {
+      // Entries of operators of other XNNPACK versions are skipped rather than failing the whole file.
+      xnn_log_warning("skipping invalid entry at line %zu of GEMM tuning file %s", line_number, path);
+      continue;
+    }
+    xnn_mutex_lock(&tuning_table.mutex);
+    status = insert_entry(&entry);
+    xnn_mutex_unlock(&tuning_table.mutex);
+    if (status != xnn_status_success) {
+      goto error;
+    }
+  }
+
+error:
+  fclose(file);
+  return status;
+}
+
+enum xnn_status xnn_save_gemm_tuning_file(const char* path)
+{
+  if (path == NULL) {
+    xnn_log_error("failed to save GEMM tuning file: path is NULL");
+    return xnn_status_invalid_parameter;
+  }
+  XNN_INIT_ONCE(gemm_tuning);
+
+  FILE* file = fopen(path, "w");
+  if (file == NULL) {
+    xnn_log_error("failed to create GEMM tuning file %s", path);
+    return xnn_status_invalid_parameter;
+  }
+
+  xnn_mutex_lock(&tuning_table.mutex);
+  bool ok = fprintf(file, "%s\n", TUNING_FILE_HEADER) > 0;
+  for (size_t i = 0; ok && i < tuning_table.num_entries; i++) {
+    const struct tuning_entry* entry = &tuning_table.entries[i];
+    ok = fprintf(file, "%08" PRIx32 " %zu %zu %zu %" PRIu32 " %s\n", entry->hardware, entry->m, entry->n, entry->k,
+                 entry->mr, xnn_operator_type_to_string(entry->operator_type)) > 0;
+  }
+  xnn_mutex_unlock(&tuning_table.mutex);
+  if (fclose(file) != 0) {
+    ok = false;
+  }
+  if (!ok) {
+    xnn_log_error("failed to write GEMM tuning file %s", path);
+    return xnn_status_invalid_state;
+  }
+  return xnn_status_success;
+}
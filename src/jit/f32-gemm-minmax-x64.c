@@ -0,0 +1,406 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/cache.h"
+#include "xnnpack/common.h"
+#include "xnnpack/hardware-config.h"
+#include "xnnpack/jit.h"
+#include "xnnpack/log.h"
+#include "xnnpack/math.h"
+#include "xnnpack/microfnptr.h"
+#include "xnnpack/x64-assembler.h"
+
+// Register allocation of the generated kernel, see gemm_compiler/fma3_template.py.
+//
+// Arguments (System V): mr in rdi, nc in rsi, kc in rdx, a in rcx, a_stride in r8, w in r9, c, cm_stride, cn_stride
+// and params on the stack. kc, a_stride, cm_stride, cn_stride and params are ignored.
+//
+// rcx, rax, rdx, r8, r11, r12, r13, r14: A row pointers.
+// r9: packed weights, advanced through the whole panel.
+// r10: C, advanced by NR columns.
+// rbx, r15: C row pointers while storing.
+// rbp: K loop counter.
+// Vector registers: a row of weights, then the accumulators, then (AVX2 only) the broadcast of A. AVX512F kernels
+// broadcast A from memory in the FMA, and use k1 .. k4 as store masks for the last columns.
+static const enum xnn_x64_gp a_registers[8] = {
+  xnn_x64_rcx, xnn_x64_rax, xnn_x64_rdx, xnn_x64_r8, xnn_x64_r11, xnn_x64_r12, xnn_x64_r13, xnn_x64_r14,
+};
+
+static const enum xnn_x64_gp callee_saved_registers[6] = {
+  xnn_x64_rbx, xnn_x64_rbp, xnn_x64_r12, xnn_x64_r13, xnn_x64_r14, xnn_x64_r15,
+};
+
+bool xnn_jit_x64_isa_supported(enum xnn_jit_x64_isa isa)
+{
+  const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+  if (hardware_config == NULL) {
+    return false;
+  }
+  switch (isa) {
+    case xnn_jit_x64_isa_avx2:
+      return hardware_config->use_x86_avx2 && hardware_config->use_x86_fma3;
+    case xnn_jit_x64_isa_avx512f:
+      return hardware_config->use_x86_avx512f;
+  }
+  return false;
+}
+
+static size_t vector_elements(enum xnn_jit_x64_isa isa)
+{
+  return isa == xnn_jit_x64_isa_avx512f ? 16 : 8;
+}
+
+size_t xnn_jit_f32_gemm_max_mr(enum xnn_jit_x64_isa isa, size_t nr)
+{
+  const size_t elements = vector_elements(isa);
+  if (nr == 0 || nr % elements != 0) {
+    return 0;
+  }
+  const size_t nr_vectors = nr / elements;
+  size_t max_mr;
+  if (isa == xnn_jit_x64_isa_avx512f) {
+    // Accumulators and a row of weights must fit in 32 registers, and the store masks of the last columns in k1 .. k4.
+    if (nr_vectors > 4) {
+      return 0;
+    }
+    max_mr = (32 - nr_vectors) / nr_vectors;
+  } else {
+    // Accumulators, a row of weights and the broadcast of A must fit in 16 registers.
+    if (nr_vectors + 1 >= 16) {
+      return 0;
+    }
+    max_mr = (16 - nr_vectors - 1) / nr_vectors;
+  }
+  return min(max_mr, XNN_COUNT_OF(a_registers));
+}
+
+static uint32_t accumulator(size_t nr_vectors, size_t i, size_t j)
+{
+  return (uint32_t) (nr_vectors + i * nr_vectors + j);
+}
+
+// Multiply-accumulates one element of K, reading A at [a_i + a_disp] and weights at [w + w_disp].
+static void emit_k_step(
+  struct xnn_x64_assembler* a, enum xnn_jit_x64_isa isa, size_t mr, size_t nr_vectors, int32_t a_disp,
+  int32_t w_disp)
+{
+  if (isa == xnn_jit_x64_isa_avx512f) {
+    for (size_t j = 0; j < nr_vectors; j++) {
+      xnn_x64_vmovups_load_zmm(a, j, xnn_x64_r9, w_disp + (int32_t) (j * 64));
+    }
+    for (size_t i = 0; i < mr; i++) {
+      for (size_t j = 0; j < nr_vectors; j++) {
+        xnn_x64_vfmadd231ps_zmm_bcst(a, accumulator(nr_vectors, i, j), j, a_registers[i], a_disp);
+      }
+    }
+  } else {
+    const uint32_t a_broadcast = accumulator(nr_vectors, mr, 0);
+    for (size_t j = 0; j < nr_vectors; j++) {
+      xnn_x64_vmovups_load_ymm(a, j, xnn_x64_r9, w_disp + (int32_t) (j * 32));
+    }
+    for (size_t i = 0; i < mr; i++) {
+      xnn_x64_vbroadcastss_ymm_mem(a, a_broadcast, a_registers[i], a_disp);
+      for (size_t j = 0; j < nr_vectors; j++) {
+        xnn_x64_vfmadd231ps_ymm(a, accumulator(nr_vectors, i, j), a_broadcast, j);
+      }
+    }
+  }
+}
+
+// Points rbx to row i of C, or keeps it on the previous row if row i is past mr.
+static void emit_next_c_row(struct xnn_x64_assembler* a, size_t i, size_t cm_stride)
+{
+  if (i == 0) {
+    xnn_x64_mov_rr(a, xnn_x64_rbx, xnn_x64_r10);
+  } else {
+    xnn_x64_lea(a, xnn_x64_r15, xnn_x64_rbx, (int32_t) cm_stride);
+    xnn_x64_cmp_imm(a, xnn_x64_rdi, (int32_t) i);
+    xnn_x64_cmov(a, xnn_x64_cond_a, xnn_x64_rbx, xnn_x64_r15);
+  }
+}
+
+// Clamps the accumulators, using the first weights register as scratch.
+static void emit_clamp(
+  struct xnn_x64_assembler* a, enum xnn_jit_x64_isa isa, size_t mr, size_t nr_vectors, float value, bool is_min)
+{
+  const uint32_t scratch = 0;
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  xnn_x64_mov_r32_imm(a, xnn_x64_rbx, bits);
+  xnn_x64_vmovd_xmm_r32(a, scratch, xnn_x64_rbx);
+  if (isa == xnn_jit_x64_isa_avx512f) {
+    xnn_x64_vbroadcastss_zmm_xmm(a, scratch, scratch);
+  } else {
+    xnn_x64_vbroadcastss_ymm_xmm(a, scratch, scratch);
+  }
+  for (uint32_t r = accumulator(nr_vectors, 0, 0); r < accumulator(nr_vectors, mr, 0); r++) {
+    if (isa == xnn_jit_x64_isa_avx512f) {
+      if (is_min) {
+        xnn_x64_vmaxps_zmm(a, r, r, scratch);
+      } else {
+        xnn_x64_vminps_zmm(a, r, r, scratch);
+      }
+    } else {
+      if (is_min) {
+        xnn_x64_vmaxps_ymm(a, r, r, scratch);
+      } else {
+        xnn_x64_vminps_ymm(a, r, r, scratch);
+      }
+    }
+  }
+}
+
+// Stores the last nc < NR columns of AVX512F accumulators with masks. Clobbers rcx and rax, the first A row pointers.
+static void emit_masked_tail_avx512f(
+  struct xnn_x64_assembler* a, size_t mr, size_t nr_vectors, size_t cm_stride)
+{
+  // Mask of the nc columns: (1 << nc) - 1, 16 bits per opmask register.
+  xnn_x64_mov_rr(a, xnn_x64_rcx, xnn_x64_rsi);
+  xnn_x64_mov_r32_imm(a, xnn_x64_rax, 1);
+  xnn_x64_shl_cl(a, xnn_x64_rax);
+  xnn_x64_sub_imm(a, xnn_x64_rax, 1);
+  for (size_t j = 0; j < nr_vectors; j++) {
+    if (j != 0) {
+      xnn_x64_shr_imm(a, xnn_x64_rax, 16);
+    }
+    xnn_x64_kmovw(a, j + 1, xnn_x64_rax);
+  }
+  for (size_t i = 0; i < mr; i++) {
+    emit_next_c_row(a, i, cm_stride);
+    for (size_t j = 0; j < nr_vectors; j++) {
+      xnn_x64_vmovups_store_zmm(a, xnn_x64_rbx, (int32_t) (j * 64), accumulator(nr_vectors, i, j), j + 1);
+    }
+  }
+}
+
+// Stores the last nc < NR columns of AVX2 accumulators of each row in decreasing powers of 2.
+static void emit_tail_avx2(
+  struct xnn_x64_assembler* a, size_t mr, size_t nr, size_t cm_stride)
+{
+  const size_t nr_vectors = nr / 8;
+  for (size_t i = 0; i < mr; i++) {
+    emit_next_c_row(a, i, cm_stride);
+    xnn_x64_mov_rr(a, xnn_x64_r15, xnn_x64_rbx);
+    const uint32_t first = accumulator(nr_vectors, i, 0);
+    for (size_t columns = nr / 2; columns >= 8; columns /= 2) {
+      struct xnn_x64_label skip;
+      xnn_x64_label_init(&skip);
+      xnn_x64_test_imm(a, xnn_x64_rsi, (int32_t) columns);
+      xnn_x64_jcc(a, xnn_x64_cond_e, &skip);
+      const size_t vectors = columns / 8;
+      for (size_t j = 0; j < vectors; j++) {
+        xnn_x64_vmovups_store_ymm(a, xnn_x64_r15, (int32_t) (j * 32), first + j);
+      }
+      for (size_t j = 0; j + vectors < nr_vectors; j++) {
+        xnn_x64_vmovaps_ymm(a, first + j, first + j + vectors);
+      }
+      xnn_x64_add_imm(a, xnn_x64_r15, (int32_t) (columns * sizeof(float)));
+      xnn_x64_bind(a, &skip);
+    }
+
+    struct xnn_x64_label skip4, skip2, skip1;
+    xnn_x64_label_init(&skip4);
+    xnn_x64_label_init(&skip2);
+    xnn_x64_label_init(&skip1);
+    xnn_x64_test_imm(a, xnn_x64_rsi, 4);
+    xnn_x64_jcc(a, xnn_x64_cond_e, &skip4);
+    xnn_x64_vmovups_store_xmm(a, xnn_x64_r15, 0, first);
+    xnn_x64_vextractf128(a, first, first, 1);
+    xnn_x64_add_imm(a, xnn_x64_r15, 4 * sizeof(float));
+    xnn_x64_bind(a, &skip4);
+    xnn_x64_test_imm(a, xnn_x64_rsi, 2);
+    xnn_x64_jcc(a, xnn_x64_cond_e, &skip2);
+    xnn_x64_vmovlps_store(a, xnn_x64_r15, 0, first);
+    xnn_x64_vmovhlps(a, first, first, first);
+    xnn_x64_add_imm(a, xnn_x64_r15, 2 * sizeof(float));
+    xnn_x64_bind(a, &skip2);
+    xnn_x64_test_imm(a, xnn_x64_rsi, 1);
+    xnn_x64_jcc(a, xnn_x64_cond_e, &skip1);
+    xnn_x64_vmovss_store(a, xnn_x64_r15, 0, first);
+    xnn_x64_bind(a, &skip1);
+  }
+}
+
+enum xnn_status xnn_generate_f32_gemm_minmax_x64(
+  struct xnn_x64_assembler* a,
+  const struct xnn_jit_f32_gemm_params* params)
+{
+  const enum xnn_jit_x64_isa isa = params->isa;
+  const size_t mr = params->mr;
+  const size_t nr = params->nr;
+  const size_t kc = params->kc;
+  if (mr == 0 || mr > xnn_jit_f32_gemm_max_mr(isa, nr) || kc == 0) {
+    xnn_log_debug("can not generate F32 GEMM microkernel with MR %zu, NR %zu and K %zu", mr, nr, kc);
+    return xnn_status_unsupported_parameter;
+  }
+  // All displacements must fit in 32 bits.
+  if (params->a_stride > INT32_MAX / XNN_COUNT_OF(a_registers) || params->cm_stride > INT32_MAX ||
+      kc > INT32_MAX / (nr * sizeof(float)) - 1) {
+    xnn_log_debug("can not generate F32 GEMM microkernel with A stride %zu, C stride %zu and K %zu",
+                  params->a_stride, params->cm_stride, kc);
+    return xnn_status_unsupported_parameter;
+  }
+
+  const size_t nr_vectors = nr / vector_elements(isa);
+  const int32_t vector_size = (int32_t) (vector_elements(isa) * sizeof(float));
+  const int32_t w_row_size = (int32_t) (nr * sizeof(float));
+  const size_t k_iterations = kc > XNN_JIT_GEMM_MAX_UNROLLED_KC ? kc / XNN_JIT_GEMM_K_UNROLL : 0;
+  const size_t k_remainder = kc - k_iterations * XNN_JIT_GEMM_K_UNROLL;
+
+  struct xnn_x64_label outer_loop, k_loop, tail, exit;
+  xnn_x64_label_init(&outer_loop);
+  xnn_x64_label_init(&k_loop);
+  xnn_x64_label_init(&tail);
+  xnn_x64_label_init(&exit);
+
+  // C is the first argument on the stack, above the return address.
+  xnn_x64_mov_rm(a, xnn_x64_r10, xnn_x64_rsp, 8);
+  for (size_t r = 0; r < XNN_COUNT_OF(callee_saved_registers); r++) {
+    xnn_x64_push(a, callee_saved_registers[r]);
+  }
+
+  // Rows past mr read the last row of A.
+  for (size_t i = 1; i < mr; i++) {
+    xnn_x64_lea(a, a_registers[i], a_registers[i - 1], (int32_t) params->a_stride);
+    xnn_x64_cmp_imm(a, xnn_x64_rdi, (int32_t) i);
+    xnn_x64_cmov(a, xnn_x64_cond_be, a_registers[i], a_registers[i - 1]);
+  }
+
+  xnn_x64_bind(a, &outer_loop);
+  // Initialize the accumulators with the bias.
+  for (size_t j = 0; j < nr_vectors; j++) {
+    if (isa == xnn_jit_x64_isa_avx512f) {
+      xnn_x64_vmovups_load_zmm(a, accumulator(nr_vectors, 0, j), xnn_x64_r9, (int32_t) j * vector_size);
+    } else {
+      xnn_x64_vmovups_load_ymm(a, accumulator(nr_vectors, 0, j), xnn_x64_r9, (int32_t) j * vector_size);
+    }
+  }
+  for (size_t i = 1; i < mr; i++) {
+    for (size_t j = 0; j < nr_vectors; j++) {
+      if (isa == xnn_jit_x64_isa_avx512f) {
+        xnn_x64_vmovaps_zmm(a, accumulator(nr_vectors, i, j), accumulator(nr_vectors, 0, j));
+      } else {
+        xnn_x64_vmovaps_ymm(a, accumulator(nr_vectors, i, j), accumulator(nr_vectors, 0, j));
+      }
+    }
+  }
+  xnn_x64_add_imm(a, xnn_x64_r9, w_row_size);
+
+  if (k_iterations != 0) {
+    xnn_x64_mov_r32_imm(a, xnn_x64_rbp, (uint32_t) k_iterations);
+    xnn_x64_bind(a, &k_loop);
+    for (size_t k = 0; k < XNN_JIT_GEMM_K_UNROLL; k++) {
+      emit_k_step(a, isa, mr, nr_vectors, (int32_t) (k * sizeof(float)), (int32_t) k * w_row_size);
+    }
+    xnn_x64_add_imm(a, xnn_x64_r9, XNN_JIT_GEMM_K_UNROLL * w_row_size);
+    for (size_t i = 0; i < mr; i++) {
+      xnn_x64_add_imm(a, a_registers[i], XNN_JIT_GEMM_K_UNROLL * sizeof(float));
+    }
+    xnn_x64_sub_imm(a, xnn_x64_rbp, 1);
+    xnn_x64_jcc(a, xnn_x64_cond_ne, &k_loop);
+  }
+  for (size_t k = 0; k < k_remainder; k++) {
+    emit_k_step(a, isa, mr, nr_vectors, (int32_t) (k * sizeof(float)), (int32_t) k * w_row_size);
+  }
+  if (k_remainder != 0) {
+    xnn_x64_add_imm(a, xnn_x64_r9, (int32_t) k_remainder * w_row_size);
+  }
+  if (k_iterations != 0) {
+    // Rewind A for the next NR columns.
+    for (size_t i = 0; i < mr; i++) {
+      xnn_x64_sub_imm(a, a_registers[i], (int32_t) (k_iterations * XNN_JIT_GEMM_K_UNROLL * sizeof(float)));
+    }
+  }
+
+  if (params->min != -INFINITY) {
+    emit_clamp(a, isa, mr, nr_vectors, params->min, /*is_min=*/true);
+  }
+  if (params->max != INFINITY) {
+    emit_clamp(a, isa, mr, nr_vectors, params->max, /*is_min=*/false);
+  }
+
+  xnn_x64_cmp_imm(a, xnn_x64_rsi, (int32_t) nr);
+  xnn_x64_jcc(a, xnn_x64_cond_b, &tail);
+  for (size_t i = 0; i < mr; i++) {
+    emit_next_c_row(a, i, params->cm_stride);
+    for (size_t j = 0; j < nr_vectors; j++) {
+      if (isa == xnn_jit_x64_isa_avx512f) {
+        xnn_x64_vmovups_store_zmm(a, xnn_x64_rbx, (int32_t) j * vector_size, accumulator(nr_vectors, i, j), 0);
+      } else {
+        xnn_x64_vmovups_store_ymm(a, xnn_x64_rbx, (int32_t) j * vector_size, accumulator(nr_vectors, i, j));
+      }
+    }
+  }
+  xnn_x64_add_imm(a, xnn_x64_r10, w_row_size);
+  xnn_x64_sub_imm(a, xnn_x64_rsi, (int32_t) nr);
+  xnn_x64_jcc(a, xnn_x64_cond_ne, &outer_loop);
+  xnn_x64_jmp(a, &exit);
+
+  // Fewer than NR columns are left.
+  xnn_x64_bind(a, &tail);
+  if (isa == xnn_jit_x64_isa_avx512f) {
+    emit_masked_tail_avx512f(a, mr, nr_vectors, params->cm_stride);
+  } else {
+    emit_tail_avx2(a, mr, nr, params->cm_stride);
+  }
+
+  xnn_x64_bind(a, &exit);
+  xnn_x64_vzeroupper(a);
+  for (size_t r = XNN_COUNT_OF(callee_saved_registers); r != 0; r--) {
+    xnn_x64_pop(a, callee_saved_registers[r - 1]);
+  }
+  xnn_x64_ret(a);
+
+  if (a->error) {
+    return xnn_status_out_of_memory;
+  }
+  return xnn_status_success;
+}
+
+xnn_f32_gemm_minmax_ukernel_fn xnn_jit_f32_gemm_minmax(
+  struct xnn_code_cache* code_cache,
+  const struct xnn_jit_f32_gemm_params* params)
+{
+#if XNN_ENABLE_JIT
+  if (!xnn_jit_x64_isa_supported(params->isa)) {
+    return NULL;
+  }
+
+  // Clear the padding, the key is compared bytewise.
+  struct xnn_jit_f32_gemm_params key;
+  memset(&key, 0, sizeof(key));
+  key.isa = params->isa;
+  key.mr = params->mr;
+  key.nr = params->nr;
+  key.kc = params->kc;
+  key.a_stride = params->a_stride;
+  key.cm_stride = params->cm_stride;
+  key.min = params->min;
+  key.max = params->max;
+
+  const void* code = xnn_code_cache_look_up(code_cache, &key, sizeof(key));
+  if (code == NULL) {
+    struct xnn_x64_assembler a;
+    xnn_x64_assembler_init(&a);
+    if (xnn_generate_f32_gemm_minmax_x64(&a, &key) == xnn_status_success) {
+      code = xnn_code_cache_insert(code_cache, &key, sizeof(key), a.code, a.size);
+      xnn_log_debug("generated F32 GEMM microkernel with MR %zu, NR %zu and K %zu: %zu bytes",
+                    key.mr, key.nr, key.kc, a.size);
+    }
+    xnn_x64_assembler_release(&a);
+  }
+  return (xnn_f32_gemm_minmax_ukernel_fn) (uintptr_t) code;
+#else
+  return NULL;
+#endif
+}
@@ -0,0 +1,495 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xnnpack/allocator.h"
+#include "xnnpack/log.h"
+#include "xnnpack/x64-assembler.h"
+
+// VEX opcode maps.
+enum vex_map {
+  vex_map_0f = 1,
+  vex_map_0f38 = 2,
+  vex_map_0f3a = 3,
+};
+
+// VEX implied mandatory prefixes.
+enum vex_pp {
+  vex_pp_none = 0,
+  vex_pp_66 = 1,
+  vex_pp_f3 = 2,
+};
+
+void xnn_x64_assembler_init(struct xnn_x64_assembler* a)
+{
+  memset(a, 0, sizeof(struct xnn_x64_assembler));
+}
+
+void xnn_x64_assembler_release(struct xnn_x64_assembler* a)
+{
+  xnn_release_memory(a->code);
+  memset(a, 0, sizeof(struct xnn_x64_assembler));
+}
+
+static void emit8(struct xnn_x64_assembler* a, uint8_t value)
+{
+  if XNN_UNLIKELY(a->size == a->capacity) {
+    if (a->error) {
+      return;
+    }
+    const size_t capacity = a->capacity == 0 ? 4096 : a->capacity * 2;
+    uint8_t* code = xnn_reallocate_memory(a->code, capacity);
+    if (code == NULL) {
+      xnn_log_error("failed to allocate %zu bytes for generated code", capacity);
+      a->error = true;
+      return;
+    }
+    a->code = code;
+    a->capacity = capacity;
+  }
+  a->code[a->size++] = value;
+}
+
+static void emit32(struct xnn_x64_assembler* a, uint32_t value)
+{
+  for (size_t i = 0; i < 4; i++) {
+    emit8(a, (uint8_t) (value >> (i * 8)));
+  }
+}
+
+static bool is_int8(int32_t value)
+{
+  return value >= INT8_MIN && value <= INT8_MAX;
+}
+
+// REX prefix, omitted when it has no bits set.
+static void emit_rex(struct xnn_x64_assembler* a, bool w, uint32_t reg, uint32_t rm)
+{
+  const uint8_t rex = 0x40 | ((uint8_t) w << 3) | (((reg >> 3) & 1) << 2) | ((rm >> 3) & 1);
+  if (rex != 0x40) {
+    emit8(a, rex);
+  }
+}
+
+// Three-byte VEX prefix.
+static void emit_vex(
+  struct xnn_x64_assembler* a, enum vex_map map, enum vex_pp pp, bool l256, uint32_t reg, uint32_t vvvv, uint32_t rm)
+{
+  assert(reg < 16);
+  assert(vvvv < 16);
+  assert(rm < 16);
+  emit8(a, 0xC4);
+  // R, X and B are stored inverted.
+  emit8(a, (((~reg >> 3) & 1) << 7) | (1 << 6) | (((~rm >> 3) & 1) << 5) | (uint8_t) map);
+  // W is always 0 for the instructions used here, vvvv is stored inverted.
+  emit8(a, ((~vvvv & 0xF) << 3) | ((uint8_t) l256 << 2) | (uint8_t) pp);
+}
+
+// Four-byte EVEX prefix for 512-bit operations. `rm` is a vector register if `rm_is_vector`, otherwise the base of a
+// memory operand.
+static void emit_evex(
+  struct xnn_x64_assembler* a, enum vex_map map, enum vex_pp pp, uint32_t reg, uint32_t vvvv, uint32_t rm,
+  bool rm_is_vector, uint32_t mask, bool broadcast)
+{
+  assert(reg < 32);
+  assert(vvvv < 32);
+  assert(rm < 32);
+  assert(mask < 8);
+  emit8(a, 0x62);
+  // R, X, B, R' are stored inverted, X extends vector registers in ModR/M rm to 32.
+  const uint32_t x = rm_is_vector ? (~rm >> 4) & 1 : 1;
+  emit8(a, (((~reg >> 3) & 1) << 7) | (x << 6) | (((~rm >> 3) & 1) << 5) | (((~reg >> 4) & 1) << 4) | (uint8_t) map);
+  // W is always 0 for the instructions used here, vvvv is stored inverted.
+  emit8(a, ((~vvvv & 0xF) << 3) | (1 << 2) | (uint8_t) pp);
+  // L'L = 2 for 512-bit vectors, V' is stored inverted.
+  emit8(a, (2 << 5) | ((uint8_t) broadcast << 4) | (((~vvvv >> 4) & 1) << 3) | mask);
+}
+
+static void emit_modrm_reg(struct xnn_x64_assembler* a, uint32_t reg, uint32_t rm)
+{
+  emit8(a, 0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+static void emit_modrm_mem(struct xnn_x64_assembler* a, uint32_t reg, enum xnn_x64_gp base, int32_t disp)
+{
+  const uint32_t rm = (uint32_t) base & 7;
+  // [rbp] and [r13] have no encoding without displacement.
+  if (disp == 0 && rm != 5) {
+    emit8(a, 0x00 | ((reg & 7) << 3) | rm);
+  } else if (is_int8(disp)) {
+    emit8(a, 0x40 | ((reg & 7) << 3) | rm);
+  } else {
+    emit8(a, 0x80 | ((reg & 7) << 3) | rm);
+  }
+  // [rsp] and [r12] need a SIB byte.
+  if (rm == 4) {
+    emit8(a, 0x24);
+  }
+  if (disp == 0 && rm != 5) {
+    return;
+  } else if (is_int8(disp)) {
+    emit8(a, (uint8_t) (int8_t) disp);
+  } else {
+    emit32(a, (uint32_t) disp);
+  }
+}
+
+// ModR/M for EVEX memory operands, where 8-bit displacements are scaled by the size `n` of the memory operand.
+static void emit_modrm_mem_evex(struct xnn_x64_assembler* a, uint32_t reg, enum xnn_x64_gp base, int32_t disp, int32_t n)
+{
+  const uint32_t rm = (uint32_t) base & 7;
+  const bool compressed = disp % n == 0 && is_int8(disp / n);
+  if (disp == 0 && rm != 5) {
+    emit8(a, 0x00 | ((reg & 7) << 3) | rm);
+  } else if (compressed) {
+    emit8(a, 0x40 | ((reg & 7) << 3) | rm);
+  } else {
+    emit8(a, 0x80 | ((reg & 7) << 3) | rm);
+  }
+  if (rm == 4) {
+    emit8(a, 0x24);
+  }
+  if (disp == 0 && rm != 5) {
+    return;
+  } else if (compressed) {
+    emit8(a, (uint8_t) (int8_t) (disp / n));
+  } else {
+    emit32(a, (uint32_t) disp);
+  }
+}
+
+void xnn_x64_label_init(struct xnn_x64_label* label)
+{
+  label->offset = SIZE_MAX;
+  label->num_users = 0;
+}
+
+static void patch_rel32(struct xnn_x64_assembler* a, size_t rel32_offset, size_t target)
+{
+  const int32_t rel = (int32_t) ((ptrdiff_t) target - (ptrdiff_t) (rel32_offset + 4));
+  for (size_t i = 0; i < 4; i++) {
+    a->code[rel32_offset + i] = (uint8_t) ((uint32_t) rel >> (i * 8));
+  }
+}
+
+void xnn_x64_bind(struct xnn_x64_assembler* a, struct xnn_x64_label* label)
+{
+  assert(label->offset == SIZE_MAX);
+  label->offset = a->size;
+  if (a->error) {
+    return;
+  }
+  for (size_t i = 0; i < label->num_users; i++) {
+    patch_rel32(a, label->users[i], label->offset);
+  }
+  label->num_users = 0;
+}
+
+static void emit_rel32(struct xnn_x64_assembler* a, struct xnn_x64_label* label)
+{
+  const size_t rel32_offset = a->size;
+  emit32(a, 0);
+  if (a->error) {
+    return;
+  }
+  if (label->offset != SIZE_MAX) {
+    patch_rel32(a, rel32_offset, label->offset);
+  } else if (label->num_users < XNN_X64_MAX_LABEL_USERS) {
+    label->users[label->num_users++] = rel32_offset;
+  } else {
+    xnn_log_error("failed to generate code: too many branches to an unbound label");
+    a->error = true;
+  }
+}
+
+void xnn_x64_push(struct xnn_x64_assembler* a, enum xnn_x64_gp reg)
+{
+  emit_rex(a, /*w=*/false, 0, reg);
+  emit8(a, 0x50 | (reg & 7));
+}
+
+void xnn_x64_pop(struct xnn_x64_assembler* a, enum xnn_x64_gp reg)
+{
+  emit_rex(a, /*w=*/false, 0, reg);
+  emit8(a, 0x58 | (reg & 7));
+}
+
+void xnn_x64_ret(struct xnn_x64_assembler* a)
+{
+  emit8(a, 0xC3);
+}
+
+void xnn_x64_mov_rr(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, enum xnn_x64_gp src)
+{
+  emit_rex(a, /*w=*/true, src, dst);
+  emit8(a, 0x89);
+  emit_modrm_reg(a, src, dst);
+}
+
+void xnn_x64_mov_rm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, enum xnn_x64_gp base, int32_t disp)
+{
+  emit_rex(a, /*w=*/true, dst, base);
+  emit8(a, 0x8B);
+  emit_modrm_mem(a, dst, base, disp);
+}
+
+void xnn_x64_mov_r32_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, uint32_t imm)
+{
+  emit_rex(a, /*w=*/false, 0, dst);
+  emit8(a, 0xB8 | (dst & 7));
+  emit32(a, imm);
+}
+
+void xnn_x64_lea(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, enum xnn_x64_gp base, int32_t disp)
+{
+  emit_rex(a, /*w=*/true, dst, base);
+  emit8(a, 0x8D);
+  emit_modrm_mem(a, dst, base, disp);
+}
+
+// ADD/SUB/CMP r64, imm with the opcode extension in the ModR/M reg field.
+static void emit_alu_imm(struct xnn_x64_assembler* a, uint32_t extension, enum xnn_x64_gp reg, int32_t imm)
+{
+  emit_rex(a, /*w=*/true, 0, reg);
+  if (is_int8(imm)) {
+    emit8(a, 0x83);
+    emit_modrm_reg(a, extension, reg);
+    emit8(a, (uint8_t) (int8_t) imm);
+  } else {
+    emit8(a, 0x81);
+    emit_modrm_reg(a, extension, reg);
+    emit32(a, (uint32_t) imm);
+  }
+}
+
+void xnn_x64_add_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, int32_t imm)
+{
+  emit_alu_imm(a, 0, dst, imm);
+}
+
+void xnn_x64_sub_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, int32_t imm)
+{
+  emit_alu_imm(a, 5, dst, imm);
+}
+
+void xnn_x64_cmp_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp reg, int32_t imm)
+{
+  emit_alu_imm(a, 7, reg, imm);
+}
+
+void xnn_x64_test_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp reg, int32_t imm)
+{
+  emit_rex(a, /*w=*/true, 0, reg);
+  emit8(a, 0xF7);
+  emit_modrm_reg(a, 0, reg);
+  emit32(a, (uint32_t) imm);
+}
+
+void xnn_x64_shl_cl(struct xnn_x64_assembler* a, enum xnn_x64_gp reg)
+{
+  emit_rex(a, /*w=*/true, 0, reg);
+  emit8(a, 0xD3);
+  emit_modrm_reg(a, 4, reg);
+}
+
+void xnn_x64_shr_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp reg, uint8_t imm)
+{
+  emit_rex(a, /*w=*/true, 0, reg);
+  emit8(a, 0xC1);
+  emit_modrm_reg(a, 5, reg);
+  emit8(a, imm);
+}
+
+void xnn_x64_cmov(struct xnn_x64_assembler* a, enum xnn_x64_cond cond, enum xnn_x64_gp dst, enum xnn_x64_gp src)
+{
+  emit_rex(a, /*w=*/true, dst, src);
+  emit8(a, 0x0F);
+  emit8(a, 0x40 | (uint8_t) cond);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_jcc(struct xnn_x64_assembler* a, enum xnn_x64_cond cond, struct xnn_x64_label* label)
+{
+  emit8(a, 0x0F);
+  emit8(a, 0x80 | (uint8_t) cond);
+  emit_rel32(a, label);
+}
+
+void xnn_x64_jmp(struct xnn_x64_assembler* a, struct xnn_x64_label* label)
+{
+  emit8(a, 0xE9);
+  emit_rel32(a, label);
+}
+
+void xnn_x64_vzeroupper(struct xnn_x64_assembler* a)
+{
+  emit8(a, 0xC5);
+  emit8(a, 0xF8);
+  emit8(a, 0x77);
+}
+
+void xnn_x64_vmovups_load_ymm(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp base, int32_t disp)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/true, dst, 0, base);
+  emit8(a, 0x10);
+  emit_modrm_mem(a, dst, base, disp);
+}
+
+void xnn_x64_vmovups_store_ymm(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/true, src, 0, base);
+  emit8(a, 0x11);
+  emit_modrm_mem(a, src, base, disp);
+}
+
+void xnn_x64_vmovups_store_xmm(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/false, src, 0, base);
+  emit8(a, 0x11);
+  emit_modrm_mem(a, src, base, disp);
+}
+
+void xnn_x64_vmovlps_store(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/false, src, 0, base);
+  emit8(a, 0x13);
+  emit_modrm_mem(a, src, base, disp);
+}
+
+void xnn_x64_vmovss_store(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src)
+{
+  emit_vex(a, vex_map_0f, vex_pp_f3, /*l256=*/false, src, 0, base);
+  emit8(a, 0x11);
+  emit_modrm_mem(a, src, base, disp);
+}
+
+void xnn_x64_vmovaps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/true, dst, 0, src);
+  emit8(a, 0x28);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_vmovhlps(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/false, dst, src1, src2);
+  emit8(a, 0x12);
+  emit_modrm_reg(a, dst, src2);
+}
+
+void xnn_x64_vmovd_xmm_r32(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp src)
+{
+  emit_vex(a, vex_map_0f, vex_pp_66, /*l256=*/false, dst, 0, src);
+  emit8(a, 0x6E);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_vbroadcastss_ymm_mem(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp base, int32_t disp)
+{
+  emit_vex(a, vex_map_0f38, vex_pp_66, /*l256=*/true, dst, 0, base);
+  emit8(a, 0x18);
+  emit_modrm_mem(a, dst, base, disp);
+}
+
+void xnn_x64_vbroadcastss_ymm_xmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src)
+{
+  emit_vex(a, vex_map_0f38, vex_pp_66, /*l256=*/true, dst, 0, src);
+  emit8(a, 0x18);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_vextractf128(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src, uint8_t imm)
+{
+  // The source YMM register is in the ModR/M reg field.
+  emit_vex(a, vex_map_0f3a, vex_pp_66, /*l256=*/true, src, 0, dst);
+  emit8(a, 0x19);
+  emit_modrm_reg(a, src, dst);
+  emit8(a, imm);
+}
+
+void xnn_x64_vfmadd231ps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2)
+{
+  emit_vex(a, vex_map_0f38, vex_pp_66, /*l256=*/true, dst, src1, src2);
+  emit8(a, 0xB8);
+  emit_modrm_reg(a, dst, src2);
+}
+
+void xnn_x64_vmaxps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/true, dst, src1, src2);
+  emit8(a, 0x5F);
+  emit_modrm_reg(a, dst, src2);
+}
+
+void xnn_x64_vminps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2)
+{
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/true, dst, src1, src2);
+  emit8(a, 0x5D);
+  emit_modrm_reg(a, dst, src2);
+}
+
+void xnn_x64_kmovw(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp src)
+{
+  assert(dst < 8);
+  emit_vex(a, vex_map_0f, vex_pp_none, /*l256=*/false, dst, 0, src);
+  emit8(a, 0x92);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_vmovups_load_zmm(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp base, int32_t disp)
+{
+  emit_evex(a, vex_map_0f, vex_pp_none, dst, 0, base, /*rm_is_vector=*/false, /*mask=*/0, /*broadcast=*/false);
+  emit8(a, 0x10);
+  emit_modrm_mem_evex(a, dst, base, disp, 64);
+}
+
+void xnn_x64_vmovups_store_zmm(
+  struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src, uint32_t mask)
+{
+  emit_evex(a, vex_map_0f, vex_pp_none, src, 0, base, /*rm_is_vector=*/false, mask, /*broadcast=*/false);
+  emit8(a, 0x11);
+  emit_modrm_mem_evex(a, src, base, disp, 64);
+}
+
+void xnn_x64_vmovaps_zmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src)
+{
+  emit_evex(a, vex_map_0f, vex_pp_none, dst, 0, src, /*rm_is_vector=*/true, /*mask=*/0, /*broadcast=*/false);
+  emit8(a, 0x28);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_vbroadcastss_zmm_xmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src)
+{
+  emit_evex(a, vex_map_0f38, vex_pp_66, dst, 0, src, /*rm_is_vector=*/true, /*mask=*/0, /*broadcast=*/false);
+  emit8(a, 0x18);
+  emit_modrm_reg(a, dst, src);
+}
+
+void xnn_x64_vfmadd231ps_zmm_bcst(
+  struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, enum xnn_x64_gp base, int32_t disp)
+{
+  emit_evex(a, vex_map_0f38, vex_pp_66, dst, src1, base, /*rm_is_vector=*/false, /*mask=*/0, /*broadcast=*/true);
+  emit8(a, 0xB8);
+  emit_modrm_mem_evex(a, dst, base, disp, 4);
+}
+
+void xnn_x64_vmaxps_zmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2)
+{
+  emit_evex(a, vex_map_0f, vex_pp_none, dst, src1, src2, /*rm_is_vector=*/true, /*mask=*/0, /*broadcast=*/false);
+  emit8(a, 0x5F);
+  emit_modrm_reg(a, dst, src2);
+}
+
+void xnn_x64_vminps_zmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2)
+{
+  emit_evex(a, vex_map_0f, vex_pp_none, dst, src1, src2, /*rm_is_vector=*/true, /*mask=*/0, /*broadcast=*/false);
+  emit8(a, 0x5D);
+  emit_modrm_reg(a, dst, src2);
+}
@@ -10,6 +10,7 @@
 
 #include "xnnpack.h"
 #include "xnnpack/allocator.h"
+#include "xnnpack/math.h"
 #include "xnnpack/memory-planner.h"
 #include "xnnpack/subgraph.h"
 
@@ -96,24 +97,12 @@ static inline int cmp_memory_block(const void* a, const void* b) {
   return (start_a > start_b) - (start_a < start_b);
 }
 
-// Given the current live memory blocks, return the offset in a memory arena for a to-be-allocated value of size
-// 'to_alloc_size'.
-static size_t find_value_alloc_offset(struct memory_block* live_mem_blocks,
-                                      size_t num_mem_blocks,
-                                      size_t to_alloc_size) {
-  if (num_mem_blocks == 0) {
-    return 0;
-  }
-
-  if (num_mem_blocks == 1) {
-    return live_mem_blocks[0].end;
-  }
-
-  // Sort memory blocks according to 'start' in increasing order.
+// Sort memory blocks according to 'start' in increasing order, and coalesce overlapping or immediate adjacent memory
+// blocks to form a list of non-overlapping memory blocks. Returns the number of coalesced memory blocks.
+static size_t coalesce_mem_blocks(struct memory_block* live_mem_blocks, size_t num_mem_blocks) {
+  assert(num_mem_blocks != 0);
   qsort(live_mem_blocks, num_mem_blocks, sizeof(struct memory_block), cmp_memory_block);
 
-  // Coalesce overlapping or immediate adjacent memory blocks to form a list of non-overlapping memory blocks in order
-  // to find the smallest gap.
   size_t num_coalesced_mem_blocks = 1;
   for (size_t i = 1; i < num_mem_blocks; ++i) {
     const size_t current_coalesced_end =
@@ -128,6 +117,24 @@ static size_t find_value_alloc_offset(struct memory_block* live_mem_blocks,
       live_mem_blocks[num_coalesced_mem_blocks - 1].end = live_mem_blocks[i].end;
     }
   }
+  return num_coalesced_mem_blocks;
+}
+
+// Given the current live memory blocks, return the offset in a memory arena for a to-be-allocated value of size
+// 'to_alloc_size'.
+static size_t find_value_alloc_offset(struct memory_block* live_mem_blocks,
+                                      size_t num_mem_blocks,
+                                      size_t to_alloc_size) {
+  if (num_mem_blocks == 0) {
+    return 0;
+  }
+
+  if (num_mem_blocks == 1) {
+    return live_mem_blocks[0].end;
+  }
+
+  // Coalesce the memory blocks in order to find the smallest gap.
+  const size_t num_coalesced_mem_blocks = coalesce_mem_blocks(live_mem_blocks, num_mem_blocks);
 
   size_t smallest_gap_size = SIZE_MAX;
   // The first index to live_mem_blocks that the 'to_alloc_size' should be allocated after.
@@ -143,6 +150,70 @@ static size_t find_value_alloc_offset(struct memory_block* live_mem_blocks,
   return live_mem_blocks[smallest_gap_index].end;
 }
 
+// Same as find_value_alloc_offset, but also considers the gap between the start of the memory arena and the first
+// live memory block.
+static size_t find_best_fit_value_alloc_offset(struct memory_block* live_mem_blocks,
+                                               size_t num_mem_blocks,
+                                               size_t to_alloc_size) {
+  if (num_mem_blocks == 0) {
+    return 0;
+  }
+
+  const size_t num_coalesced_mem_blocks = coalesce_mem_blocks(live_mem_blocks, num_mem_blocks);
+
+  size_t smallest_gap_size = SIZE_MAX;
+  size_t smallest_gap_offset = live_mem_blocks[num_coalesced_mem_blocks - 1].end;
+  size_t gap_start = 0;
+  for (size_t i = 0; i < num_coalesced_mem_blocks; ++i) {
+    const size_t gap = live_mem_blocks[i].start - gap_start;
+    if (gap >= to_alloc_size && gap < smallest_gap_size) {
+      smallest_gap_offset = gap_start;
+      smallest_gap_size = gap;
+    }
+    gap_start = live_mem_blocks[i].end;
+  }
+  return smallest_gap_offset;
+}
+
+// Given the current live memory blocks, return the lowest offset in a memory arena where a value of size
+// 'to_alloc_size' fits.
+static size_t find_lowest_value_alloc_offset(struct memory_block* live_mem_blocks,
+                                             size_t num_mem_blocks,
+                                             size_t to_alloc_size) {
+  if (num_mem_blocks == 0) {
+    return 0;
+  }
+
+  const size_t num_coalesced_mem_blocks = coalesce_mem_blocks(live_mem_blocks, num_mem_blocks);
+
+  size_t gap_start = 0;
+  for (size_t i = 0; i < num_coalesced_mem_blocks; ++i) {
+    if (live_mem_blocks[i].start - gap_start >= to_alloc_size) {
+      break;
+    }
+    gap_start = live_mem_blocks[i].end;
+  }
+  return gap_start;
+}
+
+// Collect the memory blocks of the 'allocated' values whose lifecycle overlaps with 'current', and return the number of
+// collected memory blocks. 'current' itself is skipped if it is one of the allocated values.
+static size_t collect_live_mem_blocks(const struct xnn_usage_record* current,
+                                      struct xnn_usage_record* const* allocated,
+                                      size_t num_allocated,
+                                      struct memory_block* live_mem_blocks) {
+  size_t num_live_mem_blocks = 0;
+  for (size_t j = 0; j < num_allocated; ++j) {
+    if (allocated[j] != current && value_lifecycle_overlap(current, allocated[j])) {
+      live_mem_blocks[num_live_mem_blocks++] = (struct memory_block){
+          .start = allocated[j]->alloc_offset,
+          .end = allocated[j]->alloc_offset + allocated[j]->tensor_size,
+      };
+    }
+  }
+  return num_live_mem_blocks;
+}
+
 void xnn_init_value_allocation_tracker(
   struct xnn_value_allocation_tracker* tracker,
   const struct xnn_runtime* runtime)
@@ -154,6 +225,8 @@ void xnn_init_value_allocation_tracker(
 #endif
   tracker->min_value_id = XNN_INVALID_VALUE_ID;
   tracker->max_value_id = XNN_INVALID_VALUE_ID;
+  tracker->strategy = xnn_memory_planner_strategy_greedy_by_size;
+  tracker->lower_bound = 0;
 }
 
 void xnn_mark_tensor_as_reuse(struct xnn_value_allocation_tracker* tracker,
@@ -202,45 +275,310 @@ void xnn_add_operator_workspace_allocation_tracker(
   tracker->usage[operator_workspace_value_id].opdata_id = opdata_id;
 }
 
+void xnn_assign_value_allocation_tracker_stages(
+  struct xnn_value_allocation_tracker* tracker,
+  const struct xnn_runtime* runtime)
+{
+#if XNN_ENABLE_MEMOPT
+  assert(runtime->num_stages != 0);
+  struct xnn_usage_record* usage = tracker->usage;
+  for (uint32_t i = 0; i < runtime->num_values; i++) {
+    usage[i].first_node = UINT32_MAX;
+    usage[i].last_node = 0;
+  }
+  // Stages do not follow the order of operators, so track the minimum and maximum stage of all users of a value.
+  for (uint32_t nid = 0; nid < runtime->num_ops; ++nid) {
+    const struct xnn_operator_data* opdata = runtime->opdata + nid;
+    if (opdata->operator_objects[0] == NULL) {
+      continue;  // Fused into another operator.
+    }
+    const uint32_t stage = opdata->stage;
+    for (uint32_t i = 0; i < opdata->num_inputs + opdata->num_outputs; ++i) {
+      const uint32_t value_id = i < opdata->num_inputs ? opdata->inputs[i] : opdata->outputs[i - opdata->num_inputs];
+      if (value_id == XNN_INVALID_VALUE_ID) {
+        continue;  // Optimized away.
+      }
+      usage[value_id].first_node = min(usage[value_id].first_node, stage);
+      usage[value_id].last_node = max(usage[value_id].last_node, stage);
+    }
+    usage[runtime->num_values + nid].first_node = stage;
+    usage[runtime->num_values + nid].last_node = stage;
+  }
+  for (uint32_t i = 0; i < runtime->num_values; i++) {
+    if (usage[i].first_node == UINT32_MAX) {
+      usage[i].first_node = 0;
+    }
+  }
+#endif
+}
+
+#if XNN_ENABLE_MEMOPT
+// Runtimes with at most this many tensors to allocate are planned by searching all allocation orders with
+// xnn_memory_planner_strategy_exhaustive.
+#define XNN_MEMORY_PLANNER_EXHAUSTIVE_MAX_VALUES 8
+
+// Use this comparison function to sort xnn_usage_record according to the alloc_offset in increasing order.
+static inline int cmp_value_usage_alloc_offset(const void* a, const void* b) {
+  const size_t alloc_offset_a = (*(struct xnn_usage_record *const*)a)->alloc_offset;
+  const size_t alloc_offset_b = (*(struct xnn_usage_record *const*)b)->alloc_offset;
+  return (alloc_offset_a > alloc_offset_b) - (alloc_offset_a < alloc_offset_b);
+}
+
+// The total size of tensors live while running an operator (or stage).
+struct node_breadth {
+  uint32_t node;
+  size_t breadth;
+};
+
+// Use this comparison function to sort node_breadth according to the breadth in decreasing order.
+static inline int cmp_node_breadth(const void* a, const void* b) {
+  const struct node_breadth* node_a = (const struct node_breadth*) a;
+  const struct node_breadth* node_b = (const struct node_breadth*) b;
+  if (node_a->breadth != node_b->breadth) {
+    return (node_b->breadth > node_a->breadth) - (node_b->breadth < node_a->breadth);
+  }
+  return (node_a->node > node_b->node) - (node_a->node < node_b->node);
+}
+
+static void compute_node_breadth(struct xnn_usage_record* const* usage,
+                                 size_t num_values_to_alloc,
+                                 struct node_breadth* node_breadth,
+                                 size_t num_nodes) {
+  for (size_t n = 0; n < num_nodes; ++n) {
+    node_breadth[n] = (struct node_breadth) {.node = (uint32_t) n, .breadth = 0};
+  }
+  for (size_t i = 0; i < num_values_to_alloc; ++i) {
+    for (uint32_t n = usage[i]->first_node; n <= usage[i]->last_node; ++n) {
+      node_breadth[n].breadth += usage[i]->tensor_size;
+    }
+  }
+}
+
+static size_t arena_size_of(struct xnn_usage_record* const* usage, size_t num_values_to_alloc) {
+  size_t mem_arena_size = 0;
+  for (size_t i = 0; i < num_values_to_alloc; ++i) {
+    mem_arena_size = max(mem_arena_size, usage[i]->alloc_offset + usage[i]->tensor_size);
+  }
+  return mem_arena_size;
+}
+
+// Allocate values in order of decreasing size, each in the smallest gap between live values that fits. 'sorted_usage'
+// must be sorted by decreasing size.
+static size_t plan_greedy_by_size(struct xnn_usage_record** sorted_usage,
+                                  size_t num_values_to_alloc,
+                                  struct memory_block* live_mem_blocks) {
+  size_t mem_arena_size = 0;
+  for (size_t i = 0; i < num_values_to_alloc; ++i) {
+    struct xnn_usage_record* current = sorted_usage[i];
+    const size_t num_live_mem_blocks = collect_live_mem_blocks(current, sorted_usage, i, live_mem_blocks);
+    current->alloc_offset = find_value_alloc_offset(live_mem_blocks, num_live_mem_blocks, current->tensor_size);
+    mem_arena_size = max(mem_arena_size, current->alloc_offset + current->tensor_size);
+  }
+  return mem_arena_size;
+}
+
+// Visit nodes in order of decreasing breadth, and allocate the values live at each node in order of decreasing size.
+// 'sorted_usage' must be sorted by decreasing size.
+static size_t plan_greedy_by_breadth(struct xnn_usage_record** sorted_usage,
+                                     size_t num_values_to_alloc,
+                                     struct memory_block* live_mem_blocks,
+                                     struct node_breadth* node_breadth,
+                                     size_t num_nodes) {
+  qsort(node_breadth, num_nodes, sizeof(struct node_breadth), cmp_node_breadth);
+
+  struct xnn_usage_record** allocated =
+      xnn_allocate_zero_memory(sizeof(struct xnn_usage_record*) * num_values_to_alloc);
+  bool* is_allocated = xnn_allocate_zero_memory(sizeof(bool) * num_values_to_alloc);
+  size_t num_allocated = 0;
+  size_t mem_arena_size = 0;
+  for (size_t n = 0; n < num_nodes && num_allocated < num_values_to_alloc; ++n) {
+    const uint32_t node = node_breadth[n].node;
+    for (size_t i = 0; i < num_values_to_alloc; ++i) {
+      struct xnn_usage_record* current = sorted_usage[i];
+      if (is_allocated[i] || current->first_node > node || current->last_node < node) {
+        continue;
+      }
+      const size_t num_live_mem_blocks =
+          collect_live_mem_blocks(current, allocated, num_allocated, live_mem_blocks);
+      current->alloc_offset =
+          find_best_fit_value_alloc_offset(live_mem_blocks, num_live_mem_blocks, current->tensor_size);
+      mem_arena_size = max(mem_arena_size, current->alloc_offset + current->tensor_size);
+      is_allocated[i] = true;
+      allocated[num_allocated++] = current;
+    }
+  }
+  assert(num_allocated == num_values_to_alloc);
+
+  xnn_release_memory(allocated);
+  xnn_release_memory(is_allocated);
+  return mem_arena_size;
+}
+
+// Repeatedly move each allocated value to the lowest offset where it does not overlap with other live values, until no
+// value can be moved. Values never move up, so the arena never grows. Reorders 'usage' by increasing offset.
+static size_t compact_allocations(struct xnn_usage_record** usage,
+                                  size_t num_values_to_alloc,
+                                  struct memory_block* live_mem_blocks) {
+  qsort(usage, num_values_to_alloc, sizeof(struct xnn_usage_record*), cmp_value_usage_alloc_offset);
+  bool moved;
+  do {
+    moved = false;
+    for (size_t i = 0; i < num_values_to_alloc; ++i) {
+      struct xnn_usage_record* current = usage[i];
+      const size_t num_live_mem_blocks =
+          collect_live_mem_blocks(current, usage, num_values_to_alloc, live_mem_blocks);
+      const size_t alloc_offset =
+          find_lowest_value_alloc_offset(live_mem_blocks, num_live_mem_blocks, current->tensor_size);
+      assert(alloc_offset <= current->alloc_offset);
+      if (alloc_offset < current->alloc_offset) {
+        current->alloc_offset = alloc_offset;
+        moved = true;
+      }
+    }
+  } while (moved);
+  return arena_size_of(usage, num_values_to_alloc);
+}
+
+struct allocation_order_search {
+  struct xnn_usage_record** usage;
+  size_t num_values_to_alloc;
+  // Values in the order they were allocated in the current branch of the search.
+  struct xnn_usage_record** allocated;
+  bool* is_allocated;
+  struct memory_block* live_mem_blocks;
+  // Offsets of the best allocation found so far, indexed like 'usage'.
+  size_t* best_alloc_offsets;
+  size_t best_mem_arena_size;
+  size_t lower_bound;
+};
+
+// Allocating values at the lowest offset where they fit, in every possible order, finds the smallest arena: sorting the
+// values of an optimal allocation by offset gives an order where each value fits at or below its optimal offset.
+static void search_allocation_orders(struct allocation_order_search* search,
+                                     size_t num_allocated,
+                                     size_t mem_arena_size) {
+  if (num_allocated == search->num_values_to_alloc) {
+    search->best_mem_arena_size = mem_arena_size;
+    for (size_t i = 0; i < search->num_values_to_alloc; ++i) {
+      search->best_alloc_offsets[i] = search->usage[i]->alloc_offset;
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < search->num_values_to_alloc; ++i) {
+    if (search->is_allocated[i]) {
+      continue;
+    }
+    struct xnn_usage_record* current = search->usage[i];
+    const size_t num_live_mem_blocks =
+        collect_live_mem_blocks(current, search->allocated, num_allocated, search->live_mem_blocks);
+    const size_t alloc_offset =
+        find_lowest_value_alloc_offset(search->live_mem_blocks, num_live_mem_blocks, current->tensor_size);
+    const size_t new_mem_arena_size = max(mem_arena_size, alloc_offset + current->tensor_size);
+    if (new_mem_arena_size >= search->best_mem_arena_size) {
+      continue;
+    }
+
+    current->alloc_offset = alloc_offset;
+    search->is_allocated[i] = true;
+    search->allocated[num_allocated] = current;
+    search_allocation_orders(search, num_allocated + 1, new_mem_arena_size);
+    search->is_allocated[i] = false;
+
+    if (search->best_mem_arena_size == search->lower_bound) {
+      // No allocation can be smaller.
+      return;
+    }
+  }
+}
+
+// Find the smallest arena by searching all allocation orders, starting from the best_fit allocation in 'usage'.
+static size_t plan_exhaustive(struct xnn_usage_record** usage,
+                              size_t num_values_to_alloc,
+                              struct memory_block* live_mem_blocks,
+                              size_t mem_arena_size,
+                              size_t lower_bound) {
+  struct allocation_order_search search = {
+    .usage = usage,
+    .num_values_to_alloc = num_values_to_alloc,
+    .allocated = xnn_allocate_zero_memory(sizeof(struct xnn_usage_record*) * num_values_to_alloc),
+    .is_allocated = xnn_allocate_zero_memory(sizeof(bool) * num_values_to_alloc),
+    .live_mem_blocks = live_mem_blocks,
+    .best_alloc_offsets = xnn_allocate_zero_memory(sizeof(size_t) * num_values_to_alloc),
+    .best_mem_arena_size = mem_arena_size,
+    .lower_bound = lower_bound,
+  };
+  for (size_t i = 0; i < num_values_to_alloc; ++i) {
+    search.best_alloc_offsets[i] = usage[i]->alloc_offset;
+  }
+
+  if (mem_arena_size > lower_bound) {
+    search_allocation_orders(&search, 0, 0);
+  }
+
+  for (size_t i = 0; i < num_values_to_alloc; ++i) {
+    usage[i]->alloc_offset = search.best_alloc_offsets[i];
+  }
+  xnn_release_memory(search.allocated);
+  xnn_release_memory(search.is_allocated);
+  xnn_release_memory(search.best_alloc_offsets);
+  return search.best_mem_arena_size;
+}
+#endif  // XNN_ENABLE_MEMOPT
+
 void xnn_plan_value_allocation_tracker(struct xnn_value_allocation_tracker* tracker) {
 #if XNN_ENABLE_MEMOPT
   if (tracker->min_value_id == XNN_INVALID_VALUE_ID) {
     assert(tracker->max_value_id == XNN_INVALID_VALUE_ID);
+    tracker->lower_bound = 0;
     return;
   }
 
   const uint32_t num_values = tracker->max_value_id - tracker->min_value_id + 1;
   struct xnn_usage_record** sorted_usage = xnn_allocate_zero_memory(sizeof(struct xnn_usage_record*) * num_values);
   size_t num_values_to_alloc = 0;
+  size_t num_nodes = 0;
   for (size_t i = tracker->min_value_id; i <= tracker->max_value_id; ++i) {
     struct xnn_usage_record* info = tracker->usage + i;
     if (info->tensor_size != 0) {
       sorted_usage[num_values_to_alloc++] = info;
+      num_nodes = max(num_nodes, (size_t) info->last_node + 1);
     }
   }
   qsort(sorted_usage, num_values_to_alloc, sizeof(struct xnn_usage_record*), cmp_value_usage_tensor_size);
 
+  // The arena must hold all values that are live at the same node.
+  struct node_breadth* node_breadth = xnn_allocate_zero_memory(sizeof(struct node_breadth) * max(num_nodes, 1));
+  compute_node_breadth(sorted_usage, num_values_to_alloc, node_breadth, num_nodes);
+  size_t lower_bound = 0;
+  for (size_t n = 0; n < num_nodes; ++n) {
+    lower_bound = max(lower_bound, node_breadth[n].breadth);
+  }
+
   // Start the allocation planning process.
   struct memory_block* current_live_mem_blocks = xnn_allocate_zero_memory(
-      sizeof(struct memory_block) * num_values_to_alloc);
+      sizeof(struct memory_block) * max(num_values_to_alloc, 1));
   size_t mem_arena_size = 0;
-  for (size_t i = 0; i < num_values_to_alloc; ++i) {
-    size_t num_live_mem_blocks = 0;
-    struct xnn_usage_record* current = sorted_usage[i];
-    for (size_t j = 0; j < i; ++j) {
-      const struct xnn_usage_record* allocated = sorted_usage[j];
-      if (value_lifecycle_overlap(current, allocated)) {
-        current_live_mem_blocks[num_live_mem_blocks++] = (struct memory_block){
-            .start = allocated->alloc_offset,
-            .end = allocated->alloc_offset + allocated->tensor_size,
-        };
+  switch (tracker->strategy) {
+    case xnn_memory_planner_strategy_greedy_by_size:
+      mem_arena_size = plan_greedy_by_size(sorted_usage, num_values_to_alloc, current_live_mem_blocks);
+      break;
+    case xnn_memory_planner_strategy_greedy_by_breadth:
+      mem_arena_size = plan_greedy_by_breadth(
+          sorted_usage, num_values_to_alloc, current_live_mem_blocks, node_breadth, num_nodes);
+      break;
+    case xnn_memory_planner_strategy_best_fit:
+    case xnn_memory_planner_strategy_exhaustive:
+      plan_greedy_by_size(sorted_usage, num_values_to_alloc, current_live_mem_blocks);
+      mem_arena_size = compact_allocations(sorted_usage, num_values_to_alloc, current_live_mem_blocks);
+      if (tracker->strategy == xnn_memory_planner_strategy_exhaustive &&
+          num_values_to_alloc <= XNN_MEMORY_PLANNER_EXHAUSTIVE_MAX_VALUES) {
+        mem_arena_size = plan_exhaustive(
+            sorted_usage, num_values_to_alloc, current_live_mem_blocks, mem_arena_size, lower_bound);
       }
-    }
-    current->alloc_offset = find_value_alloc_offset(current_live_mem_blocks, num_live_mem_blocks, current->tensor_size);
-    if (mem_arena_size < current->alloc_offset + current->tensor_size) {
-      mem_arena_size = current->alloc_offset + current->tensor_size;
-    }
+      break;
   }
+  assert(mem_arena_size >= lower_bound);
 
   // Walk through all tensors that are reusing memory, and update their usage records.
   for (size_t i = tracker->min_value_id; i <= tracker->max_value_id; ++i) {
@@ -254,7 +592,9 @@ void xnn_plan_value_allocation_tracker(struct xnn_value_allocation_tracker* trac
   }
 
   tracker->mem_arena_size = mem_arena_size;
+  tracker->lower_bound = lower_bound;
   xnn_release_memory(sorted_usage);
+  xnn_release_memory(node_breadth);
   xnn_release_memory(current_live_mem_blocks);
 #else
   tracker->mem_arena_size = 0;
@@ -264,5 +604,7 @@ void xnn_plan_value_allocation_tracker(struct xnn_value_allocation_tracker* trac
       tracker->mem_arena_size += tracker->usage[i].tensor_size;
     }
   }
+  // Without lifecycle information, all values are considered live at the same time.
+  tracker->lower_bound = tracker->mem_arena_size;
 #endif
 }
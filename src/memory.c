@@ -316,3 +316,41 @@ enum xnn_status xnn_finalize_weights_memory(struct xnn_weights_buffer* buffer) {
 
   return set_memory_permission(buffer->start, buffer->size, xnn_memory_permission_read_only);
 }
+
+enum xnn_status xnn_allocate_code_memory(struct xnn_code_buffer* buffer, size_t size) {
+  memset(buffer, 0, sizeof(struct xnn_code_buffer));
+  const size_t page_aligned_size = round_up_po2(size, get_page_size());
+  buffer->start = allocate_buffer(page_aligned_size);
+  if (buffer->start == NULL) {
+    return xnn_status_out_of_memory;
+  }
+
+  buffer->size = 0;
+  buffer->capacity = page_aligned_size;
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_release_code_memory(struct xnn_code_buffer* buffer) {
+  if (buffer->capacity == 0) {
+    return xnn_status_success;
+  }
+  const enum xnn_status status = release_memory(buffer->start, buffer->capacity);
+  if (status != xnn_status_success) {
+    return status;
+  }
+  memset(buffer, 0, sizeof(struct xnn_code_buffer));
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_finalize_code_memory(struct xnn_code_buffer* buffer) {
+  const enum xnn_status status = release_unused_memory(buffer->size, buffer->start, &buffer->capacity);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
+  if (buffer->capacity == 0) {
+    return xnn_status_success;
+  }
+
+  return set_memory_permission(buffer->start, buffer->size, xnn_memory_permission_read_execute);
+}
@@ -7,6 +7,7 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "xnnpack/math.h"
 
@@ -30,6 +31,34 @@ size_t xnn_gemm_best_nc(size_t num_groups, size_t m, size_t n, size_t mr,
   return nc;
 }
 
+size_t xnn_gemm_best_kc(size_t k, size_t nr, size_t kr_sr,
+                        uint32_t log2_element_size, size_t l2_cache_bytes) {
+  const size_t max_kc =
+      round_down_po2((l2_cache_bytes / 2) / ((XNN_GEMM_K_BLOCK_MIN_NR_TILES * nr) << log2_element_size), kr_sr);
+  if (max_kc == 0 || k <= max_kc) {
+    return k;
+  }
+  // Balance the blocks, rather than leaving a small remainder in the last one.
+  const size_t num_blocks = divide_round_up(k, max_kc);
+  return round_up_po2(divide_round_up(k, num_blocks), kr_sr);
+}
+
+void xnn_gemm_k_blocked_tile(size_t m, size_t n, size_t mr, size_t nr,
+                             size_t kc, uint32_t log2_element_size,
+                             size_t l2_cache_bytes, size_t num_threads,
+                             size_t* mc, size_t* nc) {
+  // The widest panel of weights that fits in half of L2, without leaving
+  // threads idle.
+  const size_t max_nc = max(1, (l2_cache_bytes / 2) / (kc << log2_element_size) / nr) * nr;
+  *nc = min(xnn_gemm_best_nc(/*num_groups=*/1, m, n, mr, nr, num_threads), max_nc);
+
+  // As many rows as possible per tile, so that each panel of weights is read
+  // from memory once per tile.
+  const size_t min_num_tiles = num_threads > 1 ? num_threads * XNN_GEMM_TILES_PER_THREAD : 1;
+  const size_t num_tile_rows = divide_round_up(min_num_tiles, divide_round_up(n, *nc));
+  *mc = round_up(divide_round_up(m, num_tile_rows), mr);
+}
+
 static size_t dwconv_num_middle_pass(
   size_t kernel_size,
   size_t first_pass_tile,
@@ -8,6 +8,7 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <math.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -15,16 +16,20 @@
 #include "xnnpack.h"
 #include "xnnpack/common.h"
 #include "xnnpack/compute.h"
+#include "xnnpack/hardware-config.h"
 #include "xnnpack/indirection.h"
 #include "xnnpack/log.h"
 #include "xnnpack/math.h"
 #include "xnnpack/microfnptr.h"
 #include "xnnpack/microkernel-type.h"
+#include "xnnpack/microkernel-utils.h"
 #include "xnnpack/microparams.h"
 #include "xnnpack/operator-type.h"
 #include "xnnpack/operator.h"
 #include "xnnpack/packq.h"
 #include "xnnpack/quantization.h"
+#include "xnnpack/trace.h"
+#include "xnnpack/winograd.h"
 #include "pthreadpool.h"
 
 #if XNN_MAX_UARCH_TYPES > 1
@@ -340,6 +345,28 @@ void xnn_compute_batched_packw_gemm_gio(
       packed_weights, /*extra_bytes=*/0, /*params=*/NULL);
 }
 
+void xnn_compute_batched_packw_gemm_gio_k_tiled(
+    const struct packw_gemm_gio_context context[restrict XNN_MIN_ELEMENTS(1)],
+    size_t batch_index,
+    size_t k_block_start,
+    size_t k_block_size)
+{
+  const void* kernel = (const void*) ((uintptr_t) context->kernel + k_block_start * context->k_stride_elements *
+                                      context->n_stride + batch_index * context->gk_stride);
+  const void* bias = context->bias;
+  if (bias != NULL) {
+    bias = (const void*) ((uintptr_t) bias + batch_index * context->gb_stride);
+  }
+  // All tiles but the last one have kc input channels.
+  void* packed_weights = (void*) ((uintptr_t) context->packed_weights + k_block_start / context->kc *
+                                  context->gc_k_tile_stride + batch_index * context->gc_stride);
+
+  context->packw_gemm_gio(
+      /*groups=*/1, context->nc, k_block_size, context->nr, context->kr,
+      context->sr, context->k_stride_elements, kernel, bias, /*scale=*/NULL,
+      packed_weights, /*extra_bytes=*/0, /*params=*/NULL);
+}
+
 void xnn_compute_packw_gemm_goi(
     const struct packw_gemm_goi_context context[restrict XNN_MIN_ELEMENTS(1)],
     size_t n_block_start,
@@ -458,6 +485,45 @@ void xnn_compute_grouped_gemm(
                                nr_block_size);
 }
 
+// Applies the epilogue to `rows` rows of `row_size` bytes at `offset` in the output `c`, right after the GEMM
+// micro-kernel wrote them. Rows are processed in pieces that fit in a stack buffer, which also keeps the reads of the
+// micro-kernels within the buffer at the end of the output.
+static void apply_gemm_epilogue(
+    const struct gemm_epilogue* epilogue,
+    void* c,
+    size_t offset,
+    size_t rows,
+    size_t row_size,
+    size_t cm_stride)
+{
+  XNN_ALIGN(64) uint8_t buffer[XNN_GEMM_EPILOGUE_TILE_BYTES + XNN_EXTRA_BYTES];
+
+  const size_t num_steps = epilogue->num_steps;
+  for (size_t m = 0; m < rows; m++) {
+    const size_t row_offset = offset + m * cm_stride;
+    for (size_t done = 0; done < row_size;) {
+      const size_t n = min(row_size - done, XNN_GEMM_EPILOGUE_TILE_BYTES);
+      void* output = (void*) ((uintptr_t) c + row_offset + done);
+      memcpy(buffer, output, n);
+      for (size_t i = 0; i < num_steps; i++) {
+        const struct fused_elementwise_step_context* step = &epilogue->steps[i];
+        void* y = i + 1 == num_steps ? output : buffer;
+        if (step->unary_ukernel != NULL) {
+          step->unary_ukernel(n, buffer, y, &step->params.unary);
+        } else {
+          const void* residual = (const void*) ((uintptr_t) epilogue->residual + row_offset + done);
+          if (step->operand_first) {
+            step->binary_config->op_ukernel(n, residual, buffer, y, &step->params.binary);
+          } else {
+            step->binary_config->op_ukernel(n, buffer, residual, y, &step->params.binary);
+          }
+        }
+      }
+      done += n;
+    }
+  }
+}
+
 void xnn_compute_gemm(
     const struct gemm_context context[restrict XNN_MIN_ELEMENTS(1)],
     size_t mr_block_start,
@@ -479,6 +545,114 @@ void xnn_compute_gemm(
       cm_stride,
       context->cn_stride,
       context->fused_params);
+
+  if XNN_UNLIKELY(context->epilogue != NULL) {
+    apply_gemm_epilogue(
+        context->epilogue, context->c, mr_block_start * cm_stride + (nr_block_start << context->log2_csize),
+        mr_block_size, nr_block_size << context->log2_csize, cm_stride);
+  }
+}
+
+void xnn_compute_gemm_k_blocked(
+    const struct gemm_context context[restrict XNN_MIN_ELEMENTS(1)],
+    size_t mr_block_start,
+    size_t nr_block_start,
+    size_t mr_block_size,
+    size_t nr_block_size)
+{
+  const size_t mr = context->mr;
+  const size_t nr = context->cn_stride / sizeof(float);
+  const size_t a_stride = context->a_stride;
+  const size_t cm_stride = context->cm_stride;
+  const size_t k_scaled = context->k_scaled;
+  const size_t kc_scaled = context->kc_scaled;
+  const size_t kr_sr_scaled = (context->kr * context->sr) * sizeof(float);
+  const xnn_gemm_ukernel_fn ukernel = context->ukernel.function[XNN_UARCH_DEFAULT];
+  float* c = (float*) ((uintptr_t) context->c + mr_block_start * cm_stride + nr_block_start * sizeof(float));
+
+  // Partial sums are not clamped, only the sum of all blocks is.
+  union xnn_f32_minmax_params unclamped_params;
+  unclamped_params.scalar.min = -INFINITY;
+  unclamped_params.scalar.max = INFINITY;
+  // Products of the blocks after the first one are accumulated into C through a small buffer.
+  float partial[1024];
+  assert(mr * nr <= 1024);
+  const size_t partial_nc = 1024 / (mr * nr) * nr;
+
+  for (size_t k_start = 0; k_start < k_scaled; k_start += kc_scaled) {
+    const size_t k_block_size = min(kc_scaled, k_scaled - k_start);
+    // Only the last block may be smaller, and its weights are padded to a multiple of `kr * sr`.
+    const size_t w_stride = context->w_stride - kc_scaled + round_up_po2(k_block_size, kr_sr_scaled);
+    const void* w = (const void*) ((uintptr_t) context->packed_w + k_start / kc_scaled * context->kb_stride +
+                                   nr_block_start * w_stride);
+    for (size_t m = 0; m < mr_block_size; m += mr) {
+      const size_t mb = min(mr, mr_block_size - m);
+      const void* a = (const void*) ((uintptr_t) context->a + (mr_block_start + m) * a_stride + k_start);
+      float* c_m = (float*) ((uintptr_t) c + m * cm_stride);
+      if (k_start == 0) {
+        ukernel(mb, nr_block_size, k_block_size, a, a_stride, w, c_m, cm_stride, context->cn_stride,
+                &unclamped_params);
+        continue;
+      }
+      for (size_t n = 0; n < nr_block_size; n += partial_nc) {
+        const size_t nb = min(partial_nc, nr_block_size - n);
+        ukernel(mb, nb, k_block_size, a, a_stride, (const void*) ((uintptr_t) w + n * w_stride), partial,
+                nb * sizeof(float), context->cn_stride, &unclamped_params);
+        for (size_t i = 0; i < mb; i++) {
+          float* c_row = (float*) ((uintptr_t) c_m + i * cm_stride) + n;
+          for (size_t j = 0; j < nb; j++) {
+            c_row[j] += partial[i * nb + j];
+          }
+        }
+      }
+    }
+  }
+
+  const float output_min = context->params.f32.scalar.min;
+  const float output_max = context->params.f32.scalar.max;
+  for (size_t i = 0; i < mr_block_size; i++) {
+    float* c_row = (float*) ((uintptr_t) c + i * cm_stride);
+    for (size_t j = 0; j < nr_block_size; j++) {
+      c_row[j] = math_min_f32(math_max_f32(c_row[j], output_min), output_max);
+    }
+  }
+
+  if XNN_UNLIKELY(context->epilogue != NULL) {
+    apply_gemm_epilogue(
+        context->epilogue, context->c, mr_block_start * cm_stride + nr_block_start * sizeof(float),
+        mr_block_size, nr_block_size * sizeof(float), cm_stride);
+  }
+}
+
+void xnn_reshape_gemm_k_blocked(
+  xnn_operator_t op,
+  size_t m,
+  size_t n,
+  uint32_t mr,
+  uint32_t log2_element_size,
+  size_t num_threads)
+{
+  const size_t nr = op->ukernel.gemm.nr;
+  const size_t kc = op->ukernel.gemm.kc;
+  assert(kc != 0);
+
+  struct gemm_context* context = &op->context.gemm.gemm.gemm;
+  context->mr = mr;
+  context->kc_scaled = kc << log2_element_size;
+  context->w_stride = (kc + 1) << log2_element_size;
+  context->kb_stride = round_up(n, nr) * context->w_stride;
+
+  const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+  size_t mc = mr;
+  size_t nc = n;
+  xnn_gemm_k_blocked_tile(m, n, mr, nr, kc, log2_element_size, hardware_config->l2_data_cache_bytes, num_threads,
+                          &mc, &nc);
+  op->compute[0].type = xnn_parallelization_type_2d_tile_2d;
+  op->compute[0].task_2d_tile_2d = (pthreadpool_task_2d_tile_2d_t) xnn_compute_gemm_k_blocked;
+  op->compute[0].range[0] = m;
+  op->compute[0].range[1] = n;
+  op->compute[0].tile[0] = mc;
+  op->compute[0].tile[1] = nc;
 }
 
 void xnn_compute_dqgemm(
@@ -746,6 +920,13 @@ void xnn_compute_batch_igemm(
       context->a_offset + batch_index * context->ba_stride,
       context->zero,
       &context->params);
+
+  if XNN_UNLIKELY(context->epilogue != NULL) {
+    apply_gemm_epilogue(
+        context->epilogue, context->c,
+        batch_index * context->bc_stride + mr_block_start * cm_stride + (nr_block_start << context->log2_csize),
+        mr_block_size, nr_block_size << context->log2_csize, cm_stride);
+  }
 }
 
 void xnn_compute_batch_dqigemm(
@@ -799,6 +980,12 @@ void xnn_compute_igemm(
       context->a_offset,
       context->zero,
       &context->params);
+
+  if XNN_UNLIKELY(context->epilogue != NULL) {
+    apply_gemm_epilogue(
+        context->epilogue, context->c, mr_block_start * cm_stride + (nr_block_start << context->log2_csize),
+        mr_block_size, nr_block_size << context->log2_csize, cm_stride);
+  }
 }
 
 void xnn_compute_dqigemm(
@@ -1560,6 +1747,214 @@ void xnn_compute_pad_5d(
   }
 }
 
+void xnn_compute_hmp_tiled_scaled_dot_product_attention_with_thread(
+  const struct scaled_dot_product_attention_context context[restrict XNN_MIN_ELEMENTS(1)],
+  uint32_t uarch_index,
+  size_t thread_index,
+  size_t batch_index,
+  size_t head_index,
+  size_t tokens_start,
+  size_t tokens_block_size)
+{
+  assert(tokens_block_size <= XNN_MAX_MR);
+
+  const size_t query_key_scaled_channels = context->query_key_scaled_channels;
+  const size_t query_tile_offset =
+    batch_index * context->query_batch_stride + head_index * context->query_head_stride +
+    tokens_start * query_key_scaled_channels;
+  const size_t key_value_tokens = context->key_value_tokens;
+  const size_t key_value_tokens_scaled = context->key_value_tokens_scaled;
+  const size_t key_value_tile = context->key_value_tile;
+  const size_t key_value_tile_scaled = context->key_value_tile_scaled;
+  const size_t value_scaled_channels = context->value_scaled_channels;
+  const size_t cn_stride = context->cn_stride;
+  const void* scaled_query =
+    (void*) ((uintptr_t) context->scaled_query + thread_index * context->scaled_query_thread_stride);
+  void* const logits = (void*) ((uintptr_t) context->logits_buffer + thread_index * context->logits_thread_stride);
+  void* const tile_output =
+    (void*) ((uintptr_t) context->tile_output_buffer + thread_index * context->tile_output_thread_stride);
+  void* const output = (void*) ((uintptr_t) context->output + batch_index * context->output_batch_stride +
+                                head_index * context->output_head_stride + tokens_start * value_scaled_channels);
+  const void* minmax_params = &context->minmax_params;
+
+  {
+    uintptr_t query = (uintptr_t) context->query + query_tile_offset;
+    uintptr_t query_scaled_current = (uintptr_t) scaled_query;
+    // Q_scaled = Q * Scale (along channels). Q and Q_scaled have dimensions [tokens_block_size, query_key_channels].
+    size_t i = tokens_block_size;
+    do {
+      context->vmul_ukernel(
+        /*batch=*/query_key_scaled_channels,
+        /*input_x=*/(const void*) query,
+        /*input_y=*/context->scale,
+        /*output=*/(void*) query_scaled_current,
+        /*params=*/minmax_params);
+      query += query_key_scaled_channels;
+      query_scaled_current += query_key_scaled_channels;
+    } while (--i != 0);
+  }
+
+  struct attention_online_softmax_state softmax_state[XNN_MAX_MR];
+  for (size_t i = 0; i < tokens_block_size; i++) {
+    softmax_state[i].max = -INFINITY;
+    softmax_state[i].sum = 0.0f;
+  }
+  // Skip initialization of locals as they will be written to immediately.
+  float output_scale[XNN_MAX_MR];
+  float tile_scale[XNN_MAX_MR];
+
+  const struct attention_logits_cap logits_cap = context->logits_cap;
+  uintptr_t key = (uintptr_t) context->key + batch_index * context->key_batch_stride +
+                  head_index * context->key_head_stride;
+  uintptr_t value = (uintptr_t) context->value + batch_index * context->value_batch_stride +
+                    head_index * context->value_head_stride;
+  const uintptr_t mask = (uintptr_t) context->mask + tokens_start * key_value_tokens_scaled;
+  size_t tile_start_scaled = 0;
+  for (size_t tile_start = 0; tile_start < key_value_tokens; tile_start += key_value_tile) {
+    const size_t tile_size = min(key_value_tile, key_value_tokens - tile_start);
+    const size_t tile_size_scaled = min(key_value_tile_scaled, key_value_tokens_scaled - tile_start_scaled);
+
+    // S = GEMM(Q_scaled, K^t) for a tile of keys. S is [tokens_block_size, tile_size].
+    context->gemm_ukernel.function[uarch_index](
+      /*mr=*/tokens_block_size,
+      /*nr=*/tile_size,
+      /*k=*/query_key_scaled_channels,
+      /*a=*/scaled_query,
+      /*a_stride=*/query_key_scaled_channels,
+      /*w=*/(const void*) key,
+      /*c=*/logits,
+      /*cm_stride=*/key_value_tile_scaled,
+      /*cn_stride=*/cn_stride,
+      /*params=*/minmax_params);
+
+    // P = exp(S - max(S)) along each row of the tile, and fold the tile into the softmax of the row.
+    for (size_t i = 0; i < tokens_block_size; i++) {
+      void* logits_row = (void*) ((uintptr_t) logits + i * key_value_tile_scaled);
+      if (logits_cap.type == xnn_attention_logits_cap_type_tanh) {
+        // (Optional) S = TanH(S/Cap) * Cap. Overwrites buffer.
+        context->vmulc_ukernel(
+          /*batch=*/tile_size_scaled,
+          /*input_x=*/logits_row,
+          /*input_y=*/&logits_cap.cap_reciprocal,
+          /*output=*/logits_row,
+          /*params=*/minmax_params);
+        context->vtanh_ukernel(
+          /*batch=*/tile_size_scaled,
+          /*input=*/logits_row,
+          /*output=*/logits_row,
+          /*params=*/&context->tanh_params);
+        context->vmulc_ukernel(
+          /*batch=*/tile_size_scaled,
+          /*input_x=*/logits_row,
+          /*input_y=*/&logits_cap.cap,
+          /*output=*/logits_row,
+          /*params=*/minmax_params);
+      }
+
+      // S = S + Mask. Mask has dimensions [query_tokens, key_value_tokens].
+      context->vadd_ukernel(
+        /*batch=*/tile_size_scaled,
+        /*input_x=*/logits_row,
+        /*input_y=*/(const void*) (mask + i * key_value_tokens_scaled + tile_start_scaled),
+        /*output=*/logits_row,
+        /*params=*/minmax_params);
+
+      float tile_max;
+      context->rmax_ukernel(
+        /*batch=*/tile_size_scaled,
+        /*input=*/logits_row,
+        /*output=*/&tile_max,
+        /*params=*/&context->rmax_params);
+
+      float tile_sum;
+      context->raddstoreexpminusmax_ukernel(
+        /*batch=*/tile_size_scaled,
+        /*input=*/logits_row,
+        /*max=*/&tile_max,
+        /*output=*/logits_row,
+        /*sum=*/&tile_sum,
+        /*params=*/&context->expminus_params);
+
+      context->update_online_softmax(
+        /*tile_max=*/&tile_max,
+        /*tile_sum=*/&tile_sum,
+        /*state=*/&softmax_state[i],
+        /*output_scale=*/&output_scale[i],
+        /*tile_scale=*/&tile_scale[i]);
+    }
+
+    // O_tile = GEMM(P, V) for a tile of values. O_tile has dimensions [tokens_block_size, value_channels]. The first
+    // tile is written directly to the output, because its maximum is the maximum of each row seen so far.
+    context->gemm_ukernel.function[uarch_index](
+      /*mr=*/tokens_block_size,
+      /*nc=*/context->value_channels,
+      /*kc=*/tile_size_scaled,
+      /*a=*/logits,
+      /*a_stride=*/key_value_tile_scaled,
+      /*w=*/(const void*) value,
+      /*c=*/tile_start == 0 ? output : tile_output,
+      /*cm_stride=*/value_scaled_channels,
+      /*cn_stride=*/cn_stride,
+      /*params=*/minmax_params);
+
+    if (tile_start != 0) {
+      // O = O * output_scale + O_tile * tile_scale, along each row.
+      for (size_t i = 0; i < tokens_block_size; i++) {
+        void* output_row = (void*) ((uintptr_t) output + i * value_scaled_channels);
+        void* tile_output_row = (void*) ((uintptr_t) tile_output + i * value_scaled_channels);
+        context->vmulc_ukernel(
+          /*batch=*/value_scaled_channels,
+          /*input_x=*/output_row,
+          /*input_y=*/&output_scale[i],
+          /*output=*/output_row,
+          /*params=*/minmax_params);
+        context->vmulc_ukernel(
+          /*batch=*/value_scaled_channels,
+          /*input_x=*/tile_output_row,
+          /*input_y=*/&tile_scale[i],
+          /*output=*/tile_output_row,
+          /*params=*/minmax_params);
+        context->vadd_ukernel(
+          /*batch=*/value_scaled_channels,
+          /*input_x=*/output_row,
+          /*input_y=*/tile_output_row,
+          /*output=*/output_row,
+          /*params=*/minmax_params);
+      }
+    }
+
+    key += context->key_tile_stride;
+    value += context->value_tile_stride;
+    tile_start_scaled += key_value_tile_scaled;
+  }
+
+  // O = O / sum(exp(S - max(S))) along each row.
+  for (size_t i = 0; i < tokens_block_size; i++) {
+    void* output_row = (void*) ((uintptr_t) output + i * value_scaled_channels);
+    context->compute_online_softmax_scale(
+      /*state=*/&softmax_state[i],
+      /*output_scale=*/&output_scale[i]);
+    context->vmulc_ukernel(
+      /*batch=*/value_scaled_channels,
+      /*input_x=*/output_row,
+      /*input_y=*/&output_scale[i],
+      /*output=*/output_row,
+      /*params=*/minmax_params);
+  }
+}
+
+void xnn_compute_tiled_scaled_dot_product_attention_with_thread(
+  const struct scaled_dot_product_attention_context context[restrict XNN_MIN_ELEMENTS(1)],
+  size_t thread_index,
+  size_t batch_index,
+  size_t head_index,
+  size_t tokens_start,
+  size_t tokens_block_size)
+{
+  xnn_compute_hmp_tiled_scaled_dot_product_attention_with_thread(
+    context, XNN_UARCH_DEFAULT, thread_index, batch_index, head_index, tokens_start, tokens_block_size);
+}
+
 void xnn_compute_scaled_dot_product_attention(
   const struct scaled_dot_product_attention_context context[restrict XNN_MIN_ELEMENTS(1)],
   size_t batch_index,
@@ -2059,6 +2454,67 @@ void xnn_compute_univector_contiguous(
   context->ukernel(size, x, y, &context->params);
 }
 
+void xnn_compute_fused_elementwise(
+    const struct fused_elementwise_context context[restrict XNN_MIN_ELEMENTS(1)],
+    size_t offset,
+    size_t size)
+{
+  assert(size <= XNN_FUSED_ELEMENTWISE_TILE_BYTES);
+  // Intermediate results alternate between the two buffers, only the last step writes to the output.
+  XNN_ALIGN(64) uint8_t buffers[2][XNN_FUSED_ELEMENTWISE_TILE_BYTES + XNN_EXTRA_BYTES];
+
+  const size_t num_steps = context->num_steps;
+  const void* x = (const void*) ((uintptr_t) context->inputs[0] + offset);
+  for (size_t i = 0; i < num_steps; i++) {
+    const struct fused_elementwise_step_context* step = &context->steps[i];
+    void* y = i + 1 == num_steps ? (void*) ((uintptr_t) context->output + offset) : buffers[i % 2];
+    if (step->unary_ukernel != NULL) {
+      step->unary_ukernel(size, x, y, &step->params.unary);
+    } else {
+      const uintptr_t operand = (uintptr_t) context->inputs[step->operand];
+      switch (step->broadcast) {
+        case xnn_fused_elementwise_broadcast_none:
+        {
+          const void* b = (const void*) (operand + offset);
+          if (step->operand_first) {
+            step->binary_config->op_ukernel(size, b, x, y, &step->params.binary);
+          } else {
+            step->binary_config->op_ukernel(size, x, b, y, &step->params.binary);
+          }
+          break;
+        }
+        case xnn_fused_elementwise_broadcast_scalar:
+          if (step->operand_first) {
+            step->binary_config->ropc_ukernel(size, x, (const void*) operand, y, &step->params.binary);
+          } else {
+            step->binary_config->opc_ukernel(size, x, (const void*) operand, y, &step->params.binary);
+          }
+          break;
+        case xnn_fused_elementwise_broadcast_channel:
+        {
+          const size_t channels = context->channels;
+          size_t channel_offset = offset % channels;
+          for (size_t done = 0; done < size;) {
+            const size_t n = min(size - done, channels - channel_offset);
+            const void* a = (const void*) ((uintptr_t) x + done);
+            const void* b = (const void*) (operand + channel_offset);
+            void* c = (void*) ((uintptr_t) y + done);
+            if (step->operand_first) {
+              step->binary_config->op_ukernel(n, b, a, c, &step->params.binary);
+            } else {
+              step->binary_config->op_ukernel(n, a, b, c, &step->params.binary);
+            }
+            done += n;
+            channel_offset = 0;
+          }
+          break;
+        }
+      }
+    }
+    x = y;
+  }
+}
+
 void xnn_compute_contiguous_reduce(
     const struct reduce_context context[restrict XNN_MIN_ELEMENTS(1)],
     size_t output_idx0,
@@ -2369,6 +2825,71 @@ void xnn_compute_vmulcaddc(
     &context->params);
 }
 
+void xnn_compute_winograd_input_transform(
+    const struct winograd_input_transform_context context[restrict XNN_MIN_ELEMENTS(1)],
+    size_t batch_index,
+    size_t tile_index)
+{
+  const size_t tile_y = tile_index / context->tiles_width;
+  const size_t tile_x = tile_index % context->tiles_width;
+  const void* input = (const void*) ((uintptr_t) context->input + batch_index * context->input_batch_stride);
+
+  // Pixels of the tile outside of the input read from the zero buffer.
+  const void* pixels[XNN_WINOGRAD_F4X4K3X3_INPUT_TILE * XNN_WINOGRAD_F4X4K3X3_INPUT_TILE];
+  for (size_t i = 0; i < XNN_WINOGRAD_F4X4K3X3_INPUT_TILE; i++) {
+    const size_t input_y = tile_y * XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE + i - context->input_padding_top;
+    for (size_t j = 0; j < XNN_WINOGRAD_F4X4K3X3_INPUT_TILE; j++) {
+      const size_t input_x = tile_x * XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE + j - context->input_padding_left;
+      if (input_y < context->input_height && input_x < context->input_width) {
+        pixels[i * XNN_WINOGRAD_F4X4K3X3_INPUT_TILE + j] = (const void*) ((uintptr_t) input +
+          (input_y * context->input_width + input_x) * context->input_pixel_stride);
+      } else {
+        pixels[i * XNN_WINOGRAD_F4X4K3X3_INPUT_TILE + j] = context->zero;
+      }
+    }
+  }
+
+  const size_t tile = batch_index * context->tiles_per_image + tile_index;
+  context->ukernel(
+    context->channels, pixels,
+    (void*) ((uintptr_t) context->output + tile * context->output_tile_stride),
+    context->output_position_stride);
+}
+
+void xnn_compute_winograd_output_transform(
+    const struct winograd_output_transform_context context[restrict XNN_MIN_ELEMENTS(1)],
+    size_t batch_index,
+    size_t tile_index)
+{
+  const size_t tile_y = tile_index / context->tiles_width;
+  const size_t tile_x = tile_index % context->tiles_width;
+  const size_t output_y = tile_y * XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE;
+  const size_t output_x = tile_x * XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE;
+  const size_t rows = min(context->output_height - output_y, XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE);
+  const size_t columns = min(context->output_width - output_x, XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE);
+  const size_t output_offset = batch_index * context->output_batch_stride + output_y * context->output_row_stride +
+    output_x * context->output_pixel_stride;
+
+  const size_t tile = batch_index * context->tiles_per_image + tile_index;
+  context->ukernel(
+    context->channels,
+    (const void*) ((uintptr_t) context->input + tile * context->input_tile_stride),
+    context->input_position_stride,
+    context->bias,
+    (void*) ((uintptr_t) context->output + output_offset),
+    context->output_row_stride, context->output_pixel_stride,
+    rows, columns,
+    &context->params);
+
+  if XNN_UNLIKELY(context->epilogue != NULL) {
+    for (size_t y = 0; y < rows; y++) {
+      apply_gemm_epilogue(
+          context->epilogue, context->output, output_offset + y * context->output_row_stride,
+          columns, context->channels, context->output_pixel_stride);
+    }
+  }
+}
+
 void xnn_compute_rope(
     const struct rope_context context[restrict XNN_MIN_ELEMENTS(1)],
     size_t batch_index,
@@ -2404,6 +2925,12 @@ void xnn_compute_hmp_gemm(
       (void*)((uintptr_t)context->c + mr_block_start * cm_stride +
               (nr_block_start << context->log2_csize)),
       cm_stride, context->cn_stride, context->fused_params);
+
+  if XNN_UNLIKELY(context->epilogue != NULL) {
+    apply_gemm_epilogue(
+        context->epilogue, context->c, mr_block_start * cm_stride + (nr_block_start << context->log2_csize),
+        mr_block_size, nr_block_size << context->log2_csize, cm_stride);
+  }
   }
 
   void xnn_compute_hmp_dqgemm(
@@ -2570,6 +3097,13 @@ void xnn_compute_hmp_gemm(
         context->a_offset + batch_index * context->ba_stride,
         context->zero,
         &context->params);
+
+    if XNN_UNLIKELY(context->epilogue != NULL) {
+      apply_gemm_epilogue(
+          context->epilogue, context->c,
+          batch_index * context->bc_stride + mr_block_start * cm_stride + (nr_block_start << context->log2_csize),
+          mr_block_size, nr_block_size << context->log2_csize, cm_stride);
+    }
   }
 
   void xnn_compute_batch_hmp_dqigemm(
@@ -2625,6 +3159,12 @@ void xnn_compute_hmp_gemm(
         context->a_offset,
         context->zero,
         &context->params);
+
+    if XNN_UNLIKELY(context->epilogue != NULL) {
+      apply_gemm_epilogue(
+          context->epilogue, context->c, mr_block_start * cm_stride + (nr_block_start << context->log2_csize),
+          mr_block_size, nr_block_size << context->log2_csize, cm_stride);
+    }
   }
 
   void xnn_compute_hmp_dqigemm(
@@ -2961,13 +3501,14 @@ void xnn_compute_hmp_scaled_dot_product_attention_with_thread(
 
 enum xnn_status xnn_run_operator(xnn_operator_t op, pthreadpool_t threadpool)
 {
-  return xnn_run_operator_with_index(op, 0, 0, threadpool);
+  return xnn_run_operator_with_index(op, 0, 0, /*trace=*/NULL, threadpool);
 }
 
 enum xnn_status xnn_run_operator_with_index(
   xnn_operator_t op,
   size_t opdata_index,
   size_t operator_object_index,
+  struct xnn_trace* trace,
   pthreadpool_t threadpool)
 {
   switch (op->state) {
@@ -2998,301 +3539,315 @@ enum xnn_status xnn_run_operator_with_index(
     flags |= PTHREADPOOL_FLAG_YIELD_WORKERS;
   }
   for (size_t i = 0; i < XNN_MAX_COMPUTE_INVOCATIONS; i++) {
-    switch (op->compute[i].type) {
+    const struct compute_parameters* compute = &op->compute[i];
+    void* context = (void*) ((uintptr_t) &op->context + compute->context_offset);
+    struct xnn_trace_task trace_task;
+    struct compute_parameters traced_compute;
+    const bool traced = trace != NULL && compute->type != xnn_parallelization_type_invalid &&
+                        xnn_trace_begin_compute(&trace_task, compute, context, &traced_compute);
+    if (traced) {
+      compute = &traced_compute;
+      context = &trace_task;
+    }
+    switch (compute->type) {
       case xnn_parallelization_type_invalid:
         break;
       case xnn_parallelization_type_1d:
-        assert(op->compute[i].range[0] != 0);
+        assert(compute->range[0] != 0);
         pthreadpool_parallelize_1d(
             threadpool,
-            op->compute[i].task_1d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0],
+            compute->task_1d,
+            context,
+            compute->range[0],
             flags);
         break;
       case xnn_parallelization_type_1d_with_thread:
-        assert(op->compute[i].range[0] != 0);
+        assert(compute->range[0] != 0);
         pthreadpool_parallelize_1d_with_thread(
             threadpool,
-            op->compute[i].task_1d_with_thread,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0],
+            compute->task_1d_with_thread,
+            context,
+            compute->range[0],
             flags);
         break;
       case xnn_parallelization_type_1d_tile_1d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_1d_tile_1d(
             threadpool,
-            op->compute[i].task_1d_tile_1d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0],
-            op->compute[i].tile[0],
+            compute->task_1d_tile_1d,
+            context,
+            compute->range[0],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_2d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
         pthreadpool_parallelize_2d(
             threadpool,
-            op->compute[i].task_2d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1],
+            compute->task_2d,
+            context,
+            compute->range[0], compute->range[1],
             flags);
         break;
       case xnn_parallelization_type_2d_with_thread:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
         pthreadpool_parallelize_2d_with_thread(
             threadpool,
-            op->compute[i].task_2d_with_thread,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1],
+            compute->task_2d_with_thread,
+            context,
+            compute->range[0], compute->range[1],
             flags);
         break;
       case xnn_parallelization_type_2d_tile_1d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_2d_tile_1d(
             threadpool,
-            op->compute[i].task_2d_tile_1d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1],
-            op->compute[i].tile[0],
+            compute->task_2d_tile_1d,
+            context,
+            compute->range[0], compute->range[1],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_2d_tile_2d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_2d_tile_2d(
             threadpool,
-            op->compute[i].task_2d_tile_2d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->task_2d_tile_2d,
+            context,
+            compute->range[0], compute->range[1],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
       case xnn_parallelization_type_3d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
         pthreadpool_parallelize_3d(
             threadpool,
-            op->compute[i].task_3d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
+            compute->task_3d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2],
             flags);
         break;
       case xnn_parallelization_type_3d_tile_1d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_3d_tile_1d(
             threadpool,
-            op->compute[i].task_3d_tile_1d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
-            op->compute[i].tile[0],
+            compute->task_3d_tile_1d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_3d_tile_1d_with_thread:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_3d_tile_1d_with_thread(
             threadpool,
-            op->compute[i].task_3d_tile_1d_with_thread,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
-            op->compute[i].tile[0],
+            compute->task_3d_tile_1d_with_thread,
+            context,
+            compute->range[0], compute->range[1], compute->range[2],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_3d_tile_2d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_3d_tile_2d(
             threadpool,
-            op->compute[i].task_3d_tile_2d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->task_3d_tile_2d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
       case xnn_parallelization_type_4d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].range[3] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->range[3] != 0);
         pthreadpool_parallelize_4d(
             threadpool,
-            op->compute[i].task_4d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2], op->compute[i].range[3],
+            compute->task_4d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2], compute->range[3],
             flags);
         break;
       case xnn_parallelization_type_4d_tile_2d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].range[3] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->range[3] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_4d_tile_2d(
             threadpool,
-            op->compute[i].task_4d_tile_2d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2], op->compute[i].range[3],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->task_4d_tile_2d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2], compute->range[3],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
       case xnn_parallelization_type_5d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].range[3] != 0);
-        assert(op->compute[i].range[4] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->range[3] != 0);
+        assert(compute->range[4] != 0);
         pthreadpool_parallelize_5d(
             threadpool,
-            op->compute[i].task_5d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2], op->compute[i].range[3],
-              op->compute[i].range[4],
+            compute->task_5d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2], compute->range[3],
+              compute->range[4],
             flags);
         break;
       case xnn_parallelization_type_5d_tile_2d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].range[3] != 0);
-        assert(op->compute[i].range[4] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->range[3] != 0);
+        assert(compute->range[4] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_5d_tile_2d(
             threadpool,
-            op->compute[i].task_5d_tile_2d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2], op->compute[i].range[3],
-              op->compute[i].range[4],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->task_5d_tile_2d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2], compute->range[3],
+              compute->range[4],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
       case xnn_parallelization_type_6d_tile_2d:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].range[3] != 0);
-        assert(op->compute[i].range[4] != 0);
-        assert(op->compute[i].range[5] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->range[3] != 0);
+        assert(compute->range[4] != 0);
+        assert(compute->range[5] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_6d_tile_2d(
             threadpool,
-            op->compute[i].task_6d_tile_2d,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2], op->compute[i].range[3],
-              op->compute[i].range[4], op->compute[i].range[5],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->task_6d_tile_2d,
+            context,
+            compute->range[0], compute->range[1], compute->range[2], compute->range[3],
+              compute->range[4], compute->range[5],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
   #if XNN_MAX_UARCH_TYPES > 1
       case xnn_parallelization_type_2d_tile_1d_with_uarch:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_2d_tile_1d_with_uarch(
             threadpool,
-            op->compute[i].task_2d_tile_1d_with_id,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
+            compute->task_2d_tile_1d_with_id,
+            context,
             0 /* default uarch index */, XNN_MAX_UARCH_TYPES - 1,
-            op->compute[i].range[0], op->compute[i].range[1],
-            op->compute[i].tile[0],
+            compute->range[0], compute->range[1],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_2d_tile_2d_with_uarch:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_2d_tile_2d_with_uarch(
             threadpool,
-            op->compute[i].task_2d_tile_2d_with_id,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
+            compute->task_2d_tile_2d_with_id,
+            context,
             0 /* default uarch index */, XNN_MAX_UARCH_TYPES - 1,
-            op->compute[i].range[0], op->compute[i].range[1],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->range[0], compute->range[1],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
       case xnn_parallelization_type_3d_tile_1d_with_uarch:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_3d_tile_1d_with_uarch(
             threadpool,
-            op->compute[i].task_3d_tile_1d_with_id,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
+            compute->task_3d_tile_1d_with_id,
+            context,
             0 /* default uarch index */, XNN_MAX_UARCH_TYPES - 1,
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
-            op->compute[i].tile[0],
+            compute->range[0], compute->range[1], compute->range[2],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_3d_tile_1d_with_uarch_with_thread:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].tile[0] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->tile[0] != 0);
         pthreadpool_parallelize_3d_tile_1d_with_uarch_with_thread(
             threadpool,
-            op->compute[i].task_3d_tile_1d_with_id_with_thread,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
+            compute->task_3d_tile_1d_with_id_with_thread,
+            context,
             0 /* default uarch index */, XNN_MAX_UARCH_TYPES - 1,
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
-            op->compute[i].tile[0],
+            compute->range[0], compute->range[1], compute->range[2],
+            compute->tile[0],
             flags);
         break;
       case xnn_parallelization_type_3d_tile_2d_with_uarch:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_3d_tile_2d_with_uarch(
             threadpool,
-            op->compute[i].task_3d_tile_2d_with_id,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
+            compute->task_3d_tile_2d_with_id,
+            context,
             0 /* default uarch index */, XNN_MAX_UARCH_TYPES - 1,
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->range[0], compute->range[1], compute->range[2],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
       case xnn_parallelization_type_4d_tile_2d_with_uarch:
-        assert(op->compute[i].range[0] != 0);
-        assert(op->compute[i].range[1] != 0);
-        assert(op->compute[i].range[2] != 0);
-        assert(op->compute[i].range[3] != 0);
-        assert(op->compute[i].tile[0] != 0);
-        assert(op->compute[i].tile[1] != 0);
+        assert(compute->range[0] != 0);
+        assert(compute->range[1] != 0);
+        assert(compute->range[2] != 0);
+        assert(compute->range[3] != 0);
+        assert(compute->tile[0] != 0);
+        assert(compute->tile[1] != 0);
         pthreadpool_parallelize_4d_tile_2d_with_uarch(
             threadpool,
-            op->compute[i].task_4d_tile_2d_with_id,
-            (void*) ((uintptr_t) &op->context + op->compute[i].context_offset),
+            compute->task_4d_tile_2d_with_id,
+            context,
             0 /* default uarch index */, XNN_MAX_UARCH_TYPES - 1,
-            op->compute[i].range[0], op->compute[i].range[1], op->compute[i].range[2], op->compute[i].range[3],
-            op->compute[i].tile[0], op->compute[i].tile[1],
+            compute->range[0], compute->range[1], compute->range[2], compute->range[3],
+            compute->tile[0], compute->tile[1],
             flags);
         break;
   #endif  // XNN_MAX_UARCH_TYPES > 1
       default:
         XNN_UNREACHABLE;
     }
+    if (traced) {
+      xnn_trace_end_compute(
+        trace, &trace_task, xnn_operator_type_to_string(op->type), opdata_index, operator_object_index, i);
+    }
   }
   return xnn_status_success;
 }
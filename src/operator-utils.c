@@ -40,6 +40,42 @@ void* xnn_get_pointer_to_write_weights(
   return weights_ptr;
 }
 
+void xnn_pack_gemm_weights_in_k_blocks(
+  size_t n,
+  size_t k,
+  size_t kc,
+  size_t nr,
+  size_t kr_sr,
+  uint32_t log2_element_size,
+  const void* packed_weights,
+  void* blocked_weights)
+{
+  assert(kc % kr_sr == 0);
+  const size_t n_stride = round_up(n, nr);
+  const size_t k_stride = round_up_po2(k, kr_sr);
+  // Weights of a tile of `nr` output channels are packed in order of input channels, in groups of `kr_sr`, so each
+  // block of K is a contiguous range of the packed tile.
+  const size_t tile_bias_size = nr << log2_element_size;
+  const size_t tile_stride = (nr * (k_stride + 1)) << log2_element_size;
+  for (size_t k_start = 0; k_start < k_stride; k_start += kc) {
+    const size_t k_block_size = min(kc, k_stride - k_start);
+    void* block = (void*) ((uintptr_t) blocked_weights + ((n_stride * (kc + 1) * (k_start / kc)) << log2_element_size));
+    for (size_t n_start = 0; n_start < n_stride; n_start += nr) {
+      const void* tile = (const void*) ((uintptr_t) packed_weights + n_start / nr * tile_stride);
+      if (k_start == 0) {
+        memcpy(block, tile, tile_bias_size);
+      } else {
+        memset(block, 0, tile_bias_size);
+      }
+      block = (void*) ((uintptr_t) block + tile_bias_size);
+      const size_t tile_block_size = (nr * k_block_size) << log2_element_size;
+      memcpy(block, (const void*) ((uintptr_t) tile + tile_bias_size + ((nr * k_start) << log2_element_size)),
+             tile_block_size);
+      block = (void*) ((uintptr_t) block + tile_block_size);
+    }
+  }
+}
+
 size_t xnn_compute_convolution_output_dimension(
   size_t padded_input_dimension,
   size_t kernel_dimension,
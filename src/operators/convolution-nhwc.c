@@ -34,6 +34,7 @@
 #include "xnnpack/operator.h"
 #include "xnnpack/pack.h"
 #include "xnnpack/params.h"
+#include "xnnpack/winograd.h"
 #include "pthreadpool.h"
 
 #ifndef XNN_ENABLE_GEMM_M_SPECIALIZATION
@@ -324,7 +325,25 @@ static enum xnn_status create_gemm_or_igemm(
   const size_t n_stride = round_up(group_output_channels, nr);
   const size_t k_stride = round_up_po2(group_input_channels, kr * sr);
 
-  const uint32_t cache_seed = groups ^ group_input_channels ^ group_output_channels ^ nr ^ kr ^ sr ^ ukernel_type ^ flags;
+  // 1x1 F32 convolutions with many input channels block their weights along K, like Fully Connected operators, see
+  // xnn_compute_gemm_k_blocked.
+  size_t kc = 0;
+  if (ukernel_type == xnn_microkernel_type_gemm && groups == 1 &&
+      operator_type == xnn_operator_type_convolution_nhwc_f32 && gemm_config->pack_weights_and_biases == NULL &&
+      extra_weights_bytes == 0) {
+    const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+    assert(hardware_config != NULL);
+    kc = xnn_gemm_best_kc(k_stride, nr, kr * sr, log2_filter_element_size, hardware_config->l2_data_cache_bytes);
+    if (kc == k_stride) {
+      kc = 0;
+    }
+  }
+  const size_t num_k_blocks = kc != 0 ? divide_round_up(k_stride, kc) : 1;
+
+  uint32_t cache_seed = groups ^ group_input_channels ^ group_output_channels ^ nr ^ kr ^ sr ^ ukernel_type ^ flags;
+  if (kc != 0) {
+    cache_seed ^= (uint32_t) kc << 16;
+  }
 
   if (use_weights_cache(convolution_op)) {
     struct xnn_weights_cache_look_up_key cache_key;
@@ -339,7 +358,8 @@ static enum xnn_status create_gemm_or_igemm(
       convolution_op->packed_weights.offset != XNN_CACHE_NOT_FOUND;
 
   const size_t packed_group_weights_size =
-      ((kernel_size * k_stride << log2_filter_element_size) + bias_element_size + extra_weights_bytes) * n_stride;
+      ((kernel_size * k_stride << log2_filter_element_size) + num_k_blocks * bias_element_size + extra_weights_bytes) *
+      n_stride;
   const size_t aligned_total_weights_size = round_up_po2(packed_group_weights_size * groups, XNN_ALLOCATION_ALIGNMENT);
   void* weights_ptr = NULL;
 
@@ -361,7 +381,8 @@ static enum xnn_status create_gemm_or_igemm(
   const uint32_t mr = gemm_config->mr;
   if (linear_activation && gemm_config->linear.gemm[mr - 1].function[XNN_UARCH_DEFAULT] != NULL) {
     gemm_ukernels = &gemm_config->linear;
-  } else if (relu_activation && gemm_config->relu.gemm[mr - 1].function[XNN_UARCH_DEFAULT] != NULL) {
+  } else if (relu_activation && kc == 0 && gemm_config->relu.gemm[mr - 1].function[XNN_UARCH_DEFAULT] != NULL) {
+    // Partial sums of blocked weights must not be clamped.
     gemm_ukernels = &gemm_config->relu;
   }
   switch (ukernel_type) {
@@ -387,6 +408,24 @@ static enum xnn_status create_gemm_or_igemm(
           // Kernel and bias have already been packed so prevent them from being
           // packed again below.
           weights_already_cached = true;
+        } else if (kc != 0) {
+          // Weights are packed as a whole first, then split in blocks.
+          const size_t unblocked_weights_size =
+            ((k_stride << log2_filter_element_size) + bias_element_size) * n_stride;
+          void* unblocked_weights = xnn_allocate_simd_memory(unblocked_weights_size);
+          if (unblocked_weights == NULL) {
+            xnn_log_error("failed to allocate %zu bytes for %s operator gemm packed weights",
+                unblocked_weights_size, xnn_operator_type_to_string(operator_type));
+            goto error;
+          }
+          pack_gemm_goi_w(groups, group_output_channels, group_input_channels,
+                          nr, kr, sr,
+                          kernel, bias, /*scale=*/NULL, unblocked_weights, /*extra_bytes=*/0,
+                          packing_params);
+          xnn_pack_gemm_weights_in_k_blocks(
+              group_output_channels, group_input_channels, kc, nr, kr * sr, log2_filter_element_size,
+              unblocked_weights, weights_ptr);
+          xnn_release_simd_memory(unblocked_weights);
         } else {
           pack_gemm_goi_w(groups, group_output_channels, group_input_channels,
                           nr, kr, sr,
@@ -399,6 +438,7 @@ static enum xnn_status create_gemm_or_igemm(
         .nr = nr,
         .kr = kr,
         .sr = sr,
+        .kc = kc,
       };
 
       assert(XNN_MAX_MR >= mr);
@@ -497,6 +537,134 @@ error:
   return status;
 }
 
+// Dense 3x3 stride-1 F32 convolutions with at least this many input and output channels use Winograd F(4x4, 3x3):
+// with fewer channels, the input and output transforms cost more than the 4x fewer multiplications save.
+#define XNN_WINOGRAD_MIN_CHANNELS 32
+
+static enum xnn_status create_winograd_path(
+    size_t input_channels,
+    size_t output_channels,
+    const float* kernel,
+    const float* bias,
+    uint32_t flags,
+    xnn_packw_gemm_goi_ukernel_fn pack_gemm_goi_w,
+    const void* winograd_params,
+    size_t winograd_params_size,
+    const struct xnn_gemm_config* gemm_config,
+    const struct xnn_winograd_config* winograd_config,
+    enum xnn_operator_type operator_type,
+    xnn_operator_t convolution_op,
+    size_t* zero_size)
+{
+  assert(winograd_config != NULL);
+  assert(winograd_params != NULL);
+
+  enum xnn_status status = xnn_status_out_of_memory;
+  float* transformed_kernel = NULL;
+
+  const uint32_t nr = gemm_config->nr;
+  const uint32_t kr = UINT32_C(1) << gemm_config->log2_kr;
+  const uint32_t sr = UINT32_C(1) << gemm_config->log2_sr;
+  const size_t n_stride = round_up(output_channels, nr);
+  const size_t k_stride = round_up_po2(input_channels, kr * sr);
+  const size_t positions = XNN_WINOGRAD_F4X4K3X3_INPUT_TILE * XNN_WINOGRAD_F4X4K3X3_INPUT_TILE;
+
+  // The transformed weights of each of the 36 positions are packed as a group of GEMM weights with zero bias, and
+  // followed by the bias which is added by the output transform.
+  const size_t packed_position_weights_size = ((k_stride + 1) * sizeof(float)) * n_stride;
+  const size_t packed_weights_size =
+    positions * packed_position_weights_size + output_channels * sizeof(float) + XNN_EXTRA_BYTES;
+  const size_t aligned_total_weights_size = round_up_po2(packed_weights_size, XNN_ALLOCATION_ALIGNMENT);
+  const uint32_t cache_seed =
+    input_channels ^ output_channels ^ nr ^ kr ^ sr ^ xnn_microkernel_type_winograd ^ flags;
+
+  if (use_weights_cache(convolution_op)) {
+    struct xnn_weights_cache_look_up_key cache_key;
+    cache_key.seed = cache_seed;
+    cache_key.kernel = kernel;
+    cache_key.bias = bias;
+    convolution_op->packed_weights.offset = xnn_weights_cache_look_up(
+        convolution_op->weights_cache, &cache_key);
+  }
+
+  const bool weights_already_cached = use_weights_cache(convolution_op) &&
+      convolution_op->packed_weights.offset != XNN_CACHE_NOT_FOUND;
+
+  if (!weights_already_cached) {
+    void* weights_ptr = xnn_get_pointer_to_write_weights(
+        convolution_op, aligned_total_weights_size, /*padding_byte=*/0);
+    if (weights_ptr == NULL) {
+      xnn_log_error("failed to reserve or allocated %zu bytes for %s operator winograd packed weights",
+                    aligned_total_weights_size, xnn_operator_type_to_string(operator_type));
+      goto error;
+    }
+    xnn_log_debug("allocated %zu bytes for packed weights in %s operator",
+                  aligned_total_weights_size, xnn_operator_type_to_string(operator_type));
+
+    const size_t transformed_kernel_size = positions * output_channels * input_channels * sizeof(float);
+    transformed_kernel = xnn_allocate_simd_memory(transformed_kernel_size);
+    if (transformed_kernel == NULL) {
+      xnn_log_error("failed to allocate %zu bytes for %s operator transformed weights",
+                    transformed_kernel_size, xnn_operator_type_to_string(operator_type));
+      goto error;
+    }
+    xnn_pack_f32_winograd_f4x4k3x3_w(output_channels, input_channels, kernel, transformed_kernel);
+    pack_gemm_goi_w(positions, output_channels, input_channels,
+                    nr, kr, sr,
+                    transformed_kernel, /*bias=*/NULL, /*scale=*/NULL, weights_ptr, /*extra_bytes=*/0,
+                    /*params=*/NULL);
+    xnn_release_simd_memory(transformed_kernel);
+    transformed_kernel = NULL;
+
+    float* packed_bias = (float*) ((uintptr_t) weights_ptr + positions * packed_position_weights_size);
+    if (bias != NULL) {
+      memcpy(packed_bias, bias, output_channels * sizeof(float));
+    } else {
+      memset(packed_bias, 0, output_channels * sizeof(float));
+    }
+
+    if (use_weights_cache(convolution_op)) {
+      struct xnn_weights_cache_look_up_key cache_key;
+      cache_key.seed = cache_seed;
+      cache_key.kernel = kernel;
+      cache_key.bias = bias;
+      convolution_op->packed_weights.offset = xnn_look_up_or_insert_weights_cache(
+          convolution_op->weights_cache, &cache_key, weights_ptr, aligned_total_weights_size);
+    }
+  }
+
+  memcpy(&convolution_op->params, winograd_params, winograd_params_size);
+  // Products in the Winograd domain are not clamped: the output transform clamps the final outputs.
+  if XNN_LIKELY(gemm_config->init.f32 != NULL) {
+    gemm_config->init.f32(&convolution_op->params2.f32_minmax, -INFINITY, INFINITY);
+  }
+
+  const uint32_t mr = gemm_config->mr;
+  const struct gemm_fused_ukernels* gemm_ukernels = &gemm_config->minmax;
+  if (gemm_config->linear.gemm[mr - 1].function[XNN_UARCH_DEFAULT] != NULL) {
+    gemm_ukernels = &gemm_config->linear;
+  }
+  convolution_op->ukernel.winograd = (struct xnn_ukernel_winograd) {
+    .input_transform = winograd_config->input_transform,
+    .output_transform = winograd_config->output_transform,
+    .mr = mr,
+    .nr = nr,
+    .kr = kr,
+    .sr = sr,
+  };
+  assert(XNN_MAX_MR >= mr);
+  for (size_t i = 0; i < mr; i++) {
+    convolution_op->ukernel.winograd.gemm_cases[i] = gemm_ukernels->gemm[i];
+  }
+
+  *zero_size = XNN_EXTRA_BYTES + input_channels * sizeof(float);
+  return xnn_status_success;
+
+error:
+  xnn_release_simd_memory(transformed_kernel);
+  return status;
+}
+
 static enum xnn_status create_convolution2d_nhwc(
     uint32_t input_padding_top,
     uint32_t input_padding_right,
@@ -539,9 +707,12 @@ static enum xnn_status create_convolution2d_nhwc(
     size_t dwconv_params_size,
     const void* vmulcaddc_params,
     size_t vmulcaddc_params_size,
+    const void* winograd_params,
+    size_t winograd_params_size,
     const struct xnn_gemm_config* gemm_config,
     const struct xnn_dwconv_config* dwconv_ukernel,
     const struct xnn_vmulcaddc_config* vmulcaddc_config,
+    const struct xnn_winograd_config* winograd_config,
     bool linear_activation,
     bool relu_activation,
     enum xnn_operator_type operator_type,
@@ -663,6 +834,11 @@ static enum xnn_status create_convolution2d_nhwc(
     ukernel_type = xnn_microkernel_type_vmulcaddc;
   } else if (group_input_channels == 1 && group_output_channels == 1 && dwconv_ukernel != NULL) {
     ukernel_type = xnn_microkernel_type_dwconv;
+  } else if (winograd_config != NULL && groups == 1 && kernel_height == 3 && kernel_width == 3 && unit_subsampling &&
+             (dilation_height | dilation_width) == 1 && (flags & XNN_FLAG_DEPTHWISE_CONVOLUTION) == 0 &&
+             group_input_channels >= XNN_WINOGRAD_MIN_CHANNELS && group_output_channels >= XNN_WINOGRAD_MIN_CHANNELS &&
+             !dynamic_quantization && gemm_config->pack_weights_and_biases == NULL && extra_weights_bytes == 0) {
+    ukernel_type = xnn_microkernel_type_winograd;
   } else if (kernel_size == 1 && unit_subsampling && !any_padding && !dynamic_quantization) {
     ukernel_type = xnn_microkernel_type_gemm;
   } else {
@@ -721,13 +897,30 @@ static enum xnn_status create_convolution2d_nhwc(
       }
       break;
     }
+    case xnn_microkernel_type_winograd:
+    {
+      status = create_winograd_path(
+          group_input_channels, group_output_channels,
+          kernel, bias, flags,
+          pack_gemm_goi_w,
+          winograd_params, winograd_params_size,
+          gemm_config, winograd_config,
+          operator_type,
+          convolution_op,
+          &zero_size);
+      if (status != xnn_status_success) {
+        goto error;
+      }
+      break;
+    }
     default:
       XNN_UNREACHABLE;
   }
 
   convolution_op->zero_size = 0;
   const bool tf_same_padding = (flags & XNN_FLAG_TENSORFLOW_SAME_PADDING) != 0 && kernel_size != 1;
-  if (any_padding || tf_same_padding) {
+  // Winograd tiles may extend past the input even without padding.
+  if (any_padding || tf_same_padding || ukernel_type == xnn_microkernel_type_winograd) {
     convolution_op->zero_size = zero_size;
     convolution_op->zero_buffer = xnn_allocate_simd_memory(zero_size);
     if (convolution_op->zero_buffer == NULL) {
@@ -865,9 +1058,12 @@ enum xnn_status create_convolution2d_nhwc_qx8_f16_qc8w(
     /*dwconv_params_size=*/0,
     /*vmulcaddc_params=*/NULL,
     /*vmulcaddc_params_size=*/0,
+    /*winograd_params=*/NULL,
+    /*winograd_params_size=*/0,
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/NULL,
     /*vmulcaddc_config=*/NULL,
+    /*winograd_config=*/NULL,
     /*linear_activation=*/false,
     /*relu_activation=*/false,
     /*operator_type=*/expected_operator_type,
@@ -1030,9 +1226,12 @@ enum xnn_status create_convolution2d_nhwc_qx8_f32_qc8w(
     /*dwconv_params_size=*/0,
     /*vmulcaddc_params=*/NULL,
     /*vmulcaddc_params_size=*/0,
+    /*winograd_params=*/NULL,
+    /*winograd_params_size=*/0,
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/NULL,
     /*vmulcaddc_config=*/NULL,
+    /*winograd_config=*/NULL,
     /*linear_activation=*/false,
     /*relu_activation=*/false,
     /*operator_type=*/expected_operator_type,
@@ -1240,9 +1439,12 @@ enum xnn_status xnn_create_convolution2d_nhwc_qu8(
     /*dwconv_params_size=*/sizeof(dwconv_params),
     /*vmulcaddc_params=*/NULL,
     /*vmulcaddc_params_size=*/0,
+    /*winograd_params=*/NULL,
+    /*winograd_params_size=*/0,
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/dwconv_ukernel,
     /*vmulcaddc_config=*/NULL,
+    /*winograd_config=*/NULL,
     /*linear_activation=*/false,
     /*relu_activation=*/false,
     /*operator_type=*/xnn_operator_type_convolution_nhwc_qu8,
@@ -1384,9 +1586,12 @@ enum xnn_status xnn_create_convolution2d_nhwc_qs8(
     /*dwconv_params_size=*/sizeof(dwconv_params),
     /*vmulcaddc_params=*/NULL,
     /*vmulcaddc_params_size=*/0,
+    /*winograd_params=*/NULL,
+    /*winograd_params_size=*/0,
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/dwconv_ukernel,
     /*vmulcaddc_config=*/NULL,
+    /*winograd_config=*/NULL,
     /*linear_activation=*/false,
     /*relu_activation=*/false,
     /*operator_type=*/xnn_operator_type_convolution_nhwc_qs8,
@@ -1536,9 +1741,12 @@ enum xnn_status xnn_create_convolution2d_nhwc_qs8_qc8w(
     /*dwconv_params_size=*/sizeof(dwconv_params),
     /*vmulcaddc_params=*/NULL,
     /*vmulcaddc_params_size=*/0,
+    /*winograd_params=*/NULL,
+    /*winograd_params_size=*/0,
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/dwconv_ukernel,
     /*vmulcaddc_config=*/NULL,
+    /*winograd_config=*/NULL,
     /*linear_activation=*/false,
     /*relu_activation=*/false,
     /*operator_type=*/xnn_operator_type_convolution_nhwc_qc8,
@@ -1684,9 +1892,12 @@ enum xnn_status xnn_create_convolution2d_nhwc_f16(
     /*dwconv_params_size=*/sizeof(dwconv_params),
     /*vmulcaddc_params=*/&vmulcaddc_params,
     /*vmulcaddc_params_size=*/sizeof(vmulcaddc_params),
+    /*winograd_params=*/NULL,
+    /*winograd_params_size=*/0,
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/dwconv_ukernel,
     /*vmulcaddc_config=*/vmulcaddc_config,
+    /*winograd_config=*/NULL,
     /*linear_activation=*/false,
     /*relu_activation=*/false,
     /*operator_type=*/xnn_operator_type_convolution_nhwc_f16,
@@ -1776,6 +1987,13 @@ enum xnn_status create_convolution2d_nhwc_f32(
     vmulcaddc_config->init.f32(&vmulcaddc_params, output_min, output_max);
   }
 
+  // Winograd is optional: convolutions use IGEMM on hardware without Winograd transforms.
+  const struct xnn_winograd_config* winograd_config = xnn_init_f32_winograd_config();
+  union xnn_f32_minmax_params winograd_params;
+  if (winograd_config != NULL && winograd_config->init.f32 != NULL) {
+    winograd_config->init.f32(&winograd_params, output_min, output_max);
+  }
+
   return create_convolution2d_nhwc(
     input_padding_top, input_padding_right, input_padding_bottom, input_padding_left,
     kernel_height, kernel_width,
@@ -1807,9 +2025,12 @@ enum xnn_status create_convolution2d_nhwc_f32(
     /*dwconv_params_size=*/sizeof(dwconv_params),
     /*vmulcaddc_params=*/&vmulcaddc_params,
     /*vmulcaddc_params_size=*/sizeof(vmulcaddc_params),
+    /*winograd_params=*/&winograd_params,
+    /*winograd_params_size=*/sizeof(winograd_params),
     /*gemm_config=*/gemm_config,
     /*dwconv_ukernel=*/dwconv_ukernel,
     /*vmulcaddc_config=*/vmulcaddc_config,
+    /*winograd_config=*/winograd_config,
     /*linear_activation=*/linear_activation,
     /*relu_activation=*/relu_activation,
     /*operator_type=*/xnn_operator_type_convolution_nhwc_f32,
@@ -2083,6 +2304,7 @@ static enum xnn_status reshape_gemm(
       .log2_csize = log2_output_element_size,
       .num_batch_dims = 1,
       .ukernel = gemm_ukernel,
+      .epilogue = convolution_op->gemm_epilogue.num_steps != 0 ? &convolution_op->gemm_epilogue : NULL,
   };
   convolution_op->context.gemm.gemm.gemm.batch_dims_a[0] = groups;
   convolution_op->context.gemm.gemm.gemm.batch_dims_b[0] = groups;
@@ -2093,7 +2315,11 @@ static enum xnn_status reshape_gemm(
   size_t nc = xnn_gemm_best_nc(groups, batch_output_size, group_output_channels,
                                mr, nr, num_threads);
 
-  if (groups == 1) {
+  if (convolution_op->ukernel.gemm.kc != 0) {
+    assert(groups == 1);
+    xnn_reshape_gemm_k_blocked(
+        convolution_op, batch_output_size, group_output_channels, mr, log2_input_element_size, num_threads);
+  } else if (groups == 1) {
     #if XNN_MAX_UARCH_TYPES > 1
       if (xnn_is_hmp_gemm_ukernel(gemm_ukernel)) {
         convolution_op->compute[0].type = xnn_parallelization_type_2d_tile_2d_with_uarch;
@@ -2267,6 +2493,7 @@ static enum xnn_status reshape_igemm(
       .bc_stride = output_size * convolution_op->output_pixel_stride << log2_output_element_size,
       .log2_csize = log2_output_element_size,
       .ukernel = igemm_ukernel,
+      .epilogue = convolution_op->gemm_epilogue.num_steps != 0 ? &convolution_op->gemm_epilogue : NULL,
   };
   memcpy(&convolution_op->context.igemm.igemm.params, &convolution_op->params, sizeof(convolution_op->context.igemm.igemm.params));
 
@@ -2622,6 +2849,154 @@ static enum xnn_status reshape_vmulcaddc(
   return xnn_status_success;
 }
 
+// Size of the transformed input at the start of the workspace of Winograd convolutions, followed by the products of
+// the transformed input and weights.
+static inline size_t winograd_transformed_input_size(size_t position_stride)
+{
+  const size_t positions = XNN_WINOGRAD_F4X4K3X3_INPUT_TILE * XNN_WINOGRAD_F4X4K3X3_INPUT_TILE;
+  return round_up_po2(positions * position_stride + XNN_EXTRA_BYTES, XNN_ALLOCATION_ALIGNMENT);
+}
+
+static enum xnn_status reshape_winograd(
+  xnn_operator_t convolution_op,
+  size_t* workspace_size,
+  size_t* workspace_alignment,
+  size_t num_threads)
+{
+  const size_t batch_size = convolution_op->batch_size;
+  const size_t output_height = convolution_op->output_height;
+  const size_t output_width = convolution_op->output_width;
+  const size_t input_channels = convolution_op->group_input_channels;
+  const size_t output_channels = convolution_op->group_output_channels;
+  const size_t tiles_width = divide_round_up(output_width, XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE);
+  const size_t tiles_per_image = divide_round_up(output_height, XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE) * tiles_width;
+  const size_t positions = XNN_WINOGRAD_F4X4K3X3_INPUT_TILE * XNN_WINOGRAD_F4X4K3X3_INPUT_TILE;
+  // Rows of each of the GEMMs in the Winograd domain.
+  const size_t tiles = batch_size * tiles_per_image;
+
+  const size_t input_position_stride = tiles * input_channels * sizeof(float);
+  const size_t output_position_stride = tiles * output_channels * sizeof(float);
+  *workspace_size = winograd_transformed_input_size(input_position_stride) +
+    positions * output_position_stride + XNN_EXTRA_BYTES;
+  *workspace_alignment = XNN_ALLOCATION_ALIGNMENT;
+
+  uint32_t mr = convolution_op->ukernel.winograd.mr;
+  const uint32_t nr = convolution_op->ukernel.winograd.nr;
+  const uint32_t kr = convolution_op->ukernel.winograd.kr;
+  const uint32_t sr = convolution_op->ukernel.winograd.sr;
+  struct xnn_hmp_gemm_ukernel* gemm_cases = convolution_op->ukernel.winograd.gemm_cases;
+
+  #if XNN_ENABLE_GEMM_M_SPECIALIZATION
+    mr = xnn_get_heuristic_mr_gemm(tiles, mr, nr, gemm_cases);
+  #else
+    if (tiles == 1 && gemm_cases[0].function[XNN_UARCH_DEFAULT] != NULL) {
+      mr = 1;
+    }
+  #endif
+
+  const size_t n_stride = round_up(output_channels, nr);
+  const size_t w_stride = (round_up_po2(input_channels, kr * sr) + 1) * sizeof(float);
+  const void* weights = packed_weights(convolution_op);
+
+  convolution_op->context.winograd.input_transform = (struct winograd_input_transform_context) {
+    .input_pixel_stride = convolution_op->input_pixel_stride * sizeof(float),
+    .input_batch_stride = convolution_op->input_height * convolution_op->input_width *
+      convolution_op->input_pixel_stride * sizeof(float),
+    .input_height = convolution_op->input_height,
+    .input_width = convolution_op->input_width,
+    .input_padding_top = convolution_op->padding_top,
+    .input_padding_left = convolution_op->padding_left,
+    .zero = convolution_op->zero_buffer,
+    .tiles_width = tiles_width,
+    .tiles_per_image = tiles_per_image,
+    .channels = input_channels * sizeof(float),
+    .output_position_stride = input_position_stride,
+    .output_tile_stride = input_channels * sizeof(float),
+    .ukernel = convolution_op->ukernel.winograd.input_transform,
+  };
+
+  convolution_op->context.winograd.gemm = (struct gemm_context) {
+    .k_scaled = input_channels * sizeof(float),
+    .a_stride = input_channels * sizeof(float),
+    .ga_stride = input_position_stride,
+    .packed_w = weights,
+    .w_stride = w_stride,
+    .gw_stride = w_stride * n_stride,
+    .cm_stride = output_channels * sizeof(float),
+    .cn_stride = nr * sizeof(float),
+    .gc_stride = output_position_stride,
+    .log2_csize = XNN_LOG2_SIZEOF_FLOAT,
+    .num_batch_dims = 1,
+    .mr = mr,
+    .kr = kr,
+    .sr = sr,
+    .ukernel = gemm_cases[mr - 1],
+  };
+  convolution_op->context.winograd.gemm.batch_dims_a[0] = positions;
+  convolution_op->context.winograd.gemm.batch_dims_b[0] = positions;
+  convolution_op->context.winograd.gemm.batch_strides_c[0] = 1;
+  memcpy(&convolution_op->context.winograd.gemm.params, &convolution_op->params2.f32_minmax,
+         sizeof(convolution_op->params2.f32_minmax));
+
+  convolution_op->context.winograd.output_transform = (struct winograd_output_transform_context) {
+    .input_position_stride = output_position_stride,
+    .input_tile_stride = output_channels * sizeof(float),
+    .bias = (const void*) ((uintptr_t) weights + positions * w_stride * n_stride),
+    .output_pixel_stride = convolution_op->output_pixel_stride * sizeof(float),
+    .output_row_stride = output_width * convolution_op->output_pixel_stride * sizeof(float),
+    .output_batch_stride = output_height * output_width * convolution_op->output_pixel_stride * sizeof(float),
+    .output_height = output_height,
+    .output_width = output_width,
+    .tiles_width = tiles_width,
+    .tiles_per_image = tiles_per_image,
+    .channels = output_channels * sizeof(float),
+    .ukernel = convolution_op->ukernel.winograd.output_transform,
+    .epilogue = convolution_op->gemm_epilogue.num_steps != 0 ? &convolution_op->gemm_epilogue : NULL,
+  };
+  memcpy(&convolution_op->context.winograd.output_transform.params, &convolution_op->params,
+         sizeof(convolution_op->context.winograd.output_transform.params));
+
+  convolution_op->compute[0].type = xnn_parallelization_type_2d;
+  convolution_op->compute[0].context_offset =
+    offsetof(struct xnn_operator, context.winograd.input_transform) - offsetof(struct xnn_operator, context);
+  convolution_op->compute[0].task_2d = (pthreadpool_task_2d_t) xnn_compute_winograd_input_transform;
+  convolution_op->compute[0].range[0] = batch_size;
+  convolution_op->compute[0].range[1] = tiles_per_image;
+
+  const size_t nc = xnn_gemm_best_nc(positions, tiles, output_channels, mr, nr, num_threads);
+  #if XNN_MAX_UARCH_TYPES > 1
+    if (xnn_is_hmp_gemm_ukernel(gemm_cases[mr - 1])) {
+      convolution_op->compute[1].type = xnn_parallelization_type_3d_tile_2d_with_uarch;
+      convolution_op->compute[1].task_3d_tile_2d_with_id =
+        (pthreadpool_task_3d_tile_2d_with_id_t) xnn_compute_hmp_grouped_gemm;
+    } else {
+      convolution_op->compute[1].type = xnn_parallelization_type_3d_tile_2d;
+      convolution_op->compute[1].task_3d_tile_2d = (pthreadpool_task_3d_tile_2d_t) xnn_compute_grouped_gemm;
+    }
+  #else
+    convolution_op->compute[1].type = xnn_parallelization_type_3d_tile_2d;
+    convolution_op->compute[1].task_3d_tile_2d = (pthreadpool_task_3d_tile_2d_t) xnn_compute_grouped_gemm;
+  #endif
+  convolution_op->compute[1].context_offset =
+    offsetof(struct xnn_operator, context.winograd.gemm) - offsetof(struct xnn_operator, context);
+  convolution_op->compute[1].range[0] = positions;
+  convolution_op->compute[1].range[1] = tiles;
+  convolution_op->compute[1].range[2] = output_channels;
+  convolution_op->compute[1].tile[0] = mr;
+  convolution_op->compute[1].tile[1] = nc;
+
+  convolution_op->compute[2].type = xnn_parallelization_type_2d;
+  convolution_op->compute[2].context_offset =
+    offsetof(struct xnn_operator, context.winograd.output_transform) - offsetof(struct xnn_operator, context);
+  convolution_op->compute[2].task_2d = (pthreadpool_task_2d_t) xnn_compute_winograd_output_transform;
+  convolution_op->compute[2].range[0] = batch_size;
+  convolution_op->compute[2].range[1] = tiles_per_image;
+
+  convolution_op->state = xnn_run_state_needs_setup;
+
+  return xnn_status_success;
+}
+
 static enum xnn_status reshape_convolution2d_nhwc(
   xnn_operator_t convolution_op,
   enum xnn_operator_type expected_operator_type,
@@ -2728,6 +3103,10 @@ static enum xnn_status reshape_convolution2d_nhwc(
           convolution_op,
           log2_input_element_size, log2_output_element_size,
           workspace_size, workspace_alignment, num_threads);
+    case xnn_microkernel_type_winograd:
+      return reshape_winograd(
+          convolution_op,
+          workspace_size, workspace_alignment, num_threads);
     default:
       XNN_UNREACHABLE;
   }
@@ -3071,6 +3450,22 @@ static enum xnn_status setup_vmulcaddc(xnn_operator_t convolution_op)
   return xnn_status_success;
 }
 
+static enum xnn_status setup_winograd(xnn_operator_t convolution_op, void* workspace)
+{
+  assert(workspace != NULL);
+  void* transformed_output = (void*) ((uintptr_t) workspace +
+    winograd_transformed_input_size(convolution_op->context.winograd.input_transform.output_position_stride));
+  convolution_op->context.winograd.input_transform.input = convolution_op->input;
+  convolution_op->context.winograd.input_transform.output = workspace;
+  convolution_op->context.winograd.gemm.a = workspace;
+  convolution_op->context.winograd.gemm.c = transformed_output;
+  convolution_op->context.winograd.output_transform.input = transformed_output;
+  convolution_op->context.winograd.output_transform.output = convolution_op->output;
+  convolution_op->state = xnn_run_state_ready;
+
+  return xnn_status_success;
+}
+
 static enum xnn_status setup_convolution2d_nhwc(
   xnn_operator_t convolution_op,
   enum xnn_operator_type expected_operator_type,
@@ -3121,6 +3516,8 @@ static enum xnn_status setup_convolution2d_nhwc(
       return setup_dwconv(convolution_op, workspace, log2_input_element_size);
     case xnn_microkernel_type_vmulcaddc:
       return setup_vmulcaddc(convolution_op);
+    case xnn_microkernel_type_winograd:
+      return setup_winograd(convolution_op, workspace);
     default:
       XNN_UNREACHABLE;
   }
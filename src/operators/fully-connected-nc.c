@@ -20,6 +20,8 @@
 #include "xnnpack/common.h"
 #include "xnnpack/compute.h"
 #include "xnnpack/config.h"
+#include "xnnpack/gemm-tuning.h"
+#include "xnnpack/jit.h"
 #include "xnnpack/log.h"
 #include "xnnpack/math.h"
 #include "xnnpack/microfnptr.h"
@@ -158,7 +160,21 @@ static enum xnn_status create_fully_connected_nc(
                 gemm_config, input_channels, block_wise ? block_size : k_stride, extra_weights_bytes)
           : (k_stride << log2_filter_element_size) + bias_element_size +
                 extra_weights_bytes + block_scale_bytes;
-  const size_t packed_weights_size = n_stride * weights_stride;
+
+  // Large F32 weights are blocked along K, so that a panel of each block stays in L2 cache while it is multiplied with
+  // all rows of the input. Each block has its own bias, see xnn_pack_gemm_weights_in_k_blocks.
+  size_t kc = 0;
+  if (operator_type == xnn_operator_type_fully_connected_nc_f32 && gemm_config->pack_weights_and_biases == NULL) {
+    const struct xnn_hardware_config* hardware_config = xnn_init_hardware_config();
+    assert(hardware_config != NULL);
+    kc = xnn_gemm_best_kc(k_stride, nr, kr * sr, log2_filter_element_size, hardware_config->l2_data_cache_bytes);
+    if (kc == k_stride) {
+      kc = 0;
+    }
+  }
+  const size_t num_k_blocks = kc != 0 ? divide_round_up(k_stride, kc) : 1;
+
+  const size_t packed_weights_size = n_stride * (weights_stride + (num_k_blocks - 1) * bias_element_size);
   fully_connected_op->weights_stride = weights_stride;
   size_t aligned_total_weights_size = round_up_po2(packed_weights_size, XNN_ALLOCATION_ALIGNMENT);
 
@@ -166,6 +182,9 @@ static enum xnn_status create_fully_connected_nc(
   if (flags & XNN_FLAG_TRANSPOSE_WEIGHTS) {
     cache_seed = ~cache_seed;
   }
+  if (kc != 0) {
+    cache_seed ^= (uint32_t) kc << 16;
+  }
   size_t cache_offset = XNN_CACHE_NOT_FOUND;
   struct xnn_weights_cache_look_up_key cache_key;
   cache_key.seed = cache_seed;
@@ -215,13 +234,24 @@ static enum xnn_status create_fully_connected_nc(
               bias, weights_start);
       }
     } else {
+      // Blocked weights are packed as a whole first, then split in blocks.
+      void* pack_ptr = weights_ptr;
+      if (kc != 0) {
+        pack_ptr = xnn_allocate_simd_memory(n_stride * weights_stride);
+        if (pack_ptr == NULL) {
+          xnn_log_error(
+            "failed to allocate %zu bytes for %s operator packed weights",
+            n_stride * weights_stride, xnn_operator_type_to_string(operator_type));
+          goto error;
+        }
+      }
       if (flags & XNN_FLAG_TRANSPOSE_WEIGHTS) {
         pack_gemm_gio_w(
           /*groups=*/1, output_channels, input_channels,
           nr, kr, sr,
           output_channels,
           kernel, bias, /*scale=*/NULL,
-          weights_ptr,
+          pack_ptr,
           gemm_config->nr * extra_weights_bytes,
           packing_params);
       } else {
@@ -239,11 +269,16 @@ static enum xnn_status create_fully_connected_nc(
             /*groups=*/1, output_channels, input_channels,
             nr, kr, sr,
             kernel, bias, /*scale=*/NULL,
-            weights_ptr,
+            pack_ptr,
             gemm_config->nr * extra_weights_bytes,
             packing_params);
         }
       }
+      if (kc != 0) {
+        xnn_pack_gemm_weights_in_k_blocks(
+          output_channels, input_channels, kc, nr, kr * sr, log2_filter_element_size, pack_ptr, weights_ptr);
+        xnn_release_simd_memory(pack_ptr);
+      }
       if (kernel_scale_params != NULL) {
         assert(init_kernel_scale_params != NULL);
 
@@ -320,11 +355,20 @@ static enum xnn_status create_fully_connected_nc(
       .kr = kr,
       .sr = sr,
       .kp = planes,
+      .kc = kc,
   };
   assert(XNN_MAX_MR >= mr);
   for (size_t i = 0; i < mr; i++) {
     fully_connected_op->ukernel.gemm.gemm_cases[i] = gemm_ukernels->gemm[i];
   }
+  if ((flags & XNN_FLAG_AUTOTUNE) && gemm_ukernels == &gemm_config->minmax) {
+    // Microkernels of other MR are only considered by the tuner, see reshape_fully_connected_nc.
+    for (size_t i = 0; i < XNN_MAX_MR; i++) {
+      if (fully_connected_op->ukernel.gemm.gemm_cases[i].function[XNN_UARCH_DEFAULT] == NULL) {
+        fully_connected_op->ukernel.gemm.gemm_cases[i] = gemm_config->minmax_tuning[i];
+      }
+    }
+  }
 
   fully_connected_op->state = xnn_run_state_invalid;
 
@@ -336,6 +380,79 @@ error:
   return status;
 }
 
+enum xnn_status xnn_create_fully_connected_nc_bf16_f32(
+    size_t input_channels,
+    size_t output_channels,
+    size_t input_stride,
+    size_t output_stride,
+    const void* kernel,
+    const float* bias,
+    float output_min,
+    float output_max,
+    uint32_t flags,
+    xnn_code_cache_t code_cache,
+    xnn_weights_cache_t weights_cache,
+    xnn_operator_t* fully_connected_op_out)
+{
+  if (isnan(output_min)) {
+    xnn_log_error(
+      "failed to create %s operator with NaN output lower bound: lower bound must be non-NaN",
+      xnn_operator_type_to_string(xnn_operator_type_fully_connected_nc_bf16_f32));
+    return xnn_status_invalid_parameter;
+  }
+
+  if (isnan(output_max)) {
+    xnn_log_error(
+      "failed to create %s operator with NaN output upper bound: upper bound must be non-NaN",
+      xnn_operator_type_to_string(xnn_operator_type_fully_connected_nc_bf16_f32));
+    return xnn_status_invalid_parameter;
+  }
+
+  if (output_min > output_max) {
+    xnn_log_error(
+      "failed to create %s operator with [%.7g, %.7g] output range: lower bound must be less than or equal to upper bound",
+      xnn_operator_type_to_string(xnn_operator_type_fully_connected_nc_bf16_f32), output_min, output_max);
+    return xnn_status_invalid_parameter;
+  }
+
+  const struct xnn_gemm_config* gemm_config = xnn_init_bf16_f32_gemm_config();
+  if (gemm_config == NULL) {
+    xnn_log_error("failed to create %s operator: unsupported hardware configuration",
+                  xnn_operator_type_to_string(xnn_operator_type_fully_connected_nc_bf16_f32));
+    return xnn_status_unsupported_hardware;
+  }
+
+  union xnn_f32_minmax_params params;
+  if XNN_LIKELY(gemm_config->init.f32 != NULL) {
+    gemm_config->init.f32(&params, output_min, output_max);
+  }
+
+  return create_fully_connected_nc(
+    input_channels, output_channels,
+    input_stride, output_stride,
+    kernel, bias, flags,
+    /*block_size=*/0,
+    /*extra_bl_bytes=*/0,
+    /*blockwise_kernel_scale_params=*/NULL,
+    /*log2_input_element_size=*/XNN_LOG2_SIZEOF_HALF,
+    /*log2_filter_element_size=*/XNN_LOG2_SIZEOF_HALF,
+    /*filter_is_nibble=*/false,
+    /*bias_element_size=*/sizeof(float),
+    (xnn_packw_gemm_gio_ukernel_fn) gemm_config->pack_gemm_gio,
+    (xnn_packw_gemm_goi_ukernel_fn) gemm_config->pack_gemm_goi,
+    /*pack_gemm_goi_bl_w=*/NULL,
+    /*packing_params=*/NULL,
+    /*packed_weights_padding_byte=*/0,
+    /*extra_weights_bytes=*/0,
+    /*init_scale_params=*/NULL, /*scale_params=*/NULL,
+    /*init_kernel_scale_params=*/NULL, /*kernel_scale_params=*/NULL,
+    &params, sizeof(params),
+    gemm_config, &gemm_config->minmax,
+    xnn_operator_type_fully_connected_nc_bf16_f32,
+    /*weights_cache=*/weights_cache,
+    fully_connected_op_out);
+}
+
 enum xnn_status xnn_create_fully_connected_nc_f16(
     size_t input_channels,
     size_t output_channels,
@@ -1571,6 +1688,55 @@ enum xnn_status xnn_create_fully_connected_nc_f32_f16(
   return status;
 }
 
+// Replaces the GEMM microkernels of an F32 fully connected operator with microkernels generated for its number of
+// input channels, strides and output range. Keeps the static microkernels if they can not be generated.
+static void jit_fully_connected_nc_f32(
+    xnn_operator_t fully_connected_op,
+    float output_min,
+    float output_max,
+    xnn_code_cache_t code_cache)
+{
+  struct xnn_ukernel_gemm* gemm = &fully_connected_op->ukernel.gemm;
+  // Generated microkernels read the whole K of unblocked weights packed with kr = sr = 1.
+  if (gemm->kc != 0 || gemm->kr != 1 || gemm->sr != 1) {
+    return;
+  }
+  // Generated microkernels keep a row of NR outputs in vector registers, wide NR leaves room for few rows only. Do not
+  // trade more than half of the rows of the static microkernel for the specialization.
+  const enum xnn_jit_x64_isa isa =
+    xnn_jit_x64_isa_supported(xnn_jit_x64_isa_avx512f) && gemm->nr % 16 == 0 ? xnn_jit_x64_isa_avx512f
+                                                                              : xnn_jit_x64_isa_avx2;
+  const size_t mr = min(gemm->mr, xnn_jit_f32_gemm_max_mr(isa, gemm->nr));
+  if (mr == 0 || 2 * mr < gemm->mr) {
+    return;
+  }
+
+  struct xnn_jit_f32_gemm_params params = {
+    .isa = isa,
+    .mr = mr,
+    .nr = gemm->nr,
+    .kc = fully_connected_op->group_input_channels,
+    .a_stride = fully_connected_op->input_pixel_stride * sizeof(float),
+    .cm_stride = fully_connected_op->output_pixel_stride * sizeof(float),
+    .min = output_min,
+    .max = output_max,
+  };
+  const xnn_f32_gemm_minmax_ukernel_fn gemm_mr = xnn_jit_f32_gemm_minmax(code_cache, &params);
+  params.mr = 1;
+  const xnn_f32_gemm_minmax_ukernel_fn gemm_1 = mr == 1 ? gemm_mr : xnn_jit_f32_gemm_minmax(code_cache, &params);
+  if (gemm_mr == NULL || gemm_1 == NULL) {
+    xnn_log_debug("failed to generate microkernels for %s operator, using static microkernels",
+      xnn_operator_type_to_string(fully_connected_op->type));
+    return;
+  }
+
+  memset(gemm->gemm_cases, 0, sizeof(gemm->gemm_cases));
+  gemm->gemm_cases[0] = xnn_init_hmp_gemm_ukernel((xnn_gemm_ukernel_fn) gemm_1);
+  gemm->gemm_cases[mr - 1] = xnn_init_hmp_gemm_ukernel((xnn_gemm_ukernel_fn) gemm_mr);
+  gemm->mr = mr;
+  fully_connected_op->code_cache = code_cache;
+}
+
 enum xnn_status create_fully_connected_nc_f32(
     size_t input_channels,
     size_t output_channels,
@@ -1618,7 +1784,7 @@ enum xnn_status create_fully_connected_nc_f32(
     gemm_config->init.f32(&params, output_min, output_max);
   }
 
-  return create_fully_connected_nc(
+  enum xnn_status status = create_fully_connected_nc(
     input_channels, output_channels,
     input_stride, output_stride,
     kernel, bias, flags,
@@ -1642,6 +1808,10 @@ enum xnn_status create_fully_connected_nc_f32(
     xnn_operator_type_fully_connected_nc_f32,
     /*weights_cache=*/weights_cache,
     fully_connected_op_out);
+  if (status == xnn_status_success && code_cache != NULL && gemm_config->pack_weights_and_biases == NULL) {
+    jit_fully_connected_nc_f32(*fully_connected_op_out, output_min, output_max, code_cache);
+  }
+  return status;
 }
 
 enum xnn_status xnn_create_fully_connected_nc_f32(
@@ -2232,8 +2402,6 @@ static enum xnn_status reshape_fully_connected_nc(
     mr = 1;
   }
 
-  assert(mr != 0 && mr <= XNN_MAX_MR);
-  struct xnn_hmp_gemm_ukernel gemm_ukernel = gemm_cases[mr - 1];
   if (filter_is_nibble) {
     const uint32_t planes = fully_connected_op->ukernel.gemm.kp;
     input_channels = round_up_po2(input_channels, planes);
@@ -2247,6 +2415,27 @@ static enum xnn_status reshape_fully_connected_nc(
       (fully_connected_op->type ==
        xnn_operator_type_fully_connected_nc_qp8_f32_qb4w);
 
+  // Dynamically quantized microkernels take additional arguments, and K-blocked weights are not read by whole rows.
+  if ((fully_connected_op->flags & XNN_FLAG_AUTOTUNE) && !dynamic_quantization && !is_qp8_ukernel &&
+      fully_connected_op->ukernel.gemm.kc == 0) {
+    const struct xnn_gemm_tuning_problem problem = {
+      .operator_type = fully_connected_op->type,
+      .m = batch_size,
+      .n = output_channels,
+      .k = fully_connected_op->group_input_channels,
+      .k_scaled = input_channels << log2_input_element_size,
+      .nr = nr,
+      .log2_input_element_size = log2_input_element_size,
+      .log2_output_element_size = log2_output_element_size,
+      .packed_weights = packed_weights(fully_connected_op),
+      .params = params,
+    };
+    mr = xnn_gemm_tuning_select_mr(&problem, gemm_cases, mr);
+  }
+
+  assert(mr != 0 && mr <= XNN_MAX_MR);
+  struct xnn_hmp_gemm_ukernel gemm_ukernel = gemm_cases[mr - 1];
+
   fully_connected_op->context.gemm.gemm.gemm = (struct gemm_context){
       .k_scaled = input_channels << log2_input_element_size,
       .w_stride = fully_connected_op->weights_stride,
@@ -2265,10 +2454,19 @@ static enum xnn_status reshape_fully_connected_nc(
       .mr = mr,
       .kr = fully_connected_op->ukernel.gemm.kr,
       .sr = fully_connected_op->ukernel.gemm.sr,
+      .epilogue = fully_connected_op->gemm_epilogue.num_steps != 0 ? &fully_connected_op->gemm_epilogue : NULL,
   };
   memcpy(&fully_connected_op->context.gemm.gemm.gemm.params, params, params_size);
   fully_connected_op->context.gemm.gemm.gemm.fused_params = &fully_connected_op->context.gemm.gemm.gemm.params;
 
+  if (fully_connected_op->ukernel.gemm.kc != 0) {
+    xnn_reshape_gemm_k_blocked(
+      fully_connected_op, batch_size, output_channels, mr, log2_input_element_size,
+      pthreadpool_get_threads_count(threadpool));
+    fully_connected_op->state = xnn_run_state_needs_setup;
+    return xnn_status_success;
+  }
+
   size_t nc =
       xnn_gemm_best_nc(/*num_groups=*/1, batch_size, output_channels, mr, nr,
                        pthreadpool_get_threads_count(threadpool));
@@ -2315,6 +2513,24 @@ static enum xnn_status reshape_fully_connected_nc(
     return xnn_status_success;
 }
 
+enum xnn_status xnn_reshape_fully_connected_nc_bf16_f32(
+    xnn_operator_t fully_connected_op,
+    size_t batch_size,
+    pthreadpool_t threadpool)
+{
+  return reshape_fully_connected_nc(
+    fully_connected_op, xnn_operator_type_fully_connected_nc_bf16_f32,
+    batch_size,
+    /*log2_input_element_size=*/XNN_LOG2_SIZEOF_HALF,
+    /*log2_filter_element_size=*/XNN_LOG2_SIZEOF_HALF,
+    /*filter_is_nibble=*/false,
+    /*dynamic_quantization=*/false,
+    /*log2_output_element_size=*/XNN_LOG2_SIZEOF_FLOAT,
+    &fully_connected_op->params.f32_minmax,
+    sizeof(fully_connected_op->params.f32_minmax),
+    threadpool);
+}
+
 enum xnn_status xnn_reshape_fully_connected_nc_f16(
     xnn_operator_t fully_connected_op,
     size_t batch_size,
@@ -2749,6 +2965,16 @@ static enum xnn_status setup_fully_connected_nc(
   return xnn_status_success;
 }
 
+enum xnn_status xnn_setup_fully_connected_nc_bf16_f32(
+    xnn_operator_t fully_connected_op,
+    const void* input,
+    float* output)
+{
+  return setup_fully_connected_nc(
+    fully_connected_op, xnn_operator_type_fully_connected_nc_bf16_f32,
+    input, output, /*quantization_params=*/NULL);
+}
+
 enum xnn_status xnn_setup_fully_connected_nc_f16(
     xnn_operator_t fully_connected_op,
     const void* input,
@@ -0,0 +1,310 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/allocator.h"
+#include "xnnpack/common.h"
+#include "xnnpack/compute.h"
+#include "xnnpack/config-types.h"
+#include "xnnpack/datatype.h"
+#include "xnnpack/internal.h"
+#include "xnnpack/log.h"
+#include "xnnpack/math.h"
+#include "xnnpack/microparams.h"
+#include "xnnpack/operator-type.h"
+#include "xnnpack/operator.h"
+#include "xnnpack/params.h"
+#include "pthreadpool.h"
+
+// Initializes the micro-kernel and parameters of a step from a temporary unary or binary operator, so that the fused
+// operator uses the same kernels and parameters as the unfused operators.
+static enum xnn_status init_step(
+  enum xnn_datatype datatype,
+  const struct xnn_fused_elementwise_step* step,
+  struct fused_elementwise_step_context* step_context)
+{
+  const struct xnn_quantization_params quantization = {0};
+  xnn_operator_t op = NULL;
+  enum xnn_status status;
+  if (step->binary_operator == xnn_binary_invalid) {
+    status = xnn_create_unary_elementwise_nc(
+      step->unary_operator, datatype, datatype, &step->unary_params, &quantization, &quantization,
+      /*flags=*/0, &op);
+    if (status != xnn_status_success) {
+      return status;
+    }
+    assert(op->unary_elementwise_config != NULL);
+    step_context->unary_ukernel = op->unary_elementwise_config->ukernel;
+    memcpy(&step_context->params.unary, &op->params.unary, sizeof(op->params.unary));
+  } else {
+    status = xnn_create_binary_elementwise_nd(
+      step->binary_operator, datatype, &quantization, &quantization, &quantization, /*flags=*/0, &op);
+    if (status != xnn_status_success) {
+      return status;
+    }
+    assert(op->binary_elementwise_config != NULL);
+    step_context->binary_config = op->binary_elementwise_config;
+    // Parameters of floating-point operators do not depend on the order of the operands.
+    memcpy(&step_context->params.binary, &op->params.binary, sizeof(op->params.binary));
+    step_context->operand = step->operand;
+    step_context->operand_first = step->operand_first;
+  }
+  xnn_delete_operator(op);
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_create_fused_elementwise_nc(
+  enum xnn_datatype datatype,
+  size_t num_steps,
+  const struct xnn_fused_elementwise_step* steps,
+  uint32_t flags,
+  xnn_operator_t* fused_elementwise_op_out)
+{
+  xnn_operator_t fused_elementwise_op = NULL;
+  enum xnn_status status = xnn_status_uninitialized;
+
+  if ((xnn_params.init_flags & XNN_INIT_FLAG_XNNPACK) == 0) {
+    xnn_log_error("failed to create %s operator: XNNPACK is not initialized",
+      xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc));
+    goto error;
+  }
+
+  status = xnn_status_invalid_parameter;
+
+  if (datatype != xnn_datatype_fp32 && datatype != xnn_datatype_fp16) {
+    xnn_log_error("failed to create %s operator: unsupported datatype %s",
+      xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc), xnn_datatype_to_string(datatype));
+    goto error;
+  }
+
+  if (num_steps == 0 || num_steps > XNN_MAX_FUSED_ELEMENTWISE_STEPS) {
+    xnn_log_error(
+      "failed to create %s operator with %zu steps: number of steps must be in [1, %d] range",
+      xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc), num_steps,
+      XNN_MAX_FUSED_ELEMENTWISE_STEPS);
+    goto error;
+  }
+
+  for (size_t i = 0; i < num_steps; i++) {
+    if (steps[i].binary_operator != xnn_binary_invalid && steps[i].operand >= XNN_MAX_FUSED_ELEMENTWISE_INPUTS) {
+      xnn_log_error(
+        "failed to create %s operator: step #%zu reads operand from invalid input #%" PRIu32,
+        xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc), i, steps[i].operand);
+      goto error;
+    }
+  }
+
+  status = xnn_status_out_of_memory;
+
+  fused_elementwise_op = xnn_allocate_zero_simd_memory(sizeof(struct xnn_operator));
+  if (fused_elementwise_op == NULL) {
+    xnn_log_error(
+      "failed to allocate %zu bytes for %s operator descriptor",
+      sizeof(struct xnn_operator), xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc));
+    goto error;
+  }
+
+  struct fused_elementwise_context* context = &fused_elementwise_op->context.fused_elementwise;
+  for (size_t i = 0; i < num_steps; i++) {
+    status = init_step(datatype, &steps[i], &context->steps[i]);
+    if (status != xnn_status_success) {
+      xnn_log_error(
+        "failed to create %s operator: step #%zu is not supported for datatype %s",
+        xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc), i, xnn_datatype_to_string(datatype));
+      goto error;
+    }
+  }
+  context->num_steps = num_steps;
+
+  fused_elementwise_op->binary_elementwise.log2_element_size = xnn_datatype_log2_size_bytes(datatype);
+  fused_elementwise_op->type = xnn_operator_type_fused_elementwise_nc;
+  fused_elementwise_op->flags = flags;
+  fused_elementwise_op->state = xnn_run_state_invalid;
+
+  *fused_elementwise_op_out = fused_elementwise_op;
+  return xnn_status_success;
+
+error:
+  xnn_delete_operator(fused_elementwise_op);
+  return status;
+}
+
+enum xnn_status xnn_reshape_fused_elementwise_nc(
+  xnn_operator_t fused_elementwise_op,
+  size_t batch_size,
+  size_t channels,
+  const size_t* input_sizes,
+  pthreadpool_t threadpool)
+{
+  if (fused_elementwise_op->type != xnn_operator_type_fused_elementwise_nc) {
+    xnn_log_error("failed to reshape operator: operator type mismatch (expected %s, got %s)",
+      xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc),
+      xnn_operator_type_to_string(fused_elementwise_op->type));
+    return xnn_status_invalid_parameter;
+  }
+  fused_elementwise_op->state = xnn_run_state_invalid;
+
+  if ((xnn_params.init_flags & XNN_INIT_FLAG_XNNPACK) == 0) {
+    xnn_log_error("failed to reshape %s operator: XNNPACK is not initialized",
+      xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc));
+    return xnn_status_uninitialized;
+  }
+
+  if (batch_size == 0 || channels == 0) {
+    fused_elementwise_op->state = xnn_run_state_skip;
+    return xnn_status_success;
+  }
+
+  const size_t num_elements = batch_size * channels;
+  struct fused_elementwise_context* context = &fused_elementwise_op->context.fused_elementwise;
+  for (size_t i = 0; i < context->num_steps; i++) {
+    struct fused_elementwise_step_context* step = &context->steps[i];
+    if (step->unary_ukernel != NULL) {
+      continue;
+    }
+    const size_t operand_size = input_sizes[step->operand];
+    if (operand_size == num_elements) {
+      step->broadcast = xnn_fused_elementwise_broadcast_none;
+    } else if (operand_size == 1) {
+      step->broadcast = xnn_fused_elementwise_broadcast_scalar;
+    } else if (operand_size == channels) {
+      step->broadcast = xnn_fused_elementwise_broadcast_channel;
+    } else {
+      xnn_log_error(
+        "failed to reshape %s operator: input #%" PRIu32 " with %zu elements can not be broadcast to %zu x %zu elements",
+        xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc), step->operand, operand_size,
+        batch_size, channels);
+      return xnn_status_invalid_parameter;
+    }
+  }
+
+  const uint32_t log2_element_size = fused_elementwise_op->binary_elementwise.log2_element_size;
+  context->channels = channels << log2_element_size;
+
+  const size_t range = num_elements << log2_element_size;
+  const size_t num_threads = pthreadpool_get_threads_count(threadpool);
+  fused_elementwise_op->compute[0].type = xnn_parallelization_type_1d_tile_1d;
+  fused_elementwise_op->compute[0].task_1d_tile_1d = (pthreadpool_task_1d_tile_1d_t) xnn_compute_fused_elementwise;
+  fused_elementwise_op->compute[0].range[0] = range;
+  // Tiles are a multiple of a cache line, and at most the size of the buffers for the intermediate results.
+  fused_elementwise_op->compute[0].tile[0] =
+    min(XNN_FUSED_ELEMENTWISE_TILE_BYTES, round_up_po2(divide_round_up(range, num_threads), 64));
+  fused_elementwise_op->state = xnn_run_state_needs_setup;
+
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_setup_fused_elementwise_nc(
+  xnn_operator_t fused_elementwise_op,
+  const void* const* inputs,
+  void* output)
+{
+  if (fused_elementwise_op->type != xnn_operator_type_fused_elementwise_nc) {
+    xnn_log_error("failed to setup operator: operator type mismatch (expected %s, got %s)",
+      xnn_operator_type_to_string(xnn_operator_type_fused_elementwise_nc),
+      xnn_operator_type_to_string(fused_elementwise_op->type));
+    return xnn_status_invalid_parameter;
+  }
+
+  switch (fused_elementwise_op->state) {
+    case xnn_run_state_skip:
+      return xnn_status_success;
+    case xnn_run_state_invalid:
+      xnn_log_error(
+        "failed to setup %s operator: operator has not been reshaped yet",
+        xnn_operator_type_to_string(fused_elementwise_op->type));
+      return xnn_status_invalid_state;
+    case xnn_run_state_needs_setup:
+      // Operator has been reshaped, but not setup, continue with setup.
+    case xnn_run_state_ready:
+      // Operator has been reshaped, and we are setting up with different pointers.
+      break;
+  }
+
+  struct fused_elementwise_context* context = &fused_elementwise_op->context.fused_elementwise;
+  context->inputs[0] = inputs[0];
+  for (size_t i = 0; i < context->num_steps; i++) {
+    if (context->steps[i].unary_ukernel == NULL) {
+      const uint32_t operand = context->steps[i].operand;
+      context->inputs[operand] = inputs[operand];
+    }
+  }
+  context->output = output;
+  fused_elementwise_op->state = xnn_run_state_ready;
+
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_fuse_gemm_epilogue(
+  xnn_operator_t op,
+  size_t num_steps,
+  const struct xnn_fused_elementwise_step* steps)
+{
+  switch (op->type) {
+    case xnn_operator_type_fully_connected_nc_f32:
+      break;
+    case xnn_operator_type_convolution_nhwc_f32:
+      if (op->groups == 1 &&
+          (op->ukernel.type == xnn_microkernel_type_gemm || op->ukernel.type == xnn_microkernel_type_igemm ||
+           op->ukernel.type == xnn_microkernel_type_winograd)) {
+        break;
+      }
+      XNN_FALLTHROUGH
+    default:
+      xnn_log_error(
+        "failed to fuse epilogue into %s operator: only ungrouped GEMM-based F32 operators are supported",
+        xnn_operator_type_to_string(op->type));
+      return xnn_status_unsupported_parameter;
+  }
+
+  if (num_steps == 0 || num_steps > XNN_MAX_GEMM_EPILOGUE_STEPS) {
+    xnn_log_error(
+      "failed to fuse epilogue with %zu steps into %s operator: number of steps must be in [1, %d] range",
+      num_steps, xnn_operator_type_to_string(op->type), XNN_MAX_GEMM_EPILOGUE_STEPS);
+    return xnn_status_invalid_parameter;
+  }
+
+  struct gemm_epilogue* epilogue = &op->gemm_epilogue;
+  memset(epilogue, 0, sizeof(struct gemm_epilogue));
+  for (size_t i = 0; i < num_steps; i++) {
+    const enum xnn_status status = init_step(xnn_datatype_fp32, &steps[i], &epilogue->steps[i]);
+    if (status != xnn_status_success) {
+      xnn_log_error(
+        "failed to fuse epilogue into %s operator: step #%zu is not supported",
+        xnn_operator_type_to_string(op->type), i);
+      memset(epilogue, 0, sizeof(struct gemm_epilogue));
+      return status;
+    }
+    epilogue->steps[i].operand = 0;
+  }
+  epilogue->num_steps = num_steps;
+
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_setup_gemm_epilogue(
+  xnn_operator_t op,
+  const void* residual)
+{
+  struct gemm_epilogue* epilogue = &op->gemm_epilogue;
+  for (size_t i = 0; i < epilogue->num_steps; i++) {
+    if (epilogue->steps[i].unary_ukernel == NULL && residual == NULL) {
+      xnn_log_error(
+        "failed to setup epilogue of %s operator: step #%zu requires a residual tensor",
+        xnn_operator_type_to_string(op->type), i);
+      return xnn_status_invalid_parameter;
+    }
+  }
+  epilogue->residual = residual;
+
+  return xnn_status_success;
+}
@@ -15,6 +15,7 @@
 #include "xnnpack/compute.h"
 #include "xnnpack/config-types.h"
 #include "xnnpack/config.h"
+#include "xnnpack/internal.h"
 #include "xnnpack/log.h"
 #include "xnnpack/math.h"
 #include "xnnpack/microkernel-type.h"
@@ -24,6 +25,10 @@
 #include "xnnpack/params.h"
 #include "pthreadpool.h"
 
+// Number of key/value tokens per tile when computing attention with an online softmax, rounded up to a multiple of NR.
+// Logits for a tile of MR query tokens should stay in L1 cache.
+#define XNN_ATTENTION_KEY_VALUE_TILE 256
+
 static enum xnn_status create_scaled_dot_product_attention_nhtc(
   enum xnn_attention_logits_cap_type cap_type,
   const void* cap_params,
@@ -340,6 +345,51 @@ static void compute_reciprocal_f32(
   *output = 1.0f / *input;
 }
 
+static void update_online_softmax_f16(
+  const xnn_float16 tile_max[XNN_MIN_ELEMENTS(1)],
+  const xnn_float16 tile_sum[XNN_MIN_ELEMENTS(1)],
+  struct attention_online_softmax_state state[XNN_MIN_ELEMENTS(1)],
+  xnn_float16 output_scale[XNN_MIN_ELEMENTS(1)],
+  xnn_float16 tile_scale[XNN_MIN_ELEMENTS(1)])
+{
+  const float tile_max_f32 = xnn_float16_to_float(*tile_max);
+  const float max = math_max_f32(state->max, tile_max_f32);
+  const float output_scale_f32 = state->max == max ? 1.0f : expf(state->max - max);
+  const float tile_scale_f32 = tile_max_f32 == max ? 1.0f : expf(tile_max_f32 - max);
+  state->sum = state->sum * output_scale_f32 + xnn_float16_to_float(*tile_sum) * tile_scale_f32;
+  state->max = max;
+  *output_scale = xnn_float16_from_float(output_scale_f32);
+  *tile_scale = xnn_float16_from_float(tile_scale_f32);
+}
+
+static void update_online_softmax_f32(
+  const float tile_max[XNN_MIN_ELEMENTS(1)],
+  const float tile_sum[XNN_MIN_ELEMENTS(1)],
+  struct attention_online_softmax_state state[XNN_MIN_ELEMENTS(1)],
+  float output_scale[XNN_MIN_ELEMENTS(1)],
+  float tile_scale[XNN_MIN_ELEMENTS(1)])
+{
+  const float max = math_max_f32(state->max, *tile_max);
+  *output_scale = state->max == max ? 1.0f : expf(state->max - max);
+  *tile_scale = *tile_max == max ? 1.0f : expf(*tile_max - max);
+  state->sum = state->sum * *output_scale + *tile_sum * *tile_scale;
+  state->max = max;
+}
+
+static void compute_online_softmax_scale_f16(
+  const struct attention_online_softmax_state state[XNN_MIN_ELEMENTS(1)],
+  xnn_float16 output_scale[XNN_MIN_ELEMENTS(1)])
+{
+  *output_scale = xnn_float16_from_float(1.0f / state->sum);
+}
+
+static void compute_online_softmax_scale_f32(
+  const struct attention_online_softmax_state state[XNN_MIN_ELEMENTS(1)],
+  float output_scale[XNN_MIN_ELEMENTS(1)])
+{
+  *output_scale = 1.0f / state->sum;
+}
+
 static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
   xnn_operator_t attention_op,
   enum xnn_operator_type expected_operator_type,
@@ -348,6 +398,7 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
   size_t query_tokens,
   size_t key_value_heads,
   size_t key_value_tokens,
+  size_t key_value_tokens_stride,
   size_t query_key_channels,
   size_t value_channels,
   size_t* workspace_size,
@@ -355,6 +406,8 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
   size_t log2_element_size,
   size_t element_size,
   xnn_compute_reciprocal_fn compute_reciprocal,
+  xnn_compute_online_softmax_update_fn update_online_softmax,
+  xnn_compute_online_softmax_scale_fn compute_online_softmax_scale,
   void* cap,
   void* cap_reciprocal,
   size_t cap_size,
@@ -424,6 +477,14 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
     return xnn_status_invalid_parameter;
   }
 
+  if (key_value_tokens_stride < key_value_tokens) {
+    xnn_log_error(
+      "failed to create %s operator with key/value tokens stride of %zu: key/value tokens stride must be at least as "
+      "large as key/value tokens (%zu)",
+      xnn_operator_type_to_string(expected_operator_type), key_value_tokens_stride, key_value_tokens);
+    return xnn_status_invalid_parameter;
+  }
+
   if (query_key_channels == 0) {
     xnn_log_error(
       "failed to create %s operator with %zu channels: query/key channels must be non-zero",
@@ -443,10 +504,17 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
   const uint32_t kr = attention_op->ukernel.gemm.kr;
   const uint32_t sr = attention_op->ukernel.gemm.sr;
 
+  // With an online softmax, logits are computed for tiles of key_value_tile tokens rather than for all key/value
+  // tokens at once. Each tile of value is packed separately, and tiles of packed key start at a multiple of NR.
+  const size_t key_value_tile = round_up(XNN_ATTENTION_KEY_VALUE_TILE, nr);
+  const bool use_online_softmax =
+    (attention_op->flags & XNN_FLAG_ATTENTION_ONLINE_SOFTMAX) != 0 && key_value_tokens > key_value_tile;
+  const size_t logits_tokens = use_online_softmax ? key_value_tile : key_value_tokens;
+
   const size_t num_threads = pthreadpool_get_threads_count(threadpool);
   const size_t size_using_threads = num_threads * mr;
   const size_t size_using_batch = batch_size * query_heads * query_tokens;
-  const bool use_threads_workspace_size = size_using_threads < size_using_batch;
+  const bool use_threads_workspace_size = use_online_softmax || size_using_threads < size_using_batch;
   const size_t workspace_multiplier = use_threads_workspace_size ? size_using_threads : size_using_batch;
   // Calculate size required for workspace.
   // 1. Workspace for Q scaled, each thread computes a maximum of mr * query_key_channels.
@@ -463,15 +531,31 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
   // Value is [key_value_tokens (input channel), channels (output channel)].
   const size_t value_n_stride = round_up(value_channels, nr);
   const size_t value_k_stride = round_up_po2(key_value_tokens, kr * sr);
-  const size_t value_head_stride = value_n_stride * (element_size + (value_k_stride << log2_element_size));
-  // 3. Workspace for packed key.
+  size_t value_head_stride = value_n_stride * (element_size + (value_k_stride << log2_element_size));
+  size_t value_tile_stride = 0;
+  if (use_online_softmax) {
+    const size_t value_tile_k_stride = round_up_po2(key_value_tile, kr * sr);
+    value_tile_stride = value_n_stride * (element_size + (value_tile_k_stride << log2_element_size));
+    value_head_stride = key_value_tokens / key_value_tile * value_tile_stride;
+    const size_t last_tile_tokens = key_value_tokens % key_value_tile;
+    if (last_tile_tokens != 0) {
+      const size_t value_last_tile_k_stride = round_up_po2(last_tile_tokens, kr * sr);
+      value_head_stride += value_n_stride * (element_size + (value_last_tile_k_stride << log2_element_size));
+    }
+  }
+  // 3. Workspace for packed value.
   const size_t packed_value_size = round_up_po2(batch_size * key_value_heads * value_head_stride, XNN_ALLOCATION_ALIGNMENT);
 
-  // 4. Workspace for logits (Q*K), each thread computes mr * key_value_tokens.
+  // 4. Workspace for logits (Q*K), each thread computes mr * logits_tokens.
   const size_t logits_size =
-    round_up_po2(workspace_multiplier * key_value_tokens * element_size + XNN_EXTRA_BYTES, XNN_ALLOCATION_ALIGNMENT);
+    round_up_po2(workspace_multiplier * logits_tokens * element_size + XNN_EXTRA_BYTES, XNN_ALLOCATION_ALIGNMENT);
+
+  // 5. Workspace for the output of P*V for a tile, each thread computes mr * value_channels.
+  const size_t tile_output_size = use_online_softmax ?
+    round_up_po2(workspace_multiplier * value_channels * element_size + XNN_EXTRA_BYTES, XNN_ALLOCATION_ALIGNMENT) : 0;
 
-  const size_t total_workspace_size = scaled_query_size + packed_key_size + packed_value_size + logits_size;
+  const size_t total_workspace_size =
+    scaled_query_size + packed_key_size + packed_value_size + logits_size + tile_output_size;
 
   *workspace_size = total_workspace_size;
   *workspace_alignment = XNN_ALLOCATION_ALIGNMENT;
@@ -486,7 +570,7 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
     // b_stride and gb_stride not needed because we do not have bias.
     .w_stride = element_size + (key_k_stride << log2_element_size),
     .packw_gemm_goi = attention_op->ukernel.gemm.packw_gemm_goi,
-    .gk_stride = key_value_tokens * (query_key_channels << log2_element_size),
+    .gk_stride = key_value_tokens_stride * (query_key_channels << log2_element_size),
     .gc_stride = key_head_stride,
   };
   attention_op->compute[0].type = xnn_parallelization_type_2d_tile_1d;
@@ -501,7 +585,7 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
 
   // Pack value.
   attention_op->context.gemm.packw_gemm_gio = (struct packw_gemm_gio_context) {
-    .kc = key_value_tokens,
+    .kc = use_online_softmax ? key_value_tile : key_value_tokens,
     .nr = nr,
     .kr = kr,
     .sr = sr,
@@ -510,17 +594,26 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
     // b_stride and gb_stride not needed because we do not have bias.
     .w_stride = element_size + (value_k_stride << log2_element_size),
     .packw_gemm_gio = attention_op->ukernel.gemm.packw_gemm_gio,
-    .gk_stride = key_value_tokens * (value_channels << log2_element_size),
+    .gk_stride = key_value_tokens_stride * (value_channels << log2_element_size),
     .gb_stride = value_channels * element_size,
     .gc_stride = value_head_stride,
+    .nc = value_channels,
+    .gc_k_tile_stride = value_tile_stride,
   };
   attention_op->compute[1].type = xnn_parallelization_type_2d_tile_1d;
-  attention_op->compute[1].task_2d_tile_1d = (pthreadpool_task_2d_tile_1d_t) xnn_compute_batched_packw_gemm_gio;
   attention_op->compute[1].context_offset =
     offsetof(struct xnn_operator, context.gemm.packw_gemm_gio) - offsetof(struct xnn_operator, context);
   attention_op->compute[1].range[0] = batch_size * key_value_heads;
-  attention_op->compute[1].range[1] = value_channels;
-  attention_op->compute[1].tile[0] = value_channels;
+  if (use_online_softmax) {
+    attention_op->compute[1].task_2d_tile_1d =
+      (pthreadpool_task_2d_tile_1d_t) xnn_compute_batched_packw_gemm_gio_k_tiled;
+    attention_op->compute[1].range[1] = key_value_tokens;
+    attention_op->compute[1].tile[0] = key_value_tile;
+  } else {
+    attention_op->compute[1].task_2d_tile_1d = (pthreadpool_task_2d_tile_1d_t) xnn_compute_batched_packw_gemm_gio;
+    attention_op->compute[1].range[1] = value_channels;
+    attention_op->compute[1].tile[0] = value_channels;
+  }
 
   struct xnn_hmp_gemm_ukernel gemm_ukernel = attention_op->ukernel.gemm.gemm_cases[mr - 1];
 
@@ -543,9 +636,16 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
     .output_batch_stride = query_heads * query_tokens * value_channels * element_size,
     .output_head_stride = query_tokens * value_channels * element_size,
     .scaled_query_thread_stride = mr * query_key_channels * element_size,
-    .logits_thread_stride = mr * key_value_tokens * element_size,
+    .logits_thread_stride = mr * logits_tokens * element_size,
+    .tile_output_thread_stride = mr * value_channels * element_size,
+    .key_value_tile = key_value_tile,
+    .key_value_tile_scaled = key_value_tile * element_size,
+    .key_tile_stride = key_value_tile * (element_size + (key_k_stride << log2_element_size)),
+    .value_tile_stride = value_tile_stride,
     .gemm_ukernel = gemm_ukernel,
     .compute_reciprocal = compute_reciprocal,
+    .update_online_softmax = update_online_softmax,
+    .compute_online_softmax_scale = compute_online_softmax_scale,
     .raddstoreexpminusmax_ukernel = attention_op->attention.raddstoreexpminusmax_config->ukernel,
     .rmax_ukernel = attention_op->attention.rmax_config->ukernel,
     .vadd_ukernel = attention_op->attention.vadd_config->op_ukernel,
@@ -562,7 +662,12 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
 
   #if XNN_MAX_UARCH_TYPES > 1
     if (xnn_is_hmp_gemm_ukernel(gemm_ukernel)) {
-      if (use_threads_workspace_size) {
+      if (use_online_softmax) {
+        attention_op->compute[2].type = xnn_parallelization_type_3d_tile_1d_with_uarch_with_thread;
+        attention_op->compute[2].task_3d_tile_1d_with_id_with_thread =
+          (pthreadpool_task_3d_tile_1d_with_id_with_thread_t)
+            xnn_compute_hmp_tiled_scaled_dot_product_attention_with_thread;
+      } else if (use_threads_workspace_size) {
         attention_op->compute[2].type = xnn_parallelization_type_3d_tile_1d_with_uarch_with_thread;
         attention_op->compute[2].task_3d_tile_1d_with_id_with_thread =
           (pthreadpool_task_3d_tile_1d_with_id_with_thread_t) xnn_compute_hmp_scaled_dot_product_attention_with_thread;
@@ -572,7 +677,11 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
           (pthreadpool_task_3d_tile_1d_with_id_t) xnn_compute_hmp_scaled_dot_product_attention;
       }
     } else {
-      if (use_threads_workspace_size) {
+      if (use_online_softmax) {
+        attention_op->compute[2].type = xnn_parallelization_type_3d_tile_1d_with_thread;
+        attention_op->compute[2].task_3d_tile_1d_with_thread =
+          (pthreadpool_task_3d_tile_1d_with_thread_t) xnn_compute_tiled_scaled_dot_product_attention_with_thread;
+      } else if (use_threads_workspace_size) {
         attention_op->compute[2].type = xnn_parallelization_type_3d_tile_1d_with_thread;
         attention_op->compute[2].task_3d_tile_1d_with_thread =
           (pthreadpool_task_3d_tile_1d_with_thread_t) xnn_compute_scaled_dot_product_attention_with_thread;
@@ -583,7 +692,11 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
       }
     }
   #else
-    if (use_threads_workspace_size) {
+    if (use_online_softmax) {
+      attention_op->compute[2].type = xnn_parallelization_type_3d_tile_1d_with_thread;
+      attention_op->compute[2].task_3d_tile_1d_with_thread =
+        (pthreadpool_task_3d_tile_1d_with_thread_t) xnn_compute_tiled_scaled_dot_product_attention_with_thread;
+    } else if (use_threads_workspace_size) {
       attention_op->compute[2].type = xnn_parallelization_type_3d_tile_1d_with_thread;
       attention_op->compute[2].task_3d_tile_1d_with_thread =
         (pthreadpool_task_3d_tile_1d_with_thread_t) xnn_compute_scaled_dot_product_attention_with_thread;
@@ -603,6 +716,8 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
   attention_op->context.gemm.gemm.attention.packed_k_offset = scaled_query_size;
   attention_op->context.gemm.gemm.attention.packed_v_offset = scaled_query_size + packed_key_size;
   attention_op->context.gemm.gemm.attention.logits_offset = scaled_query_size + packed_key_size + packed_value_size;
+  attention_op->context.gemm.gemm.attention.tile_output_offset =
+    scaled_query_size + packed_key_size + packed_value_size + logits_size;
 
   memcpy(&attention_op->context.gemm.gemm.attention.minmax_params, minmax_params, minmax_params_size);
   memcpy(&attention_op->context.gemm.gemm.attention.expminus_params, expminus_params, expminus_params_size);
@@ -615,13 +730,14 @@ static enum xnn_status reshape_scaled_dot_product_attention_nhtc(
 
 }
 
-enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f16(
+enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f16(
   xnn_operator_t attention_op,
   size_t batch_size,
   size_t heads,
   size_t query_tokens,
   size_t key_value_heads,
   size_t key_value_tokens,
+  size_t key_value_cache_tokens,
   size_t query_key_channels,
   size_t value_channels,
   size_t* workspace_size,
@@ -639,12 +755,15 @@ enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f16(
     query_tokens,
     key_value_heads,
     key_value_tokens,
+    key_value_cache_tokens,
     query_key_channels,
     value_channels,
     workspace_size, workspace_alignment,
     /*log2_element_size=*/XNN_LOG2_SIZEOF_UINT16_T,
     /*element_size=*/sizeof(uint16_t),
     (xnn_compute_reciprocal_fn) compute_reciprocal_f16,
+    (xnn_compute_online_softmax_update_fn) update_online_softmax_f16,
+    (xnn_compute_online_softmax_scale_fn) compute_online_softmax_scale_f16,
     &cap, &cap_reciprocal, sizeof(uint16_t),
     &attention_op->params.f16_minmax, sizeof(attention_op->params.f16_minmax),
     &attention_op->params2.f16_default, sizeof(attention_op->params2.f16_default),
@@ -653,13 +772,33 @@ enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f16(
     threadpool);
 }
 
-enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f32(
+enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f16(
+  xnn_operator_t attention_op,
+  size_t batch_size,
+  size_t heads,
+  size_t query_tokens,
+  size_t key_value_heads,
+  size_t key_value_tokens,
+  size_t query_key_channels,
+  size_t value_channels,
+  size_t* workspace_size,
+  size_t* workspace_alignment,
+  pthreadpool_t threadpool)
+{
+  return xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f16(
+    attention_op, batch_size, heads, query_tokens, key_value_heads, key_value_tokens,
+    /*key_value_cache_tokens=*/key_value_tokens, query_key_channels, value_channels, workspace_size,
+    workspace_alignment, threadpool);
+}
+
+enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f32(
   xnn_operator_t attention_op,
   size_t batch_size,
   size_t query_heads,
   size_t query_tokens,
   size_t key_value_heads,
   size_t key_value_tokens,
+  size_t key_value_cache_tokens,
   size_t query_key_channels,
   size_t value_channels,
   size_t* workspace_size,
@@ -677,12 +816,15 @@ enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f32(
     query_tokens,
     key_value_heads,
     key_value_tokens,
+    key_value_cache_tokens,
     query_key_channels,
     value_channels,
     workspace_size, workspace_alignment,
     /*log2_element_size=*/XNN_LOG2_SIZEOF_FLOAT,
     /*element_size=*/sizeof(float),
     (xnn_compute_reciprocal_fn) compute_reciprocal_f32,
+    (xnn_compute_online_softmax_update_fn) update_online_softmax_f32,
+    (xnn_compute_online_softmax_scale_fn) compute_online_softmax_scale_f32,
     &cap, &cap_reciprocal, sizeof(float),
     &attention_op->params.f32_minmax, sizeof(attention_op->params.f32_minmax),
     &attention_op->params2.f32_default, sizeof(attention_op->params2.f32_default),
@@ -691,6 +833,25 @@ enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f32(
     threadpool);
 }
 
+enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_f32(
+  xnn_operator_t attention_op,
+  size_t batch_size,
+  size_t query_heads,
+  size_t query_tokens,
+  size_t key_value_heads,
+  size_t key_value_tokens,
+  size_t query_key_channels,
+  size_t value_channels,
+  size_t* workspace_size,
+  size_t* workspace_alignment,
+  pthreadpool_t threadpool)
+{
+  return xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f32(
+    attention_op, batch_size, query_heads, query_tokens, key_value_heads, key_value_tokens,
+    /*key_value_cache_tokens=*/key_value_tokens, query_key_channels, value_channels, workspace_size,
+    workspace_alignment, threadpool);
+}
+
 static enum xnn_status setup_scaled_dot_product_attention_nhtc(
   xnn_operator_t attention_op,
   enum xnn_operator_type expected_operator_type,
@@ -739,6 +900,8 @@ static enum xnn_status setup_scaled_dot_product_attention_nhtc(
     (void*) ((uintptr_t) workspace + attention_op->context.gemm.gemm.attention.scaled_query_offset);
   attention_op->context.gemm.gemm.attention.logits_buffer =
     (void*) ((uintptr_t) workspace + attention_op->context.gemm.gemm.attention.logits_offset);
+  attention_op->context.gemm.gemm.attention.tile_output_buffer =
+    (void*) ((uintptr_t) workspace + attention_op->context.gemm.gemm.attention.tile_output_offset);
   attention_op->context.gemm.gemm.attention.query = query;
   attention_op->context.gemm.gemm.attention.key = attention_op->context.gemm.packw_gemm_goi.packed_weights;
   attention_op->context.gemm.gemm.attention.value = attention_op->context.gemm.packw_gemm_gio.packed_weights;
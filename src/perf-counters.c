@@ -0,0 +1,167 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+// Include first for the platform detection macros.
+#include "xnnpack/common.h"
+
+#if XNN_PLATFORM_LINUX || XNN_PLATFORM_ANDROID
+  #ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+  #endif
+  #include <dirent.h>
+  #include <errno.h>
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <sys/types.h>
+  #include <unistd.h>
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/allocator.h"
+#include "xnnpack/log.h"
+#include "xnnpack/perf-counters.h"
+
+#if XNN_PLATFORM_LINUX || XNN_PLATFORM_ANDROID
+
+static void init_event_attr(enum xnn_perf_counter counter, struct perf_event_attr* attr)
+{
+  memset(attr, 0, sizeof(struct perf_event_attr));
+  attr->size = sizeof(struct perf_event_attr);
+  attr->exclude_kernel = 1;
+  attr->exclude_hv = 1;
+  switch (counter) {
+    case xnn_perf_counter_cycles:
+      attr->type = PERF_TYPE_HARDWARE;
+      attr->config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case xnn_perf_counter_instructions:
+      attr->type = PERF_TYPE_HARDWARE;
+      attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case xnn_perf_counter_l1d_cache_misses:
+      attr->type = PERF_TYPE_HW_CACHE;
+      attr->config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case xnn_perf_counter_llc_misses:
+      attr->type = PERF_TYPE_HARDWARE;
+      attr->config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case xnn_perf_counter_count:
+      XNN_UNREACHABLE;
+  }
+}
+
+static int open_event(enum xnn_perf_counter counter, pid_t tid)
+{
+  struct perf_event_attr attr;
+  init_event_attr(counter, &attr);
+  return (int) syscall(__NR_perf_event_open, &attr, tid, /*cpu=*/-1, /*group_fd=*/-1, /*flags=*/0);
+}
+
+enum xnn_status xnn_open_perf_counters(struct xnn_perf_counters* counters)
+{
+  memset(counters, 0, sizeof(struct xnn_perf_counters));
+
+  DIR* tasks = opendir("/proc/self/task");
+  if (tasks == NULL) {
+    xnn_log_warning("failed to open hardware performance counters: can not list threads (error code %d)", errno);
+    return xnn_status_unsupported_hardware;
+  }
+
+  size_t capacity = 0;
+  struct dirent* entry;
+  while ((entry = readdir(tasks)) != NULL) {
+    char* end = NULL;
+    const long tid = strtol(entry->d_name, &end, 10);
+    if (end == entry->d_name || *end != '\0') {
+      // "." and "..".
+      continue;
+    }
+
+    if (counters->num_threads == capacity) {
+      capacity = capacity == 0 ? 8 : capacity * 2;
+      int (*fds)[xnn_perf_counter_count] = xnn_reallocate_memory(counters->fds, capacity * sizeof(*fds));
+      if (fds == NULL) {
+        xnn_log_error("failed to allocate hardware performance counters for %zu threads", capacity);
+        closedir(tasks);
+        xnn_close_perf_counters(counters);
+        return xnn_status_out_of_memory;
+      }
+      counters->fds = fds;
+    }
+
+    int* fds = counters->fds[counters->num_threads++];
+    for (int i = 0; i < xnn_perf_counter_count; i++) {
+      fds[i] = open_event((enum xnn_perf_counter) i, (pid_t) tid);
+      counters->available |= fds[i] >= 0;
+    }
+  }
+  closedir(tasks);
+
+  if (!counters->available) {
+    xnn_log_warning(
+      "failed to open hardware performance counters: perf_event_open is not supported or not permitted (error code %d)",
+      errno);
+    xnn_close_perf_counters(counters);
+    return xnn_status_unsupported_hardware;
+  }
+  return xnn_status_success;
+}
+
+void xnn_read_perf_counters(const struct xnn_perf_counters* counters, uint64_t values[xnn_perf_counter_count])
+{
+  memset(values, 0, xnn_perf_counter_count * sizeof(uint64_t));
+  for (size_t t = 0; t < counters->num_threads; t++) {
+    for (int i = 0; i < xnn_perf_counter_count; i++) {
+      const int fd = counters->fds[t][i];
+      uint64_t value = 0;
+      // Threads that exited read as 0.
+      if (fd >= 0 && read(fd, &value, sizeof(value)) == sizeof(value)) {
+        values[i] += value;
+      }
+    }
+  }
+}
+
+void xnn_close_perf_counters(struct xnn_perf_counters* counters)
+{
+  for (size_t t = 0; t < counters->num_threads; t++) {
+    for (int i = 0; i < xnn_perf_counter_count; i++) {
+      if (counters->fds[t][i] >= 0) {
+        close(counters->fds[t][i]);
+      }
+    }
+  }
+  xnn_release_memory(counters->fds);
+  memset(counters, 0, sizeof(struct xnn_perf_counters));
+}
+
+#else  // !(XNN_PLATFORM_LINUX || XNN_PLATFORM_ANDROID)
+
+enum xnn_status xnn_open_perf_counters(struct xnn_perf_counters* counters)
+{
+  memset(counters, 0, sizeof(struct xnn_perf_counters));
+  xnn_log_warning("failed to open hardware performance counters: only supported on Linux and Android");
+  return xnn_status_unsupported_hardware;
+}
+
+void xnn_read_perf_counters(const struct xnn_perf_counters* counters, uint64_t values[xnn_perf_counter_count])
+{
+  memset(values, 0, xnn_perf_counter_count * sizeof(uint64_t));
+}
+
+void xnn_close_perf_counters(struct xnn_perf_counters* counters)
+{
+  memset(counters, 0, sizeof(struct xnn_perf_counters));
+}
+
+#endif  // XNN_PLATFORM_LINUX || XNN_PLATFORM_ANDROID
@@ -16,6 +16,7 @@
 
 #include <immintrin.h>
 
+#include "xnnpack/amx.h"
 #include "xnnpack/common.h"
 #include "xnnpack/gemm.h"
 #include "xnnpack/intrinsics-polyfill.h"
@@ -54,19 +55,8 @@ void xnn_qd8_f16_qc8w_gemm_minmax_ukernel_16x64c4__avx512amx_prfm(
   kc = round_up_po2(kc, 4 * sizeof(int8_t));
   const size_t kremainder = (kc & 63) ? (kc & 63) : 64;
 
-  // Define tile config data structure
-  struct __tile_config {
-    uint8_t palette_id;
-    uint8_t start_row;
-    uint8_t reserved_0[14];
-    uint16_t colsb[8];
-    uint16_t reserved_1[8];
-    uint8_t rows[8];
-    uint8_t reserved_2[8];
-  };
-
   // Load tile configuration
-  __attribute__((aligned(64))) struct __tile_config tile_data = {0};
+  __attribute__((aligned(64))) struct xnn_amx_tile_config tile_data = {0};
   tile_data.palette_id = 1;
   tile_data.rows[0] = mr;              // tmm0 = res[0]
   tile_data.rows[1] = mr;              // tmm1 = res[1]
@@ -86,8 +76,8 @@ void xnn_qd8_f16_qc8w_gemm_minmax_ukernel_16x64c4__avx512amx_prfm(
   tile_data.colsb[6] = kremainder;  // tmm6 = input remainder
   tile_data.colsb[7] = 64;          // tmm7 = weights remainder
 
-  //_tile_loadconfig(&tile_data);
-  __asm__ volatile ("ldtilecfg %0" :: "m" (tile_data));
+  // The tiles stay configured on return, for the next call from this thread.
+  xnn_amx_load_tile_config(&tile_data);
 
   xnn_float16* c0 = c;
   xnn_float16* c1 = (xnn_float16*) ((uintptr_t) c0 + cm_stride);
@@ -987,8 +977,5 @@ void xnn_qd8_f16_qc8w_gemm_minmax_ukernel_16x64c4__avx512amx_prfm(
       nc = 0;
     }
   } while (nc != 0);
-  // Release tile config
-  //  _tile_release();
-  __asm__ volatile ("tilerelease" ::);
   #endif  // defined(__x86_64__)
 }
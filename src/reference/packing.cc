@@ -1118,6 +1118,105 @@ void xnn_pack_f16_gemm_gio_w(size_t g, size_t nc, size_t kc, size_t nr,
   } while (--g != 0);
 }
 
+void xnn_pack_bf16_f32_gemm_goi_w(
+  size_t g,
+  size_t nc,
+  size_t kc,
+  size_t nr,
+  size_t kr,
+  size_t sr,
+  const xnn_bfloat16* k,
+  const float* b,
+  const void* scale,
+  void* packed_weights,
+  size_t extra_bytes,
+  const void* params)
+{
+  assert(g != 0);
+  assert(nr >= sr);
+  assert(k != nullptr);
+  assert(packed_weights != nullptr);
+
+  const size_t skr = sr * kr;
+  do {
+    for (size_t nr_block_start = 0; nr_block_start < nc; nr_block_start += nr) {
+      const size_t nr_block_size = min(nc - nr_block_start, nr);
+      float* packed_b = (float*) packed_weights;
+      copy_bias(b, nr_block_start, nr_block_size, packed_b);
+      std::fill_n(packed_b + nr_block_size, nr - nr_block_size, 0.0f);
+      uint16_t* packed_k = (uint16_t*) (packed_b + nr);
+
+      for (size_t kr_block_start = 0; kr_block_start < round_up_po2(kc, skr); kr_block_start += kr) {
+        for (size_t nr_block_offset = 0; nr_block_offset < nr_block_size; nr_block_offset++) {
+          const size_t kc_begin = round_down_po2(kr_block_start, skr) + ((kr_block_start + nr_block_offset * kr) & (skr - 1));
+          for (size_t kr_block_offset = 0; kr_block_offset < kr; kr_block_offset++) {
+            const size_t kc_idx = kc_begin + kr_block_offset;
+            packed_k[kr_block_offset] = kc_idx < kc ? k[(nr_block_start + nr_block_offset) * kc + kc_idx].value : 0;
+          }
+          packed_k += kr;
+        }
+        std::fill_n(packed_k, (nr - nr_block_size) * kr, 0);
+        packed_k += (nr - nr_block_size) * kr;
+      }
+      packed_weights = (void*) ((uintptr_t) packed_k + extra_bytes);
+    }
+    k += nc * kc;
+    if XNN_UNPREDICTABLE(b != nullptr) {
+      b += nc;
+    }
+  } while (--g != 0);
+}
+
+void xnn_pack_bf16_f32_gemm_gio_w(
+  size_t g,
+  size_t nc,
+  size_t kc,
+  size_t nr,
+  size_t kr,
+  size_t sr,
+  size_t k_stride,
+  const xnn_bfloat16* k,
+  const float* b,
+  const void* scale,
+  void* packed_weights,
+  size_t extra_bytes,
+  const void* params)
+{
+  assert(g != 0);
+  assert(nr >= sr);
+  assert(k != nullptr);
+  assert(packed_weights != nullptr);
+
+  const size_t skr = sr * kr;
+  do {
+    for (size_t nr_block_start = 0; nr_block_start < nc; nr_block_start += nr) {
+      const size_t nr_block_size = min(nc - nr_block_start, nr);
+      float* packed_b = (float*) packed_weights;
+      copy_bias(b, nr_block_start, nr_block_size, packed_b);
+      std::fill_n(packed_b + nr_block_size, nr - nr_block_size, 0.0f);
+      uint16_t* packed_k = (uint16_t*) (packed_b + nr);
+
+      for (size_t kr_block_start = 0; kr_block_start < round_up_po2(kc, skr); kr_block_start += kr) {
+        for (size_t nr_block_offset = 0; nr_block_offset < nr_block_size; nr_block_offset++) {
+          const size_t kc_begin = round_down_po2(kr_block_start, skr) + ((kr_block_start + nr_block_offset * kr) & (skr - 1));
+          for (size_t kr_block_offset = 0; kr_block_offset < kr; kr_block_offset++) {
+            const size_t kc_idx = kc_begin + kr_block_offset;
+            packed_k[kr_block_offset] = kc_idx < kc ? k[kc_idx * k_stride + nr_block_start + nr_block_offset].value : 0;
+          }
+          packed_k += kr;
+        }
+        std::fill_n(packed_k, (nr - nr_block_size) * kr, 0);
+        packed_k += (nr - nr_block_size) * kr;
+      }
+      packed_weights = (void*) ((uintptr_t) packed_k + extra_bytes);
+    }
+    k += nc * kc;
+    if XNN_UNPREDICTABLE(b != nullptr) {
+      b += nc;
+    }
+  } while (--g != 0);
+}
+
 void xnn_pack_f32_to_f16_gemm_gio_w(
   size_t g,
   size_t nc,
@@ -1881,6 +1980,49 @@ void xnn_pack_f32_conv_goki_w(
   } while (--g != 0);
 }
 
+void xnn_pack_f32_winograd_f4x4k3x3_w(
+  size_t output_channels,
+  size_t input_channels,
+  const float* kernel,
+  float* transformed_kernel)
+{
+  assert(output_channels != 0);
+  assert(input_channels != 0);
+  assert(kernel != nullptr);
+  assert(transformed_kernel != nullptr);
+
+  // G of Winograd F(4, 3).
+  static const float g[6][3] = {
+    {1.0f / 4.0f, 0.0f, 0.0f},
+    {-1.0f / 6.0f, -1.0f / 6.0f, -1.0f / 6.0f},
+    {-1.0f / 6.0f, 1.0f / 6.0f, -1.0f / 6.0f},
+    {1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f},
+    {1.0f / 24.0f, -1.0f / 12.0f, 1.0f / 6.0f},
+    {0.0f, 0.0f, 1.0f},
+  };
+  const size_t position_stride = output_channels * input_channels;
+  for (size_t oc = 0; oc < output_channels; oc++) {
+    for (size_t ic = 0; ic < input_channels; ic++) {
+      const float* k = &kernel[oc * 9 * input_channels + ic];
+      // G k, then (G k) G^T.
+      double gk[6][3];
+      for (size_t i = 0; i < 6; i++) {
+        for (size_t kx = 0; kx < 3; kx++) {
+          gk[i][kx] = (double) g[i][0] * k[(0 * 3 + kx) * input_channels] +
+                      (double) g[i][1] * k[(1 * 3 + kx) * input_channels] +
+                      (double) g[i][2] * k[(2 * 3 + kx) * input_channels];
+        }
+      }
+      for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 6; j++) {
+          const double u = gk[i][0] * g[j][0] + gk[i][1] * g[j][1] + gk[i][2] * g[j][2];
+          transformed_kernel[(i * 6 + j) * position_stride + oc * input_channels + ic] = (float) u;
+        }
+      }
+    }
+  }
+}
+
 void xnn_pack_f16_conv_goki_w(
   size_t g,
   size_t nc,
@@ -0,0 +1,270 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "xnnpack/reshape-cache.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/allocator.h"
+#include "xnnpack/common.h"
+#include "xnnpack/log.h"
+#include "xnnpack/operator.h"
+#include "xnnpack/subgraph.h"
+
+void xnn_init_reshape_cache(struct xnn_reshape_cache* cache)
+{
+  memset(cache, 0, sizeof(struct xnn_reshape_cache));
+}
+
+static void release_entry(struct xnn_reshape_cache_entry* entry)
+{
+  xnn_release_memory(entry->key);
+  xnn_release_memory(entry->value_shapes);
+  xnn_release_memory(entry->opdata);
+  xnn_release_simd_memory(entry->operators);
+  xnn_release_memory(entry->first_operator);
+  memset(entry, 0, sizeof(struct xnn_reshape_cache_entry));
+}
+
+void xnn_release_reshape_cache(struct xnn_reshape_cache* cache)
+{
+  for (size_t i = 0; i < cache->num_entries; i++) {
+    release_entry(&cache->entries[i]);
+  }
+  xnn_release_memory(cache->entries);
+  xnn_init_reshape_cache(cache);
+}
+
+void xnn_configure_reshape_cache(
+  struct xnn_reshape_cache* cache,
+  size_t max_entries,
+  enum xnn_reshape_cache_eviction_policy eviction_policy)
+{
+  xnn_release_reshape_cache(cache);
+  cache->max_entries = max_entries;
+  cache->eviction_policy = eviction_policy;
+}
+
+static inline bool is_external_input(const struct xnn_value* value)
+{
+  return (value->flags & XNN_VALUE_FLAG_EXTERNAL_INPUT) != 0;
+}
+
+static bool key_matches(const struct xnn_reshape_cache_entry* entry, const struct xnn_runtime* runtime)
+{
+  size_t k = 0;
+  for (size_t i = 0; i < runtime->num_values; i++) {
+    const struct xnn_value* value = &runtime->values[i];
+    if (!is_external_input(value)) {
+      continue;
+    }
+    const size_t num_dims = value->shape.num_dims;
+    if (k + 1 + num_dims > entry->key_size || entry->key[k] != num_dims ||
+        memcmp(&entry->key[k + 1], value->shape.dim, num_dims * sizeof(size_t)) != 0) {
+      return false;
+    }
+    k += 1 + num_dims;
+  }
+  return k == entry->key_size;
+}
+
+struct xnn_reshape_cache_entry* xnn_reshape_cache_look_up(
+  struct xnn_reshape_cache* cache,
+  const struct xnn_runtime* runtime)
+{
+  for (size_t i = 0; i < cache->num_entries; i++) {
+    struct xnn_reshape_cache_entry* entry = &cache->entries[i];
+    if (key_matches(entry, runtime)) {
+      entry->last_used = ++cache->clock;
+      cache->hits++;
+      return entry;
+    }
+  }
+  cache->misses++;
+  return NULL;
+}
+
+void xnn_reshape_cache_restore_values(
+  const struct xnn_reshape_cache_entry* entry,
+  struct xnn_runtime* runtime)
+{
+  // Sizes are not restored: they only grow, and the memory plan is based on them.
+  for (size_t i = 0; i < runtime->num_values; i++) {
+    runtime->values[i].shape = entry->value_shapes[i];
+  }
+}
+
+bool xnn_reshape_cache_restore_operator(
+  const struct xnn_reshape_cache_entry* entry,
+  struct xnn_runtime* runtime,
+  size_t opdata_id)
+{
+  size_t index = entry->first_operator[opdata_id];
+  if (index == SIZE_MAX) {
+    return false;
+  }
+
+  struct xnn_operator_data* opdata = &runtime->opdata[opdata_id];
+  for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
+    if (opdata->operator_objects[j] != NULL) {
+      // Operators can point to their own fields, e.g. to parameters, so they must be restored in place.
+      memcpy(opdata->operator_objects[j], &entry->operators[index++], sizeof(struct xnn_operator));
+    }
+  }
+
+  // The workspace is assigned by the memory planner, which may have run since this entry was recorded.
+  void* workspace = opdata->workspace;
+  const size_t planned_workspace_size = opdata->planned_workspace_size;
+  *opdata = entry->opdata[opdata_id];
+  opdata->workspace = workspace;
+  opdata->planned_workspace_size = planned_workspace_size;
+  return true;
+}
+
+// Operators that allocate buffers that depend on the shapes in reshape, e.g. indirection buffers, can not be restored
+// from a copy: another reshape may have reallocated or overwritten their buffers.
+static bool operator_is_restorable(const struct xnn_operator* op)
+{
+  return op->indirection_buffer == NULL && op->pixelwise_buffer == NULL && op->zero_buffers == NULL &&
+         op->subconvolution_buffer == NULL;
+}
+
+static bool opdata_is_restorable(const struct xnn_operator_data* opdata)
+{
+  if (opdata->operator_objects[0] == NULL) {
+    // Operator was removed during optimization.
+    return false;
+  }
+  for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
+    if (opdata->operator_objects[j] != NULL && !operator_is_restorable(opdata->operator_objects[j])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static struct xnn_reshape_cache_entry* allocate_entry(struct xnn_reshape_cache* cache)
+{
+  if (cache->num_entries < cache->max_entries) {
+    if (cache->entries == NULL) {
+      cache->entries = xnn_allocate_zero_memory(cache->max_entries * sizeof(struct xnn_reshape_cache_entry));
+      if (cache->entries == NULL) {
+        xnn_log_error(
+          "failed to allocate %zu bytes for reshape cache entries",
+          cache->max_entries * sizeof(struct xnn_reshape_cache_entry));
+        return NULL;
+      }
+    }
+    return &cache->entries[cache->num_entries++];
+  }
+
+  // Evict the least recently used, or the oldest entry.
+  assert(cache->num_entries != 0);
+  struct xnn_reshape_cache_entry* victim = &cache->entries[0];
+  for (size_t i = 1; i < cache->num_entries; i++) {
+    struct xnn_reshape_cache_entry* entry = &cache->entries[i];
+    switch (cache->eviction_policy) {
+      case xnn_reshape_cache_eviction_policy_lru:
+        if (entry->last_used < victim->last_used) {
+          victim = entry;
+        }
+        break;
+      case xnn_reshape_cache_eviction_policy_fifo:
+        if (entry->inserted < victim->inserted) {
+          victim = entry;
+        }
+        break;
+    }
+  }
+  release_entry(victim);
+  return victim;
+}
+
+enum xnn_status xnn_reshape_cache_insert(
+  struct xnn_reshape_cache* cache,
+  const struct xnn_runtime* runtime)
+{
+  assert(cache->max_entries != 0);
+
+  size_t key_size = 0;
+  for (size_t i = 0; i < runtime->num_values; i++) {
+    if (is_external_input(&runtime->values[i])) {
+      key_size += 1 + runtime->values[i].shape.num_dims;
+    }
+  }
+  size_t num_operators = 0;
+  for (size_t i = 0; i < runtime->num_ops; i++) {
+    if (opdata_is_restorable(&runtime->opdata[i])) {
+      for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
+        if (runtime->opdata[i].operator_objects[j] != NULL) {
+          num_operators++;
+        }
+      }
+    }
+  }
+
+  struct xnn_reshape_cache_entry* entry = allocate_entry(cache);
+  if (entry == NULL) {
+    return xnn_status_out_of_memory;
+  }
+
+  const size_t key_bytes = key_size * sizeof(size_t);
+  const size_t operators_bytes = num_operators * sizeof(struct xnn_operator);
+  entry->key = key_bytes != 0 ? xnn_allocate_memory(key_bytes) : NULL;
+  entry->value_shapes = xnn_allocate_memory(runtime->num_values * sizeof(struct xnn_shape));
+  entry->opdata = xnn_allocate_memory(runtime->num_ops * sizeof(struct xnn_operator_data));
+  entry->first_operator = xnn_allocate_memory(runtime->num_ops * sizeof(size_t));
+  // Operators are allocated with SIMD alignment, keep the copies aligned the same way.
+  entry->operators = operators_bytes != 0 ? xnn_allocate_simd_memory(operators_bytes) : NULL;
+  if ((key_bytes != 0 && entry->key == NULL) || entry->value_shapes == NULL || entry->opdata == NULL ||
+      entry->first_operator == NULL || (operators_bytes != 0 && entry->operators == NULL)) {
+    xnn_log_error("failed to allocate reshape cache entry for %zu operators", runtime->num_ops);
+    release_entry(entry);
+    // Keep entries contiguous.
+    cache->num_entries--;
+    if (entry != &cache->entries[cache->num_entries]) {
+      *entry = cache->entries[cache->num_entries];
+      memset(&cache->entries[cache->num_entries], 0, sizeof(struct xnn_reshape_cache_entry));
+    }
+    return xnn_status_out_of_memory;
+  }
+
+  size_t k = 0;
+  for (size_t i = 0; i < runtime->num_values; i++) {
+    const struct xnn_value* value = &runtime->values[i];
+    entry->value_shapes[i] = value->shape;
+    if (is_external_input(value)) {
+      entry->key[k++] = value->shape.num_dims;
+      memcpy(&entry->key[k], value->shape.dim, value->shape.num_dims * sizeof(size_t));
+      k += value->shape.num_dims;
+    }
+  }
+  assert(k == key_size);
+  entry->key_size = key_size;
+
+  size_t index = 0;
+  for (size_t i = 0; i < runtime->num_ops; i++) {
+    const struct xnn_operator_data* opdata = &runtime->opdata[i];
+    entry->opdata[i] = *opdata;
+    entry->first_operator[i] = SIZE_MAX;
+    if (opdata_is_restorable(opdata)) {
+      entry->first_operator[i] = index;
+      for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
+        if (opdata->operator_objects[j] != NULL) {
+          memcpy(&entry->operators[index++], opdata->operator_objects[j], sizeof(struct xnn_operator));
+        }
+      }
+    }
+  }
+  assert(index == num_operators);
+
+  entry->inserted = entry->last_used = ++cache->clock;
+  return xnn_status_success;
+}
@@ -20,6 +20,7 @@
 #include "xnnpack/allocator.h"
 #include "xnnpack/cache.h"
 #include "xnnpack/common.h"
+#include "xnnpack/jit.h"
 #include "xnnpack/log.h"
 #include "xnnpack/memory-planner.h"
 #include "xnnpack/memory.h"
@@ -28,6 +29,8 @@
 #include "xnnpack/operator-type.h"
 #include "xnnpack/operator.h"
 #include "xnnpack/params.h"
+#include "xnnpack/perf-counters.h"
+#include "xnnpack/reshape-cache.h"
 #include "xnnpack/subgraph.h"
 #include "pthreadpool.h"
 
@@ -121,7 +124,10 @@ enum xnn_status xnn_release_workspace(xnn_workspace_t workspace)
   return xnn_status_success;
 }
 
-enum xnn_status xnn_create_weights_cache_with_size(size_t size, xnn_weights_cache_t* weights_cache_out)
+static enum xnn_status create_weights_cache(
+  size_t size,
+  const char* path,
+  xnn_weights_cache_t* weights_cache_out)
 {
   struct xnn_weights_cache_provider* cache_provider = NULL;
   enum xnn_status status = xnn_status_uninitialized;
@@ -143,7 +149,11 @@ enum xnn_status xnn_create_weights_cache_with_size(size_t size, xnn_weights_cach
     goto error;
   }
 
-  status = xnn_internal_init_weights_cache_with_size(cache_provider->context, size);
+  if (path != NULL) {
+    status = xnn_internal_init_weights_cache_from_file(cache_provider->context, path);
+  } else {
+    status = xnn_internal_init_weights_cache_with_size(cache_provider->context, size);
+  }
   if (status != xnn_status_success) {
     goto error;
   }
@@ -158,11 +168,26 @@ enum xnn_status xnn_create_weights_cache_with_size(size_t size, xnn_weights_cach
 
 error:
   if (cache_provider != NULL) {
-    xnn_internal_release_weights_cache(cache_provider->context);
+    xnn_release_memory(cache_provider->context);
+    xnn_release_memory(cache_provider);
   }
   return status;
 }
 
+enum xnn_status xnn_create_weights_cache_with_size(size_t size, xnn_weights_cache_t* weights_cache_out)
+{
+  return create_weights_cache(size, /*path=*/NULL, weights_cache_out);
+}
+
+enum xnn_status xnn_create_weights_cache_from_file(const char* path, xnn_weights_cache_t* weights_cache_out)
+{
+  if (path == NULL) {
+    xnn_log_error("failed to create weights cache: path is NULL");
+    return xnn_status_invalid_parameter;
+  }
+  return create_weights_cache(/*size=*/0, path, weights_cache_out);
+}
+
 enum xnn_status xnn_create_weights_cache(xnn_weights_cache_t* weights_cache_out)
 {
   return xnn_create_weights_cache_with_size(XNN_DEFAULT_WEIGHTS_BUFFER_SIZE, weights_cache_out);
@@ -391,6 +416,7 @@ static void optimize_tensor_allocation_for_in_place_operations(
     switch (node->type) {
       case xnn_node_type_unary_elementwise:
       case xnn_node_type_binary_elementwise:
+      case xnn_node_type_fused_elementwise:
       case xnn_node_type_copy:
       case xnn_node_type_softmax:
       case xnn_node_type_static_reshape:
@@ -416,6 +442,9 @@ static void optimize_tensor_allocation_for_in_place_operations(
     // TODO(zhin): consider aliasing input to output rather than output to input.
     struct xnn_value* output = &runtime->values[node->outputs[0]];
     if (output->num_consumers == 1) {
+      // Usage records track the lifecycle in execution stages if operators run concurrently.
+      const uint32_t first_consumer =
+        runtime->num_stages != 0 ? runtime->opdata[output->first_consumer].stage : output->first_consumer;
       uint32_t reuse_id = input_id;
       // If the tensor we are reusing is itself reused, find the "root tensor" to be reused.
       while (tracker->usage[reuse_id].reuse_value_id != XNN_INVALID_VALUE_ID) {
@@ -423,10 +452,10 @@ static void optimize_tensor_allocation_for_in_place_operations(
       }
       // We only support when output has a single consumer because we cannot easily find all consumer nodes
       // without traversing the entire graph. This will require tracking output->last_consumer in the future.
-      assert(tracker->usage[reuse_id].last_node < output->first_consumer);
+      assert(tracker->usage[reuse_id].last_node < first_consumer);
       xnn_log_debug("reusing tensor id #%" PRIu32 " memory for tensor id #%" PRIu32 " Node #%" PRIu32 " %s",
                     reuse_id, output->id, node->id, xnn_node_type_to_string(node->type));
-      xnn_mark_tensor_as_reuse(tracker, output->id, reuse_id, output->first_consumer);
+      xnn_mark_tensor_as_reuse(tracker, output->id, reuse_id, first_consumer);
     }
   }
 }
@@ -512,6 +541,153 @@ void propagate_rank(
   }
 }
 
+// Groups the operators of the runtime into stages of operators without dependencies between them. An operator depends
+// on the producers of its inputs, and on all earlier operators which read or write any of its outputs. Operators of a
+// stage are assigned disjoint thread pools with an equal share of the runtime's threads.
+static enum xnn_status create_runtime_stages(xnn_runtime_t runtime)
+{
+  const size_t num_threads = pthreadpool_get_threads_count(runtime->threadpool);
+  if (num_threads <= 1) {
+    xnn_log_debug("inter-operator parallelism disabled: runtime has a single thread");
+    return xnn_status_success;
+  }
+
+  enum xnn_status status = xnn_status_out_of_memory;
+  size_t num_live_ops = 0;
+  size_t num_stages = 0;
+  uint32_t* stage_sizes = NULL;
+  // One past the last stage that accessed each value, or 0 if the value was not accessed yet.
+  uint32_t* value_last_access = xnn_allocate_zero_memory(runtime->num_values * sizeof(uint32_t));
+  if (value_last_access == NULL) {
+    xnn_log_error("failed to allocate %zu bytes for value access tracking", runtime->num_values * sizeof(uint32_t));
+    goto cleanup;
+  }
+
+  for (uint32_t opdata_id = 0; opdata_id < runtime->num_ops; opdata_id++) {
+    struct xnn_operator_data* opdata = &runtime->opdata[opdata_id];
+    if (opdata->operator_objects[0] == NULL) {
+      continue;  // Operator was removed during optimization
+    }
+    uint32_t stage = 0;
+    for (uint32_t i = 0; i < opdata->num_inputs; i++) {
+      const uint32_t input_id = opdata->inputs[i];
+      if (input_id == XNN_INVALID_VALUE_ID) {
+        continue;
+      }
+      const uint32_t producer = runtime->values[input_id].producer;
+      if (producer != XNN_INVALID_NODE_ID && producer != opdata_id &&
+          runtime->opdata[producer].operator_objects[0] != NULL) {
+        assert(producer < opdata_id);
+        stage = max(stage, runtime->opdata[producer].stage + 1);
+      }
+    }
+    for (uint32_t i = 0; i < opdata->num_outputs; i++) {
+      const uint32_t output_id = opdata->outputs[i];
+      if (output_id != XNN_INVALID_VALUE_ID) {
+        stage = max(stage, value_last_access[output_id]);
+      }
+    }
+    opdata->stage = stage;
+    for (uint32_t i = 0; i < opdata->num_inputs + opdata->num_outputs; i++) {
+      const uint32_t value_id = i < opdata->num_inputs ? opdata->inputs[i] : opdata->outputs[i - opdata->num_inputs];
+      if (value_id != XNN_INVALID_VALUE_ID) {
+        value_last_access[value_id] = max(value_last_access[value_id], stage + 1);
+      }
+    }
+    num_stages = max(num_stages, stage + 1);
+    num_live_ops += 1;
+  }
+
+  if (num_stages == num_live_ops) {
+    xnn_log_debug("inter-operator parallelism disabled: no independent operators in the runtime");
+    status = xnn_status_success;
+    goto cleanup;
+  }
+
+  stage_sizes = xnn_allocate_zero_memory(num_stages * sizeof(uint32_t));
+  runtime->stages = xnn_allocate_zero_memory(num_stages * sizeof(struct xnn_runtime_stage));
+  runtime->stage_ops = xnn_allocate_zero_memory(num_live_ops * sizeof(uint32_t));
+  if (stage_sizes == NULL || runtime->stages == NULL || runtime->stage_ops == NULL) {
+    xnn_log_error("failed to allocate descriptors for %zu runtime stages", num_stages);
+    goto cleanup;
+  }
+  runtime->num_stages = num_stages;
+
+  for (uint32_t opdata_id = 0; opdata_id < runtime->num_ops; opdata_id++) {
+    if (runtime->opdata[opdata_id].operator_objects[0] != NULL) {
+      runtime->stages[runtime->opdata[opdata_id].stage].num_ops += 1;
+    }
+  }
+  // Each operator of a stage with K operators gets num_threads / K threads, rounded down to a power of 2 so that thread
+  // pools can be shared between stages of similar width. Operators which get a single thread run without a thread pool.
+  uint32_t branch_sizes_mask = 0;
+  size_t first_op = 0;
+  for (size_t i = 0; i < num_stages; i++) {
+    struct xnn_runtime_stage* stage = &runtime->stages[i];
+    stage->first_op = first_op;
+    first_op += stage->num_ops;
+    const size_t threads_per_op = num_threads / stage->num_ops;
+    if (stage->num_ops > 1 && threads_per_op > 1) {
+      branch_sizes_mask |= UINT32_C(1) << (31 - math_clz_nonzero_u32((uint32_t) threads_per_op));
+    }
+  }
+  size_t num_branch_threadpools = 0;
+  for (uint32_t mask = branch_sizes_mask; mask != 0; mask &= mask - 1) {
+    num_branch_threadpools += num_threads >> math_ctz_u32(mask);
+  }
+  if (num_branch_threadpools != 0) {
+    runtime->branch_threadpools = xnn_allocate_zero_memory(num_branch_threadpools * sizeof(pthreadpool_t));
+    if (runtime->branch_threadpools == NULL) {
+      xnn_log_error("failed to allocate %zu bytes for branch thread pools",
+                    num_branch_threadpools * sizeof(pthreadpool_t));
+      goto cleanup;
+    }
+    runtime->num_branch_threadpools = num_branch_threadpools;
+  }
+
+  for (uint32_t opdata_id = 0; opdata_id < runtime->num_ops; opdata_id++) {
+    struct xnn_operator_data* opdata = &runtime->opdata[opdata_id];
+    if (opdata->operator_objects[0] == NULL) {
+      continue;
+    }
+    const struct xnn_runtime_stage* stage = &runtime->stages[opdata->stage];
+    const uint32_t slot = stage_sizes[opdata->stage]++;
+    runtime->stage_ops[stage->first_op + slot] = opdata_id;
+    if (stage->num_ops == 1) {
+      opdata->threadpool = runtime->threadpool;
+      continue;
+    }
+    const size_t threads_per_op = num_threads / stage->num_ops;
+    if (threads_per_op <= 1) {
+      opdata->threadpool = NULL;
+      continue;
+    }
+    // Thread pools with 2**k threads follow all thread pools with fewer threads.
+    const uint32_t log2_threads = 31 - math_clz_nonzero_u32((uint32_t) threads_per_op);
+    size_t pool_index = slot;
+    for (uint32_t mask = branch_sizes_mask & ((UINT32_C(1) << log2_threads) - 1); mask != 0; mask &= mask - 1) {
+      pool_index += num_threads >> math_ctz_u32(mask);
+    }
+    assert(pool_index < num_branch_threadpools);
+    if (runtime->branch_threadpools[pool_index] == NULL) {
+      runtime->branch_threadpools[pool_index] = pthreadpool_create((size_t) 1 << log2_threads);
+      if (runtime->branch_threadpools[pool_index] == NULL) {
+        xnn_log_error("failed to create thread pool with %zu threads", (size_t) 1 << log2_threads);
+        goto cleanup;
+      }
+    }
+    opdata->threadpool = runtime->branch_threadpools[pool_index];
+  }
+  xnn_log_debug("scheduled %zu operators in %zu stages", num_live_ops, num_stages);
+  status = xnn_status_success;
+
+cleanup:
+  // Stages and thread pools are released in xnn_delete_runtime.
+  xnn_release_memory(value_last_access);
+  xnn_release_memory(stage_sizes);
+  return status;
+}
+
 enum xnn_status xnn_create_runtime_v4(
   xnn_subgraph_t subgraph,
   xnn_weights_cache_t weights_cache,
@@ -586,7 +762,35 @@ enum xnn_status xnn_create_runtime_v4(
     }
   }
 
-  struct xnn_code_cache* code_cache = NULL;
+  if (flags & XNN_FLAG_AUTOTUNE) {
+    for (size_t i = 0; i < subgraph->num_nodes; i++) {
+      struct xnn_node* node = subgraph->nodes + i;
+      if (node->type == xnn_node_type_fully_connected) {
+        node->flags |= XNN_FLAG_AUTOTUNE;
+      }
+    }
+  }
+
+  if (flags & XNN_FLAG_JIT) {
+    #if XNN_ENABLE_JIT
+      runtime->code_cache = xnn_allocate_zero_memory(sizeof(struct xnn_code_cache));
+      if (runtime->code_cache == NULL) {
+        xnn_log_error("failed to allocate %zu bytes for code cache", sizeof(struct xnn_code_cache));
+        goto error;
+      }
+      status = xnn_init_code_cache(runtime->code_cache);
+      if (status != xnn_status_success) {
+        xnn_release_memory(runtime->code_cache);
+        runtime->code_cache = NULL;
+        goto error;
+      }
+      status = xnn_status_out_of_memory;
+    #else
+      xnn_log_warning("JIT is not supported on this platform, using static microkernels");
+    #endif
+  }
+
+  struct xnn_code_cache* code_cache = runtime->code_cache;
   runtime->values = xnn_allocate_zero_memory(sizeof(struct xnn_value) * subgraph->num_values);
   if (runtime->values == NULL) {
     xnn_log_error("failed to allocate %zu bytes for runtime's value descriptors",
@@ -614,6 +818,7 @@ enum xnn_status xnn_create_runtime_v4(
     runtime->opdata[i].flags = node->flags;
     runtime->opdata[i].id = node->id;
     runtime->opdata[i].num_inputs = node->num_inputs;
+    runtime->opdata[i].num_epilogue_inputs = node->epilogue.num_inputs;
     runtime->opdata[i].num_outputs = node->num_outputs;
     // Copy all inputs (not just num_inputs) to get all invalid ID (e.g. no bias).
     for (size_t input_i = 0; input_i < node->num_inputs; input_i++) {
@@ -637,6 +842,17 @@ enum xnn_status xnn_create_runtime_v4(
   }
 
   runtime->threadpool = threadpool;
+  for (size_t i = 0; i < runtime->num_ops; i++) {
+    runtime->opdata[i].threadpool = threadpool;
+  }
+
+  if (flags & XNN_FLAG_INTER_OP_PARALLELISM) {
+    status = create_runtime_stages(runtime);
+    if (status != xnn_status_success) {
+      xnn_log_error("failed to create runtime stages");
+      goto error;
+    }
+  }
 
 #ifdef XNN_SLINKY_ENABLED
   // If compiling with XNN_SLINKY_ENABLED defined, assume we always
@@ -673,9 +889,23 @@ enum xnn_status xnn_create_runtime_v4(
   runtime->next_workspace_user = runtime->workspace->first_user;
   runtime->workspace->first_user = runtime;
 
-  if (flags & XNN_FLAG_BASIC_PROFILING) {
+  if (flags & (XNN_FLAG_BASIC_PROFILING | XNN_FLAG_HARDWARE_COUNTER_PROFILING)) {
     runtime->profiling = true;
   }
+  if (flags & XNN_FLAG_HARDWARE_COUNTER_PROFILING) {
+    // Profiling without counters is still useful, so failing to open them is not an error.
+    status = xnn_open_perf_counters(&runtime->perf_counters);
+    if (status == xnn_status_out_of_memory) {
+      goto error;
+    }
+  }
+  if (flags & XNN_FLAG_PARALLEL_TRACING) {
+    status = xnn_init_trace(&runtime->trace);
+    if (status != xnn_status_success) {
+      goto error;
+    }
+    runtime->tracing = true;
+  }
 
   *runtime_out = runtime;
   return xnn_status_success;
@@ -690,6 +920,7 @@ enum xnn_status xnn_plan_memory(
   enum xnn_status status = xnn_status_invalid_state;
   struct xnn_value_allocation_tracker mem_alloc_tracker;
   xnn_init_value_allocation_tracker(&mem_alloc_tracker, runtime);
+  mem_alloc_tracker.strategy = runtime->memory_planner_strategy;
 
   size_t persistent_size = 0;
 
@@ -718,10 +949,16 @@ enum xnn_status xnn_plan_memory(
     xnn_add_operator_workspace_allocation_tracker(
         &mem_alloc_tracker, runtime->num_values + opdata_id, xnn_get_rounded_size(opdata->workspace_size),
         opdata_id);
+    opdata->planned_workspace_size = opdata->workspace_size;
   }
 
+  if (runtime->num_stages != 0) {
+    xnn_assign_value_allocation_tracker_stages(&mem_alloc_tracker, runtime);
+  }
   optimize_tensor_allocation_for_in_place_operations(&mem_alloc_tracker, runtime);
   xnn_plan_value_allocation_tracker(&mem_alloc_tracker);
+  runtime->memory_arena_size = mem_alloc_tracker.mem_arena_size;
+  runtime->memory_lower_bound = mem_alloc_tracker.lower_bound;
 
   status = initialize_workspace_values(runtime, &mem_alloc_tracker, old_persistent_size);
   if (status != xnn_status_success) {
@@ -743,16 +980,31 @@ enum xnn_status xnn_reshape_runtime(
 {
   bool reallocation_required = false;
 
+  struct xnn_reshape_cache_entry* cached_reshape = NULL;
+  if (runtime->reshape_cache.max_entries != 0) {
+    cached_reshape = xnn_reshape_cache_look_up(&runtime->reshape_cache, runtime);
+    if (cached_reshape != NULL) {
+      xnn_reshape_cache_restore_values(cached_reshape, runtime);
+    }
+  }
+
   for (uint32_t opdata_id = 0; opdata_id < runtime->num_ops; opdata_id++) {
     struct xnn_operator_data* opdata = &runtime->opdata[opdata_id];
     if (opdata->operator_objects[0] == NULL) {
       // Operator was removed during optimization
       continue;
     }
+    if (cached_reshape != NULL && xnn_reshape_cache_restore_operator(cached_reshape, runtime, opdata_id)) {
+      // Value sizes only grow, so only the workspace of the operator can exceed the memory plan.
+      if (opdata->workspace_size > opdata->planned_workspace_size) {
+        reallocation_required = true;
+      }
+      continue;
+    }
     assert(opdata->reshape != NULL);
     xnn_log_debug("reshaping operator %u (%s)", opdata_id,
                   xnn_operator_type_to_string(opdata->operator_objects[0]->type));
-    enum xnn_status status = opdata->reshape(opdata, runtime->values, runtime->num_values, runtime->threadpool);
+    enum xnn_status status = opdata->reshape(opdata, runtime->values, runtime->num_values, opdata->threadpool);
     if (status == xnn_status_reallocation_required) {
       reallocation_required = true;
     } else if (status != xnn_status_success) {
@@ -762,8 +1014,77 @@ enum xnn_status xnn_reshape_runtime(
   }
   if (reallocation_required || !runtime->memory_planned) {
     runtime->memory_planned = true;
-    return xnn_plan_memory(runtime);
+    const enum xnn_status status = xnn_plan_memory(runtime);
+    if (status != xnn_status_success) {
+      return status;
+    }
+  }
+
+  if (runtime->reshape_cache.max_entries != 0 && cached_reshape == NULL) {
+    if (xnn_reshape_cache_insert(&runtime->reshape_cache, runtime) != xnn_status_success) {
+      // The runtime was reshaped, the next reshape with the same shapes will not be cached.
+      xnn_log_warning("failed to cache reshape of runtime");
+    }
+  }
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_set_runtime_memory_planner(
+  xnn_runtime_t runtime,
+  enum xnn_memory_planner_strategy strategy)
+{
+  switch (strategy) {
+    case xnn_memory_planner_strategy_greedy_by_size:
+    case xnn_memory_planner_strategy_greedy_by_breadth:
+    case xnn_memory_planner_strategy_best_fit:
+    case xnn_memory_planner_strategy_exhaustive:
+      break;
+    default:
+      xnn_log_error("failed to set runtime memory planner: invalid strategy %d", strategy);
+      return xnn_status_invalid_parameter;
+  }
+
+  if (runtime->memory_planner_strategy != strategy) {
+    runtime->memory_planner_strategy = strategy;
+    // Replan memory on the next reshape.
+    runtime->memory_planned = false;
+  }
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_set_runtime_reshape_cache(
+  xnn_runtime_t runtime,
+  size_t max_entries,
+  enum xnn_reshape_cache_eviction_policy eviction_policy)
+{
+  switch (eviction_policy) {
+    case xnn_reshape_cache_eviction_policy_lru:
+    case xnn_reshape_cache_eviction_policy_fifo:
+      break;
+    default:
+      xnn_log_error("failed to set runtime reshape cache: invalid eviction policy %d", eviction_policy);
+      return xnn_status_invalid_parameter;
   }
+
+  xnn_configure_reshape_cache(&runtime->reshape_cache, max_entries, eviction_policy);
+  return xnn_status_success;
+}
+
+enum xnn_status xnn_get_runtime_memory_plan_info(
+  xnn_runtime_t runtime,
+  size_t* arena_size_out,
+  size_t* lower_bound_out)
+{
+  if (!runtime->memory_planned) {
+    xnn_log_error("failed to get runtime memory plan info: memory was not planned, call xnn_reshape_runtime first");
+    return xnn_status_invalid_state;
+  }
+  if (arena_size_out == NULL || lower_bound_out == NULL) {
+    xnn_log_error("failed to get runtime memory plan info: null pointer");
+    return xnn_status_invalid_parameter;
+  }
+  *arena_size_out = runtime->memory_arena_size;
+  *lower_bound_out = runtime->memory_lower_bound;
   return xnn_status_success;
 }
 
@@ -811,7 +1132,7 @@ enum xnn_status xnn_setup_runtime(
       }
 
       assert(opdata->reshape != NULL);
-      enum xnn_status status = opdata->reshape(opdata, runtime->values, runtime->num_values, runtime->threadpool);
+      enum xnn_status status = opdata->reshape(opdata, runtime->values, runtime->num_values, opdata->threadpool);
       if (status != xnn_status_success && status != xnn_status_reallocation_required) {
         xnn_log_error("failed to setup runtime: error in reshaping operator #%u", opdata_id);
         return status;
@@ -949,6 +1270,52 @@ static inline uint64_t xnn_get_elapsed_time(const xnn_timestamp* start, const xn
 #endif
 }
 
+// Estimates the arithmetic operations of an operator from the current shapes of its values: two per multiply-accumulate
+// for convolutions and matrix multiplications, and one per output element for all other operators.
+static uint64_t estimate_operator_flops(const struct xnn_runtime* runtime, const struct xnn_operator_data* opdata)
+{
+  const struct xnn_value* input = &runtime->values[opdata->inputs[0]];
+  const struct xnn_value* output = &runtime->values[opdata->outputs[0]];
+  const uint64_t output_elements = xnn_shape_multiply_all_dims(&output->shape);
+  switch (opdata->type) {
+    case xnn_node_type_convolution_2d:
+    case xnn_node_type_depthwise_convolution_2d:
+    case xnn_node_type_fully_connected:
+    {
+      // Every output pixel, or row, takes one multiply-accumulate per element of the filter.
+      const struct xnn_value* filter = &runtime->values[opdata->inputs[1]];
+      return 2 * xnn_shape_multiply_non_channel_dims(&output->shape) * xnn_shape_multiply_all_dims(&filter->shape);
+    }
+    case xnn_node_type_deconvolution_2d:
+    {
+      // Every input pixel takes one multiply-accumulate per element of the filter.
+      const struct xnn_value* filter = &runtime->values[opdata->inputs[1]];
+      return 2 * xnn_shape_multiply_non_channel_dims(&input->shape) * xnn_shape_multiply_all_dims(&filter->shape);
+    }
+    case xnn_node_type_batch_matrix_multiply:
+    {
+      const size_t k = input->shape.num_dims == 0 ? 1 : input->shape.dim[input->shape.num_dims - 1];
+      return 2 * output_elements * k;
+    }
+    default:
+      return output_elements;
+  }
+}
+
+static uint64_t operator_bytes(const struct xnn_runtime* runtime, const struct xnn_operator_data* opdata)
+{
+  uint64_t bytes = 0;
+  for (uint32_t i = 0; i < opdata->num_inputs; i++) {
+    bytes += xnn_tensor_get_size(&runtime->values[opdata->inputs[i]]);
+  }
+  for (uint32_t i = 0; i < opdata->num_outputs; i++) {
+    if (opdata->outputs[i] != XNN_INVALID_VALUE_ID) {
+      bytes += xnn_tensor_get_size(&runtime->values[opdata->outputs[i]]);
+    }
+  }
+  return bytes;
+}
+
 enum xnn_status xnn_get_runtime_profiling_info(xnn_runtime_t runtime,
                                                enum xnn_profile_info param_name,
                                                size_t param_value_size,
@@ -1022,15 +1389,14 @@ enum xnn_status xnn_get_runtime_profiling_info(xnn_runtime_t runtime,
         *param_value_size_ret = required_size;
         status = xnn_status_out_of_memory;
       } else {
-        xnn_timestamp previous_ts = runtime->start_ts;
         uint64_t* data = (uint64_t*) param_value;
         for (size_t i = 0; i < runtime->num_ops; ++i) {
           if (opdata[i].operator_objects[0] != NULL) {
+            // Operators may run concurrently, so time each operator object separately.
             uint64_t op_time = 0;
             for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
               if (opdata[i].operator_objects[j] != NULL) {
-                op_time += xnn_get_elapsed_time(&previous_ts, &opdata[i].end_ts[j]);
-                previous_ts = opdata[i].end_ts[j];
+                op_time += xnn_get_elapsed_time(&opdata[i].start_ts[j], &opdata[i].end_ts[j]);
               }
             }
             *data++ = op_time;
@@ -1039,12 +1405,139 @@ enum xnn_status xnn_get_runtime_profiling_info(xnn_runtime_t runtime,
       }
       break;
     }
+    case xnn_profile_info_operator_cycles:
+    case xnn_profile_info_operator_instructions:
+    case xnn_profile_info_operator_l1d_cache_misses:
+    case xnn_profile_info_operator_llc_misses:
+    case xnn_profile_info_operator_flops:
+    case xnn_profile_info_operator_bytes:
+    {
+      enum xnn_perf_counter counter = xnn_perf_counter_count;
+      switch (param_name) {
+        case xnn_profile_info_operator_cycles:
+          counter = xnn_perf_counter_cycles;
+          break;
+        case xnn_profile_info_operator_instructions:
+          counter = xnn_perf_counter_instructions;
+          break;
+        case xnn_profile_info_operator_l1d_cache_misses:
+          counter = xnn_perf_counter_l1d_cache_misses;
+          break;
+        case xnn_profile_info_operator_llc_misses:
+          counter = xnn_perf_counter_llc_misses;
+          break;
+        default:
+          break;
+      }
+      if (counter != xnn_perf_counter_count && !runtime->perf_counters.available) {
+        return xnn_status_unsupported_hardware;
+      }
+
+      size_t num_valid_ops = 0;
+      for (size_t i = 0; i < runtime->num_ops; ++i) {
+        if (opdata[i].operator_objects[0] != NULL) {
+          num_valid_ops += 1;
+        }
+      }
+      required_size = num_valid_ops * sizeof(uint64_t);
+      if (param_value_size < required_size) {
+        *param_value_size_ret = required_size;
+        status = xnn_status_out_of_memory;
+      } else {
+        uint64_t* data = (uint64_t*) param_value;
+        for (size_t i = 0; i < runtime->num_ops; ++i) {
+          if (opdata[i].operator_objects[0] != NULL) {
+            switch (param_name) {
+              case xnn_profile_info_operator_flops:
+                *data++ = estimate_operator_flops(runtime, &opdata[i]);
+                break;
+              case xnn_profile_info_operator_bytes:
+                *data++ = operator_bytes(runtime, &opdata[i]);
+                break;
+              default:
+                *data++ = opdata[i].perf_counters[counter];
+                break;
+            }
+          }
+        }
+      }
+      break;
+    }
     default:
       status = xnn_status_invalid_parameter;
   }
   return status;
 }
 
+enum xnn_status xnn_write_runtime_trace(xnn_runtime_t runtime, const char* filename)
+{
+  if (!runtime->tracing) {
+    xnn_log_error("failed to write runtime trace: runtime was not created with XNN_FLAG_PARALLEL_TRACING");
+    return xnn_status_invalid_state;
+  }
+  const enum xnn_status status = xnn_write_trace(&runtime->trace, filename);
+  if (status != xnn_status_success) {
+    return status;
+  }
+  xnn_clear_trace(&runtime->trace);
+  return xnn_status_success;
+}
+
+static enum xnn_status run_operator_data(
+  xnn_runtime_t runtime,
+  size_t opdata_id)
+{
+  struct xnn_operator_data* opdata = &runtime->opdata[opdata_id];
+  const bool read_perf_counters = runtime->perf_counters.available;
+  uint64_t start_counters[xnn_perf_counter_count];
+  if (read_perf_counters) {
+    xnn_read_perf_counters(&runtime->perf_counters, start_counters);
+  }
+  for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
+    if (opdata->operator_objects[j] == NULL) {
+      // Operator was removed after fusion
+      continue;
+    }
+
+    if (runtime->profiling) {
+      opdata->start_ts[j] = xnn_read_timer();
+    }
+    const enum xnn_status status = xnn_run_operator_with_index(
+      opdata->operator_objects[j], opdata_id, j, runtime->tracing ? &runtime->trace : NULL, opdata->threadpool);
+    if (status != xnn_status_success) {
+      return status;
+    }
+    if (runtime->profiling) {
+      opdata->end_ts[j] = xnn_read_timer();
+    }
+  }
+  if (read_perf_counters) {
+    uint64_t end_counters[xnn_perf_counter_count];
+    xnn_read_perf_counters(&runtime->perf_counters, end_counters);
+    for (size_t i = 0; i < xnn_perf_counter_count; i++) {
+      opdata->perf_counters[i] = end_counters[i] - start_counters[i];
+    }
+  }
+  return xnn_status_success;
+}
+
+struct stage_context {
+  xnn_runtime_t runtime;
+  const struct xnn_runtime_stage* stage;
+  enum xnn_status status;
+};
+
+static void run_stage_operator(
+  struct stage_context* context,
+  size_t index)
+{
+  const uint32_t opdata_id = context->runtime->stage_ops[context->stage->first_op + index];
+  const enum xnn_status status = run_operator_data(context->runtime, opdata_id);
+  if (status != xnn_status_success) {
+    context->status = status;
+  }
+}
+
 enum xnn_status xnn_invoke_runtime(
   xnn_runtime_t runtime)
 {
@@ -1056,20 +1549,35 @@ enum xnn_status xnn_invoke_runtime(
   if (runtime->profiling) {
     runtime->start_ts = xnn_read_timer();
   }
-  for (size_t i = 0; i < runtime->num_ops; i++) {
-    for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
-      if (runtime->opdata[i].operator_objects[j] == NULL) {
-        // Operator was removed after fusion
-        continue;
+  if (runtime->num_stages == 0) {
+    for (size_t i = 0; i < runtime->num_ops; i++) {
+      const enum xnn_status status = run_operator_data(runtime, i);
+      if (status != xnn_status_success) {
+        return status;
       }
+    }
+    return xnn_status_success;
+  }
 
-      const enum xnn_status status = xnn_run_operator_with_index(runtime->opdata[i].operator_objects[j], i, j, runtime->threadpool);
+  for (size_t i = 0; i < runtime->num_stages; i++) {
+    const struct xnn_runtime_stage* stage = &runtime->stages[i];
+    if (stage->num_ops == 1) {
+      const enum xnn_status status = run_operator_data(runtime, runtime->stage_ops[stage->first_op]);
       if (status != xnn_status_success) {
         return status;
       }
-      if (runtime->profiling) {
-        runtime->opdata[i].end_ts[j] = xnn_read_timer();
-      }
+      continue;
+    }
+    // Each operator of the stage runs on its own thread pool, or on the calling worker thread.
+    struct stage_context context = {
+      .runtime = runtime,
+      .stage = stage,
+      .status = xnn_status_success,
+    };
+    pthreadpool_parallelize_1d(
+      runtime->threadpool, (pthreadpool_task_1d_t) run_stage_operator, &context, stage->num_ops, /*flags=*/0);
+    if (context.status != xnn_status_success) {
+      return context.status;
     }
   }
   return xnn_status_success;
@@ -1083,6 +1591,12 @@ enum xnn_status xnn_delete_runtime(
     // slinky_destroy_pipeline(runtime);
     #endif
 
+    xnn_release_reshape_cache(&runtime->reshape_cache);
+    xnn_close_perf_counters(&runtime->perf_counters);
+    if (runtime->tracing) {
+      xnn_release_trace(&runtime->trace);
+    }
+
     if (runtime->opdata != NULL) {
       for (size_t i = 0; i < runtime->num_ops; i++) {
         for (size_t j = 0; j < XNN_MAX_OPERATOR_OBJECTS; j++) {
@@ -1091,6 +1605,15 @@ enum xnn_status xnn_delete_runtime(
       }
       xnn_release_memory(runtime->opdata);
 
+      for (size_t i = 0; i < runtime->num_branch_threadpools; i++) {
+        if (runtime->branch_threadpools[i] != NULL) {
+          pthreadpool_destroy(runtime->branch_threadpools[i]);
+        }
+      }
+      xnn_release_memory(runtime->branch_threadpools);
+      xnn_release_memory(runtime->stage_ops);
+      xnn_release_memory(runtime->stages);
+
       if (runtime->values != NULL) {
         // Release the buffers created during FP16 rewrite.
         for (size_t i = 0; i < runtime->num_values; i++) {
@@ -1120,6 +1643,12 @@ enum xnn_status xnn_delete_runtime(
         xnn_release_workspace(runtime->workspace);
       }
     }
+
+    // Operators are deleted, nothing runs the generated code anymore.
+    if (runtime->code_cache != NULL) {
+      xnn_release_code_cache(runtime->code_cache);
+      xnn_release_memory(runtime->code_cache);
+    }
     xnn_release_memory(runtime);
   }
   return xnn_status_success;
@@ -1405,6 +1405,290 @@ enum xnn_status xnn_subgraph_fusion(
   return xnn_status_success;
 }
 
+static bool is_fusable_elementwise_value(const struct xnn_value* value)
+{
+  return (value->datatype == xnn_datatype_fp32 || value->datatype == xnn_datatype_fp16) &&
+         value->layout == xnn_layout_type_nhwc;
+}
+
+static bool is_fusable_elementwise_node(xnn_subgraph_t subgraph, const struct xnn_node* node)
+{
+  switch (node->type) {
+    case xnn_node_type_unary_elementwise:
+      if (node->unary_operator == xnn_unary_convert) {
+        return false;
+      }
+      break;
+    case xnn_node_type_binary_elementwise:
+      break;
+    default:
+      return false;
+  }
+  const struct xnn_value* output = &subgraph->values[node->outputs[0]];
+  if (!is_fusable_elementwise_value(output)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < node->num_inputs; i++) {
+    const struct xnn_value* input = &subgraph->values[node->inputs[i]];
+    if (!is_fusable_elementwise_value(input) || input->datatype != output->datatype) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool shapes_equal(const struct xnn_shape* a, const struct xnn_shape* b)
+{
+  return a->num_dims == b->num_dims && memcmp(a->dim, b->dim, a->num_dims * sizeof(size_t)) == 0;
+}
+
+// Fills `step` with the operation of `node` on the result of the chain so far, `chain_id`, and adds the other operand
+// of binary nodes to `inputs`. Returns false if the node can not be appended to the chain.
+static bool init_fused_elementwise_step(
+  xnn_subgraph_t subgraph,
+  const struct xnn_node* node,
+  uint32_t chain_id,
+  const struct xnn_shape* shape,
+  struct xnn_fused_elementwise_step* step,
+  uint32_t* inputs,
+  uint32_t* num_inputs)
+{
+  if (!is_fusable_elementwise_node(subgraph, node) || !shapes_equal(&subgraph->values[node->outputs[0]].shape, shape)) {
+    return false;
+  }
+
+  if (node->type == xnn_node_type_unary_elementwise) {
+    *step = (struct xnn_fused_elementwise_step) {
+      .binary_operator = xnn_binary_invalid,
+      .unary_operator = node->unary_operator,
+      .unary_params = node->params.unary,
+    };
+    return true;
+  }
+
+  assert(node->type == xnn_node_type_binary_elementwise);
+  const bool operand_first = node->inputs[1] == chain_id;
+  const uint32_t operand_id = operand_first ? node->inputs[0] : node->inputs[1];
+  // Intermediate results of the chain are not stored, only the input of the chain can be used twice.
+  if (operand_id == chain_id && chain_id != inputs[0]) {
+    return false;
+  }
+  if (!xnn_fused_elementwise_can_broadcast(&subgraph->values[operand_id].shape, shape)) {
+    return false;
+  }
+  uint32_t operand = 0;
+  while (operand < *num_inputs && inputs[operand] != operand_id) {
+    operand++;
+  }
+  if (operand == XNN_MAX_FUSED_ELEMENTWISE_INPUTS) {
+    return false;
+  }
+  if (operand == *num_inputs) {
+    inputs[(*num_inputs)++] = operand_id;
+  }
+  *step = (struct xnn_fused_elementwise_step) {
+    .binary_operator = node->binary_operator,
+    .unary_operator = xnn_unary_invalid,
+    .operand = operand,
+    .operand_first = operand_first,
+  };
+  return true;
+}
+
+void xnn_subgraph_fuse_elementwise_chains(xnn_subgraph_t subgraph)
+{
+  xnn_subgraph_analyze_consumers_and_producers(subgraph);
+
+  bool changed = false;
+  for (uint32_t n = 0; n < subgraph->num_nodes; n++) {
+    const struct xnn_node* first_node = &subgraph->nodes[n];
+    if (!is_fusable_elementwise_node(subgraph, first_node)) {
+      continue;
+    }
+
+    // The input of the chain is the input with the shape of the output, all other operands are broadcast to it.
+    const struct xnn_shape* shape = &subgraph->values[first_node->outputs[0]].shape;
+    uint32_t input_id = first_node->inputs[0];
+    if (!shapes_equal(&subgraph->values[input_id].shape, shape) && first_node->num_inputs > 1) {
+      input_id = first_node->inputs[1];
+    }
+    if (!shapes_equal(&subgraph->values[input_id].shape, shape)) {
+      continue;
+    }
+
+    struct xnn_fused_elementwise_step steps[XNN_MAX_FUSED_ELEMENTWISE_STEPS];
+    uint32_t node_ids[XNN_MAX_FUSED_ELEMENTWISE_STEPS];
+    uint32_t inputs[XNN_MAX_FUSED_ELEMENTWISE_INPUTS] = {input_id};
+    uint32_t num_inputs = 1;
+    size_t num_steps = 0;
+    uint32_t node_id = n;
+    uint32_t chain_id = input_id;
+    while (num_steps < XNN_MAX_FUSED_ELEMENTWISE_STEPS) {
+      const struct xnn_node* node = &subgraph->nodes[node_id];
+      if (!init_fused_elementwise_step(subgraph, node, chain_id, shape, &steps[num_steps], inputs, &num_inputs)) {
+        break;
+      }
+      node_ids[num_steps++] = node_id;
+
+      // Intermediate results must only be consumed by the next node of the chain.
+      chain_id = node->outputs[0];
+      const struct xnn_value* value = &subgraph->values[chain_id];
+      if (value->num_consumers != 1 || !xnn_value_is_internal(value)) {
+        break;
+      }
+      node_id = value->first_consumer;
+      assert(node_id < subgraph->num_nodes);
+    }
+    if (num_steps < 2) {
+      continue;
+    }
+
+    // The fused Node replaces the last Node of the chain, after all of its operands are produced.
+    const uint32_t last_node_id = node_ids[num_steps - 1];
+    xnn_log_info("fuse %zu elementwise Nodes from Node #%" PRIu32 " to Node #%" PRIu32 " into Fused Elementwise Node",
+      num_steps, n, last_node_id);
+    for (size_t i = 0; i + 1 < num_steps; i++) {
+      struct xnn_node* node = &subgraph->nodes[node_ids[i]];
+      xnn_value_clear(&subgraph->values[node->outputs[0]]);
+      xnn_node_clear(node);
+    }
+    struct xnn_node* last_node = &subgraph->nodes[last_node_id];
+    xnn_init_fused_elementwise_node(last_node, num_steps, steps, num_inputs, inputs, last_node->outputs[0]);
+    changed = true;
+  }
+
+  if (changed) {
+    xnn_subgraph_analyze_consumers_and_producers(subgraph);
+  }
+}
+
+static bool is_f32_nhwc_value(const struct xnn_value* value)
+{
+  return value->datatype == xnn_datatype_fp32 && value->layout == xnn_layout_type_nhwc;
+}
+
+// Returns true if `node` is an F32 Fully Connected or Convolution Node with static weights that runs GEMM or IGEMM
+// micro-kernels.
+static bool is_gemm_epilogue_producer(xnn_subgraph_t subgraph, const struct xnn_node* node)
+{
+  switch (node->type) {
+    case xnn_node_type_fully_connected:
+      break;
+    case xnn_node_type_convolution_2d:
+      // Depthwise and channelwise Convolutions use DWCONV and VMULCADDC micro-kernels.
+      if (node->params.convolution_2d.groups != 1 ||
+          (node->params.convolution_2d.group_input_channels == 1 &&
+           node->params.convolution_2d.group_output_channels == 1)) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  if (node->epilogue.num_steps != 0 || node->num_inputs > 3 ||
+      !is_f32_nhwc_value(&subgraph->values[node->inputs[0]]) ||
+      !is_f32_nhwc_value(&subgraph->values[node->outputs[0]])) {
+    return false;
+  }
+  for (uint32_t i = 1; i < node->num_inputs; i++) {
+    const struct xnn_value* weights = &subgraph->values[node->inputs[i]];
+    if (weights->datatype != xnn_datatype_fp32 || !xnn_value_is_static(weights)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void xnn_subgraph_fuse_gemm_epilogues(xnn_subgraph_t subgraph)
+{
+  xnn_subgraph_analyze_consumers_and_producers(subgraph);
+
+  bool changed = false;
+  for (uint32_t n = 0; n < subgraph->num_nodes; n++) {
+    const struct xnn_node* gemm_node = &subgraph->nodes[n];
+    if (!is_gemm_epilogue_producer(subgraph, gemm_node)) {
+      continue;
+    }
+
+    const struct xnn_shape* shape = &subgraph->values[gemm_node->outputs[0]].shape;
+    struct xnn_fused_elementwise_step steps[XNN_MAX_GEMM_EPILOGUE_STEPS];
+    uint32_t node_ids[XNN_MAX_GEMM_EPILOGUE_STEPS];
+    uint32_t residual_id = XNN_INVALID_VALUE_ID;
+    size_t num_steps = 0;
+    uint32_t chain_id = gemm_node->outputs[0];
+    while (num_steps < XNN_MAX_GEMM_EPILOGUE_STEPS) {
+      // Intermediate results must only be consumed by the next node of the chain.
+      const struct xnn_value* value = &subgraph->values[chain_id];
+      if (value->num_consumers != 1 || !xnn_value_is_internal(value)) {
+        break;
+      }
+      const uint32_t node_id = value->first_consumer;
+      assert(node_id < subgraph->num_nodes);
+      const struct xnn_node* node = &subgraph->nodes[node_id];
+      if (!is_fusable_elementwise_node(subgraph, node) || !is_f32_nhwc_value(&subgraph->values[node->outputs[0]]) ||
+          !shapes_equal(&subgraph->values[node->outputs[0]].shape, shape)) {
+        break;
+      }
+
+      if (node->type == xnn_node_type_unary_elementwise) {
+        steps[num_steps] = (struct xnn_fused_elementwise_step) {
+          .binary_operator = xnn_binary_invalid,
+          .unary_operator = node->unary_operator,
+          .unary_params = node->params.unary,
+        };
+      } else {
+        // The other operand is read with the strides of the output, it can not be broadcast.
+        assert(node->type == xnn_node_type_binary_elementwise);
+        const bool operand_first = node->inputs[1] == chain_id;
+        const uint32_t operand_id = operand_first ? node->inputs[0] : node->inputs[1];
+        if (residual_id != XNN_INVALID_VALUE_ID || operand_id == chain_id ||
+            !shapes_equal(&subgraph->values[operand_id].shape, shape)) {
+          break;
+        }
+        residual_id = operand_id;
+        steps[num_steps] = (struct xnn_fused_elementwise_step) {
+          .binary_operator = node->binary_operator,
+          .unary_operator = xnn_unary_invalid,
+          .operand_first = operand_first,
+        };
+      }
+      node_ids[num_steps++] = node_id;
+      chain_id = node->outputs[0];
+    }
+    if (num_steps == 0) {
+      continue;
+    }
+
+    // The fused Node replaces the last Node of the chain, after the residual is produced.
+    const uint32_t last_node_id = node_ids[num_steps - 1];
+    xnn_log_info("fuse %zu elementwise Nodes up to Node #%" PRIu32 " into the epilogue of %s Node #%" PRIu32,
+      num_steps, last_node_id, xnn_node_type_to_string(gemm_node->type), n);
+    struct xnn_node* last_node = &subgraph->nodes[last_node_id];
+    const uint32_t output_id = last_node->outputs[0];
+    xnn_value_clear(&subgraph->values[gemm_node->outputs[0]]);
+    for (size_t i = 0; i + 1 < num_steps; i++) {
+      struct xnn_node* node = &subgraph->nodes[node_ids[i]];
+      xnn_value_clear(&subgraph->values[node->outputs[0]]);
+      xnn_node_clear(node);
+    }
+    *last_node = *gemm_node;
+    last_node->id = last_node_id;
+    last_node->outputs[0] = output_id;
+    last_node->epilogue.num_steps = num_steps;
+    memcpy(last_node->epilogue.steps, steps, num_steps * sizeof(struct xnn_fused_elementwise_step));
+    if (residual_id != XNN_INVALID_VALUE_ID) {
+      last_node->inputs[last_node->num_inputs++] = residual_id;
+      last_node->epilogue.num_inputs = 1;
+    }
+    xnn_node_clear(&subgraph->nodes[n]);
+    changed = true;
+  }
+
+  if (changed) {
+    xnn_subgraph_analyze_consumers_and_producers(subgraph);
+  }
+}
+
 void xnn_subgraph_optimize_dynamic_quantization_ops(xnn_subgraph_t subgraph) {
   enum xnn_weights_type {
     xnn_weights_type_invalid = 0,
@@ -1612,6 +1896,12 @@ enum xnn_status xnn_subgraph_optimize(
 
   xnn_subgraph_optimize_dynamic_quantization_ops(subgraph);
 
+  // Elementwise chains are fused after the FP16 and NCHW rewrites, which do not handle fused elementwise Nodes.
+  if (!(optimization_flags & XNN_FLAG_NO_OPERATOR_FUSION)) {
+    xnn_subgraph_fuse_gemm_epilogues(subgraph);
+    xnn_subgraph_fuse_elementwise_chains(subgraph);
+  }
+
   return xnn_status_success;
 }
 
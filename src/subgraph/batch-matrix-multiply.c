@@ -47,6 +47,9 @@ static enum xnn_status create_batch_matrix_multiply_operator(
   if (inputa_datatype == inputb_datatype && inputa_datatype == xnn_datatype_fp16) {
     return xnn_create_batch_matrix_multiply_nc_f16(node->flags, &opdata->operator_objects[0]);
   }
+  if (inputa_datatype == inputb_datatype && inputa_datatype == xnn_datatype_bf16) {
+    return xnn_create_batch_matrix_multiply_nc_bf16_f32(node->flags, &opdata->operator_objects[0]);
+  }
   const struct xnn_value* input_b = values + input_b_id;
   // Get the shape and size of the second input.
   size_t batch_size_b = 1;
@@ -230,6 +233,12 @@ static enum xnn_status reshape_batch_matrix_multiply_operator(
   const size_t old_workspace_size = opdata->workspace_size;
   enum xnn_status status = xnn_status_invalid_state;
   switch (opdata->operator_objects[0]->type) {
+    case xnn_operator_type_batch_matrix_multiply_nc_bf16_f32:
+      status = xnn_reshape_batch_matrix_multiply_nc_bf16_f32(
+          opdata->operator_objects[0], num_batch_dims, padded_dims_a,
+          padded_dims_b, m, k, n, &opdata->workspace_size,
+          &opdata->workspace_alignment, threadpool);
+      break;
     case xnn_operator_type_batch_matrix_multiply_nc_f16:
       status = xnn_reshape_batch_matrix_multiply_nc_f16(
           opdata->operator_objects[0], num_batch_dims, padded_dims_a,
@@ -310,6 +319,10 @@ static enum xnn_status setup_batch_matrix_multiply_operator(
   assert(output_data != NULL);
 
   switch (opdata->operator_objects[0]->type) {
+    case xnn_operator_type_batch_matrix_multiply_nc_bf16_f32:
+      return xnn_setup_batch_matrix_multiply_nc_bf16_f32(
+          opdata->operator_objects[0], opdata->workspace, input_a_data,
+          input_b_data, output_data);
     case xnn_operator_type_batch_matrix_multiply_nc_f16:
       return xnn_setup_batch_matrix_multiply_nc_f16(
           opdata->operator_objects[0], opdata->workspace, input_a_data,
@@ -340,6 +353,11 @@ static inline bool validate_datatypes(
   enum xnn_datatype output_datatype)
 {
   switch (input2_datatype) {
+    case xnn_datatype_bf16:
+      if (input1_datatype == xnn_datatype_bf16 && output_datatype == xnn_datatype_fp32) {
+        return true;
+      }
+      break;
     case xnn_datatype_fp16:
       if (input1_datatype == xnn_datatype_fp16 && output_datatype == xnn_datatype_fp16) {
         return true;
@@ -386,6 +404,7 @@ enum xnn_status xnn_define_batch_matrix_multiply(
   }
 
   switch (input1_value->datatype) {
+    case xnn_datatype_bf16:
     case xnn_datatype_fp16:
     case xnn_datatype_fp32:
       break;
@@ -422,6 +441,7 @@ enum xnn_status xnn_define_batch_matrix_multiply(
   }
 
   switch (input2_value->datatype) {
+    case xnn_datatype_bf16:
     case xnn_datatype_fp16:
     case xnn_datatype_fp32:
       break;
@@ -30,8 +30,9 @@ static enum xnn_status create_convolution_operator(
   struct xnn_code_cache* code_cache,
   xnn_weights_cache_t weights_cache)
 {
-  assert(node->num_inputs >= 2);
-  assert(node->num_inputs <= 3);
+  const uint32_t num_inputs = node->num_inputs - node->epilogue.num_inputs;
+  assert(num_inputs >= 2);
+  assert(num_inputs <= 3);
   const uint32_t input_id = node->inputs[0];
   assert(input_id != XNN_INVALID_VALUE_ID);
   assert(input_id < num_values);
@@ -49,7 +50,7 @@ static enum xnn_status create_convolution_operator(
 
   const void* bias_data = NULL;
   uint32_t bias_id = XNN_INVALID_VALUE_ID;
-  if (node->num_inputs > 2) {
+  if (num_inputs > 2) {
     bias_id = node->inputs[2];
     assert(bias_id != XNN_INVALID_VALUE_ID);
     assert(bias_id < num_values);
@@ -542,6 +543,9 @@ static enum xnn_status create_convolution_operator(
         XNN_UNREACHABLE;
     }
   }
+  if (status == xnn_status_success && node->epilogue.num_steps != 0) {
+    status = xnn_fuse_gemm_epilogue(opdata->operator_objects[0], node->epilogue.num_steps, node->epilogue.steps);
+  }
   return status;
 }
 
@@ -739,6 +743,11 @@ static enum xnn_status setup_convolution_operator(
   void* output_data = output_value->data;
   assert(output_data != NULL);
 
+  const enum xnn_status status = xnn_setup_gemm_epilogue_residual(opdata, values, num_values);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
   switch (opdata->operator_objects[0]->type) {
     case xnn_operator_type_convolution_nchw_f16:
       return xnn_setup_convolution2d_nchw_f16(
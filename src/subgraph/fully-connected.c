@@ -53,6 +53,7 @@ enum fully_connected_op_type {
   fc_type_qdu8_f32_qb4w = 26,
   fc_type_qdu8_f16_qc4w = 27,
   fc_type_qp8_f32_qc8w = 28,
+  fc_type_bf16_bf16_f32 = 29,
 };
 
 enum fully_connected_op_type get_fully_connected_op_type(
@@ -115,6 +116,8 @@ enum fully_connected_op_type get_fully_connected_op_type(
       break;
     case xnn_datatype_fp32:
       switch (filter_datatype) {
+        case xnn_datatype_bf16:
+          return fc_type_bf16_bf16_f32;
         case xnn_datatype_fp16:
           switch (input_datatype) {
             case xnn_datatype_fp32:
@@ -199,8 +202,9 @@ static enum xnn_status create_fully_connected_operator(
     const struct xnn_node* node, const struct xnn_value* values,
     size_t num_values, struct xnn_operator_data* opdata,
     struct xnn_code_cache* code_cache, xnn_weights_cache_t weights_cache) {
-  assert(node->num_inputs >= 2);
-  assert(node->num_inputs <= 3);
+  const uint32_t num_inputs = node->num_inputs - node->epilogue.num_inputs;
+  assert(num_inputs >= 2);
+  assert(num_inputs <= 3);
   const uint32_t input_id = node->inputs[0];
   assert(input_id != XNN_INVALID_VALUE_ID);
   assert(input_id < num_values);
@@ -229,7 +233,7 @@ static enum xnn_status create_fully_connected_operator(
 
   const void* bias_data = NULL;
   const struct xnn_value* bias_value = NULL;
-  if (node->num_inputs > 2) {
+  if (num_inputs > 2) {
     const uint32_t bias_id = node->inputs[2];
     assert(bias_id != XNN_INVALID_VALUE_ID);
     assert(bias_id < num_values);
@@ -336,6 +340,15 @@ static enum xnn_status create_fully_connected_operator(
           /*flags=*/node->flags, code_cache, weights_cache,
           &opdata->operator_objects[0]);
       break;
+    case fc_type_bf16_bf16_f32:
+      status = xnn_create_fully_connected_nc_bf16_f32(
+          input_channels, output_channels,
+          /*input_stride=*/input_channels,
+          /*output_stride=*/output_channels, kernel_data, bias_data,
+          node->activation.output_min, node->activation.output_max,
+          /*flags=*/node->flags, code_cache, weights_cache,
+          &opdata->operator_objects[0]);
+      break;
     case fc_type_pf32_f32_f32:
       status = xnn_create_fully_connected_nc_pf32(
           input_channels, output_channels,
@@ -542,6 +555,11 @@ static enum xnn_status create_fully_connected_operator(
     default:
       XNN_UNREACHABLE;
   }
+  if (status == xnn_status_success && node->epilogue.num_steps != 0) {
+    status = xnn_fuse_gemm_epilogue(opdata->operator_objects[0],
+                                    node->epilogue.num_steps,
+                                    node->epilogue.steps);
+  }
   return status;
 }
 
@@ -627,6 +645,10 @@ static enum xnn_status reshape_fully_connected_operator(
           output_channels, input_channels, output_channels,
           &opdata->workspace_size, &opdata->workspace_alignment, threadpool);
       break;
+    case xnn_operator_type_fully_connected_nc_bf16_f32:
+      status = xnn_reshape_fully_connected_nc_bf16_f32(
+          opdata->operator_objects[0], batch_size, threadpool);
+      break;
     case xnn_operator_type_fully_connected_nc_f16:
       status = xnn_reshape_fully_connected_nc_f16(opdata->operator_objects[0],
                                                   batch_size, threadpool);
@@ -754,7 +776,7 @@ static enum xnn_status setup_fully_connected_operator(
           : kernel_value->data;
 
   const void* bias_data = NULL;
-  if (opdata->num_inputs > 2) {
+  if (opdata->num_inputs - opdata->num_epilogue_inputs > 2) {
     assert(bias_id != XNN_INVALID_VALUE_ID);
     assert(bias_id < num_values);
     const struct xnn_value* bias_value = values + bias_id;
@@ -770,6 +792,12 @@ static enum xnn_status setup_fully_connected_operator(
   void* output_data = output_value->data;
   assert(output_data != NULL);
 
+  enum xnn_status status =
+      xnn_setup_gemm_epilogue_residual(opdata, values, num_values);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
   switch (opdata->operator_objects[0]->type) {
     case xnn_operator_type_dynamic_fully_connected_nc_f16:
       assert(kernel_data != NULL);
@@ -781,6 +809,11 @@ static enum xnn_status setup_fully_connected_operator(
       return xnn_setup_dynamic_fully_connected_nc_f32(
           opdata->operator_objects[0], opdata->workspace, input_data,
           kernel_data, bias_data, output_data);
+    case xnn_operator_type_fully_connected_nc_bf16_f32:
+      assert(kernel_data == NULL);
+      assert(bias_data == NULL);
+      return xnn_setup_fully_connected_nc_bf16_f32(opdata->operator_objects[0],
+                                                   input_data, output_data);
     case xnn_operator_type_fully_connected_nc_f16:
       assert(kernel_data == NULL);
       assert(bias_data == NULL);
@@ -956,6 +989,13 @@ static inline bool validate_datatypes_with_bias(
     enum xnn_datatype input_datatype, enum xnn_datatype kernel_datatype,
     enum xnn_datatype bias_datatype, enum xnn_datatype output_datatype) {
   switch (kernel_datatype) {
+    case xnn_datatype_bf16:
+      if (input_datatype == xnn_datatype_bf16 &&
+          bias_datatype == xnn_datatype_fp32 &&
+          output_datatype == xnn_datatype_fp32) {
+        return true;
+      }
+      break;
     case xnn_datatype_fp32:
       if (input_datatype == xnn_datatype_fp32 &&
           bias_datatype == xnn_datatype_fp32 &&
@@ -1066,6 +1106,12 @@ static inline bool validate_datatypes_without_bias(
     enum xnn_datatype input_datatype, enum xnn_datatype kernel_datatype,
     enum xnn_datatype output_datatype) {
   switch (kernel_datatype) {
+    case xnn_datatype_bf16:
+      if (input_datatype == xnn_datatype_bf16 &&
+          output_datatype == xnn_datatype_fp32) {
+        return true;
+      }
+      break;
     case xnn_datatype_fp32:
       if (input_datatype == xnn_datatype_fp32 &&
           output_datatype == xnn_datatype_fp32) {
@@ -1178,6 +1224,7 @@ enum xnn_status xnn_define_fully_connected(xnn_subgraph_t subgraph,
   }
 
   switch (input_value->datatype) {
+    case xnn_datatype_bf16:
     case xnn_datatype_fp16:
     case xnn_datatype_fp32:
     case xnn_datatype_qint8:
@@ -1239,6 +1286,7 @@ enum xnn_status xnn_define_fully_connected(xnn_subgraph_t subgraph,
 
   // Non-static kernel is supported, but only for some data types
   switch (kernel_value->datatype) {
+    case xnn_datatype_bf16:
     case xnn_datatype_fp16:
     case xnn_datatype_fp32:
       break;
@@ -0,0 +1,186 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+#include "xnnpack/compute.h"
+#include "xnnpack/internal.h"
+#include "xnnpack/log.h"
+#include "xnnpack/node-type.h"
+#include "xnnpack/operator-type.h"
+#include "xnnpack/operator.h"
+#include "xnnpack/reshape-helpers.h"
+#include "xnnpack/subgraph.h"
+#include "pthreadpool.h"
+
+static enum xnn_status create_fused_elementwise_operator(
+  const struct xnn_node* node,
+  const struct xnn_value* values,
+  size_t num_values,
+  struct xnn_operator_data* opdata,
+  struct xnn_code_cache* code_cache,
+  xnn_weights_cache_t weights_cache)
+{
+  assert(node->num_outputs == 1);
+  const uint32_t output_id = node->outputs[0];
+  assert(output_id < num_values);
+
+  return xnn_create_fused_elementwise_nc(
+    values[output_id].datatype,
+    node->params.fused_elementwise.num_steps,
+    node->params.fused_elementwise.steps,
+    node->flags,
+    &opdata->operator_objects[0]);
+}
+
+static enum xnn_status reshape_fused_elementwise_operator(
+  struct xnn_operator_data* opdata,
+  struct xnn_value* values,
+  size_t num_values,
+  pthreadpool_t threadpool)
+{
+  const uint32_t input_id = opdata->inputs[0];
+  assert(input_id < num_values);
+  const struct xnn_shape* input_shape = &values[input_id].shape;
+  const size_t batch_size = xnn_shape_multiply_non_channel_dims(input_shape);
+  const size_t channels = input_shape->num_dims == 0 ? 1 : input_shape->dim[input_shape->num_dims - 1];
+
+  size_t input_sizes[XNN_MAX_FUSED_ELEMENTWISE_INPUTS];
+  assert(opdata->num_inputs <= XNN_MAX_FUSED_ELEMENTWISE_INPUTS);
+  for (uint32_t i = 0; i < opdata->num_inputs; i++) {
+    const struct xnn_shape* operand_shape = &values[opdata->inputs[i]].shape;
+    if (!xnn_fused_elementwise_can_broadcast(operand_shape, input_shape)) {
+      xnn_log_error(
+        "failed to reshape %s operator: shape of input #%" PRIu32 " (Value ID #%" PRIu32
+        ") can not be broadcast to the shape of input #0",
+        xnn_node_type_to_string(xnn_node_type_fused_elementwise), i, opdata->inputs[i]);
+      return xnn_status_invalid_parameter;
+    }
+    input_sizes[i] = xnn_shape_multiply_all_dims(operand_shape);
+  }
+
+  const size_t old_workspace_size = opdata->workspace_size;
+  enum xnn_status status = xnn_reshape_fused_elementwise_nc(
+    opdata->operator_objects[0], batch_size, channels, input_sizes, threadpool);
+  if (status != xnn_status_success) {
+    return status;
+  }
+  return resize_unary_elementwise_output_tensor(opdata, values, num_values, old_workspace_size, threadpool);
+}
+
+static enum xnn_status setup_fused_elementwise_operator(
+  const struct xnn_operator_data* opdata,
+  const struct xnn_value* values,
+  size_t num_values,
+  pthreadpool_t threadpool)
+{
+  const void* inputs[XNN_MAX_FUSED_ELEMENTWISE_INPUTS];
+  for (uint32_t i = 0; i < opdata->num_inputs; i++) {
+    const uint32_t input_id = opdata->inputs[i];
+    assert(input_id != XNN_INVALID_VALUE_ID);
+    assert(input_id < num_values);
+    inputs[i] = values[input_id].data;
+    assert(inputs[i] != NULL);
+  }
+
+  const uint32_t output_id = opdata->outputs[0];
+  assert(output_id != XNN_INVALID_VALUE_ID);
+  assert(output_id < num_values);
+  void* output_data = values[output_id].data;
+  assert(output_data != NULL);
+
+  return xnn_setup_fused_elementwise_nc(opdata->operator_objects[0], inputs, output_data);
+}
+
+bool xnn_fused_elementwise_can_broadcast(const struct xnn_shape* operand_shape, const struct xnn_shape* input_shape)
+{
+  if (operand_shape->num_dims > input_shape->num_dims) {
+    return false;
+  }
+  const size_t num_leading_dims = input_shape->num_dims - operand_shape->num_dims;
+
+  // Same elements as the input.
+  bool same = true;
+  for (size_t i = 0; i < num_leading_dims; i++) {
+    same &= input_shape->dim[i] == 1;
+  }
+  for (size_t i = 0; i < operand_shape->num_dims; i++) {
+    same &= operand_shape->dim[i] == input_shape->dim[num_leading_dims + i];
+  }
+  if (same) {
+    return true;
+  }
+
+  // A single element, or one element per channel.
+  for (size_t i = 0; i + 1 < operand_shape->num_dims; i++) {
+    if (operand_shape->dim[i] != 1) {
+      return false;
+    }
+  }
+  return operand_shape->num_dims == 0 || operand_shape->dim[operand_shape->num_dims - 1] == 1 ||
+         operand_shape->dim[operand_shape->num_dims - 1] == input_shape->dim[input_shape->num_dims - 1];
+}
+
+void xnn_init_fused_elementwise_node(
+  struct xnn_node* node,
+  size_t num_steps,
+  const struct xnn_fused_elementwise_step* steps,
+  uint32_t num_inputs,
+  const uint32_t* inputs,
+  uint32_t output_id)
+{
+  assert(num_steps <= XNN_MAX_FUSED_ELEMENTWISE_STEPS);
+  assert(num_inputs <= XNN_MAX_FUSED_ELEMENTWISE_INPUTS);
+  assert(num_inputs <= XNN_MAX_INPUTS);
+
+  const uint32_t id = node->id;
+  xnn_node_clear(node);
+  node->type = xnn_node_type_fused_elementwise;
+  node->id = id;
+  node->params.fused_elementwise.num_steps = num_steps;
+  memcpy(node->params.fused_elementwise.steps, steps, num_steps * sizeof(struct xnn_fused_elementwise_step));
+  node->num_inputs = num_inputs;
+  memcpy(node->inputs, inputs, num_inputs * sizeof(uint32_t));
+  node->num_outputs = 1;
+  node->outputs[0] = output_id;
+
+  node->create = create_fused_elementwise_operator;
+  node->reshape = reshape_fused_elementwise_operator;
+  node->setup = setup_fused_elementwise_operator;
+}
+
+enum xnn_status xnn_setup_gemm_epilogue_residual(
+  const struct xnn_operator_data* opdata,
+  const struct xnn_value* values,
+  size_t num_values)
+{
+  if (opdata->num_epilogue_inputs == 0) {
+    return xnn_status_success;
+  }
+  assert(opdata->num_epilogue_inputs == 1);
+  const uint32_t residual_id = opdata->inputs[opdata->num_inputs - 1];
+  assert(residual_id < num_values);
+  const uint32_t output_id = opdata->outputs[0];
+  assert(output_id < num_values);
+
+  // The residual is read with the strides of the output.
+  const struct xnn_shape* residual_shape = &values[residual_id].shape;
+  const struct xnn_shape* output_shape = &values[output_id].shape;
+  if (residual_shape->num_dims != output_shape->num_dims ||
+      memcmp(residual_shape->dim, output_shape->dim, output_shape->num_dims * sizeof(size_t)) != 0) {
+    xnn_log_error(
+      "failed to setup %s operator: shape of residual (Value ID #%" PRIu32 ") does not match the shape of the output",
+      xnn_node_type_to_string(opdata->type), residual_id);
+    return xnn_status_invalid_parameter;
+  }
+  return xnn_setup_gemm_epilogue(opdata->operator_objects[0], values[residual_id].data);
+}
@@ -6,11 +6,15 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
 #include "xnnpack.h"
 #include "xnnpack/common.h"
+#include "xnnpack/datatype.h"
+#include "xnnpack/internal.h"
 #include "xnnpack/log.h"
 #include "xnnpack/node-type.h"
 #include "xnnpack/operator-type.h"
@@ -19,6 +23,25 @@
 #include "xnnpack/subgraph.h"
 #include "pthreadpool.h"
 
+static size_t attention_operator_index(size_t num_outputs)
+{
+  return num_outputs == 3 ? 2 : 0;
+}
+
+// A key/value cache must have the same dimensions as the new key/value tokens, except for the tokens dimension.
+static bool kv_cache_shape_matches(const struct xnn_shape* tokens_shape, const struct xnn_shape* cache_shape)
+{
+  if (tokens_shape->num_dims != cache_shape->num_dims) {
+    return false;
+  }
+  for (size_t i = 0; i < tokens_shape->num_dims; i++) {
+    if (i != tokens_shape->num_dims - 2 && tokens_shape->dim[i] != cache_shape->dim[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static enum xnn_status create_scaled_dot_product_attention_operator(
   const struct xnn_node* node,
   const struct xnn_value* values,
@@ -28,7 +51,12 @@ static enum xnn_status create_scaled_dot_product_attention_operator(
   xnn_weights_cache_t weights_cache)
 {
   assert(node->num_inputs == 5);
-  assert(node->num_outputs == 1);
+  assert(node->num_outputs == 1 || node->num_outputs == 3);
+
+  // With a key/value cache, the first two operators append the new key and value tokens to the caches, and the
+  // attention operator runs last over the caches.
+  const bool has_kv_cache = node->num_outputs == 3;
+  const size_t attention_index = attention_operator_index(node->num_outputs);
 
   enum xnn_status status;
   const uint32_t input_id = node->inputs[0];
@@ -37,20 +65,40 @@ static enum xnn_status create_scaled_dot_product_attention_operator(
   switch (input_value->datatype) {
     case xnn_datatype_fp32:
     {
+      if (has_kv_cache) {
+        status = xnn_create_copy_nc_x32(/*flags=*/0, &opdata->operator_objects[0]);
+        if (status != xnn_status_success) {
+          break;
+        }
+        status = xnn_create_copy_nc_x32(/*flags=*/0, &opdata->operator_objects[1]);
+        if (status != xnn_status_success) {
+          break;
+        }
+      }
       status = xnn_create_scaled_dot_product_attention_nhtc_f32(
         node->params.scaled_dot_product_attention.cap_type,
         &node->params.scaled_dot_product_attention.cap_tanh_params,
-        /*flags=*/0,
-        &opdata->operator_objects[0]);
+        /*flags=*/XNN_FLAG_ATTENTION_ONLINE_SOFTMAX,
+        &opdata->operator_objects[attention_index]);
       break;
     }
     case xnn_datatype_fp16:
     {
+      if (has_kv_cache) {
+        status = xnn_create_copy_nc_x16(/*flags=*/0, &opdata->operator_objects[0]);
+        if (status != xnn_status_success) {
+          break;
+        }
+        status = xnn_create_copy_nc_x16(/*flags=*/0, &opdata->operator_objects[1]);
+        if (status != xnn_status_success) {
+          break;
+        }
+      }
       status = xnn_create_scaled_dot_product_attention_nhtc_f16(
         node->params.scaled_dot_product_attention.cap_type,
         &node->params.scaled_dot_product_attention.cap_tanh_params,
-        /*flags=*/0,
-        &opdata->operator_objects[0]);
+        /*flags=*/XNN_FLAG_ATTENTION_ONLINE_SOFTMAX,
+        &opdata->operator_objects[attention_index]);
       break;
     }
     default:
@@ -118,6 +166,28 @@ static enum xnn_status resize_scaled_dot_product_attention_output_tensor(
   return xnn_status_success;
 }
 
+static enum xnn_status reshape_kv_cache_append(
+  xnn_operator_t copy_op,
+  size_t cache_rows,
+  size_t new_tokens,
+  size_t channels,
+  size_t cache_tokens,
+  pthreadpool_t threadpool)
+{
+  switch (copy_op->type) {
+    case xnn_operator_type_copy_nc_x16:
+      return xnn_reshape_copy_nc_x16(
+        copy_op, cache_rows, new_tokens * channels, /*input_stride=*/new_tokens * channels,
+        /*output_stride=*/cache_tokens * channels, threadpool);
+    case xnn_operator_type_copy_nc_x32:
+      return xnn_reshape_copy_nc_x32(
+        copy_op, cache_rows, new_tokens * channels, /*input_stride=*/new_tokens * channels,
+        /*output_stride=*/cache_tokens * channels, threadpool);
+    default:
+      XNN_UNREACHABLE;
+  }
+}
+
 static enum xnn_status reshape_scaled_dot_product_attention_operator(
   struct xnn_operator_data* opdata,
   struct xnn_value* values,
@@ -255,7 +325,47 @@ static enum xnn_status reshape_scaled_dot_product_attention_operator(
     return xnn_status_invalid_parameter;
   }
 
-  if (mask->shape.dim[1] != key_tokens) {
+  const bool has_kv_cache = opdata->num_outputs == 3;
+  const size_t attention_index = attention_operator_index(opdata->num_outputs);
+  // Without a cache, attention is computed over the key/value tokens. With a cache, it is computed over the valid
+  // prefix of the cache, whose length is given by the mask and includes the new key/value tokens.
+  const size_t attention_tokens = mask->shape.dim[1];
+  size_t cache_tokens = key_tokens;
+  if (has_kv_cache) {
+    const uint32_t key_cache_id = opdata->outputs[1];
+    assert(key_cache_id != XNN_INVALID_VALUE_ID);
+    assert(key_cache_id < num_values);
+    const struct xnn_value* key_cache = values + key_cache_id;
+
+    const uint32_t value_cache_id = opdata->outputs[2];
+    assert(value_cache_id != XNN_INVALID_VALUE_ID);
+    assert(value_cache_id < num_values);
+    const struct xnn_value* value_cache = values + value_cache_id;
+
+    if (!kv_cache_shape_matches(&key->shape, &key_cache->shape)) {
+      xnn_log_error(
+        "failed to reshape %s operator with key ID #%" PRIu32 " and key cache ID #%" PRIu32 ": key cache must have "
+        "the same dimensions as key, except for tokens", xnn_node_type_to_string(opdata->type), key_id, key_cache_id);
+      return xnn_status_invalid_parameter;
+    }
+
+    if (!kv_cache_shape_matches(&value->shape, &value_cache->shape)) {
+      xnn_log_error(
+        "failed to reshape %s operator with value ID #%" PRIu32 " and value cache ID #%" PRIu32 ": value cache must "
+        "have the same dimensions as value, except for tokens",
+        xnn_node_type_to_string(opdata->type), value_id, value_cache_id);
+      return xnn_status_invalid_parameter;
+    }
+
+    cache_tokens = key_cache->shape.dim[key_cache->shape.num_dims - 2];
+    if (attention_tokens < key_tokens || attention_tokens > cache_tokens) {
+      xnn_log_error(
+        "failed to reshape %s operator with mask ID #%" PRIu32 ": mask key/value tokens (%zu) must be between the "
+        "number of new key/value tokens (%zu) and the key/value cache tokens (%zu)",
+        xnn_node_type_to_string(opdata->type), mask_id, attention_tokens, key_tokens, cache_tokens);
+      return xnn_status_invalid_parameter;
+    }
+  } else if (attention_tokens != key_tokens) {
     xnn_log_error(
       "failed to reshape %s operator with mask ID #%" PRIu32 ": mask key/value tokens (%zu) must be equal to key/value "
       "tokens (%zu)", xnn_node_type_to_string(opdata->type), mask_id, mask->shape.dim[1], key_tokens);
@@ -303,15 +413,16 @@ static enum xnn_status reshape_scaled_dot_product_attention_operator(
   const size_t old_workspace_size = opdata->workspace_size;
   status = xnn_status_invalid_state;
 
-  switch (opdata->operator_objects[0]->type) {
+  switch (opdata->operator_objects[attention_index]->type) {
     case xnn_operator_type_scaled_dot_product_attention_nhtc_f32:
-      status = xnn_reshape_scaled_dot_product_attention_nhtc_f32(
-        opdata->operator_objects[0],
+      status = xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f32(
+        opdata->operator_objects[attention_index],
         batch_size,
         query_heads,
         query_tokens,
         key_heads,
-        key_tokens,
+        attention_tokens,
+        cache_tokens,
         query_channels,
         value_channels,
         &opdata->workspace_size,
@@ -319,13 +430,14 @@ static enum xnn_status reshape_scaled_dot_product_attention_operator(
         threadpool);
       break;
     case xnn_operator_type_scaled_dot_product_attention_nhtc_f16:
-      status = xnn_reshape_scaled_dot_product_attention_nhtc_f16(
-        opdata->operator_objects[0],
+      status = xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f16(
+        opdata->operator_objects[attention_index],
         batch_size,
         query_heads,
         query_tokens,
         key_heads,
-        key_tokens,
+        attention_tokens,
+        cache_tokens,
         query_channels,
         value_channels,
         &opdata->workspace_size,
@@ -340,10 +452,40 @@ static enum xnn_status reshape_scaled_dot_product_attention_operator(
     return status;
   }
 
+  if (has_kv_cache) {
+    // Each key/value head of the new tokens is appended to the corresponding row of the cache.
+    const size_t cache_rows = batch_size * key_heads;
+    status = reshape_kv_cache_append(
+      opdata->operator_objects[0], cache_rows, key_tokens, query_channels, cache_tokens, threadpool);
+    if (status != xnn_status_success) {
+      return status;
+    }
+    status = reshape_kv_cache_append(
+      opdata->operator_objects[1], cache_rows, key_tokens, value_channels, cache_tokens, threadpool);
+    if (status != xnn_status_success) {
+      return status;
+    }
+  }
+
   // Resize the output tensor.
   return resize_scaled_dot_product_attention_output_tensor(opdata, values, num_values, old_workspace_size);
 }
 
+static enum xnn_status setup_kv_cache_append(
+  xnn_operator_t copy_op,
+  const void* input,
+  void* cache)
+{
+  switch (copy_op->type) {
+    case xnn_operator_type_copy_nc_x16:
+      return xnn_setup_copy_nc_x16(copy_op, input, cache);
+    case xnn_operator_type_copy_nc_x32:
+      return xnn_setup_copy_nc_x32(copy_op, input, cache);
+    default:
+      XNN_UNREACHABLE;
+  }
+}
+
 static enum xnn_status setup_scaled_dot_product_attention_operator(
   const struct xnn_operator_data* opdata,
   const struct xnn_value* values,
@@ -392,10 +534,47 @@ static enum xnn_status setup_scaled_dot_product_attention_operator(
   void* output_data = output->data;
   assert(output_data != NULL);
 
-  switch (opdata->operator_objects[0]->type) {
+  const size_t attention_index = attention_operator_index(opdata->num_outputs);
+  if (opdata->num_outputs == 3) {
+    const uint32_t key_cache_id = opdata->outputs[1];
+    assert(key_cache_id != XNN_INVALID_VALUE_ID);
+    assert(key_cache_id < num_values);
+    const struct xnn_value* key_cache = values + key_cache_id;
+    assert(key_cache->data != NULL);
+
+    const uint32_t value_cache_id = opdata->outputs[2];
+    assert(value_cache_id != XNN_INVALID_VALUE_ID);
+    assert(value_cache_id < num_values);
+    const struct xnn_value* value_cache = values + value_cache_id;
+    assert(value_cache->data != NULL);
+
+    // The new tokens are the last ones of the valid prefix of the cache.
+    const size_t new_tokens = key->shape.dim[key->shape.num_dims - 2];
+    const size_t position = mask->shape.dim[1] - new_tokens;
+    const size_t element_size = xnn_datatype_size_bytes(key->datatype);
+    const size_t key_offset = position * key->shape.dim[key->shape.num_dims - 1] * element_size;
+    const size_t value_offset = position * value->shape.dim[value->shape.num_dims - 1] * element_size;
+
+    enum xnn_status status = setup_kv_cache_append(
+      opdata->operator_objects[0], key_data, (void*) ((uintptr_t) key_cache->data + key_offset));
+    if (status != xnn_status_success) {
+      return status;
+    }
+    status = setup_kv_cache_append(
+      opdata->operator_objects[1], attention_value_data, (void*) ((uintptr_t) value_cache->data + value_offset));
+    if (status != xnn_status_success) {
+      return status;
+    }
+
+    // Attention reads the key and value from the caches.
+    key_data = key_cache->data;
+    attention_value_data = value_cache->data;
+  }
+
+  switch (opdata->operator_objects[attention_index]->type) {
     case xnn_operator_type_scaled_dot_product_attention_nhtc_f32:
       return xnn_setup_scaled_dot_product_attention_nhtc_f32(
-        opdata->operator_objects[0],
+        opdata->operator_objects[attention_index],
         opdata->workspace,
         query_data,
         key_data,
@@ -405,7 +584,7 @@ static enum xnn_status setup_scaled_dot_product_attention_operator(
         output_data);
     case xnn_operator_type_scaled_dot_product_attention_nhtc_f16:
       return xnn_setup_scaled_dot_product_attention_nhtc_f16(
-        opdata->operator_objects[0],
+        opdata->operator_objects[attention_index],
         opdata->workspace,
         query_data,
         key_data,
@@ -449,7 +628,51 @@ static enum xnn_status check_inputs(
   return status;
 }
 
-enum xnn_status xnn_define_scaled_dot_product_attention(
+static enum xnn_status check_kv_cache(
+  xnn_subgraph_t subgraph,
+  uint32_t tokens_id,
+  uint32_t cache_id)
+{
+  const enum xnn_node_type node_type = xnn_node_type_scaled_dot_product_attention;
+  enum xnn_status status = xnn_subgraph_check_output_node_id(node_type, cache_id, subgraph->num_values);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
+  const struct xnn_value* cache = &subgraph->values[cache_id];
+  status = xnn_subgraph_check_output_type_dense(node_type, cache_id, cache);
+  if (status != xnn_status_success) {
+    return status;
+  }
+
+  // The cache must outlive a single inference, so that the appended tokens are available to the next one.
+  if (!xnn_value_is_persistent(cache)) {
+    xnn_log_error(
+      "failed to define %s operator with cache ID #%" PRIu32 ": cache must be a persistent value",
+      xnn_node_type_to_string(node_type), cache_id);
+    return xnn_status_invalid_parameter;
+  }
+
+  const struct xnn_value* tokens = &subgraph->values[tokens_id];
+  if (cache->datatype != tokens->datatype) {
+    xnn_log_error(
+      "failed to define %s operator with input ID #%" PRIu32 " and cache ID #%" PRIu32 ": mismatching datatypes "
+      "across input (%s) and cache (%s)", xnn_node_type_to_string(node_type), tokens_id, cache_id,
+      xnn_datatype_to_string(tokens->datatype), xnn_datatype_to_string(cache->datatype));
+    return xnn_status_invalid_parameter;
+  }
+
+  if (!kv_cache_shape_matches(&tokens->shape, &cache->shape)) {
+    xnn_log_error(
+      "failed to define %s operator with input ID #%" PRIu32 " and cache ID #%" PRIu32 ": cache must have the same "
+      "dimensions as input, except for tokens", xnn_node_type_to_string(node_type), tokens_id, cache_id);
+    return xnn_status_invalid_parameter;
+  }
+
+  return xnn_status_success;
+}
+
+static enum xnn_status define_scaled_dot_product_attention(
   xnn_subgraph_t subgraph,
   enum xnn_attention_logits_cap_type cap_type,
   const void* cap_params,
@@ -458,9 +681,13 @@ enum xnn_status xnn_define_scaled_dot_product_attention(
   uint32_t value_id,
   uint32_t scale_id,
   uint32_t mask_id,
+  uint32_t key_cache_id,
+  uint32_t value_cache_id,
   uint32_t output_id,
   uint32_t flags)
 {
+  const bool has_kv_cache = key_cache_id != XNN_INVALID_VALUE_ID;
+
   const enum xnn_node_type node_type = xnn_node_type_scaled_dot_product_attention;
   enum xnn_status status = xnn_subgraph_check_xnnpack_initialized(node_type);
   if (status != xnn_status_success) {
@@ -646,8 +873,38 @@ enum xnn_status xnn_define_scaled_dot_product_attention(
     return xnn_status_invalid_parameter;
   }
 
-  // Mask key/value tokens must match key/value tokens.
-  if (mask->shape.dim[1] != key_tokens) {
+  if (has_kv_cache) {
+    status = check_kv_cache(subgraph, key_id, key_cache_id);
+    if (status != xnn_status_success) {
+      return status;
+    }
+
+    status = check_kv_cache(subgraph, value_id, value_cache_id);
+    if (status != xnn_status_success) {
+      return status;
+    }
+
+    const struct xnn_value* key_cache = &subgraph->values[key_cache_id];
+    const struct xnn_value* value_cache = &subgraph->values[value_cache_id];
+    const size_t cache_tokens = key_cache->shape.dim[key_num_dims - 2];
+    if (value_cache->shape.dim[value_num_dims - 2] != cache_tokens) {
+      xnn_log_error(
+        "failed to define %s operator with key cache ID #%" PRIu32 " and value cache ID #%" PRIu32 ": key cache "
+        "tokens (%zu) must be equal to value cache tokens (%zu)", xnn_node_type_to_string(node_type), key_cache_id,
+        value_cache_id, cache_tokens, value_cache->shape.dim[value_num_dims - 2]);
+      return xnn_status_invalid_parameter;
+    }
+
+    // Mask key/value tokens are the valid cache tokens, including the new key/value tokens.
+    if (mask->shape.dim[1] < key_tokens || mask->shape.dim[1] > cache_tokens) {
+      xnn_log_error(
+        "failed to define %s operator with mask ID #%" PRIu32 ": mask key/value tokens (%zu) must be between the "
+        "number of new key/value tokens (%zu) and the key/value cache tokens (%zu)",
+        xnn_node_type_to_string(node_type), mask_id, mask->shape.dim[1], key_tokens, cache_tokens);
+      return xnn_status_invalid_parameter;
+    }
+  } else if (mask->shape.dim[1] != key_tokens) {
+    // Mask key/value tokens must match key/value tokens.
     xnn_log_error(
       "failed to define %s operator with mask ID #%" PRIu32 ": mask key/value tokens (%zu) must match key/value (%zu)",
       xnn_node_type_to_string(node_type), mask_id, mask->shape.dim[1], key_tokens);
@@ -748,6 +1005,11 @@ enum xnn_status xnn_define_scaled_dot_product_attention(
   node->inputs[4] = mask_id;
   node->num_outputs = 1;
   node->outputs[0] = output_id;
+  if (has_kv_cache) {
+    node->num_outputs = 3;
+    node->outputs[1] = key_cache_id;
+    node->outputs[2] = value_cache_id;
+  }
   node->flags = flags;
 
   node->create = create_scaled_dot_product_attention_operator;
@@ -756,3 +1018,47 @@ enum xnn_status xnn_define_scaled_dot_product_attention(
 
   return xnn_status_success;
 }
+
+enum xnn_status xnn_define_scaled_dot_product_attention(
+  xnn_subgraph_t subgraph,
+  enum xnn_attention_logits_cap_type cap_type,
+  const void* cap_params,
+  uint32_t query_id,
+  uint32_t key_id,
+  uint32_t value_id,
+  uint32_t scale_id,
+  uint32_t mask_id,
+  uint32_t output_id,
+  uint32_t flags)
+{
+  return define_scaled_dot_product_attention(
+    subgraph, cap_type, cap_params, query_id, key_id, value_id, scale_id, mask_id,
+    /*key_cache_id=*/XNN_INVALID_VALUE_ID, /*value_cache_id=*/XNN_INVALID_VALUE_ID, output_id, flags);
+}
+
+enum xnn_status xnn_define_scaled_dot_product_attention_with_kv_cache(
+  xnn_subgraph_t subgraph,
+  enum xnn_attention_logits_cap_type cap_type,
+  const void* cap_params,
+  uint32_t query_id,
+  uint32_t key_id,
+  uint32_t value_id,
+  uint32_t scale_id,
+  uint32_t mask_id,
+  uint32_t key_cache_id,
+  uint32_t value_cache_id,
+  uint32_t output_id,
+  uint32_t flags)
+{
+  if (key_cache_id == XNN_INVALID_VALUE_ID || value_cache_id == XNN_INVALID_VALUE_ID) {
+    xnn_log_error(
+      "failed to define %s operator with key cache ID #%" PRIu32 " and value cache ID #%" PRIu32 ": both caches must "
+      "be specified", xnn_node_type_to_string(xnn_node_type_scaled_dot_product_attention), key_cache_id,
+      value_cache_id);
+    return xnn_status_invalid_parameter;
+  }
+
+  return define_scaled_dot_product_attention(
+    subgraph, cap_type, cap_params, query_id, key_id, value_id, scale_id, mask_id, key_cache_id, value_cache_id,
+    output_id, flags);
+}
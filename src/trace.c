@@ -0,0 +1,595 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+// Include first for the platform detection macros.
+#include "xnnpack/common.h"
+
+#if XNN_PLATFORM_WINDOWS
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+#else
+  // This define needs to come first because errno include features.h and would have defined macros that lead to
+  // clock_gettime not being declared.
+  #if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 199309L
+    #undef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 199309L
+  #endif
+  #include <pthread.h>
+  #include <time.h>
+#endif
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xnnpack.h"
+#include "xnnpack/allocator.h"
+#include "xnnpack/compute.h"
+#include "xnnpack/log.h"
+#include "xnnpack/math.h"
+#include "xnnpack/mutex.h"
+#include "xnnpack/trace.h"
+#include "pthreadpool.h"
+
+struct xnn_trace_tile {
+  uint64_t start_ns;
+  uint64_t end_ns;
+  uintptr_t thread;
+};
+
+static uint64_t read_time_ns(void)
+{
+#if XNN_PLATFORM_WINDOWS
+  LARGE_INTEGER counter;
+  LARGE_INTEGER frequency;
+  if (!QueryPerformanceCounter(&counter) || !QueryPerformanceFrequency(&frequency)) {
+    return 0;
+  }
+  return (uint64_t) ((double) counter.QuadPart * 1.0e9 / (double) frequency.QuadPart);
+#else
+  struct timespec timestamp;
+  if (clock_gettime(CLOCK_MONOTONIC, &timestamp) != 0) {
+    return 0;
+  }
+  return (uint64_t) timestamp.tv_sec * UINT64_C(1000000000) + (uint64_t) timestamp.tv_nsec;
+#endif
+}
+
+static uintptr_t current_thread(void)
+{
+#if XNN_PLATFORM_WINDOWS
+  return (uintptr_t) GetCurrentThreadId();
+#else
+  return (uintptr_t) pthread_self();
+#endif
+}
+
+// Records the task that starts at `index` in each dimension of the range.
+static void record_tile(struct xnn_trace_task* task, const size_t* index, size_t num_dims, uint64_t start_ns)
+{
+  size_t tile = 0;
+  for (size_t d = 0; d < num_dims; d++) {
+    tile += index[d] / task->step[d] * task->stride[d];
+  }
+  assert(tile < task->num_tiles);
+  task->tiles[tile].start_ns = start_ns;
+  task->tiles[tile].end_ns = read_time_ns();
+  task->tiles[tile].thread = current_thread();
+}
+
+static void trace_1d(struct xnn_trace_task* task, size_t i)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_1d(task->context, i);
+  const size_t index[1] = {i};
+  record_tile(task, index, 1, start_ns);
+}
+
+static void trace_1d_with_thread(struct xnn_trace_task* task, size_t thread_index, size_t i)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_1d_with_thread(task->context, thread_index, i);
+  const size_t index[1] = {i};
+  record_tile(task, index, 1, start_ns);
+}
+
+static void trace_1d_tile_1d(struct xnn_trace_task* task, size_t i, size_t tile_i)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_1d_tile_1d(task->context, i, tile_i);
+  const size_t index[1] = {i};
+  record_tile(task, index, 1, start_ns);
+}
+
+static void trace_2d(struct xnn_trace_task* task, size_t i, size_t j)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_2d(task->context, i, j);
+  const size_t index[2] = {i, j};
+  record_tile(task, index, 2, start_ns);
+}
+
+static void trace_2d_with_thread(struct xnn_trace_task* task, size_t thread_index, size_t i, size_t j)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_2d_with_thread(task->context, thread_index, i, j);
+  const size_t index[2] = {i, j};
+  record_tile(task, index, 2, start_ns);
+}
+
+static void trace_2d_tile_1d(struct xnn_trace_task* task, size_t i, size_t j, size_t tile_j)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_2d_tile_1d(task->context, i, j, tile_j);
+  const size_t index[2] = {i, j};
+  record_tile(task, index, 2, start_ns);
+}
+
+static void trace_2d_tile_2d(struct xnn_trace_task* task, size_t i, size_t j, size_t tile_i, size_t tile_j)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_2d_tile_2d(task->context, i, j, tile_i, tile_j);
+  const size_t index[2] = {i, j};
+  record_tile(task, index, 2, start_ns);
+}
+
+static void trace_3d(struct xnn_trace_task* task, size_t i, size_t j, size_t k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d(task->context, i, j, k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_3d_tile_1d(struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t tile_k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d_tile_1d(task->context, i, j, k, tile_k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_3d_tile_1d_with_thread(
+  struct xnn_trace_task* task, size_t thread_index, size_t i, size_t j, size_t k, size_t tile_k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d_tile_1d_with_thread(task->context, thread_index, i, j, k, tile_k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_3d_tile_2d(struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t tile_j, size_t tile_k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d_tile_2d(task->context, i, j, k, tile_j, tile_k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_4d(struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t l)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_4d(task->context, i, j, k, l);
+  const size_t index[4] = {i, j, k, l};
+  record_tile(task, index, 4, start_ns);
+}
+
+static void trace_4d_tile_2d(
+  struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t l, size_t tile_k, size_t tile_l)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_4d_tile_2d(task->context, i, j, k, l, tile_k, tile_l);
+  const size_t index[4] = {i, j, k, l};
+  record_tile(task, index, 4, start_ns);
+}
+
+static void trace_5d(struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t l, size_t m)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_5d(task->context, i, j, k, l, m);
+  const size_t index[5] = {i, j, k, l, m};
+  record_tile(task, index, 5, start_ns);
+}
+
+static void trace_5d_tile_2d(
+  struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t l, size_t m, size_t tile_l, size_t tile_m)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_5d_tile_2d(task->context, i, j, k, l, m, tile_l, tile_m);
+  const size_t index[5] = {i, j, k, l, m};
+  record_tile(task, index, 5, start_ns);
+}
+
+static void trace_6d_tile_2d(
+  struct xnn_trace_task* task, size_t i, size_t j, size_t k, size_t l, size_t m, size_t n, size_t tile_m,
+  size_t tile_n)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_6d_tile_2d(task->context, i, j, k, l, m, n, tile_m, tile_n);
+  const size_t index[6] = {i, j, k, l, m, n};
+  record_tile(task, index, 6, start_ns);
+}
+
+#if XNN_MAX_UARCH_TYPES > 1
+static void trace_2d_tile_1d_with_id(struct xnn_trace_task* task, uint32_t uarch_index, size_t i, size_t j, size_t tile_j)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_2d_tile_1d_with_id(task->context, uarch_index, i, j, tile_j);
+  const size_t index[2] = {i, j};
+  record_tile(task, index, 2, start_ns);
+}
+
+static void trace_2d_tile_2d_with_id(
+  struct xnn_trace_task* task, uint32_t uarch_index, size_t i, size_t j, size_t tile_i, size_t tile_j)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_2d_tile_2d_with_id(task->context, uarch_index, i, j, tile_i, tile_j);
+  const size_t index[2] = {i, j};
+  record_tile(task, index, 2, start_ns);
+}
+
+static void trace_3d_tile_1d_with_id(
+  struct xnn_trace_task* task, uint32_t uarch_index, size_t i, size_t j, size_t k, size_t tile_k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d_tile_1d_with_id(task->context, uarch_index, i, j, k, tile_k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_3d_tile_1d_with_id_with_thread(
+  struct xnn_trace_task* task, uint32_t uarch_index, size_t thread_index, size_t i, size_t j, size_t k, size_t tile_k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d_tile_1d_with_id_with_thread(task->context, uarch_index, thread_index, i, j, k, tile_k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_3d_tile_2d_with_id(
+  struct xnn_trace_task* task, uint32_t uarch_index, size_t i, size_t j, size_t k, size_t tile_j, size_t tile_k)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_3d_tile_2d_with_id(task->context, uarch_index, i, j, k, tile_j, tile_k);
+  const size_t index[3] = {i, j, k};
+  record_tile(task, index, 3, start_ns);
+}
+
+static void trace_4d_tile_2d_with_id(
+  struct xnn_trace_task* task, uint32_t uarch_index, size_t i, size_t j, size_t k, size_t l, size_t tile_k,
+  size_t tile_l)
+{
+  const uint64_t start_ns = read_time_ns();
+  task->compute.task_4d_tile_2d_with_id(task->context, uarch_index, i, j, k, l, tile_k, tile_l);
+  const size_t index[4] = {i, j, k, l};
+  record_tile(task, index, 4, start_ns);
+}
+#endif  // XNN_MAX_UARCH_TYPES > 1
+
+enum xnn_status xnn_init_trace(struct xnn_trace* trace)
+{
+  memset(trace, 0, sizeof(struct xnn_trace));
+  return xnn_mutex_init(&trace->mutex);
+}
+
+void xnn_clear_trace(struct xnn_trace* trace)
+{
+  for (size_t i = 0; i < trace->num_events; i++) {
+    xnn_release_memory(trace->events[i].spans);
+  }
+  trace->num_events = 0;
+}
+
+void xnn_release_trace(struct xnn_trace* trace)
+{
+  xnn_clear_trace(trace);
+  xnn_release_memory(trace->events);
+  xnn_release_memory(trace->threads);
+  xnn_mutex_destroy(&trace->mutex);
+  memset(trace, 0, sizeof(struct xnn_trace));
+}
+
+bool xnn_trace_begin_compute(
+  struct xnn_trace_task* task,
+  const struct compute_parameters* compute,
+  void* context,
+  struct compute_parameters* traced_compute)
+{
+  // Dimensions of the range, the last `num_tiled_dims` are split in tiles of compute->tile.
+  size_t num_dims = 0;
+  size_t num_tiled_dims = 0;
+  *traced_compute = *compute;
+  switch (compute->type) {
+    case xnn_parallelization_type_1d:
+      num_dims = 1;
+      traced_compute->task_1d = (pthreadpool_task_1d_t) trace_1d;
+      break;
+    case xnn_parallelization_type_1d_with_thread:
+      num_dims = 1;
+      traced_compute->task_1d_with_thread = (pthreadpool_task_1d_with_thread_t) trace_1d_with_thread;
+      break;
+    case xnn_parallelization_type_1d_tile_1d:
+      num_dims = 1;
+      num_tiled_dims = 1;
+      traced_compute->task_1d_tile_1d = (pthreadpool_task_1d_tile_1d_t) trace_1d_tile_1d;
+      break;
+    case xnn_parallelization_type_2d:
+      num_dims = 2;
+      traced_compute->task_2d = (pthreadpool_task_2d_t) trace_2d;
+      break;
+    case xnn_parallelization_type_2d_with_thread:
+      num_dims = 2;
+      traced_compute->task_2d_with_thread = (pthreadpool_task_2d_with_thread_t) trace_2d_with_thread;
+      break;
+    case xnn_parallelization_type_2d_tile_1d:
+      num_dims = 2;
+      num_tiled_dims = 1;
+      traced_compute->task_2d_tile_1d = (pthreadpool_task_2d_tile_1d_t) trace_2d_tile_1d;
+      break;
+    case xnn_parallelization_type_2d_tile_2d:
+      num_dims = 2;
+      num_tiled_dims = 2;
+      traced_compute->task_2d_tile_2d = (pthreadpool_task_2d_tile_2d_t) trace_2d_tile_2d;
+      break;
+    case xnn_parallelization_type_3d:
+      num_dims = 3;
+      traced_compute->task_3d = (pthreadpool_task_3d_t) trace_3d;
+      break;
+    case xnn_parallelization_type_3d_tile_1d:
+      num_dims = 3;
+      num_tiled_dims = 1;
+      traced_compute->task_3d_tile_1d = (pthreadpool_task_3d_tile_1d_t) trace_3d_tile_1d;
+      break;
+    case xnn_parallelization_type_3d_tile_1d_with_thread:
+      num_dims = 3;
+      num_tiled_dims = 1;
+      traced_compute->task_3d_tile_1d_with_thread =
+        (pthreadpool_task_3d_tile_1d_with_thread_t) trace_3d_tile_1d_with_thread;
+      break;
+    case xnn_parallelization_type_3d_tile_2d:
+      num_dims = 3;
+      num_tiled_dims = 2;
+      traced_compute->task_3d_tile_2d = (pthreadpool_task_3d_tile_2d_t) trace_3d_tile_2d;
+      break;
+    case xnn_parallelization_type_4d:
+      num_dims = 4;
+      traced_compute->task_4d = (pthreadpool_task_4d_t) trace_4d;
+      break;
+    case xnn_parallelization_type_4d_tile_2d:
+      num_dims = 4;
+      num_tiled_dims = 2;
+      traced_compute->task_4d_tile_2d = (pthreadpool_task_4d_tile_2d_t) trace_4d_tile_2d;
+      break;
+    case xnn_parallelization_type_5d:
+      num_dims = 5;
+      traced_compute->task_5d = (pthreadpool_task_5d_t) trace_5d;
+      break;
+    case xnn_parallelization_type_5d_tile_2d:
+      num_dims = 5;
+      num_tiled_dims = 2;
+      traced_compute->task_5d_tile_2d = (pthreadpool_task_5d_tile_2d_t) trace_5d_tile_2d;
+      break;
+    case xnn_parallelization_type_6d_tile_2d:
+      num_dims = 6;
+      num_tiled_dims = 2;
+      traced_compute->task_6d_tile_2d = (pthreadpool_task_6d_tile_2d_t) trace_6d_tile_2d;
+      break;
+#if XNN_MAX_UARCH_TYPES > 1
+    case xnn_parallelization_type_2d_tile_1d_with_uarch:
+      num_dims = 2;
+      num_tiled_dims = 1;
+      traced_compute->task_2d_tile_1d_with_id = (pthreadpool_task_2d_tile_1d_with_id_t) trace_2d_tile_1d_with_id;
+      break;
+    case xnn_parallelization_type_2d_tile_2d_with_uarch:
+      num_dims = 2;
+      num_tiled_dims = 2;
+      traced_compute->task_2d_tile_2d_with_id = (pthreadpool_task_2d_tile_2d_with_id_t) trace_2d_tile_2d_with_id;
+      break;
+    case xnn_parallelization_type_3d_tile_1d_with_uarch:
+      num_dims = 3;
+      num_tiled_dims = 1;
+      traced_compute->task_3d_tile_1d_with_id = (pthreadpool_task_3d_tile_1d_with_id_t) trace_3d_tile_1d_with_id;
+      break;
+    case xnn_parallelization_type_3d_tile_1d_with_uarch_with_thread:
+      num_dims = 3;
+      num_tiled_dims = 1;
+      traced_compute->task_3d_tile_1d_with_id_with_thread =
+        (pthreadpool_task_3d_tile_1d_with_id_with_thread_t) trace_3d_tile_1d_with_id_with_thread;
+      break;
+    case xnn_parallelization_type_3d_tile_2d_with_uarch:
+      num_dims = 3;
+      num_tiled_dims = 2;
+      traced_compute->task_3d_tile_2d_with_id = (pthreadpool_task_3d_tile_2d_with_id_t) trace_3d_tile_2d_with_id;
+      break;
+    case xnn_parallelization_type_4d_tile_2d_with_uarch:
+      num_dims = 4;
+      num_tiled_dims = 2;
+      traced_compute->task_4d_tile_2d_with_id = (pthreadpool_task_4d_tile_2d_with_id_t) trace_4d_tile_2d_with_id;
+      break;
+#endif  // XNN_MAX_UARCH_TYPES > 1
+    default:
+      return false;
+  }
+
+  memset(task, 0, sizeof(struct xnn_trace_task));
+  task->compute = *compute;
+  task->context = context;
+  size_t num_tiles = 1;
+  for (size_t d = num_dims; d-- != 0;) {
+    const size_t tiled_dim = d + num_tiled_dims - num_dims;
+    task->step[d] = d + num_tiled_dims >= num_dims ? compute->tile[tiled_dim] : 1;
+    task->stride[d] = num_tiles;
+    num_tiles *= divide_round_up(compute->range[d], task->step[d]);
+  }
+  task->num_tiles = num_tiles;
+  task->tiles = xnn_allocate_zero_memory(num_tiles * sizeof(struct xnn_trace_tile));
+  if (task->tiles == NULL) {
+    xnn_log_warning("failed to allocate %zu bytes to trace %zu tasks", num_tiles * sizeof(struct xnn_trace_tile),
+      num_tiles);
+    return false;
+  }
+  task->start_ns = read_time_ns();
+  return true;
+}
+
+static uint32_t get_thread_index(struct xnn_trace* trace, uintptr_t thread)
+{
+  for (size_t i = 0; i < trace->num_threads; i++) {
+    if (trace->threads[i] == thread) {
+      return (uint32_t) i;
+    }
+  }
+  if (trace->num_threads == trace->threads_capacity) {
+    const size_t capacity = trace->threads_capacity == 0 ? 8 : trace->threads_capacity * 2;
+    uintptr_t* threads = xnn_reallocate_memory(trace->threads, capacity * sizeof(uintptr_t));
+    if (threads == NULL) {
+      return UINT32_MAX;
+    }
+    trace->threads = threads;
+    trace->threads_capacity = capacity;
+  }
+  trace->threads[trace->num_threads] = thread;
+  return (uint32_t) trace->num_threads++;
+}
+
+void xnn_trace_end_compute(
+  struct xnn_trace* trace,
+  struct xnn_trace_task* task,
+  const char* name,
+  size_t opdata_index,
+  size_t operator_object_index,
+  size_t compute_index)
+{
+  const uint64_t end_ns = read_time_ns();
+  const uintptr_t caller = current_thread();
+
+  // Operators of the same stage run concurrently, and share the trace.
+  xnn_mutex_lock(&trace->mutex);
+  if (trace->num_events == trace->events_capacity) {
+    const size_t capacity = trace->events_capacity == 0 ? 64 : trace->events_capacity * 2;
+    struct xnn_trace_event* events = xnn_reallocate_memory(trace->events, capacity * sizeof(struct xnn_trace_event));
+    if (events == NULL) {
+      xnn_log_warning("failed to allocate %zu bytes for trace events", capacity * sizeof(struct xnn_trace_event));
+      goto cleanup;
+    }
+    trace->events = events;
+    trace->events_capacity = capacity;
+  }
+
+  // At most one span per thread of the thread pool, plus the caller.
+  struct xnn_trace_event event = {
+    .name = name,
+    .opdata_index = (uint32_t) opdata_index,
+    .operator_object_index = (uint32_t) operator_object_index,
+    .compute_index = (uint32_t) compute_index,
+    .caller_thread = get_thread_index(trace, caller),
+    .num_tiles = task->num_tiles,
+    .start_ns = task->start_ns,
+    .end_ns = end_ns,
+  };
+  for (size_t i = 0; i < task->num_tiles; i++) {
+    const struct xnn_trace_tile* tile = &task->tiles[i];
+    const uint32_t thread = get_thread_index(trace, tile->thread);
+    struct xnn_trace_thread_span* span = NULL;
+    for (size_t s = 0; s < event.num_spans; s++) {
+      if (event.spans[s].thread == thread) {
+        span = &event.spans[s];
+        break;
+      }
+    }
+    if (span == NULL) {
+      struct xnn_trace_thread_span* spans =
+        xnn_reallocate_memory(event.spans, (event.num_spans + 1) * sizeof(struct xnn_trace_thread_span));
+      if (spans == NULL) {
+        xnn_log_warning("failed to allocate trace spans for %zu threads", event.num_spans + 1);
+        xnn_release_memory(event.spans);
+        goto cleanup;
+      }
+      event.spans = spans;
+      span = &event.spans[event.num_spans++];
+      *span = (struct xnn_trace_thread_span) {
+        .thread = thread,
+        .start_ns = tile->start_ns,
+        .end_ns = tile->end_ns,
+      };
+    }
+    const uint64_t tile_ns = tile->end_ns - tile->start_ns;
+    span->num_tiles += 1;
+    span->start_ns = tile->start_ns < span->start_ns ? tile->start_ns : span->start_ns;
+    span->end_ns = tile->end_ns > span->end_ns ? tile->end_ns : span->end_ns;
+    span->busy_ns += tile_ns;
+    span->max_tile_ns = tile_ns > span->max_tile_ns ? tile_ns : span->max_tile_ns;
+  }
+  trace->events[trace->num_events++] = event;
+
+cleanup:
+  xnn_mutex_unlock(&trace->mutex);
+  xnn_release_memory(task->tiles);
+  task->tiles = NULL;
+}
+
+static double to_us(uint64_t ns, uint64_t origin_ns)
+{
+  return (double) (ns - origin_ns) * 1.0e-3;
+}
+
+enum xnn_status xnn_write_trace(const struct xnn_trace* trace, const char* filename)
+{
+  FILE* file = fopen(filename, "w");
+  if (file == NULL) {
+    xnn_log_error("failed to open trace file %s for writing", filename);
+    return xnn_status_invalid_parameter;
+  }
+
+  uint64_t origin_ns = UINT64_MAX;
+  for (size_t i = 0; i < trace->num_events; i++) {
+    if (trace->events[i].start_ns < origin_ns) {
+      origin_ns = trace->events[i].start_ns;
+    }
+  }
+
+  fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  const char* separator = "\n";
+  for (size_t t = 0; t < trace->num_threads; t++) {
+    fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%zu,\"args\":{\"name\":\"thread %zu\"}}",
+      separator, t, t);
+    separator = ",\n";
+  }
+  for (size_t i = 0; i < trace->num_events; i++) {
+    const struct xnn_trace_event* event = &trace->events[i];
+    const uint64_t duration_ns = event->end_ns - event->start_ns;
+    fprintf(file,
+      "%s{\"name\":\"%s\",\"cat\":\"operator\",\"ph\":\"X\",\"pid\":0,\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f,"
+      "\"args\":{\"operator\":%" PRIu32 ",\"operator_object\":%" PRIu32 ",\"compute\":%" PRIu32 ",\"tiles\":%zu,"
+      "\"threads\":%zu}}",
+      separator, event->name, event->caller_thread, to_us(event->start_ns, origin_ns), to_us(duration_ns, 0),
+      event->opdata_index, event->operator_object_index, event->compute_index, event->num_tiles, event->num_spans);
+    separator = ",\n";
+    for (size_t s = 0; s < event->num_spans; s++) {
+      const struct xnn_trace_thread_span* span = &event->spans[s];
+      // Idle time is the part of the computation that the thread did not spend in tasks.
+      const uint64_t idle_ns = duration_ns > span->busy_ns ? duration_ns - span->busy_ns : 0;
+      fprintf(file,
+        "%s{\"name\":\"%s tasks\",\"cat\":\"tasks\",\"ph\":\"X\",\"pid\":0,\"tid\":%" PRIu32 ",\"ts\":%.3f,"
+        "\"dur\":%.3f,\"args\":{\"tiles\":%zu,\"busy_us\":%.3f,\"idle_us\":%.3f,\"max_tile_us\":%.3f}}",
+        separator, event->name, span->thread, to_us(span->start_ns, origin_ns),
+        to_us(span->end_ns - span->start_ns, 0), span->num_tiles, to_us(span->busy_ns, 0), to_us(idle_ns, 0),
+        to_us(span->max_tile_ns, 0));
+    }
+  }
+  fprintf(file, "\n]}\n");
+
+  if (fclose(file) != 0) {
+    xnn_log_error("failed to write trace file %s", filename);
+    return xnn_status_invalid_parameter;
+  }
+  return xnn_status_success;
+}
@@ -0,0 +1,55 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "xnnpack/common.h"
+
+#if defined(__has_feature)
+  #if __has_feature(memory_sanitizer)
+    #include <sanitizer/msan_interface.h>
+  #endif
+#endif
+
+
+// Layout of the 64-byte operand of the LDTILECFG/STTILECFG instructions.
+struct xnn_amx_tile_config {
+  uint8_t palette_id;
+  uint8_t start_row;
+  uint8_t reserved_0[14];
+  uint16_t colsb[8];
+  uint16_t reserved_1[8];
+  uint8_t rows[8];
+  uint8_t reserved_2[8];
+};
+
+#if XNN_ARCH_X86_64 && defined(__GNUC__)
+
+// Configures the tiles of the calling thread, unless they are already configured exactly as requested.
+//
+// LDTILECFG is serializing and costs hundreds of cycles, while consecutive calls of an AMX microkernel from the same
+// thread almost always request the same configuration. The tile configuration is part of the thread state, so it is
+// read back with STTILECFG and only reloaded when it differs: AMX microkernels keep their tiles configured on return
+// instead of releasing them, and the configuration is loaded once per thread for all calls that share it. Reading the
+// configuration back, rather than caching it in a variable, keeps this correct when other code in the thread
+// reconfigures or releases the tiles in between. The tile data is not preserved: microkernels must zero or load all
+// tiles they read.
+XNN_INLINE static void xnn_amx_load_tile_config(const struct xnn_amx_tile_config* config) {
+  __attribute__((aligned(64))) struct xnn_amx_tile_config current_config;
+  __asm__ volatile ("sttilecfg %0" : "=m" (current_config));
+  #if defined(__has_feature)
+    #if __has_feature(memory_sanitizer)
+      __msan_unpoison(&current_config, sizeof(current_config));
+    #endif
+  #endif
+  if XNN_UNLIKELY(memcmp(&current_config, config, sizeof(current_config)) != 0) {
+    __asm__ volatile ("ldtilecfg %0" :: "m" (*config));
+  }
+}
+
+#endif  // XNN_ARCH_X86_64 && defined(__GNUC__)
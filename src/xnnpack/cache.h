@@ -69,6 +69,20 @@ enum xnn_cache_state {
   xnn_cache_state_soft_finalized,
 };
 
+// Maps a look up key to packed weights in the cache. Kernel and bias pointers
+// are stored as offsets into the source buffer of the cache, so that the entry
+// stays valid when the source buffer is mapped at a different address.
+struct xnn_weights_cache_key_entry {
+  uint32_t seed;
+  // Offset of the kernel, relative to the source buffer.
+  size_t kernel_offset;
+  // Offset of the bias, relative to the source buffer, or SIZE_MAX if there is
+  // no bias.
+  size_t bias_offset;
+  // Offset of the packed weights, relative to cache's buffer.
+  size_t offset;
+};
+
 // Internal implementation of cache for repacked weights.
 struct xnn_internal_weights_cache {
   struct xnn_cache cache;
@@ -78,6 +92,20 @@ struct xnn_internal_weights_cache {
   // Maximum size of packed weights that have been inserted into the cache.
   size_t max_weights_size;
   enum xnn_cache_state finalization_state;
+
+  // Buffer with the original (unpacked) weights. Look up keys are only recorded
+  // for kernels and biases inside this buffer.
+  const void* source_data;
+  size_t source_size;
+  // Look up keys of the packed weights in the cache.
+  struct xnn_weights_cache_key_entry* keys;
+  size_t num_keys;
+  size_t keys_capacity;
+
+  // File mapping backing `cache.weights` when the cache was loaded from a file,
+  // NULL otherwise.
+  void* mapping;
+  size_t mapping_size;
 };
 
 enum xnn_status xnn_internal_init_weights_cache_with_size(struct xnn_internal_weights_cache* cache, size_t size);
@@ -106,12 +134,58 @@ void* xnn_internal_weights_cache_offset_to_addr(struct xnn_internal_weights_cach
 
 enum xnn_status xnn_internal_delete_weights_cache(struct xnn_internal_weights_cache* weights_cache);
 
+// Sets the buffer with the original weights, look up keys pointing into this
+// buffer are recorded when packed weights are inserted into the cache.
+enum xnn_status xnn_internal_set_weights_cache_source(
+  struct xnn_internal_weights_cache* cache, const void* data, size_t size);
+
+// Writes the packed weights, the hash table and the look up keys of the cache
+// to the file at `path`. The cache must not be hard finalized.
+enum xnn_status xnn_internal_save_weights_cache(struct xnn_internal_weights_cache* cache, const char* path);
+
+// Initializes a soft finalized cache backed by a private read-write mapping of
+// the file at `path`, written by xnn_internal_save_weights_cache.
+enum xnn_status xnn_internal_init_weights_cache_from_file(struct xnn_internal_weights_cache* cache, const char* path);
+
 size_t xnn_look_up_or_insert_weights_cache(
   xnn_weights_cache_t cache, const struct xnn_weights_cache_look_up_key* cache_key, void* ptr, size_t size);
 
 size_t xnn_weights_cache_look_up(
   xnn_weights_cache_t cache, const struct xnn_weights_cache_look_up_key* cache_key);
 
+// Generated code, with a copy of the key it was generated for.
+struct xnn_code_cache_entry {
+  uint32_t hash;
+  void* key;
+  size_t key_size;
+  // Executable memory holding the code.
+  struct xnn_code_buffer code;
+};
+
+// Cache for generated microkernels, shared by the operators of a runtime created with XNN_FLAG_JIT. Every entry has
+// its own executable mapping, so code never moves and never becomes writable again once inserted.
+struct xnn_code_cache {
+  // Protects `entries`, operators may be created from multiple threads.
+  struct xnn_mutex mutex;
+  struct xnn_code_cache_entry* entries;
+  size_t num_entries;
+  size_t entries_capacity;
+  size_t hits;
+  size_t misses;
+};
+
+enum xnn_status xnn_init_code_cache(struct xnn_code_cache* cache);
+
+enum xnn_status xnn_release_code_cache(struct xnn_code_cache* cache);
+
+// Returns the code generated for `key`, NULL if it is not in the cache.
+const void* xnn_code_cache_look_up(struct xnn_code_cache* cache, const void* key, size_t key_size);
+
+// Copies `size` bytes of code to executable memory and inserts it into the cache for `key`. Returns the executable
+// code, which is the existing code if `key` is already in the cache, or NULL if the code could not be inserted.
+const void* xnn_code_cache_insert(
+  struct xnn_code_cache* cache, const void* key, size_t key_size, const void* code, size_t size);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -261,6 +261,12 @@ struct packw_gemm_gio_context {
   // Stride, in bytes, between each group of of packed weights.
   size_t gc_stride;
 
+  // Parameters used for packing tiles of kc input channels separately.
+  // Number of output channels.
+  size_t nc;
+  // Stride, in bytes, between each tile of packed weights.
+  size_t gc_k_tile_stride;
+
   // Microkernel to preform packing.
   xnn_packw_gemm_gio_ukernel_fn packw_gemm_gio;
 };
@@ -275,6 +281,11 @@ struct packw_gemm_gio_context {
       size_t batch_index,
       size_t n_block_start,
       size_t n_block_size);
+  XNN_PRIVATE void xnn_compute_batched_packw_gemm_gio_k_tiled(
+      const struct packw_gemm_gio_context context[restrict XNN_MIN_ELEMENTS(1)],
+      size_t batch_index,
+      size_t k_block_start,
+      size_t k_block_size);
 #endif
 
 // Context for Dense Matrix Multiplication.
@@ -339,9 +350,25 @@ struct gemm_context {
     struct xnn_f16_scaleminmax_params f16;
     union xnn_f32_minmax_params f32;
   } params;
+  // Elementwise operations applied to each tile of C, or NULL.
+  const struct gemm_epilogue* epilogue;
+  // Number of input channels in each block of the packed weights, scaled by size of an element in A, if the weights
+  // are blocked along K. The last block has the remainder of `k_scaled`.
+  size_t kc_scaled;
+  // Stride, in bytes, between each block of K of the packed weights.
+  size_t kb_stride;
 };
 
 #ifndef __cplusplus
+  // Computes a tile of `mr_block_size` rows (a multiple of `mr`) with weights blocked along K: for each block of K, the
+  // panel of weights is multiplied with all rows of the tile before moving to the next block.
+  XNN_PRIVATE void xnn_compute_gemm_k_blocked(
+      const struct gemm_context context[restrict XNN_MIN_ELEMENTS(1)],
+      size_t mr_block_start,
+      size_t nr_block_start,
+      size_t mr_block_size,
+      size_t nr_block_size);
+
   XNN_PRIVATE void xnn_compute_grouped_gemm(
       const struct gemm_context context[restrict XNN_MIN_ELEMENTS(1)],
       size_t group_index,
@@ -530,6 +557,8 @@ struct igemm_context {
     struct xnn_f16_scaleminmax_params f16;
     union xnn_f32_minmax_params f32;
   } params;
+  // Elementwise operations applied to each tile of C, or NULL.
+  const struct gemm_epilogue* epilogue;
 };
 
 #ifndef __cplusplus
@@ -1273,6 +1302,63 @@ struct univector_contiguous_context {
       size_t size);
 #endif
 
+#define XNN_MAX_FUSED_ELEMENTWISE_STEPS 8
+#define XNN_MAX_FUSED_ELEMENTWISE_INPUTS 5
+// Size of the buffers for the intermediate results of a tile, small enough for both buffers to stay in L1 cache.
+#define XNN_FUSED_ELEMENTWISE_TILE_BYTES 4096
+
+enum xnn_fused_elementwise_broadcast {
+  // Operand has the same number of elements as the input.
+  xnn_fused_elementwise_broadcast_none = 0,
+  // Operand has a single element.
+  xnn_fused_elementwise_broadcast_scalar,
+  // Operand has one element per channel, and is broadcast across the batch.
+  xnn_fused_elementwise_broadcast_channel,
+};
+
+struct fused_elementwise_step_context {
+  // Unary micro-kernel, or NULL for binary steps.
+  xnn_vunary_ukernel_fn unary_ukernel;
+  const struct xnn_binary_elementwise_config* binary_config;
+  union {
+    union xnn_unary_uparams unary;
+    union xnn_binary_uparams binary;
+  } params;
+  // Input with the other operand of binary steps.
+  uint32_t operand;
+  // Whether the other operand is the first operand of binary steps.
+  bool operand_first;
+  enum xnn_fused_elementwise_broadcast broadcast;
+};
+
+struct fused_elementwise_context {
+  const void* inputs[XNN_MAX_FUSED_ELEMENTWISE_INPUTS];
+  void* output;
+  // Channel size in bytes, used for operands broadcast across the batch.
+  size_t channels;
+  size_t num_steps;
+  struct fused_elementwise_step_context steps[XNN_MAX_FUSED_ELEMENTWISE_STEPS];
+};
+
+#ifndef __cplusplus
+  XNN_PRIVATE void xnn_compute_fused_elementwise(
+      const struct fused_elementwise_context context[restrict XNN_MIN_ELEMENTS(1)],
+      size_t offset,
+      size_t size);
+#endif
+
+#define XNN_MAX_GEMM_EPILOGUE_STEPS 2
+// Size of the buffer for the intermediate results of a row of a GEMM tile.
+#define XNN_GEMM_EPILOGUE_TILE_BYTES 1024
+
+// Elementwise operations fused into the output of a GEMM. Binary steps take a residual tensor with the same shape and
+// strides as the output.
+struct gemm_epilogue {
+  size_t num_steps;
+  struct fused_elementwise_step_context steps[XNN_MAX_GEMM_EPILOGUE_STEPS];
+  const void* residual;
+};
+
 struct reduce_context {
   const void* input;
   void* output;
@@ -1338,6 +1424,65 @@ struct vmulcaddc_context {
       size_t batch_size);
 #endif
 
+// Winograd F(4x4, 3x3) convolution. Each 4x4 tile of the output is computed from a 6x6 tile of the input, and the
+// transformed tiles are laid out as 36 matrices (one per position in the tile) of batch_size * tiles rows.
+struct winograd_input_transform_context {
+  const void* input;
+  size_t input_pixel_stride;
+  size_t input_batch_stride;
+  size_t input_height;
+  size_t input_width;
+  size_t input_padding_top;
+  size_t input_padding_left;
+  const void* zero;
+  // Number of tiles along the width of the output, and in each image.
+  size_t tiles_width;
+  size_t tiles_per_image;
+  // Number of input channels, scaled by the size of an element.
+  size_t channels;
+  // Transformed input, and strides, in bytes, between its positions and tiles.
+  void* output;
+  size_t output_position_stride;
+  size_t output_tile_stride;
+  xnn_winograd_input_transform_ukernel_fn ukernel;
+};
+
+struct winograd_output_transform_context {
+  // Products of the transformed input and weights, and strides, in bytes, between their positions and tiles.
+  const void* input;
+  size_t input_position_stride;
+  size_t input_tile_stride;
+  const void* bias;
+  void* output;
+  size_t output_pixel_stride;
+  size_t output_row_stride;
+  size_t output_batch_stride;
+  size_t output_height;
+  size_t output_width;
+  size_t tiles_width;
+  size_t tiles_per_image;
+  // Number of output channels, scaled by the size of an element.
+  size_t channels;
+  xnn_winograd_output_transform_ukernel_fn ukernel;
+  union {
+    union xnn_f32_minmax_params f32;
+  } params;
+  // Elementwise operations applied to each tile of the output, or NULL.
+  const struct gemm_epilogue* epilogue;
+};
+
+#ifndef __cplusplus
+  XNN_PRIVATE void xnn_compute_winograd_input_transform(
+      const struct winograd_input_transform_context context[restrict XNN_MIN_ELEMENTS(1)],
+      size_t batch_index,
+      size_t tile_index);
+
+  XNN_PRIVATE void xnn_compute_winograd_output_transform(
+      const struct winograd_output_transform_context context[restrict XNN_MIN_ELEMENTS(1)],
+      size_t batch_index,
+      size_t tile_index);
+#endif
+
 struct pad_context {
   const void* input;
   size_t input_stride[XNN_MAX_TENSOR_DIMS - 1];
@@ -1499,6 +1644,27 @@ struct f32_qd8_convert_context {
 
 typedef void (*xnn_compute_reciprocal_fn)(const void* input, void* output);
 
+// Maximum and sum of exponentials (relative to the maximum) of the logits of a row seen so far, for a softmax computed
+// over one tile of logits at a time.
+struct attention_online_softmax_state {
+  float max;
+  float sum;
+};
+
+// Merges the maximum and the sum of exponentials of a tile of logits into the state, and computes the factors to
+// rescale the output accumulated so far, and the output of the tile, to the new maximum.
+typedef void (*xnn_compute_online_softmax_update_fn)(
+    const void* tile_max,
+    const void* tile_sum,
+    struct attention_online_softmax_state* state,
+    void* output_scale,
+    void* tile_scale);
+
+// Computes the factor to normalize the output accumulated over all tiles of logits.
+typedef void (*xnn_compute_online_softmax_scale_fn)(
+    const struct attention_online_softmax_state* state,
+    void* output_scale);
+
 struct floating_point_softmax_context {
   size_t n;
   const void* x;
@@ -1626,6 +1792,20 @@ struct scaled_dot_product_attention_context {
   // Stride, in bytes, between the buffer for each thread to write logits.
   size_t logits_thread_stride;
 
+  // Parameters used when attention is computed over tiles of keys and values with an online softmax.
+  // Pointer to where we can write the output of P*V for a tile.
+  void* tile_output_buffer;
+  // Stride, in bytes, between the buffer for each thread to write the output of P*V for a tile.
+  size_t tile_output_thread_stride;
+  // Number of key/value tokens in a tile.
+  size_t key_value_tile;
+  // Number of key/value tokens in a tile, in bytes.
+  size_t key_value_tile_scaled;
+  // Stride, in bytes, between each tile of packed key.
+  size_t key_tile_stride;
+  // Stride, in bytes, between each tile of packed value.
+  size_t value_tile_stride;
+
   struct xnn_hmp_gemm_ukernel gemm_ukernel;
   xnn_compute_reciprocal_fn compute_reciprocal;
   xnn_rmax_ukernel_fn rmax_ukernel;
@@ -1635,6 +1815,8 @@ struct scaled_dot_product_attention_context {
   xnn_vbinary_ukernel_fn vdivc_ukernel;
   xnn_vbinary_ukernel_fn vadd_ukernel;
   xnn_vunary_ukernel_fn vtanh_ukernel;
+  xnn_compute_online_softmax_update_fn update_online_softmax;
+  xnn_compute_online_softmax_scale_fn compute_online_softmax_scale;
 
   union {
     struct xnn_f16_default_params f16;
@@ -1661,6 +1843,7 @@ struct scaled_dot_product_attention_context {
   size_t packed_k_offset;
   size_t packed_v_offset;
   size_t logits_offset;
+  size_t tile_output_offset;
 };
 
 #ifndef __cplusplus
@@ -1682,6 +1865,14 @@ struct scaled_dot_product_attention_context {
       size_t head_index,
       size_t tokens_start,
       size_t tokens_block_size);
+  // Attention computed over tiles of keys and values always uses a workspace based on the number of threads.
+  XNN_PRIVATE void xnn_compute_tiled_scaled_dot_product_attention_with_thread(
+      const struct scaled_dot_product_attention_context context[restrict XNN_MIN_ELEMENTS(1)],
+      size_t thread_index,
+      size_t batch_index,
+      size_t head_index,
+      size_t tokens_start,
+      size_t tokens_block_size);
   XNN_PRIVATE void xnn_compute_hmp_scaled_dot_product_attention(
       const struct scaled_dot_product_attention_context context[restrict XNN_MIN_ELEMENTS(1)],
       uint32_t uarch_index,
@@ -1697,4 +1888,12 @@ struct scaled_dot_product_attention_context {
       size_t head_index,
       size_t tokens_start,
       size_t tokens_block_size);
+  XNN_PRIVATE void xnn_compute_hmp_tiled_scaled_dot_product_attention_with_thread(
+      const struct scaled_dot_product_attention_context context[restrict XNN_MIN_ELEMENTS(1)],
+      uint32_t uarch_index,
+      size_t thread_index,
+      size_t batch_index,
+      size_t head_index,
+      size_t tokens_start,
+      size_t tokens_block_size);
 #endif
@@ -175,6 +175,9 @@ struct xnn_gemm_config {
   struct gemm_fused_ukernels minmax;
   struct gemm_fused_ukernels relu;
   struct gemm_fused_ukernels linear;
+  // Minmax GEMM microkernels of other MR than in `minmax`, for the same packed weights. Candidates of
+  // XNN_FLAG_AUTOTUNE, not used otherwise.
+  struct xnn_hmp_gemm_ukernel minmax_tuning[XNN_MAX_MR];
   union {
     xnn_init_f16_minmax_params_fn f16;
     xnn_init_f32_minmax_params_fn f32;
@@ -301,6 +304,20 @@ struct xnn_vmulcaddc_config {
   uint8_t row_tile;
 };
 
+// Winograd F(4x4, 3x3) convolution: the input transform maps 6x6 tiles of the input to 36 matrices which are
+// multiplied with the transformed weights by GEMM micro-kernels, and the output transform maps the 36 products back
+// to 4x4 tiles of the output, adding the bias and clamping.
+struct xnn_winograd_config {
+  xnn_winograd_input_transform_ukernel_fn input_transform;
+  xnn_winograd_output_transform_ukernel_fn output_transform;
+  union {
+    xnn_init_f32_minmax_params_fn f32;
+  } init;
+  // Number of channels in a tile.
+  // For best efficiency, micro-kernels must process a multiple of this number of channels in each call.
+  uint8_t channel_tile;
+};
+
 struct xnn_raddstoreexpminusmax_config {
   xnn_raddstoreexpminusmax_ukernel_fn ukernel;
   union {
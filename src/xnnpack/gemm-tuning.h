@@ -0,0 +1,65 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+#include "xnnpack/microfnptr.h"
+#include "xnnpack/operator-type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Size of the sub-problem that candidate microkernels are timed on: at most this many rows and columns of the GEMM,
+// with all of K.
+#define XNN_GEMM_TUNING_MAX_ROWS 64
+#define XNN_GEMM_TUNING_MAX_COLUMNS 256
+// Number of timed runs of each candidate after a warm-up run, the fastest run counts.
+#define XNN_GEMM_TUNING_REPETITIONS 3
+
+// Shape of a GEMM and the buffers of the operator to time the candidate microkernels with.
+struct xnn_gemm_tuning_problem {
+  enum xnn_operator_type operator_type;
+  // Rows (batch size), columns (output channels) and input channels of the GEMM.
+  size_t m;
+  size_t n;
+  size_t k;
+  // Input channels in bytes, as passed to the microkernels.
+  size_t k_scaled;
+  uint32_t nr;
+  uint32_t log2_input_element_size;
+  uint32_t log2_output_element_size;
+  const void* packed_weights;
+  const void* params;
+};
+
+// Returns a fingerprint of the hardware that tuning results are valid for.
+uint32_t xnn_gemm_tuning_hardware_fingerprint(void);
+
+// Returns the MR of the fastest microkernel in `gemm_cases` for `problem`. Looks the shape up in the tuning table
+// first, and otherwise times every MR with a microkernel and records the fastest in the table.
+uint32_t xnn_gemm_tuning_select_mr(
+  const struct xnn_gemm_tuning_problem* problem,
+  const struct xnn_hmp_gemm_ukernel gemm_cases[XNN_MAX_MR],
+  uint32_t default_mr);
+
+// Returns the recorded MR of the shape, 0 if it was not tuned on this hardware yet.
+uint32_t xnn_gemm_tuning_look_up(enum xnn_operator_type operator_type, size_t m, size_t n, size_t k);
+
+// Records the MR of the shape, replacing a previous choice.
+enum xnn_status xnn_gemm_tuning_record(
+  enum xnn_operator_type operator_type, size_t m, size_t n, size_t k, uint32_t mr);
+
+// Forgets all recorded choices.
+void xnn_gemm_tuning_clear(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
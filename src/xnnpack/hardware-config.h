@@ -54,6 +54,7 @@ enum xnn_arch_flags {
   xnn_arch_x86_avx256vnnigfni = 1 << 15,
   xnn_arch_x86_avx512amx = 1 << 16,
   xnn_arch_x86_avx512fp16 = 1 << 17,
+  xnn_arch_x86_avx512bf16 = 1 << 18,
 #endif
 #if XNN_ARCH_RISCV
   xnn_arch_riscv_vector = 1 << 0,
@@ -115,6 +116,7 @@ struct xnn_hardware_config {
   bool use_x86_avx512skx;
   bool use_x86_avx512vnni;
   bool use_x86_avx512vnnigfni;
+  bool use_x86_avx512bf16;
   bool use_x86_avx512amx;
   bool use_x86_avx512fp16;
   bool use_x86_avxvnni;
@@ -182,9 +184,10 @@ static inline bool xnn_is_f16_chw_compatible_config(const struct xnn_hardware_co
 
 static inline bool xnn_is_chw_compatible_config(const struct xnn_hardware_config hardware_config[XNN_MIN_ELEMENTS(1)]) {
   #if (XNN_ARCH_X86 || XNN_ARCH_X86_64)
-    // Sparse microkernels on x86 currently target only SSE, and on processors
-    // with AVX ISA dense inference is expected to be faster than sparse.
-    return (!hardware_config->use_x86_avx);
+    // Sparse microkernels on x86 target SSE, FMA3 and AVX512F. On processors
+    // with AVX but without FMA3 dense inference is expected to be faster than
+    // sparse.
+    return (!hardware_config->use_x86_avx || hardware_config->use_x86_fma3);
   #else
     return true;
   #endif
@@ -8,10 +8,12 @@
 #ifndef THIRD_PARTY_XNNPACK_SRC_XNNPACK_INTERNAL_H_
 #define THIRD_PARTY_XNNPACK_SRC_XNNPACK_INTERNAL_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include "xnnpack.h"
+#include "xnnpack/compute.h"
 #include "xnnpack/config-types.h"
 #include "pthreadpool.h"
 
@@ -123,6 +125,37 @@ enum xnn_status xnn_setup_pack_lh_x32(xnn_operator_t pack_lh_op,
 enum xnn_status xnn_define_pack_lh(xnn_subgraph_t subgraph, uint32_t input_id,
                                    uint32_t output_id, uint32_t flags);
 
+// Same as xnn_reshape_scaled_dot_product_attention_nhtc_f16/f32, but the key
+// and value are read from a cache holding up to key_value_cache_tokens tokens
+// per head, of which only the first key_value_tokens are attended to.
+enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f16(
+    xnn_operator_t attention_op,    //
+    size_t batch_size,              //
+    size_t heads,                   //
+    size_t query_tokens,            //
+    size_t key_value_heads,         //
+    size_t key_value_tokens,        //
+    size_t key_value_cache_tokens,  //
+    size_t query_key_channels,      //
+    size_t value_channels,          //
+    size_t* workspace_size,         //
+    size_t* workspace_alignment,    //
+    pthreadpool_t threadpool);
+
+enum xnn_status xnn_reshape_scaled_dot_product_attention_nhtc_with_kv_cache_f32(
+    xnn_operator_t attention_op,    //
+    size_t batch_size,              //
+    size_t query_heads,             //
+    size_t query_tokens,            //
+    size_t key_value_heads,         //
+    size_t key_value_tokens,        //
+    size_t key_value_cache_tokens,  //
+    size_t query_key_channels,      //
+    size_t value_channels,          //
+    size_t* workspace_size,         //
+    size_t* workspace_alignment,    //
+    pthreadpool_t threadpool);
+
 enum xnn_status xnn_create_fully_connected_nc_qp8_f32_qb4w(
     size_t input_channels,              //
     size_t output_channels,             //
@@ -363,6 +396,55 @@ enum xnn_status xnn_setup_batch_matrix_multiply_nc_qdu8_f32_qc8w(
     xnn_operator_t batch_matrix_multiply_op, const int8_t* input_a,
     const struct xnn_quantization_params* quantization_params, float* output);
 
+// One operator in a chain of elementwise operators fused into a single pass.
+struct xnn_fused_elementwise_step {
+  // Binary operator, or xnn_binary_invalid for a unary step.
+  enum xnn_binary_operator binary_operator;
+  enum xnn_unary_operator unary_operator;
+  union xnn_unary_params unary_params;
+  // Input of the fused operator with the other operand of a binary step.
+  uint32_t operand;
+  // Whether the other operand is the first operand of a binary step.
+  bool operand_first;
+};
+
+// Applies a chain of up to XNN_MAX_FUSED_ELEMENTWISE_STEPS unary and binary operators to input 0, tile by tile, such
+// that every element is loaded and stored once. Binary operators read their other operand from the other inputs.
+enum xnn_status xnn_create_fused_elementwise_nc(
+    enum xnn_datatype datatype,                      //
+    size_t num_steps,                                //
+    const struct xnn_fused_elementwise_step* steps,  //
+    uint32_t flags,                                  //
+    xnn_operator_t* fused_elementwise_op_out);
+
+// Each operand input must have batch_size * channels elements, 1 element, or
+// channels elements to be broadcast across the batch.
+enum xnn_status xnn_reshape_fused_elementwise_nc(
+    xnn_operator_t fused_elementwise_op,  //
+    size_t batch_size,                    //
+    size_t channels,                      //
+    const size_t* input_sizes,            //
+    pthreadpool_t threadpool);
+
+enum xnn_status xnn_setup_fused_elementwise_nc(
+    xnn_operator_t fused_elementwise_op,  //
+    const void* const* inputs,            //
+    void* output);
+
+// Applies up to XNN_MAX_GEMM_EPILOGUE_STEPS unary and binary operators to the
+// output of an F32 Fully Connected or Convolution operator, tile by tile, while
+// the tile is still in cache. The other operand of binary steps is a residual
+// tensor with the shape of the output, and their `operand` is ignored.
+// Convolution operators must use GEMM or IGEMM micro-kernels.
+enum xnn_status xnn_fuse_gemm_epilogue(
+    xnn_operator_t op,                               //
+    size_t num_steps,                                //
+    const struct xnn_fused_elementwise_step* steps);
+
+enum xnn_status xnn_setup_gemm_epilogue(
+    xnn_operator_t op,  //
+    const void* residual);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -154,6 +154,14 @@ size_t get_batch_scale() {
   #define TEST_REQUIRES_X86_AVX512VNNI do {} while (0)
 #endif
 
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  #define TEST_REQUIRES_X86_AVX512BF16_VALUE XNN_TEST_HWCONFIG_FLAG(use_x86_avx512bf16)
+  #define TEST_REQUIRES_X86_AVX512BF16 TEST_REQUIRES_HWCONFIG_FLAG(use_x86_avx512bf16)
+#else
+  #define TEST_REQUIRES_X86_AVX512BF16_VALUE (false)
+  #define TEST_REQUIRES_X86_AVX512BF16 do {} while (0)
+#endif
+
 #if XNN_ARCH_X86 || XNN_ARCH_X86_64
   #define TEST_REQUIRES_X86_AVX512AMX_VALUE XNN_TEST_HWCONFIG_FLAG(use_x86_avx512amx)
   #define TEST_REQUIRES_X86_AVX512AMX TEST_REQUIRES_HWCONFIG_FLAG(use_x86_avx512amx)
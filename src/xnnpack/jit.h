@@ -0,0 +1,75 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+#include "xnnpack/microfnptr.h"
+#include "xnnpack/x64-assembler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Generated kernels follow the System V calling convention.
+#if XNN_ARCH_X86_64 && !XNN_PLATFORM_WINDOWS && XNN_HAS_MMAP
+  #define XNN_ENABLE_JIT 1
+#else
+  #define XNN_ENABLE_JIT 0
+#endif
+
+// Largest K that is fully unrolled, larger K run a loop over blocks of XNN_JIT_GEMM_K_UNROLL.
+#define XNN_JIT_GEMM_MAX_UNROLLED_KC 256
+#define XNN_JIT_GEMM_K_UNROLL 16
+
+// Instruction sets of the generated x86-64 code.
+enum xnn_jit_x64_isa {
+  // AVX2 and FMA3 on YMM registers.
+  xnn_jit_x64_isa_avx2 = 1,
+  // AVX512F on ZMM registers, columns are stored with masks.
+  xnn_jit_x64_isa_avx512f = 2,
+};
+
+// Shape and activation of a generated F32 GEMM microkernel. The generated kernel has the signature of
+// xnn_f32_gemm_minmax_ukernel_fn, reads weights packed with kr = sr = 1, and ignores the kc, a_stride, cm_stride,
+// cn_stride and params arguments in favour of the values it was generated for.
+struct xnn_jit_f32_gemm_params {
+  enum xnn_jit_x64_isa isa;
+  size_t mr;
+  size_t nr;
+  // Number of input channels (elements).
+  size_t kc;
+  // Strides in bytes.
+  size_t a_stride;
+  size_t cm_stride;
+  float min;
+  float max;
+};
+
+// Returns true if the hardware supports code generated for `isa`.
+bool xnn_jit_x64_isa_supported(enum xnn_jit_x64_isa isa);
+
+// Returns the largest MR of a generated F32 GEMM microkernel with `nr` columns, 0 if `nr` is not supported.
+size_t xnn_jit_f32_gemm_max_mr(enum xnn_jit_x64_isa isa, size_t nr);
+
+// Emits an F32 GEMM microkernel.
+enum xnn_status xnn_generate_f32_gemm_minmax_x64(
+  struct xnn_x64_assembler* a,
+  const struct xnn_jit_f32_gemm_params* params);
+
+// Returns a microkernel for `params` from `code_cache`, generating it if it is not in the cache yet. Returns NULL if
+// the microkernel can not be generated on this hardware, the caller should fall back to the static microkernels.
+xnn_f32_gemm_minmax_ukernel_fn xnn_jit_f32_gemm_minmax(
+  struct xnn_code_cache* code_cache,
+  const struct xnn_jit_f32_gemm_params* params);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
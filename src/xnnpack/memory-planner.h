@@ -43,6 +43,11 @@ struct xnn_value_allocation_tracker {
   // The range of value ids (i.e. the index to runtime->values) whose memory might need to be allocated.
   size_t min_value_id;
   size_t max_value_id;
+  // The strategy used by xnn_plan_value_allocation_tracker, xnn_memory_planner_strategy_greedy_by_size by default.
+  enum xnn_memory_planner_strategy strategy;
+  // The largest total size of tensors that are live at the same time, computed by xnn_plan_value_allocation_tracker.
+  // This is a lower bound of 'mem_arena_size' for any strategy.
+  size_t lower_bound;
 };
 
 // Initialize the memory allocation tracker for xnn_values.
@@ -76,7 +81,15 @@ XNN_INTERNAL void xnn_mark_tensor_as_reuse(
   uint32_t reuse_value_id,
   uint32_t new_last_node);
 
-// Plan the exact the memory allocation for intermediate tensors according to the xnn_value allocation tracker.
+// Recompute the lifecycle of values and operator workspaces in terms of the runtime's execution stages instead of
+// operator indices. Operators in the same stage may run concurrently, so everything they use is live for the entire
+// stage. Must be called after all operator workspaces were added, and before any tensor is marked as reused.
+XNN_INTERNAL void xnn_assign_value_allocation_tracker_stages(
+  struct xnn_value_allocation_tracker* tracker,
+  const struct xnn_runtime* runtime);
+
+// Plan the exact the memory allocation for intermediate tensors according to the xnn_value allocation tracker, using
+// the tracker's strategy.
 XNN_INTERNAL void xnn_plan_value_allocation_tracker(struct xnn_value_allocation_tracker* tracker);
 
 #ifdef __cplusplus
@@ -41,6 +41,24 @@ enum xnn_status xnn_reserve_weights_memory(struct xnn_weights_buffer* buffer, si
 // is fixed after this call. This should only be called after all the weights have been written.
 enum xnn_status xnn_finalize_weights_memory(struct xnn_weights_buffer* buffer);
 
+// Buffer to hold generated code.
+struct xnn_code_buffer {
+  // Pointer to allocated memory for code.
+  void* start;
+  // Size of code.
+  size_t size;
+  // Maximum capacity of this buffer pointed to by `start`. This is the size of the allocated memory.
+  size_t capacity;
+};
+
+// Allocates a code region and associates it with `buffer`.
+enum xnn_status xnn_allocate_code_memory(struct xnn_code_buffer* buffer, size_t size);
+// Free all memory associated with `buffer`.
+enum xnn_status xnn_release_code_memory(struct xnn_code_buffer* buffer);
+// Releases unused memory in `buffer`, and sets used memory to read-execute. No code can be written to `buffer` after
+// this call.
+enum xnn_status xnn_finalize_code_memory(struct xnn_code_buffer* buffer);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
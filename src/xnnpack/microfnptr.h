@@ -152,6 +152,18 @@ typedef void (*xnn_bf16_gemm_minmax_ukernel_fn)(
     size_t cn_stride,
     const struct xnn_bf16_minmax_params params[XNN_RESTRICT XNN_MIN_ELEMENTS(1)]);
 
+typedef void (*xnn_bf16_f32_gemm_minmax_ukernel_fn)(
+    size_t mr,
+    size_t nr,
+    size_t k,
+    const xnn_bfloat16* a,
+    size_t a_stride,
+    const void* w,
+    float* c,
+    size_t cm_stride,
+    size_t cn_stride,
+    const union xnn_f32_minmax_params params[XNN_RESTRICT XNN_MIN_ELEMENTS(1)]);
+
 typedef void (*xnn_f16_gemm_minmax_ukernel_fn)(
     size_t mr,
     size_t nr,
@@ -802,6 +814,26 @@ typedef void (*xnn_f32_vmulcaddc_ukernel_fn)(
     size_t output_stride,
     const union xnn_f32_minmax_params params[XNN_RESTRICT XNN_MIN_ELEMENTS(1)]);
 
+// WINOGRAD: transforms of the input tiles to and the output tiles from the Winograd domain
+
+typedef void (*xnn_winograd_input_transform_ukernel_fn)(
+    size_t channels,
+    const void** input,
+    void* output,
+    size_t output_stride);
+
+typedef void (*xnn_winograd_output_transform_ukernel_fn)(
+    size_t channels,
+    const void* input,
+    size_t input_stride,
+    const void* bias,
+    void* output,
+    size_t output_row_stride,
+    size_t output_pixel_stride,
+    size_t rows,
+    size_t columns,
+    const void* params);
+
 // IBILINEAR: Indirect BILINEAR interpolation
 
 typedef void (*xnn_ibilinear_ukernel_fn)(
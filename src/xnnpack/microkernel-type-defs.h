@@ -21,6 +21,7 @@ XNN_ENUM_ITEM(xnn_microkernel_type_spmm, "SPMM")
 XNN_ENUM_ITEM(xnn_microkernel_type_subconv2d, "Subconv2D")
 XNN_ENUM_ITEM(xnn_microkernel_type_transpose, "Transpose")
 XNN_ENUM_ITEM(xnn_microkernel_type_vmulcaddc, "VMulCAddC")
+XNN_ENUM_ITEM(xnn_microkernel_type_winograd, "Winograd")
 
 
 #ifdef XNN_DEFINED_ENUM_ITEM_0
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "xnnpack/common.h"
 
@@ -22,6 +23,27 @@ extern "C" {
 size_t xnn_gemm_best_nc(size_t num_groups, size_t m, size_t n, size_t mr,
                         size_t nr, size_t num_threads);
 
+// When blocking GEMM weights along K, each block should leave room in L2 for
+// a panel of at least this many `nr` tiles of weights.
+#define XNN_GEMM_K_BLOCK_MIN_NR_TILES 4
+
+// Computes the number of input channels `kc`, a multiple of `kr * sr`, in
+// each block of packed weights, such that a panel of
+// XNN_GEMM_K_BLOCK_MIN_NR_TILES `nr` tiles of a block fits in half of the L2
+// cache. Returns `k` if the weights do not need to be blocked along K, or if
+// the size of the L2 cache is unknown.
+size_t xnn_gemm_best_kc(size_t k, size_t nr, size_t kr_sr,
+                        uint32_t log2_element_size, size_t l2_cache_bytes);
+
+// Computes the tile of `mc` rows and `nc` columns of a GEMM with weights
+// blocked along K in blocks of `kc`, such that the `kc x nc` panel of weights
+// fits in half of the L2 cache and is reused for as many rows as possible,
+// while keeping at least XNN_GEMM_TILES_PER_THREAD tiles per thread.
+void xnn_gemm_k_blocked_tile(size_t m, size_t n, size_t mr, size_t nr,
+                             size_t kc, uint32_t log2_element_size,
+                             size_t l2_cache_bytes, size_t num_threads,
+                             size_t* mc, size_t* nc);
+
 // The total tile size needed to cover kernel_size.
 XNN_INTERNAL size_t xnn_dwconv_multipass_tile_size(
   size_t kernel_size,
@@ -28,6 +28,7 @@ XNN_ENUM_ITEM(xnn_node_type_even_split3, "Even Split3")
 XNN_ENUM_ITEM(xnn_node_type_even_split4, "Even Split4")
 XNN_ENUM_ITEM(xnn_node_type_fully_connected, "Fully Connected")
 XNN_ENUM_ITEM(xnn_node_type_fully_connected_sparse, "Fully Connected Sparse")
+XNN_ENUM_ITEM(xnn_node_type_fused_elementwise, "Fused Elementwise")
 XNN_ENUM_ITEM(xnn_node_type_global_average_pooling_1d, "Global Average Pooling 1D")
 XNN_ENUM_ITEM(xnn_node_type_global_average_pooling_2d, "Global Average Pooling 2D")
 XNN_ENUM_ITEM(xnn_node_type_global_sum_pooling_1d, "Global Sum Pooling 1D")
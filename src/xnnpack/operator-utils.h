@@ -65,6 +65,20 @@ XNN_INTERNAL uint32_t xnn_get_heuristic_mr_igemm(
   uint32_t nr,
   struct xnn_hmp_igemm_ukernel *igemm_cases);
 
+// Copies GEMM weights packed with `k` input channels (rounded up to `kr_sr`) and a bias of the same element size, into
+// blocks of `kc` input channels, the last block with the remainder. Each block is laid out like weights packed with
+// its input channels, and only the first block has the bias, it is zero in the others so that their products can be
+// accumulated.
+XNN_INTERNAL void xnn_pack_gemm_weights_in_k_blocks(
+  size_t n,
+  size_t k,
+  size_t kc,
+  size_t nr,
+  size_t kr_sr,
+  uint32_t log2_element_size,
+  const void* packed_weights,
+  void* blocked_weights);
+
 XNN_INTERNAL enum xnn_status xnn_destroy_operator(xnn_operator_t op);
 
 XNN_INTERNAL const char* xnn_unary_operator_to_string(enum xnn_unary_operator op);
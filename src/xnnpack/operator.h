@@ -68,6 +68,8 @@ struct xnn_ukernel_gemm {
   uint8_t kr;
   uint8_t sr;
   uint8_t kp;
+  // Number of input channels in each block of the packed weights if they are blocked along K, zero otherwise.
+  size_t kc;
 };
 
 struct xnn_ukernel_igemm {
@@ -84,6 +86,17 @@ struct xnn_ukernel_spmm {
   uint8_t mr;
 };
 
+struct xnn_ukernel_winograd {
+  xnn_winograd_input_transform_ukernel_fn input_transform;
+  xnn_winograd_output_transform_ukernel_fn output_transform;
+  // GEMM micro-kernels multiplying the transformed input with the transformed weights.
+  struct xnn_hmp_gemm_ukernel gemm_cases[XNN_MAX_MR];
+  uint8_t mr;
+  uint8_t nr;
+  uint8_t kr;
+  uint8_t sr;
+};
+
 struct xnn_ukernel_vmulcaddc {
   xnn_vmulcaddc_ukernel_fn function;
   uint8_t mr;
@@ -116,6 +129,7 @@ struct xnn_ukernel {
     struct xnn_ukernel_vmulcaddc vmulcaddc;
     struct xnn_ukernel_vbinary vbinary;
     struct xnn_ukernel_vunary vunary;
+    struct xnn_ukernel_winograd winograd;
   };
 };
 
@@ -339,6 +353,7 @@ struct xnn_operator {
       struct dwconv_indirection_init_context dwconv_indirection_init;
     } dwconv;
     struct elementwise_binary_context elementwise_binary;
+    struct fused_elementwise_context fused_elementwise;
     // PACKW GEMM GOI + GEMM are used together in Dynamic Fully Connected.
     struct {
       union {
@@ -378,21 +393,44 @@ struct xnn_operator {
     struct univector_strided_context univector_strided;
     struct unpooling_context unpooling;
     struct vmulcaddc_context vmulcaddc;
+    // Input transform + batched GEMM in the Winograd domain + output transform.
+    struct {
+      struct winograd_input_transform_context input_transform;
+      struct gemm_context gemm;
+      struct winograd_output_transform_context output_transform;
+    } winograd;
     struct rope_context rope;
     struct x32_pack_lh_context x32_pack_lh;
   } context;
+  // Elementwise operations fused into the output of Fully Connected and Convolution operators.
+  struct gemm_epilogue gemm_epilogue;
 
   struct xnn_code_cache* code_cache;
   xnn_weights_cache_t weights_cache;
   enum xnn_run_state state;
 };
 
+struct xnn_trace;
+
+// Runs the operator, and records its parallelized tasks in `trace` if it is not NULL.
 XNN_INTERNAL enum xnn_status xnn_run_operator_with_index(
   xnn_operator_t op,
   size_t opdata_index,
   size_t operator_object_index,
+  struct xnn_trace* trace,
   pthreadpool_t threadpool);
 
+// Sets up the GEMM context and the computation of an operator with weights blocked along K with
+// xnn_pack_gemm_weights_in_k_blocks, for `m` rows and `n` columns. The context must have been initialized for the
+// operator without blocking.
+XNN_INTERNAL void xnn_reshape_gemm_k_blocked(
+  xnn_operator_t op,
+  size_t m,
+  size_t n,
+  uint32_t mr,
+  uint32_t log2_element_size,
+  size_t num_threads);
+
 XNN_INTERNAL enum xnn_operator_type xnn_reduce_operator_to_operator_type(enum xnn_reduce_operator op);
 
 #ifdef __cplusplus
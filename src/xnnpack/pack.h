@@ -101,6 +101,51 @@ XNN_INTERNAL void xnn_pack_f32_to_f16_gemm_goi_w(
   size_t extra_bytes,
   const void* params);
 
+typedef void (*xnn_pack_bf16_f32_gemm_fn)(
+  size_t g,
+  size_t nc,
+  size_t kc,
+  size_t nr,
+  size_t kr,
+  size_t sr,
+  const xnn_bfloat16* kernel,
+  const float* bias,
+  const void* scale,
+  void* packed_weights,
+  size_t extra_bytes,
+  const void* params);
+
+// Packs BF16 weights with FP32 biases. The padding of the last block of output channels and of the last block of
+// input channels is zeroed.
+XNN_INTERNAL void xnn_pack_bf16_f32_gemm_goi_w(
+  size_t g,
+  size_t nc,
+  size_t kc,
+  size_t nr,
+  size_t kr,
+  size_t sr,
+  const xnn_bfloat16* kernel,
+  const float* bias,
+  const void* scale,
+  void* packed_weights,
+  size_t extra_bytes,
+  const void* params);
+
+XNN_INTERNAL void xnn_pack_bf16_f32_gemm_gio_w(
+  size_t g,
+  size_t nc,
+  size_t kc,
+  size_t nr,
+  size_t kr,
+  size_t sr,
+  size_t k_stride,
+  const xnn_bfloat16* kernel,
+  const float* bias,
+  const void* scale,
+  void* packed_weights,
+  size_t extra_bytes,
+  const void* params);
+
 typedef void (*xnn_pack_qu8_gemm_fn)(
   size_t g,
   size_t nc,
@@ -649,6 +694,14 @@ XNN_INTERNAL void xnn_pack_f32_conv_goki_w(
   size_t extra_bytes,
   const void* params);
 
+// Transforms a 3x3 kernel in OHWI layout to the 6x6 positions of Winograd F(4x4, 3x3), G g G^T. The transformed
+// kernel is in [position][output channel][input channel] layout, ready to be packed as 36 groups of GEMM weights.
+XNN_INTERNAL void xnn_pack_f32_winograd_f4x4k3x3_w(
+  size_t output_channels,
+  size_t input_channels,
+  const float* kernel,
+  float* transformed_kernel);
+
 typedef void (*xnn_pack_f16_igemm_fn)(
   size_t g,
   size_t nc,
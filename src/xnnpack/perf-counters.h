@@ -0,0 +1,48 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum xnn_perf_counter {
+  xnn_perf_counter_cycles = 0,
+  xnn_perf_counter_instructions,
+  xnn_perf_counter_l1d_cache_misses,
+  xnn_perf_counter_llc_misses,
+  xnn_perf_counter_count,
+};
+
+// Hardware performance counters of all threads of the process that exist when the counters are opened, i.e. the
+// calling thread and the workers of thread pools created before.
+struct xnn_perf_counters {
+  // File descriptors of the counters of each thread, -1 for counters that could not be opened.
+  int (*fds)[xnn_perf_counter_count];
+  size_t num_threads;
+  // True if at least one counter could be opened.
+  bool available;
+};
+
+// Opens the counters of all threads. Counters that are not supported by the hardware or the kernel, or not permitted
+// by perf_event_paranoid, are left closed. Returns xnn_status_unsupported_hardware if no counter could be opened.
+enum xnn_status xnn_open_perf_counters(struct xnn_perf_counters* counters);
+
+// Reads the sum of each counter over all threads into `values`. Counters that are not open read as 0.
+void xnn_read_perf_counters(const struct xnn_perf_counters* counters, uint64_t values[xnn_perf_counter_count]);
+
+void xnn_close_perf_counters(struct xnn_perf_counters* counters);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -0,0 +1,91 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct xnn_operator;
+struct xnn_operator_data;
+struct xnn_runtime;
+struct xnn_shape;
+
+// State of a runtime after reshaping it for one set of external input shapes.
+struct xnn_reshape_cache_entry {
+  // Number of dimensions followed by the dimensions of each external input, in order of value IDs.
+  size_t* key;
+  size_t key_size;
+  // Shapes of all values, array size is runtime->num_values.
+  struct xnn_shape* value_shapes;
+  // Operator data after reshape, array size is runtime->num_ops.
+  struct xnn_operator_data* opdata;
+  // Copies of the operator objects of opdata that can be restored, in order of opdata and operator objects. Opdata
+  // that can not be restored from a copy are not included.
+  struct xnn_operator* operators;
+  // Index in `operators` of the first operator object of each opdata, or SIZE_MAX if the opdata can not be restored
+  // and must be reshaped. Array size is runtime->num_ops.
+  size_t* first_operator;
+  // Timestamps of insertion and of the last use, used for eviction.
+  uint64_t inserted;
+  uint64_t last_used;
+};
+
+// Cache of reshaped runtime states, keyed by the shapes of the external inputs.
+struct xnn_reshape_cache {
+  struct xnn_reshape_cache_entry* entries;
+  size_t num_entries;
+  // Maximum number of entries, caching is disabled if 0.
+  size_t max_entries;
+  enum xnn_reshape_cache_eviction_policy eviction_policy;
+  uint64_t clock;
+  size_t hits;
+  size_t misses;
+};
+
+void xnn_init_reshape_cache(struct xnn_reshape_cache* cache);
+
+// Releases all entries, and disables caching.
+void xnn_release_reshape_cache(struct xnn_reshape_cache* cache);
+
+// Releases all entries, and sets the maximum number of entries and the eviction policy.
+void xnn_configure_reshape_cache(
+  struct xnn_reshape_cache* cache,
+  size_t max_entries,
+  enum xnn_reshape_cache_eviction_policy eviction_policy);
+
+// Returns the entry for the current shapes of the external inputs of `runtime`, or NULL if there is none.
+struct xnn_reshape_cache_entry* xnn_reshape_cache_look_up(
+  struct xnn_reshape_cache* cache,
+  const struct xnn_runtime* runtime);
+
+// Restores the shapes of all values of `runtime` from `entry`.
+void xnn_reshape_cache_restore_values(
+  const struct xnn_reshape_cache_entry* entry,
+  struct xnn_runtime* runtime);
+
+// Restores the operator data `opdata_id` and its operator objects from `entry`. Returns false if the operator can not
+// be restored, and must be reshaped instead.
+bool xnn_reshape_cache_restore_operator(
+  const struct xnn_reshape_cache_entry* entry,
+  struct xnn_runtime* runtime,
+  size_t opdata_id);
+
+// Records the current state of `runtime`, which must have just been reshaped, evicting an entry if the cache is full.
+enum xnn_status xnn_reshape_cache_insert(
+  struct xnn_reshape_cache* cache,
+  const struct xnn_runtime* runtime);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
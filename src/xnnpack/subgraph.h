@@ -13,8 +13,12 @@
 #include "xnnpack/cache.h"
 #include "xnnpack/common.h"
 #include "xnnpack/config-types.h"
+#include "xnnpack/internal.h"
 #include "xnnpack/math.h"
 #include "xnnpack/node-type.h"
+#include "xnnpack/perf-counters.h"
+#include "xnnpack/reshape-cache.h"
+#include "xnnpack/trace.h"
 #include "pthreadpool.h"
 
 #if defined(EMSCRIPTEN)
@@ -279,6 +283,10 @@ struct xnn_node {
     struct {
       int32_t axis;
     } even_split;
+    struct {
+      size_t num_steps;
+      struct xnn_fused_elementwise_step steps[XNN_MAX_FUSED_ELEMENTWISE_STEPS];
+    } fused_elementwise;
     struct {
       uint32_t padding_top;
       uint32_t padding_right;
@@ -332,6 +340,13 @@ struct xnn_node {
     float output_min;
     float output_max;
   } activation;
+  // Elementwise operations fused into the output of Fully Connected and Convolution Nodes. The residual operand of
+  // binary steps is the last input of the Node, and is counted in num_inputs.
+  struct {
+    size_t num_steps;
+    struct xnn_fused_elementwise_step steps[XNN_MAX_GEMM_EPILOGUE_STEPS];
+    uint32_t num_inputs;
+  } epilogue;
   /// Value IDs for node inputs.
   uint32_t inputs[XNN_MAX_INPUTS];
   uint32_t num_inputs;
@@ -414,12 +429,24 @@ struct xnn_operator_data {
   uint32_t adjustment_width;
   uint32_t num_inputs;
   uint32_t inputs[XNN_MAX_INPUTS];
+  // Number of inputs, at the end of inputs, that are operands of the epilogue of the operator.
+  uint32_t num_epilogue_inputs;
   uint32_t num_outputs;
   uint32_t outputs[XNN_MAX_OUTPUTS];
+  xnn_timestamp start_ts[XNN_MAX_OPERATOR_OBJECTS];
   xnn_timestamp end_ts[XNN_MAX_OPERATOR_OBJECTS];
+  // Hardware performance counters of the last run of all operator objects, if the runtime reads counters.
+  uint64_t perf_counters[xnn_perf_counter_count];
+  // Index of the execution stage of this operator. Only valid if the runtime has stages.
+  uint32_t stage;
+  // Thread pool used to reshape and run this operator. This is the runtime's thread pool unless the operator runs
+  // concurrently with other operators of the same stage.
+  pthreadpool_t threadpool;
   void* workspace;
   size_t workspace_size;
   size_t workspace_alignment;
+  // Size of the workspace reserved for this operator by the last memory planning.
+  size_t planned_workspace_size;
   uint32_t flags;
 };
 
@@ -437,6 +464,14 @@ struct xnn_subgraph {
   struct xnn_node* nodes;
 };
 
+/// Group of operators without data dependencies between them, which can run concurrently.
+struct xnn_runtime_stage {
+  /// Index of the first operator of the stage in xnn_runtime->stage_ops.
+  size_t first_op;
+  /// Number of operators in the stage.
+  size_t num_ops;
+};
+
 /// Runtime is a combination of an execution plan for subgraph Nodes and a memory manager for subgraph Values.
 struct xnn_runtime {
   uint32_t num_external_values;
@@ -454,14 +489,37 @@ struct xnn_runtime {
 
   pthreadpool_t threadpool;
 
+  /// Execution stages, in execution order. Only initialized with XNN_FLAG_INTER_OP_PARALLELISM, otherwise NULL and
+  /// operators run one after another in the order of opdata.
+  struct xnn_runtime_stage* stages;
+  size_t num_stages;
+  /// Indices of operators in opdata, grouped by stage.
+  uint32_t* stage_ops;
+  /// Thread pools owned by the runtime for operators that run concurrently with other operators of the same stage.
+  pthreadpool_t* branch_threadpools;
+  size_t num_branch_threadpools;
+
   bool profiling;
   // The start timestamp of the first operator in the subgraph. This is set when profiling is true.
   xnn_timestamp start_ts;
+  // Counters read around each operator with XNN_FLAG_HARDWARE_COUNTER_PROFILING, if they could be opened.
+  struct xnn_perf_counters perf_counters;
+  // Tasks of each operator recorded with XNN_FLAG_PARALLEL_TRACING.
+  bool tracing;
+  struct xnn_trace trace;
+  // Microkernels generated for the operators of the runtime with XNN_FLAG_JIT, NULL if code generation is disabled.
+  struct xnn_code_cache* code_cache;
 
   // True if runtime has ever been setup. If it has been setup, the pointers inside of opdata need to be updated if
   // workspace changes.
   bool has_been_setup;
   bool memory_planned;
+  // Strategy used to plan the memory of internal values, and the result of the last planning.
+  enum xnn_memory_planner_strategy memory_planner_strategy;
+  size_t memory_arena_size;
+  size_t memory_lower_bound;
+  // Results of previous reshapes, keyed by the shapes of the external inputs.
+  struct xnn_reshape_cache reshape_cache;
 
   #ifdef XNN_SLINKY_AVAILABLE
   // Fields used by Slinky -- unused unless XNN_FLAG_SLINKY_ENABLED is set
@@ -551,6 +609,35 @@ void xnn_init_convert_node(
   uint32_t output_id,
   uint32_t flags);
 
+// Replaces `node` with a node applying `steps` to input 0 in a single pass. Operands of binary steps are read from the
+// other inputs.
+void xnn_init_fused_elementwise_node(
+  struct xnn_node* node,
+  size_t num_steps,
+  const struct xnn_fused_elementwise_step* steps,
+  uint32_t num_inputs,
+  const uint32_t* inputs,
+  uint32_t output_id);
+
+// Returns true if a fused elementwise node can apply a binary operator to an input of shape `input_shape` and an
+// operand of shape `operand_shape`: the operand must have the same elements as the input, a single element, or one
+// element per channel.
+bool xnn_fused_elementwise_can_broadcast(const struct xnn_shape* operand_shape, const struct xnn_shape* input_shape);
+
+// Fuses chains of unary and binary elementwise nodes into fused elementwise nodes, such that the intermediate results
+// are never stored to memory.
+void xnn_subgraph_fuse_elementwise_chains(xnn_subgraph_t subgraph);
+
+// Fuses unary and binary elementwise nodes that follow F32 Fully Connected and Convolution nodes into the epilogue of
+// their GEMM micro-kernels.
+void xnn_subgraph_fuse_gemm_epilogues(xnn_subgraph_t subgraph);
+
+// Sets up the residual of the epilogue of a Fully Connected or Convolution operator, if any.
+enum xnn_status xnn_setup_gemm_epilogue_residual(
+  const struct xnn_operator_data* opdata,
+  const struct xnn_value* values,
+  size_t num_values);
+
 struct xnn_workspace {
   void* data;
   size_t size;
@@ -0,0 +1,104 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+#include "xnnpack/compute.h"
+#include "xnnpack/mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct xnn_trace_tile;
+
+// Tasks that one thread ran in one parallelized computation.
+struct xnn_trace_thread_span {
+  // Index of the thread in xnn_trace.threads.
+  uint32_t thread;
+  size_t num_tiles;
+  uint64_t start_ns;
+  uint64_t end_ns;
+  // Time spent in tasks, and in the slowest task.
+  uint64_t busy_ns;
+  uint64_t max_tile_ns;
+};
+
+// One parallelized computation of an operator.
+struct xnn_trace_event {
+  const char* name;
+  uint32_t opdata_index;
+  uint32_t operator_object_index;
+  uint32_t compute_index;
+  // Index of the thread that started the computation in xnn_trace.threads.
+  uint32_t caller_thread;
+  size_t num_tiles;
+  uint64_t start_ns;
+  uint64_t end_ns;
+  struct xnn_trace_thread_span* spans;
+  size_t num_spans;
+};
+
+// Per-thread tasks of all parallelized computations of a runtime, recorded with XNN_FLAG_PARALLEL_TRACING.
+struct xnn_trace {
+  struct xnn_mutex mutex;
+  struct xnn_trace_event* events;
+  size_t num_events;
+  size_t events_capacity;
+  // System identifiers of the threads seen so far, the index in this array is the thread ID in the trace.
+  uintptr_t* threads;
+  size_t num_threads;
+  size_t threads_capacity;
+};
+
+// Task of a parallelized computation, with the original compute parameters and context.
+struct xnn_trace_task {
+  struct compute_parameters compute;
+  void* context;
+  // Step between consecutive tasks and number of tasks in each dimension of the range.
+  size_t step[6];
+  size_t stride[6];
+  size_t num_tiles;
+  uint64_t start_ns;
+  // Start, end, and thread of each task.
+  struct xnn_trace_tile* tiles;
+};
+
+enum xnn_status xnn_init_trace(struct xnn_trace* trace);
+
+// Frees all recorded events.
+void xnn_clear_trace(struct xnn_trace* trace);
+
+void xnn_release_trace(struct xnn_trace* trace);
+
+// Initializes `task` to record the tasks of `compute`, and returns in `traced_compute` the parameters that run them
+// with `task` as the context. Returns false if the tasks can not be recorded, then `compute` must run untraced.
+bool xnn_trace_begin_compute(
+  struct xnn_trace_task* task,
+  const struct compute_parameters* compute,
+  void* context,
+  struct compute_parameters* traced_compute);
+
+// Summarizes the recorded tasks per thread and appends them to the trace.
+void xnn_trace_end_compute(
+  struct xnn_trace* trace,
+  struct xnn_trace_task* task,
+  const char* name,
+  size_t opdata_index,
+  size_t operator_object_index,
+  size_t compute_index);
+
+// Writes the trace in the Chrome trace event format.
+enum xnn_status xnn_write_trace(const struct xnn_trace* trace, const char* filename);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
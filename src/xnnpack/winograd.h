@@ -0,0 +1,52 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack/common.h"
+#include "xnnpack/microparams.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Winograd F(4x4, 3x3) transforms: 6x6 tiles of the input map to 4x4 tiles of the output of a 3x3 convolution.
+#define XNN_WINOGRAD_F4X4K3X3_INPUT_TILE 6
+#define XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE 4
+
+#define DECLARE_F32_WINOGRAD_INPUT_UKERNEL_FUNCTION(fn_name) \
+  XNN_INTERNAL void fn_name(                                  \
+      size_t channels,                                        \
+      const float** input,                                    \
+      float* output,                                          \
+      size_t output_stride);
+
+#define DECLARE_F32_WINOGRAD_OUTPUT_UKERNEL_FUNCTION(fn_name)                       \
+  XNN_INTERNAL void fn_name(                                                         \
+      size_t channels,                                                               \
+      const float* input,                                                            \
+      size_t input_stride,                                                           \
+      const float* bias,                                                             \
+      float* output,                                                                 \
+      size_t output_row_stride,                                                      \
+      size_t output_pixel_stride,                                                    \
+      size_t rows,                                                                   \
+      size_t columns,                                                                \
+      const union xnn_f32_minmax_params params[XNN_RESTRICT XNN_MIN_ELEMENTS(1)]);
+
+DECLARE_F32_WINOGRAD_INPUT_UKERNEL_FUNCTION(xnn_f32_winograd_f4x4k3x3_input_ukernel__scalar_c1)
+DECLARE_F32_WINOGRAD_OUTPUT_UKERNEL_FUNCTION(xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__scalar_c1)
+
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+DECLARE_F32_WINOGRAD_INPUT_UKERNEL_FUNCTION(xnn_f32_winograd_f4x4k3x3_input_ukernel__sse_c4)
+DECLARE_F32_WINOGRAD_OUTPUT_UKERNEL_FUNCTION(xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__sse_c4)
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
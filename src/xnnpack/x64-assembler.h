@@ -0,0 +1,128 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "xnnpack.h"
+#include "xnnpack/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Minimal x86-64 assembler for the instructions used by the JIT microkernel generators: general purpose integer
+// arithmetic, branches, VEX-encoded AVX/AVX2/FMA3 instructions on YMM registers, and EVEX-encoded AVX512F instructions
+// on ZMM registers.
+
+enum xnn_x64_gp {
+  xnn_x64_rax = 0,
+  xnn_x64_rcx = 1,
+  xnn_x64_rdx = 2,
+  xnn_x64_rbx = 3,
+  xnn_x64_rsp = 4,
+  xnn_x64_rbp = 5,
+  xnn_x64_rsi = 6,
+  xnn_x64_rdi = 7,
+  xnn_x64_r8 = 8,
+  xnn_x64_r9 = 9,
+  xnn_x64_r10 = 10,
+  xnn_x64_r11 = 11,
+  xnn_x64_r12 = 12,
+  xnn_x64_r13 = 13,
+  xnn_x64_r14 = 14,
+  xnn_x64_r15 = 15,
+};
+
+// Condition codes of Jcc and CMOVcc, for unsigned comparisons.
+enum xnn_x64_cond {
+  xnn_x64_cond_b = 0x2,
+  xnn_x64_cond_ae = 0x3,
+  xnn_x64_cond_e = 0x4,
+  xnn_x64_cond_ne = 0x5,
+  xnn_x64_cond_be = 0x6,
+  xnn_x64_cond_a = 0x7,
+};
+
+#define XNN_X64_MAX_LABEL_USERS 4
+
+// Branch target. Branches to a label that is not bound yet are patched when the label is bound.
+struct xnn_x64_label {
+  // Offset of the label in the code, SIZE_MAX if not bound yet.
+  size_t offset;
+  // Offsets of the rel32 fields of the branches to the label before it was bound.
+  size_t users[XNN_X64_MAX_LABEL_USERS];
+  size_t num_users;
+};
+
+// Growable buffer of machine code.
+struct xnn_x64_assembler {
+  uint8_t* code;
+  size_t size;
+  size_t capacity;
+  // Set when a buffer allocation failed or an instruction could not be encoded, the code is invalid.
+  bool error;
+};
+
+void xnn_x64_assembler_init(struct xnn_x64_assembler* a);
+void xnn_x64_assembler_release(struct xnn_x64_assembler* a);
+
+void xnn_x64_label_init(struct xnn_x64_label* label);
+void xnn_x64_bind(struct xnn_x64_assembler* a, struct xnn_x64_label* label);
+
+// Integer instructions. Memory operands are [base + disp].
+void xnn_x64_push(struct xnn_x64_assembler* a, enum xnn_x64_gp reg);
+void xnn_x64_pop(struct xnn_x64_assembler* a, enum xnn_x64_gp reg);
+void xnn_x64_ret(struct xnn_x64_assembler* a);
+void xnn_x64_mov_rr(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, enum xnn_x64_gp src);
+void xnn_x64_mov_rm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, enum xnn_x64_gp base, int32_t disp);
+void xnn_x64_mov_r32_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, uint32_t imm);
+void xnn_x64_lea(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, enum xnn_x64_gp base, int32_t disp);
+void xnn_x64_add_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, int32_t imm);
+void xnn_x64_sub_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp dst, int32_t imm);
+void xnn_x64_cmp_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp reg, int32_t imm);
+void xnn_x64_test_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp reg, int32_t imm);
+void xnn_x64_shl_cl(struct xnn_x64_assembler* a, enum xnn_x64_gp reg);
+void xnn_x64_shr_imm(struct xnn_x64_assembler* a, enum xnn_x64_gp reg, uint8_t imm);
+void xnn_x64_cmov(struct xnn_x64_assembler* a, enum xnn_x64_cond cond, enum xnn_x64_gp dst, enum xnn_x64_gp src);
+void xnn_x64_jcc(struct xnn_x64_assembler* a, enum xnn_x64_cond cond, struct xnn_x64_label* label);
+void xnn_x64_jmp(struct xnn_x64_assembler* a, struct xnn_x64_label* label);
+
+// Vector instructions. Registers are numbered 0-15, xmm and ymm variants refer to the same registers.
+void xnn_x64_vzeroupper(struct xnn_x64_assembler* a);
+void xnn_x64_vmovups_load_ymm(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp base, int32_t disp);
+void xnn_x64_vmovups_store_ymm(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src);
+void xnn_x64_vmovups_store_xmm(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src);
+void xnn_x64_vmovlps_store(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src);
+void xnn_x64_vmovss_store(struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src);
+void xnn_x64_vmovaps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src);
+void xnn_x64_vmovhlps(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2);
+void xnn_x64_vmovd_xmm_r32(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp src);
+void xnn_x64_vbroadcastss_ymm_mem(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp base, int32_t disp);
+void xnn_x64_vbroadcastss_ymm_xmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src);
+void xnn_x64_vextractf128(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src, uint8_t imm);
+void xnn_x64_vfmadd231ps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2);
+void xnn_x64_vmaxps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2);
+void xnn_x64_vminps_ymm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2);
+
+// AVX512F instructions. Vector registers are numbered 0-31, `mask` is an opmask register 1-7, or 0 for no masking.
+void xnn_x64_kmovw(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp src);
+void xnn_x64_vmovups_load_zmm(struct xnn_x64_assembler* a, uint32_t dst, enum xnn_x64_gp base, int32_t disp);
+void xnn_x64_vmovups_store_zmm(
+  struct xnn_x64_assembler* a, enum xnn_x64_gp base, int32_t disp, uint32_t src, uint32_t mask);
+void xnn_x64_vmovaps_zmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src);
+void xnn_x64_vbroadcastss_zmm_xmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src);
+// dst += src1 * broadcast of the float at [base + disp].
+void xnn_x64_vfmadd231ps_zmm_bcst(
+  struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, enum xnn_x64_gp base, int32_t disp);
+void xnn_x64_vmaxps_zmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2);
+void xnn_x64_vminps_zmm(struct xnn_x64_assembler* a, uint32_t dst, uint32_t src1, uint32_t src2);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -6001,6 +6001,18 @@ TEST(CONVOLUTION_NHWC_F32, kernel_1x1) {
     .TestNHWCxF32();
 }
 
+TEST(CONVOLUTION_NHWC_F32, kernel_1x1_large_input_channels) {
+  // Weights are blocked along K on most targets.
+  ConvolutionOperatorTester()
+    .input_size(5, 7)
+    .kernel_size(1, 1)
+    .group_input_channels(9001)
+    .group_output_channels(19)
+    .qmax(200)
+    .iterations(1)
+    .TestNHWCxF32();
+}
+
 TEST(CONVOLUTION_NHWC_F32, kernel_1x1_with_qmin) {
   ConvolutionOperatorTester()
     .input_size(27, 37)
@@ -6422,6 +6434,161 @@ TEST(CONVOLUTION_NHWC_F32, kernel_3x3_with_batch) {
     .TestNHWCxF32();
 }
 
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3) {
+  ConvolutionOperatorTester()
+    .input_size(13, 12)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_without_padding) {
+  ConvolutionOperatorTester()
+    .input_size(13, 12)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_asymmetric_padding) {
+  ConvolutionOperatorTester()
+    .input_size(9, 14)
+    .padding_top(1)
+    .padding_left(2)
+    .padding_bottom(0)
+    .padding_right(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_tf_same_padding) {
+  for (size_t input_height = 5; input_height <= 9; input_height++) {
+    ConvolutionOperatorTester()
+      .input_size(input_height, 6)
+      .padding_tf_same(true)
+      .kernel_size(3, 3)
+      .group_input_channels(32)
+      .group_output_channels(33)
+      .iterations(1)
+      .TestNHWCxF32();
+  }
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_input_stride) {
+  ConvolutionOperatorTester()
+    .input_size(13, 12)
+    .padding(1)
+    .input_channel_stride(41)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_output_stride) {
+  ConvolutionOperatorTester()
+    .input_size(13, 12)
+    .padding(1)
+    .output_channel_stride(43)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_qmin) {
+  ConvolutionOperatorTester()
+    .qmin(128)
+    .input_size(13, 12)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_qmax) {
+  ConvolutionOperatorTester()
+    .qmax(128)
+    .input_size(13, 12)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_without_bias) {
+  ConvolutionOperatorTester()
+    .has_bias(false)
+    .input_size(10, 9)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_batch) {
+  ConvolutionOperatorTester()
+    .batch_size(3)
+    .input_size(10, 9)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_transient_indirection) {
+  ConvolutionOperatorTester()
+    .transient_indirection_buffer(true)
+    .input_size(13, 12)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_with_weights_cache) {
+  ConvolutionOperatorTester()
+    .use_weights_cache(true)
+    .input_size(13, 12)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(35)
+    .group_output_channels(37)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
+TEST(CONVOLUTION_NHWC_F32, winograd_3x3_large_channels) {
+  ConvolutionOperatorTester()
+    .input_size(8, 7)
+    .padding(1)
+    .kernel_size(3, 3)
+    .group_input_channels(131)
+    .group_output_channels(67)
+    .iterations(3)
+    .TestNHWCxF32();
+}
+
 TEST(CONVOLUTION_NHWC_F32, grouped_3x3) {
   ConvolutionOperatorTester()
     .input_size(10, 11)
@@ -2073,7 +2073,11 @@ class ConvolutionOperatorTester {
         } else {
           ASSERT_NE(workspace_size, SIZE_MAX);
           ASSERT_NE(workspace_alignment, SIZE_MAX);
-          ASSERT_EQ(workspace_alignment, 1);
+          if (workspace_size == 0) {
+            ASSERT_EQ(workspace_alignment, 1);
+          } else {
+            ASSERT_EQ(workspace_alignment, XNN_ALLOCATION_ALIGNMENT);
+          }
           ASSERT_EQ(xnn_status_success, xnn_setup_convolution2d_nhwc_f32(convolution_op2, workspace.data(), input.data(), output2.data()));
         }
         ASSERT_EQ(xnn_status_success, xnn_run_operator(convolution_op2, auto_threadpool.get()));
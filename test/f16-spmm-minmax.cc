@@ -2309,3 +2309,367 @@
     }
   }
 #endif  // XNN_ENABLE_ARM_FP16_VECTOR && (XNN_ARCH_ARM || XNN_ARCH_ARM64)
+
+
+#if XNN_ENABLE_AVX512FP16 && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, k_eq_1) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    SpMMMicrokernelTester()
+      .mr(32)
+      .nr(1)
+      .m(32)
+      .n(1)
+      .k(1)
+      .sparsity(0.0f)
+      .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, k_gt_1) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (size_t k = 2; k < 10; k++) {
+      SpMMMicrokernelTester()
+        .mr(32)
+        .nr(1)
+        .m(32)
+        .n(1)
+        .k(k)
+        .sparsity(0.0f)
+        .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, n_gt_1) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 2; n < 10; n++) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(32)
+          .nr(1)
+          .m(32)
+          .n(n)
+          .k(k)
+          .sparsity(0.0f)
+          .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, m_lt_32) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t m = 1; m < 32; m++) {
+      for (uint32_t n = 1; n < 10; n += 2) {
+        for (size_t k = 1; k <= 5; k += 2) {
+          SpMMMicrokernelTester()
+            .mr(32)
+            .nr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .sparsity(0.0f)
+            .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+        }
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, m_div_32) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t m = 64; m <= 96; m += 32) {
+      for (uint32_t n = 1; n < 10; n += 2) {
+        for (size_t k = 1; k <= 5; k += 2) {
+          SpMMMicrokernelTester()
+            .mr(32)
+            .nr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .sparsity(0.0f)
+            .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+        }
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, m_gt_32) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t m = 33; m < 64; m++) {
+      for (uint32_t n = 1; n < 10; n += 2) {
+        for (size_t k = 1; k <= 5; k += 2) {
+          SpMMMicrokernelTester()
+            .mr(32)
+            .nr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .sparsity(0.0f)
+            .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+        }
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, output_stride) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(32)
+          .nr(1)
+          .m(64)
+          .n(n)
+          .k(k)
+          .output_stride(67)
+          .sparsity(0.0f)
+          .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, qmin) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(32)
+          .nr(1)
+          .m(64)
+          .n(n)
+          .k(k)
+          .sparsity(0.0f)
+          .qmin(128)
+          .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, qmax) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(32)
+          .nr(1)
+          .m(64)
+          .n(n)
+          .k(k)
+          .sparsity(0.0f)
+          .qmax(128)
+          .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, half_sparse) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(32)
+          .nr(1)
+          .m(64)
+          .n(n)
+          .k(k)
+          .sparsity(0.5f)
+          .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_32X1__AVX512FP16, zero_weights) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(32)
+          .nr(1)
+          .m(64)
+          .n(n)
+          .k(k)
+          .sparsity(1.0f)
+          .Test(xnn_f16_spmm_minmax_ukernel_32x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+#endif  // XNN_ENABLE_AVX512FP16 && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+
+
+#if XNN_ENABLE_AVX512FP16 && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, k_eq_1) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    SpMMMicrokernelTester()
+      .mr(64)
+      .nr(1)
+      .m(64)
+      .n(1)
+      .k(1)
+      .sparsity(0.0f)
+      .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, k_gt_1) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (size_t k = 2; k < 10; k++) {
+      SpMMMicrokernelTester()
+        .mr(64)
+        .nr(1)
+        .m(64)
+        .n(1)
+        .k(k)
+        .sparsity(0.0f)
+        .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, n_gt_1) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 2; n < 10; n++) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(64)
+          .nr(1)
+          .m(64)
+          .n(n)
+          .k(k)
+          .sparsity(0.0f)
+          .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, m_lt_64) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t m = 1; m < 64; m++) {
+      for (uint32_t n = 1; n < 10; n += 2) {
+        for (size_t k = 1; k <= 5; k += 2) {
+          SpMMMicrokernelTester()
+            .mr(64)
+            .nr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .sparsity(0.0f)
+            .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+        }
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, m_div_64) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t m = 128; m <= 192; m += 64) {
+      for (uint32_t n = 1; n < 10; n += 2) {
+        for (size_t k = 1; k <= 5; k += 2) {
+          SpMMMicrokernelTester()
+            .mr(64)
+            .nr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .sparsity(0.0f)
+            .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+        }
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, m_gt_64) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t m = 65; m < 128; m++) {
+      for (uint32_t n = 1; n < 10; n += 2) {
+        for (size_t k = 1; k <= 5; k += 2) {
+          SpMMMicrokernelTester()
+            .mr(64)
+            .nr(1)
+            .m(m)
+            .n(n)
+            .k(k)
+            .sparsity(0.0f)
+            .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+        }
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, output_stride) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(64)
+          .nr(1)
+          .m(128)
+          .n(n)
+          .k(k)
+          .output_stride(131)
+          .sparsity(0.0f)
+          .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, qmin) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(64)
+          .nr(1)
+          .m(128)
+          .n(n)
+          .k(k)
+          .sparsity(0.0f)
+          .qmin(128)
+          .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, qmax) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(64)
+          .nr(1)
+          .m(128)
+          .n(n)
+          .k(k)
+          .sparsity(0.0f)
+          .qmax(128)
+          .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, half_sparse) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(64)
+          .nr(1)
+          .m(128)
+          .n(n)
+          .k(k)
+          .sparsity(0.5f)
+          .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+
+  TEST(F16_SPMM_MINMAX_64X1__AVX512FP16, zero_weights) {
+    TEST_REQUIRES_X86_AVX512FP16;
+    for (uint32_t n = 1; n < 10; n += 2) {
+      for (size_t k = 1; k <= 5; k += 2) {
+        SpMMMicrokernelTester()
+          .mr(64)
+          .nr(1)
+          .m(128)
+          .n(n)
+          .k(k)
+          .sparsity(1.0f)
+          .Test(xnn_f16_spmm_minmax_ukernel_64x1__avx512fp16, xnn_init_f16_minmax_scalar_params);
+      }
+    }
+  }
+#endif  // XNN_ENABLE_AVX512FP16 && (XNN_ARCH_X86 || XNN_ARCH_X86_64)
@@ -0,0 +1,218 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "xnnpack.h"
+#include "xnnpack/buffer.h"
+#include "xnnpack/common.h"
+#include "xnnpack/microparams.h"
+#include "xnnpack/microparams-init.h"
+#include "xnnpack/pack.h"
+#include "xnnpack/winograd.h"
+#include "replicable_random_device.h"
+
+constexpr size_t kInputTile = XNN_WINOGRAD_F4X4K3X3_INPUT_TILE;
+constexpr size_t kOutputTile = XNN_WINOGRAD_F4X4K3X3_OUTPUT_TILE;
+
+struct WinogradKernels {
+  const char* name;
+  void (*input)(size_t, const float**, float*, size_t);
+  void (*output)(size_t, const float*, size_t, const float*, float*, size_t, size_t, size_t, size_t,
+                 const union xnn_f32_minmax_params*);
+};
+
+const WinogradKernels kKernels[] = {
+  {"scalar_c1", xnn_f32_winograd_f4x4k3x3_input_ukernel__scalar_c1,
+   xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__scalar_c1},
+#if XNN_ARCH_X86 || XNN_ARCH_X86_64
+  {"sse_c4", xnn_f32_winograd_f4x4k3x3_input_ukernel__sse_c4,
+   xnn_f32_winograd_f4x4k3x3_output_minmax_ukernel__sse_c4},
+#endif  // XNN_ARCH_X86 || XNN_ARCH_X86_64
+};
+
+// Runs the input transform of a 6x6 tile of `channels` channels, multiplies it element-wise with the transformed
+// depthwise 3x3 filter, and runs the output transform: the result must be the 4x4 valid correlation of the tile with
+// the filter.
+class WinogradTester {
+ public:
+  WinogradTester& channels(size_t channels) { channels_ = channels; return *this; }
+  WinogradTester& rows(size_t rows) { rows_ = rows; return *this; }
+  WinogradTester& columns(size_t columns) { columns_ = columns; return *this; }
+  WinogradTester& transform_stride(size_t transform_stride) { transform_stride_ = transform_stride; return *this; }
+  WinogradTester& output_pixel_stride(size_t stride) { output_pixel_stride_ = stride; return *this; }
+  WinogradTester& qmin(float qmin) { qmin_ = qmin; return *this; }
+  WinogradTester& qmax(float qmax) { qmax_ = qmax; return *this; }
+
+  size_t transform_stride() const { return std::max(transform_stride_, channels_); }
+  size_t output_pixel_stride() const { return std::max(output_pixel_stride_, channels_); }
+
+  void Test(const WinogradKernels& kernels) const {
+    xnnpack::ReplicableRandomDevice rng;
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    // Each input pixel is a separate buffer, as pointed to by the indirection of the operator.
+    std::vector<xnnpack::Buffer<float>> pixels;
+    pixels.reserve(kInputTile * kInputTile);
+    std::array<const float*, kInputTile * kInputTile> indirection;
+    for (size_t i = 0; i < kInputTile * kInputTile; i++) {
+      pixels.emplace_back(channels_ + XNN_EXTRA_BYTES / sizeof(float));
+      std::generate(pixels[i].begin(), pixels[i].end(), [&]() { return dist(rng); });
+      indirection[i] = pixels[i].data();
+    }
+    // Filter in HWC layout, as in depthwise convolutions.
+    std::vector<float> filter(9 * channels_);
+    std::generate(filter.begin(), filter.end(), [&]() { return dist(rng); });
+    xnnpack::Buffer<float> bias(channels_ + XNN_EXTRA_BYTES / sizeof(float));
+    std::generate(bias.begin(), bias.end(), [&]() { return dist(rng); });
+
+    xnnpack::Buffer<float> transformed(kInputTile * kInputTile * transform_stride() + XNN_EXTRA_BYTES / sizeof(float));
+    kernels.input(channels_ * sizeof(float), indirection.data(), transformed.data(),
+                  transform_stride() * sizeof(float));
+
+    // Transformed filter of each channel, as 36 groups of a single output and input channel.
+    std::vector<float> transformed_filter(kInputTile * kInputTile * channels_);
+    std::vector<float> channel_filter(9);
+    std::vector<float> channel_transformed_filter(kInputTile * kInputTile);
+    for (size_t c = 0; c < channels_; c++) {
+      for (size_t k = 0; k < 9; k++) {
+        channel_filter[k] = filter[k * channels_ + c];
+      }
+      xnn_pack_f32_winograd_f4x4k3x3_w(
+        /*output_channels=*/1, /*input_channels=*/1, channel_filter.data(), channel_transformed_filter.data());
+      for (size_t p = 0; p < kInputTile * kInputTile; p++) {
+        transformed_filter[p * channels_ + c] = channel_transformed_filter[p];
+      }
+    }
+    for (size_t p = 0; p < kInputTile * kInputTile; p++) {
+      for (size_t c = 0; c < channels_; c++) {
+        transformed[p * transform_stride() + c] *= transformed_filter[p * channels_ + c];
+      }
+    }
+
+    std::vector<float> output_ref(kOutputTile * kOutputTile * channels_);
+    for (size_t y = 0; y < kOutputTile; y++) {
+      for (size_t x = 0; x < kOutputTile; x++) {
+        for (size_t c = 0; c < channels_; c++) {
+          double acc = bias[c];
+          for (size_t ky = 0; ky < 3; ky++) {
+            for (size_t kx = 0; kx < 3; kx++) {
+              acc += (double) pixels[(y + ky) * kInputTile + x + kx][c] * (double) filter[(ky * 3 + kx) * channels_ + c];
+            }
+          }
+          output_ref[(y * kOutputTile + x) * channels_ + c] = (float) acc;
+        }
+      }
+    }
+    const float accumulated_min = *std::min_element(output_ref.begin(), output_ref.end());
+    const float accumulated_max = *std::max_element(output_ref.begin(), output_ref.end());
+    const float accumulated_range = accumulated_max - accumulated_min;
+    const float output_min = qmin_ == 0 ? -std::numeric_limits<float>::infinity() :
+      accumulated_min + accumulated_range / 255.0f * qmin_;
+    const float output_max = qmax_ == 255 ? std::numeric_limits<float>::infinity() :
+      accumulated_max - accumulated_range / 255.0f * (255 - qmax_);
+    for (float& value : output_ref) {
+      value = std::min(std::max(value, output_min), output_max);
+    }
+
+    union xnn_f32_minmax_params params;
+    xnn_init_f32_minmax_scalar_params(&params, output_min, output_max);
+    const size_t output_row_stride = kOutputTile * output_pixel_stride();
+    const float sentinel = 1234.0f;
+    xnnpack::Buffer<float> output(kOutputTile * output_row_stride);
+    std::fill(output.begin(), output.end(), sentinel);
+    kernels.output(channels_ * sizeof(float), transformed.data(), transform_stride() * sizeof(float), bias.data(),
+                   output.data(), output_row_stride * sizeof(float), output_pixel_stride() * sizeof(float),
+                   rows_, columns_, &params);
+
+    for (size_t y = 0; y < kOutputTile; y++) {
+      for (size_t x = 0; x < kOutputTile; x++) {
+        for (size_t c = 0; c < output_pixel_stride(); c++) {
+          const float value = output[y * output_row_stride + x * output_pixel_stride() + c];
+          if (y >= rows_ || x >= columns_ || c >= channels_) {
+            ASSERT_EQ(value, sentinel) << "(x, y) = (" << x << ", " << y << "), channel " << c;
+            continue;
+          }
+          const float expected = output_ref[(y * kOutputTile + x) * channels_ + c];
+          ASSERT_NEAR(value, expected, 1.0e-4f * std::max(1.0f, std::abs(expected)))
+            << "(x, y) = (" << x << ", " << y << "), channel " << c;
+        }
+      }
+    }
+  }
+
+ private:
+  size_t channels_{1};
+  size_t rows_{kOutputTile};
+  size_t columns_{kOutputTile};
+  size_t transform_stride_{0};
+  size_t output_pixel_stride_{0};
+  float qmin_{0};
+  float qmax_{255};
+};
+
+class F32WinogradTest : public testing::TestWithParam<WinogradKernels> {};
+
+TEST_P(F32WinogradTest, channels) {
+  for (size_t channels = 1; channels <= 19; channels++) {
+    WinogradTester().channels(channels).Test(GetParam());
+  }
+}
+
+TEST_P(F32WinogradTest, partial_tiles) {
+  for (size_t rows = 1; rows <= kOutputTile; rows++) {
+    for (size_t columns = 1; columns <= kOutputTile; columns++) {
+      WinogradTester().channels(7).rows(rows).columns(columns).Test(GetParam());
+    }
+  }
+}
+
+TEST_P(F32WinogradTest, strides) {
+  for (size_t channels = 1; channels <= 9; channels += 4) {
+    WinogradTester().channels(channels).transform_stride(13).output_pixel_stride(11).Test(GetParam());
+  }
+}
+
+TEST_P(F32WinogradTest, qmin) {
+  WinogradTester().channels(11).qmin(128).Test(GetParam());
+}
+
+TEST_P(F32WinogradTest, qmax) {
+  WinogradTester().channels(11).qmax(128).Test(GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  F32_WINOGRAD_F4X4K3X3, F32WinogradTest, testing::ValuesIn(kKernels),
+  [](const testing::TestParamInfo<WinogradKernels>& info) { return info.param.name; });
+
+TEST(F32_WINOGRAD_F4X4K3X3, transformed_weights_layout) {
+  // A filter with a single non-zero tap at the center transforms to G e G^T = (G e)(G e)^T.
+  const size_t output_channels = 2;
+  const size_t input_channels = 3;
+  std::vector<float> kernel(output_channels * 9 * input_channels, 0.0f);
+  kernel[(1 * 9 + 4) * input_channels + 2] = 1.0f;
+  std::vector<float> transformed(kInputTile * kInputTile * output_channels * input_channels);
+  xnn_pack_f32_winograd_f4x4k3x3_w(output_channels, input_channels, kernel.data(), transformed.data());
+  const float g1[kInputTile] = {0.0f, -1.0f / 6.0f, 1.0f / 6.0f, 1.0f / 12.0f, -1.0f / 12.0f, 0.0f};
+  for (size_t i = 0; i < kInputTile; i++) {
+    for (size_t j = 0; j < kInputTile; j++) {
+      for (size_t o = 0; o < output_channels; o++) {
+        for (size_t c = 0; c < input_channels; c++) {
+          const float expected = o == 1 && c == 2 ? g1[i] * g1[j] : 0.0f;
+          EXPECT_NEAR(transformed[((i * kInputTile + j) * output_channels + o) * input_channels + c], expected, 1.0e-7f)
+            << "position (" << i << ", " << j << "), output channel " << o << ", input channel " << c;
+        }
+      }
+    }
+  }
+}
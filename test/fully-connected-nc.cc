@@ -687,6 +687,46 @@ TEST(FULLY_CONNECTED_NC_F32, small_batch_without_bias) {
     .TestF32();
 }
 
+TEST(FULLY_CONNECTED_NC_F32, small_batch_large_input_channels) {
+  // Weights are blocked along K on most targets.
+  FullyConnectedOperatorTester()
+    .batch_size(12)
+    .input_channels(9001)
+    .output_channels(37)
+    .iterations(1)
+    .TestF32();
+}
+
+TEST(FULLY_CONNECTED_NC_F32, small_batch_large_input_channels_with_qmin) {
+  FullyConnectedOperatorTester()
+    .batch_size(12)
+    .input_channels(9001)
+    .output_channels(37)
+    .qmin(128)
+    .iterations(1)
+    .TestF32();
+}
+
+TEST(FULLY_CONNECTED_NC_F32, small_batch_large_input_channels_transpose_weights) {
+  FullyConnectedOperatorTester()
+    .transpose_weights(true)
+    .batch_size(12)
+    .input_channels(9001)
+    .output_channels(37)
+    .iterations(1)
+    .TestF32();
+}
+
+TEST(FULLY_CONNECTED_NC_F32, unit_batch_large_input_channels_without_bias) {
+  FullyConnectedOperatorTester()
+    .has_bias(false)
+    .batch_size(1)
+    .input_channels(9001)
+    .output_channels(37)
+    .iterations(1)
+    .TestF32();
+}
+
 TEST(FULLY_CONNECTED_NC_F32, weights_cache_unit_batch) {
   FullyConnectedOperatorTester()
     .batch_size(1)
@@ -1029,6 +1069,133 @@ TEST(FULLY_CONNECTED_NC_F32_QC8W, weights_cache_unit_batch_transpose_weights) {
     .TestF32QC8W();
 }
 
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch) {
+  FullyConnectedOperatorTester()
+    .batch_size(1)
+    .input_channels(22)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch_with_qmin) {
+  FullyConnectedOperatorTester()
+    .batch_size(1)
+    .input_channels(22)
+    .output_channels(19)
+    .qmin(128)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch_with_qmax) {
+  FullyConnectedOperatorTester()
+    .batch_size(1)
+    .input_channels(22)
+    .output_channels(19)
+    .qmax(128)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch_with_input_stride) {
+  FullyConnectedOperatorTester()
+    .batch_size(1)
+    .input_channels(22)
+    .input_stride(28)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch_with_output_stride) {
+  FullyConnectedOperatorTester()
+    .batch_size(1)
+    .input_channels(22)
+    .output_channels(19)
+    .output_stride(29)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch_transpose_weights) {
+  FullyConnectedOperatorTester()
+    .transpose_weights(true)
+    .batch_size(1)
+    .input_channels(22)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, unit_batch_without_bias) {
+  FullyConnectedOperatorTester()
+    .has_bias(false)
+    .batch_size(1)
+    .input_channels(22)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, small_batch) {
+  FullyConnectedOperatorTester()
+    .batch_size(12)
+    .input_channels(22)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, small_batch_with_input_stride) {
+  FullyConnectedOperatorTester()
+    .batch_size(12)
+    .input_channels(22)
+    .input_stride(28)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, small_batch_with_output_stride) {
+  FullyConnectedOperatorTester()
+    .batch_size(12)
+    .input_channels(22)
+    .output_channels(19)
+    .output_stride(29)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, small_batch_transpose_weights) {
+  FullyConnectedOperatorTester()
+    .transpose_weights(true)
+    .batch_size(12)
+    .input_channels(22)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, large_batch_odd_input_channels) {
+  FullyConnectedOperatorTester()
+    .batch_size(37)
+    .input_channels(67)
+    .output_channels(19)
+    .iterations(3)
+    .TestBF16F32();
+}
+
+TEST(FULLY_CONNECTED_NC_BF16_F32, weights_cache_small_batch) {
+  FullyConnectedOperatorTester()
+    .batch_size(12)
+    .input_channels(22)
+    .output_channels(19)
+    .use_weights_cache(true)
+    .iterations(3)
+    .TestBF16F32();
+}
+
 TEST(FULLY_CONNECTED_NC_F16, unit_batch) {
   FullyConnectedOperatorTester()
     .batch_size(1)
@@ -3392,6 +3392,161 @@ class FullyConnectedOperatorTester {
     }
   }
 
+  void TestBF16F32() const {
+    ASSERT_EQ(weights_type(), WeightsType::Default);
+
+    xnnpack::ReplicableRandomDevice rng;
+    std::uniform_real_distribution<float> f32dist(-1.0f, 1.0f);
+
+    xnnpack::Buffer<xnn_bfloat16> input(XNN_EXTRA_BYTES / sizeof(xnn_bfloat16) +
+      (batch_size() - 1) * input_stride() + input_channels());
+    xnnpack::Buffer<xnn_bfloat16> kernel(output_channels() * input_channels());
+    xnnpack::Buffer<float> bias(output_channels());
+    xnnpack::Buffer<float> output((batch_size() - 1) * output_stride() + output_channels());
+    xnnpack::Buffer<float> output_ref(batch_size() * output_channels());
+
+    for (size_t iteration = 0; iteration < iterations(); iteration++) {
+      std::generate(input.begin(), input.end(), [&]() { return f32dist(rng); });
+      std::generate(kernel.begin(), kernel.end(), [&]() { return f32dist(rng); });
+      std::generate(bias.begin(), bias.end(), [&]() { return f32dist(rng); });
+
+      // Compute reference results. Products of BF16 values are exact in FP32.
+      for (size_t i = 0; i < batch_size(); i++) {
+        for (size_t oc = 0; oc < output_channels(); oc++) {
+          double acc = has_bias() ? bias[oc] : 0.0;
+          for (size_t ic = 0; ic < input_channels(); ic++) {
+            const xnn_bfloat16 w = transpose_weights() ? kernel[ic * output_channels() + oc]
+                                                       : kernel[oc * input_channels() + ic];
+            acc += (double) float(input[i * input_stride() + ic]) * (double) float(w);
+          }
+          output_ref[i * output_channels() + oc] = (float) acc;
+        }
+      }
+
+      // Compute clamping parameters.
+      const float accumulated_min = *std::min_element(output_ref.cbegin(), output_ref.cend());
+      const float accumulated_max = *std::max_element(output_ref.cbegin(), output_ref.cend());
+      const float accumulated_range = accumulated_max - accumulated_min;
+      const float output_min = qmin() == 0 ? -std::numeric_limits<float>::infinity() :
+        accumulated_min + accumulated_range / 255.0f * float(qmin());
+      const float output_max = qmax() == 255 ? std::numeric_limits<float>::infinity() :
+        accumulated_max - accumulated_range / 255.0f * float(255 - qmax());
+
+      // Clamp reference results.
+      for (float& value : output_ref) {
+        value = std::max(std::min(value, output_max), output_min);
+      }
+
+      // Create, setup, run, and destroy Fully Connected operator.
+      ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+      xnn_operator_t fully_connected_op = nullptr;
+
+      struct xnn_internal_weights_cache* internal_weights_cache = nullptr;
+      std::unique_ptr<xnn_weights_cache_provider, decltype(&xnn_delete_weights_cache)> auto_weights_cache(
+        nullptr, xnn_delete_weights_cache);
+      if (use_weights_cache()) {
+        xnn_weights_cache_t weights_cache = nullptr;
+        xnn_create_weights_cache(&weights_cache);
+        auto_weights_cache.reset(weights_cache);
+        if (weights_cache) {
+          internal_weights_cache = (struct xnn_internal_weights_cache*) weights_cache->context;
+        }
+      }
+
+      const uint32_t flags = transpose_weights() ? XNN_FLAG_TRANSPOSE_WEIGHTS : 0;
+      const xnn_status status = xnn_create_fully_connected_nc_bf16_f32(
+          input_channels(), output_channels(),
+          input_stride(), output_stride(),
+          kernel.data(), has_bias() ? bias.data() : nullptr,
+          output_min, output_max,
+          flags,
+          nullptr, auto_weights_cache.get(),
+          &fully_connected_op);
+      if (status == xnn_status_unsupported_hardware) {
+        GTEST_SKIP();
+      }
+      ASSERT_EQ(xnn_status_success, status);
+      ASSERT_NE(nullptr, fully_connected_op);
+      if (use_weights_cache()) {
+        ASSERT_EQ(xnn_status_success,
+                  xnn_finalize_weights_cache(auto_weights_cache.get(), xnn_weights_cache_finalization_kind_soft));
+      }
+
+      // Smart pointer to automatically delete fully_connected_op.
+      std::unique_ptr<xnn_operator, decltype(&xnn_delete_operator)> auto_fully_connected_op(fully_connected_op, xnn_delete_operator);
+
+      ASSERT_EQ(xnn_status_success,
+        xnn_reshape_fully_connected_nc_bf16_f32(
+          fully_connected_op,
+          batch_size(),
+          /*threadpool=*/nullptr));
+
+      ASSERT_EQ(xnn_status_success,
+        xnn_setup_fully_connected_nc_bf16_f32(
+          fully_connected_op,
+          input.data(), output.data()));
+
+      ASSERT_EQ(xnn_status_success,
+        xnn_run_operator(fully_connected_op, /*threadpool=*/nullptr));
+
+      // Verify results.
+      VerifyBF16F32(output, output_ref, output_max, output_min);
+
+      if (use_weights_cache()) {
+        xnn_operator_t fully_connected_op2 = nullptr;
+        size_t old_weights_cache_size = internal_weights_cache->cache.weights.size;
+        ASSERT_EQ(xnn_status_success,
+                  xnn_create_fully_connected_nc_bf16_f32(
+                      input_channels(), output_channels(), input_stride(),
+                      output_stride(), kernel.data(),
+                      has_bias() ? bias.data() : nullptr, output_min, output_max,
+                      flags, nullptr, auto_weights_cache.get(), &fully_connected_op2));
+        ASSERT_NE(nullptr, fully_connected_op2);
+
+        // Smart pointer to automatically delete fully_connected_op2.
+        std::unique_ptr<xnn_operator, decltype(&xnn_delete_operator)> auto_fully_connected_op(fully_connected_op2, xnn_delete_operator);
+        xnnpack::Buffer<float> output2(output.size());
+
+        ASSERT_EQ(xnn_status_success,
+                  xnn_reshape_fully_connected_nc_bf16_f32(
+                      fully_connected_op2,
+                      batch_size(),
+                      /*threadpool=*/nullptr));
+
+        ASSERT_EQ(xnn_status_success,
+                  xnn_setup_fully_connected_nc_bf16_f32(
+                      fully_connected_op2,
+                      input.data(), output2.data()));
+
+        ASSERT_EQ(xnn_status_success,
+                  xnn_run_operator(fully_connected_op2, /*threadpool=*/nullptr));
+
+        // Verify results.
+        VerifyBF16F32(output2, output_ref, output_max, output_min);
+        VerifyWeightsCache(*internal_weights_cache, old_weights_cache_size);
+      }
+    }
+  }
+
+  void VerifyBF16F32(const xnnpack::Buffer<float>& output,
+                     const xnnpack::Buffer<float>& output_ref,
+                     const float output_max,
+                     const float output_min) const {
+    for (size_t i = 0; i < batch_size(); i++) {
+      for (size_t c = 0; c < output_channels(); c++) {
+        ASSERT_LE(output[i * output_stride() + c], output_max)
+          << "batch index = " << i << ", channel = " << c;
+        ASSERT_GE(output[i * output_stride() + c], output_min)
+          << "batch index = " << i << ", channel = " << c;
+        EXPECT_NEAR(
+            output_ref[i * output_channels() + c],
+            output[i * output_stride() + c],
+            1.0e-5f * float(input_channels()))
+          << "batch index = " << i << ", channel = " << c;
+      }
+    }
+  }
+
   void VerifyF16(const xnnpack::Buffer<xnn_float16>& output,
                  const xnnpack::Buffer<float>& output_ref,
                  const float output_max,
@@ -760,5 +760,265 @@ TEST(COPY, fused_chain_of_copies) {
   EXPECT_EQ(copy_node->outputs[0], output_id);
 }
 
+TEST(ELEMENTWISE_CHAIN, fused_silu) {
+  // ---input--> (Sigmoid) ---sigmoid_out--> (Multiply with input) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t sigmoid_out = 1;
+  const uint32_t output_id = 2;
+  const std::vector<size_t> dims = {2, 5, 7, 19};
+  RuntimeTester tester(3);
+  tester
+      .AddInputTensorF32(dims, input_id)
+      .AddDynamicTensorF32(dims, sigmoid_out)
+      .AddOutputTensorF32(dims, output_id)
+      .AddUnary(xnn_unary_sigmoid, nullptr, input_id, sigmoid_out)
+      .AddMultiply(input_id, sigmoid_out, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 2);
+
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 1);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+
+  const xnn_node* fused_node = tester.Node(1);
+  ASSERT_EQ(fused_node->type, xnn_node_type_fused_elementwise);
+  EXPECT_EQ(fused_node->params.fused_elementwise.num_steps, 2);
+  EXPECT_EQ(fused_node->inputs[0], input_id);
+  EXPECT_EQ(fused_node->outputs[0], output_id);
+  EXPECT_EQ(tester.Value(sigmoid_out)->type, xnn_value_type_invalid);
+}
+
+TEST(ELEMENTWISE_CHAIN, fused_with_broadcast_operands) {
+  // ---input--> (Add bias) --> (HardSwish) --> (Multiply by scale) --> (Subtract from scalar) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t bias_id = 1;
+  const uint32_t scale_id = 2;
+  const uint32_t scalar_id = 3;
+  const uint32_t add_out = 4;
+  const uint32_t hardswish_out = 5;
+  const uint32_t multiply_out = 6;
+  const uint32_t output_id = 7;
+  const std::vector<size_t> dims = {3, 11, 37};
+  RuntimeTester tester(8);
+  tester
+      .AddInputTensorF32(dims, input_id)
+      .AddStaticTensorF32({37}, TensorType::kDense, bias_id)
+      .AddStaticTensorF32({1, 1, 37}, TensorType::kDense, scale_id)
+      .AddStaticTensorF32({1}, TensorType::kDense, scalar_id)
+      .AddDynamicTensorF32(dims, add_out)
+      .AddDynamicTensorF32(dims, hardswish_out)
+      .AddDynamicTensorF32(dims, multiply_out)
+      .AddOutputTensorF32(dims, output_id)
+      .AddAddition(input_id, bias_id, add_out)
+      .AddHardSwish(add_out, hardswish_out)
+      .AddMultiply(hardswish_out, scale_id, multiply_out)
+      .AddSubtract(scalar_id, multiply_out, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 4);
+
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 1);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+
+  const xnn_node* fused_node = tester.Node(3);
+  ASSERT_EQ(fused_node->type, xnn_node_type_fused_elementwise);
+  EXPECT_EQ(fused_node->params.fused_elementwise.num_steps, 4);
+  ASSERT_EQ(fused_node->num_inputs, 4);
+  EXPECT_EQ(fused_node->inputs[0], input_id);
+  EXPECT_EQ(fused_node->inputs[1], bias_id);
+  EXPECT_EQ(fused_node->inputs[2], scale_id);
+  EXPECT_EQ(fused_node->inputs[3], scalar_id);
+  EXPECT_TRUE(fused_node->params.fused_elementwise.steps[3].operand_first);
+}
+
+TEST(ELEMENTWISE_CHAIN, not_fused_across_values_with_multiple_consumers) {
+  // ---input--> (Sigmoid) ---sigmoid_out--> (Add input) ---add_out--> (Multiply with sigmoid_out) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t sigmoid_out = 1;
+  const uint32_t add_out = 2;
+  const uint32_t output_id = 3;
+  const std::vector<size_t> dims = {4, 33};
+  RuntimeTester tester(4);
+  tester
+      .AddInputTensorF32(dims, input_id)
+      .AddDynamicTensorF32(dims, sigmoid_out)
+      .AddDynamicTensorF32(dims, add_out)
+      .AddOutputTensorF32(dims, output_id)
+      .AddUnary(xnn_unary_sigmoid, nullptr, input_id, sigmoid_out)
+      .AddAddition(sigmoid_out, input_id, add_out)
+      .AddMultiply(add_out, sigmoid_out, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 3);
+
+  // The result of the sigmoid is consumed twice, so only the add and the multiply are fused.
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 2);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+  EXPECT_EQ(tester.Node(0)->type, xnn_node_type_unary_elementwise);
+  const xnn_node* fused_node = tester.Node(2);
+  ASSERT_EQ(fused_node->type, xnn_node_type_fused_elementwise);
+  EXPECT_EQ(fused_node->inputs[0], sigmoid_out);
+}
+
+TEST(GEMM_EPILOGUE, fully_connected_then_gelu_then_add_residual) {
+  // ---input--> (Fully Connected) ---fc_out--> (GELU) ---gelu_out--> (Add residual) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t residual_id = 1;
+  const uint32_t filter_id = 2;
+  const uint32_t bias_id = 3;
+  const uint32_t fc_out = 4;
+  const uint32_t gelu_out = 5;
+  const uint32_t output_id = 6;
+  const std::vector<size_t> output_dims = {5, 24};
+  RuntimeTester tester(7);
+  tester
+      .AddInputTensorF32({5, 32}, input_id)
+      .AddInputTensorF32(output_dims, residual_id)
+      .AddStaticTensorF32({24, 32}, TensorType::kDense, filter_id)
+      .AddStaticTensorF32({24}, TensorType::kDense, bias_id)
+      .AddDynamicTensorF32(output_dims, fc_out)
+      .AddDynamicTensorF32(output_dims, gelu_out)
+      .AddOutputTensorF32(output_dims, output_id)
+      .AddFullyConnected(input_id, filter_id, bias_id, fc_out)
+      .AddUnary(xnn_unary_gelu, nullptr, fc_out, gelu_out)
+      .AddAddition(residual_id, gelu_out, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 3);
+
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 1);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+
+  const xnn_node* fused_node = tester.Node(2);
+  ASSERT_EQ(fused_node->type, xnn_node_type_fully_connected);
+  EXPECT_EQ(fused_node->epilogue.num_steps, 2);
+  EXPECT_EQ(fused_node->epilogue.steps[0].unary_operator, xnn_unary_gelu);
+  EXPECT_EQ(fused_node->epilogue.steps[1].binary_operator, xnn_binary_add);
+  EXPECT_TRUE(fused_node->epilogue.steps[1].operand_first);
+  ASSERT_EQ(fused_node->num_inputs, 4);
+  EXPECT_EQ(fused_node->epilogue.num_inputs, 1);
+  EXPECT_EQ(fused_node->inputs[3], residual_id);
+  EXPECT_EQ(fused_node->outputs[0], output_id);
+  EXPECT_EQ(tester.Value(fc_out)->type, xnn_value_type_invalid);
+  EXPECT_EQ(tester.Value(gelu_out)->type, xnn_value_type_invalid);
+}
+
+TEST(GEMM_EPILOGUE, convolution_then_hardswish) {
+  // ---input--> (Convolution) ---conv_out--> (HardSwish) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t filter_id = 1;
+  const uint32_t bias_id = 2;
+  const uint32_t conv_out = 3;
+  const uint32_t output_id = 4;
+  const std::vector<size_t> output_dims = {1, 15, 17, 19};
+  RuntimeTester tester(5);
+  tester
+      .AddInputTensorF32({1, 15, 17, 3}, input_id)
+      .AddStaticTensorF32({19, 3, 3, 3}, TensorType::kDense, filter_id)
+      .AddStaticTensorF32({19}, TensorType::kDense, bias_id)
+      .AddDynamicTensorF32(output_dims, conv_out)
+      .AddOutputTensorF32(output_dims, output_id)
+      .AddConvolution2D(
+          ConvolutionParams{
+            Padding{1, 1, 1, 1},
+            Kernel{3, 3},
+            Subsampling{1, 1},
+            Dilation{1, 1},
+            /*groups=*/ 1,
+            /*group_input_channels=*/ 3,
+            /*group_output_channels=*/ 19,
+          }, input_id, filter_id, bias_id, conv_out)
+      .AddHardSwish(conv_out, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 2);
+
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 1);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+
+  const xnn_node* fused_node = tester.Node(1);
+  ASSERT_EQ(fused_node->type, xnn_node_type_convolution_2d);
+  EXPECT_EQ(fused_node->epilogue.num_steps, 1);
+  EXPECT_EQ(fused_node->epilogue.num_inputs, 0);
+  EXPECT_EQ(fused_node->num_inputs, 3);
+  EXPECT_EQ(fused_node->outputs[0], output_id);
+}
+
+TEST(GEMM_EPILOGUE, winograd_convolution_then_hardswish_then_add_residual) {
+  // ---input--> (3x3 Convolution) ---conv_out--> (HardSwish) ---hardswish_out--> (Add residual) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t residual_id = 1;
+  const uint32_t filter_id = 2;
+  const uint32_t bias_id = 3;
+  const uint32_t conv_out = 4;
+  const uint32_t hardswish_out = 5;
+  const uint32_t output_id = 6;
+  const std::vector<size_t> output_dims = {2, 9, 11, 36};
+  RuntimeTester tester(7);
+  tester
+      .AddInputTensorF32({2, 9, 11, 32}, input_id)
+      .AddInputTensorF32(output_dims, residual_id)
+      .AddStaticTensorF32({36, 3, 3, 32}, TensorType::kDense, filter_id)
+      .AddStaticTensorF32({36}, TensorType::kDense, bias_id)
+      .AddDynamicTensorF32(output_dims, conv_out)
+      .AddDynamicTensorF32(output_dims, hardswish_out)
+      .AddOutputTensorF32(output_dims, output_id)
+      .AddConvolution2D(
+          ConvolutionParams{
+            Padding{1, 1, 1, 1},
+            Kernel{3, 3},
+            Subsampling{1, 1},
+            Dilation{1, 1},
+            /*groups=*/ 1,
+            /*group_input_channels=*/ 32,
+            /*group_output_channels=*/ 36,
+          }, input_id, filter_id, bias_id, conv_out)
+      .AddHardSwish(conv_out, hardswish_out)
+      .AddAddition(hardswish_out, residual_id, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 3);
+
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 1);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+
+  const xnn_node* fused_node = tester.Node(2);
+  ASSERT_EQ(fused_node->type, xnn_node_type_convolution_2d);
+  EXPECT_EQ(fused_node->epilogue.num_steps, 2);
+  EXPECT_EQ(fused_node->epilogue.num_inputs, 1);
+  EXPECT_EQ(fused_node->outputs[0], output_id);
+}
+
+TEST(GEMM_EPILOGUE, not_fused_with_broadcast_operand) {
+  // ---input--> (Fully Connected) ---fc_out--> (Multiply by scale) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t filter_id = 1;
+  const uint32_t scale_id = 2;
+  const uint32_t fc_out = 3;
+  const uint32_t output_id = 4;
+  const std::vector<size_t> output_dims = {7, 16};
+  RuntimeTester tester(5);
+  tester
+      .AddInputTensorF32({7, 8}, input_id)
+      .AddStaticTensorF32({16, 8}, TensorType::kDense, filter_id)
+      .AddStaticTensorF32({16}, TensorType::kDense, scale_id)
+      .AddDynamicTensorF32(output_dims, fc_out)
+      .AddOutputTensorF32(output_dims, output_id)
+      .AddFullyConnected(input_id, filter_id, XNN_INVALID_VALUE_ID, fc_out)
+      .AddMultiply(fc_out, scale_id, output_id);
+
+  xnnpack::Buffer<float> unoptimized_output = tester.RunWithoutFusion<float>();
+  xnnpack::Buffer<float> optimized_output = tester.RunWithFusion<float>();
+  EXPECT_EQ(tester.NumOperators(), 2);
+  EXPECT_EQ(unoptimized_output, optimized_output);
+  EXPECT_EQ(tester.Node(0)->epilogue.num_steps, 0);
+}
+
 
 }  // namespace xnnpack
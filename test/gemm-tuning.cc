@@ -0,0 +1,193 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "xnnpack.h"
+#include "xnnpack/gemm-tuning.h"
+#include "xnnpack/operator-type.h"
+#include "replicable_random_device.h"
+
+namespace {
+
+class GemmTuningTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+    xnn_gemm_tuning_clear();
+    path_ = testing::TempDir() + "gemm-tuning.txt";
+  }
+
+  void TearDown() override {
+    xnn_gemm_tuning_clear();
+    std::remove(path_.c_str());
+  }
+
+  void WriteFile(const std::string& contents) {
+    FILE* file = std::fopen(path_.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    std::fputs(contents.c_str(), file);
+    std::fclose(file);
+  }
+
+  std::string path_;
+};
+
+}  // namespace
+
+TEST_F(GemmTuningTest, record_and_look_up) {
+  EXPECT_EQ(0, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32));
+  ASSERT_EQ(xnn_status_success, xnn_gemm_tuning_record(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32, 3));
+  EXPECT_EQ(3, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32));
+  EXPECT_EQ(0, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 5, 64, 32));
+  EXPECT_EQ(0, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f16, 4, 64, 32));
+
+  ASSERT_EQ(xnn_status_success, xnn_gemm_tuning_record(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32, 5));
+  EXPECT_EQ(5, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32));
+
+  xnn_gemm_tuning_clear();
+  EXPECT_EQ(0, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32));
+}
+
+TEST_F(GemmTuningTest, save_and_load) {
+  ASSERT_EQ(xnn_status_success, xnn_gemm_tuning_record(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32, 3));
+  ASSERT_EQ(xnn_status_success, xnn_gemm_tuning_record(xnn_operator_type_fully_connected_nc_qs8, 100, 7, 9, 1));
+  ASSERT_EQ(xnn_status_success, xnn_save_gemm_tuning_file(path_.c_str()));
+
+  xnn_gemm_tuning_clear();
+  ASSERT_EQ(xnn_status_success, xnn_load_gemm_tuning_file(path_.c_str()));
+  EXPECT_EQ(3, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32));
+  EXPECT_EQ(1, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_qs8, 100, 7, 9));
+}
+
+TEST_F(GemmTuningTest, keeps_entries_of_other_hardware) {
+  const uint32_t other_hardware = xnn_gemm_tuning_hardware_fingerprint() ^ UINT32_C(1);
+  char entry[128];
+  std::snprintf(entry, sizeof(entry), "%08x 4 64 32 6 %s\n", (unsigned) other_hardware,
+                xnn_operator_type_to_string(xnn_operator_type_fully_connected_nc_f32));
+  WriteFile(std::string("XNNPACK GEMM tuning v1\n") + entry);
+  ASSERT_EQ(xnn_status_success, xnn_load_gemm_tuning_file(path_.c_str()));
+  EXPECT_EQ(0, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 4, 64, 32));
+
+  ASSERT_EQ(xnn_status_success, xnn_save_gemm_tuning_file(path_.c_str()));
+  FILE* file = std::fopen(path_.c_str(), "r");
+  ASSERT_NE(file, nullptr);
+  std::string contents;
+  char buffer[256];
+  while (std::fgets(buffer, sizeof(buffer), file) != nullptr) {
+    contents += buffer;
+  }
+  std::fclose(file);
+  EXPECT_NE(contents.find(entry), std::string::npos);
+}
+
+TEST_F(GemmTuningTest, skips_invalid_entries) {
+  char valid_entry[128];
+  std::snprintf(valid_entry, sizeof(valid_entry), "%08x 2 3 4 2 %s\n",
+                (unsigned) xnn_gemm_tuning_hardware_fingerprint(),
+                xnn_operator_type_to_string(xnn_operator_type_fully_connected_nc_f32));
+  WriteFile(std::string("XNNPACK GEMM tuning v1\n") +
+            "00000000 1 2\n"
+            "00000000 1 2 3 4 No Such Operator\n"
+            "00000000 1 2 3 0 Fully Connected (NC, F32)\n" +
+            valid_entry);
+  ASSERT_EQ(xnn_status_success, xnn_load_gemm_tuning_file(path_.c_str()));
+  EXPECT_EQ(2, xnn_gemm_tuning_look_up(xnn_operator_type_fully_connected_nc_f32, 2, 3, 4));
+}
+
+TEST_F(GemmTuningTest, rejects_unknown_format) {
+  WriteFile("XNNPACK GEMM tuning v0\n");
+  EXPECT_EQ(xnn_status_invalid_parameter, xnn_load_gemm_tuning_file(path_.c_str()));
+  EXPECT_EQ(xnn_status_invalid_parameter, xnn_load_gemm_tuning_file((path_ + ".missing").c_str()));
+  EXPECT_EQ(xnn_status_invalid_parameter, xnn_load_gemm_tuning_file(nullptr));
+}
+
+namespace {
+
+// Runs a subgraph with a single F32 Fully Connected node.
+std::vector<float> RunFullyConnected(
+  size_t batch_size, size_t input_channels, size_t output_channels,
+  const std::vector<float>& input, const std::vector<float>& filter, const std::vector<float>& bias, uint32_t flags)
+{
+  xnn_subgraph_t subgraph = nullptr;
+  EXPECT_EQ(xnn_status_success, xnn_create_subgraph(/*external_value_ids=*/2, /*flags=*/0, &subgraph));
+  const size_t input_dims[2] = {batch_size, input_channels};
+  const size_t filter_dims[2] = {output_channels, input_channels};
+  const size_t bias_dims[1] = {output_channels};
+  const size_t output_dims[2] = {batch_size, output_channels};
+  uint32_t input_id = XNN_INVALID_VALUE_ID;
+  uint32_t filter_id = XNN_INVALID_VALUE_ID;
+  uint32_t bias_id = XNN_INVALID_VALUE_ID;
+  uint32_t output_id = XNN_INVALID_VALUE_ID;
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 2, input_dims, nullptr,
+                                                        /*external_id=*/0, XNN_VALUE_FLAG_EXTERNAL_INPUT, &input_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 2, filter_dims, filter.data(),
+                                                        XNN_INVALID_VALUE_ID, /*flags=*/0, &filter_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 1, bias_dims, bias.data(),
+                                                        XNN_INVALID_VALUE_ID, /*flags=*/0, &bias_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 2, output_dims, nullptr,
+                                                        /*external_id=*/1, XNN_VALUE_FLAG_EXTERNAL_OUTPUT, &output_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_fully_connected(subgraph, -INFINITY, INFINITY, input_id, filter_id,
+                                                           bias_id, output_id, /*flags=*/0));
+
+  xnn_runtime_t runtime = nullptr;
+  EXPECT_EQ(xnn_status_success, xnn_create_runtime_v3(subgraph, nullptr, nullptr, flags, &runtime));
+  std::vector<float> output(batch_size * output_channels);
+  const std::array<xnn_external_value, 2> external = {
+    xnn_external_value{input_id, const_cast<float*>(input.data())},
+    xnn_external_value{output_id, output.data()},
+  };
+  EXPECT_EQ(xnn_status_success, xnn_setup_runtime(runtime, external.size(), external.data()));
+  EXPECT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+  xnn_delete_runtime(runtime);
+  xnn_delete_subgraph(subgraph);
+  return output;
+}
+
+}  // namespace
+
+TEST_F(GemmTuningTest, fully_connected_matches_default_microkernels) {
+  xnnpack::ReplicableRandomDevice rng;
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (size_t batch_size : {1, 5, 29}) {
+    const size_t input_channels = 67;
+    const size_t output_channels = 45;
+    std::vector<float> input(batch_size * input_channels);
+    std::vector<float> filter(output_channels * input_channels);
+    std::vector<float> bias(output_channels);
+    std::generate(input.begin(), input.end(), [&]() { return dist(rng); });
+    std::generate(filter.begin(), filter.end(), [&]() { return dist(rng); });
+    std::generate(bias.begin(), bias.end(), [&]() { return dist(rng); });
+
+    const std::vector<float> expected =
+      RunFullyConnected(batch_size, input_channels, output_channels, input, filter, bias, /*flags=*/0);
+    const std::vector<float> actual =
+      RunFullyConnected(batch_size, input_channels, output_channels, input, filter, bias, XNN_FLAG_AUTOTUNE);
+    for (size_t i = 0; i < expected.size(); i++) {
+      ASSERT_NEAR(actual[i], expected[i], 1.0e-5f * input_channels) << "batch " << batch_size << ", index " << i;
+    }
+
+    const uint32_t tuned_mr = xnn_gemm_tuning_look_up(
+      xnn_operator_type_fully_connected_nc_f32, batch_size, output_channels, input_channels);
+    if (tuned_mr != 0) {
+      EXPECT_LE(tuned_mr, XNN_MAX_MR);
+      // The tuned choice is reused rather than timed again.
+      const std::vector<float> reused =
+        RunFullyConnected(batch_size, input_channels, output_channels, input, filter, bias, XNN_FLAG_AUTOTUNE);
+      EXPECT_EQ(reused, actual);
+      EXPECT_EQ(tuned_mr, xnn_gemm_tuning_look_up(
+        xnn_operator_type_fully_connected_nc_f32, batch_size, output_channels, input_channels));
+    }
+  }
+}
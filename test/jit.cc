@@ -0,0 +1,321 @@
+// Copyright 2024 Google LLC
+//
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "xnnpack.h"
+#include "xnnpack/cache.h"
+#include "xnnpack/common.h"
+#include "xnnpack/jit.h"
+#include "xnnpack/microparams.h"
+#include "replicable_random_device.h"
+
+namespace {
+
+class JitGemmTester {
+ public:
+  JitGemmTester& isa(xnn_jit_x64_isa isa) { isa_ = isa; return *this; }
+  JitGemmTester& mr(size_t mr) { mr_ = mr; return *this; }
+  JitGemmTester& nr(size_t nr) { nr_ = nr; return *this; }
+  JitGemmTester& kc(size_t kc) { kc_ = kc; return *this; }
+  JitGemmTester& m(size_t m) { m_ = m; return *this; }
+  JitGemmTester& n(size_t n) { n_ = n; return *this; }
+  JitGemmTester& a_stride(size_t a_stride) { a_stride_ = a_stride; return *this; }
+  JitGemmTester& cm_stride(size_t cm_stride) { cm_stride_ = cm_stride; return *this; }
+  JitGemmTester& min(float min) { min_ = min; return *this; }
+  JitGemmTester& max(float max) { max_ = max; return *this; }
+
+  size_t m() const { return m_ == 0 ? mr_ : m_; }
+  size_t a_stride() const { return a_stride_ == 0 ? kc_ : a_stride_; }
+  size_t cm_stride() const { return cm_stride_ == 0 ? n_ : cm_stride_; }
+
+  void Test(xnn_code_cache* code_cache) const {
+    xnn_jit_f32_gemm_params params = {};
+    params.isa = isa_;
+    params.mr = mr_;
+    params.nr = nr_;
+    params.kc = kc_;
+    params.a_stride = a_stride() * sizeof(float);
+    params.cm_stride = cm_stride() * sizeof(float);
+    params.min = min_;
+    params.max = max_;
+    const xnn_f32_gemm_minmax_ukernel_fn gemm = xnn_jit_f32_gemm_minmax(code_cache, &params);
+    if (gemm == nullptr) {
+      GTEST_SKIP() << "code generation is not supported";
+    }
+
+    xnnpack::ReplicableRandomDevice rng;
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a((m() - 1) * a_stride() + kc_);
+    std::generate(a.begin(), a.end(), [&]() { return dist(rng); });
+    std::vector<float> bias(n_);
+    std::generate(bias.begin(), bias.end(), [&]() { return dist(rng); });
+    std::vector<float> b(n_ * kc_);
+    std::generate(b.begin(), b.end(), [&]() { return dist(rng); });
+
+    // Pack the bias and weights of each NR columns, padding with zeros.
+    const size_t num_tiles = (n_ + nr_ - 1) / nr_;
+    std::vector<float> w(num_tiles * (kc_ + 1) * nr_);
+    for (size_t t = 0; t < num_tiles; t++) {
+      float* tile = w.data() + t * (kc_ + 1) * nr_;
+      for (size_t j = 0; j < nr_ && t * nr_ + j < n_; j++) {
+        const size_t n = t * nr_ + j;
+        tile[j] = bias[n];
+        for (size_t k = 0; k < kc_; k++) {
+          tile[(k + 1) * nr_ + j] = b[k * n_ + n];
+        }
+      }
+    }
+
+    const float sentinel = 12345.0f;
+    std::vector<float> c((m() - 1) * cm_stride() + n_ + 1, sentinel);
+    xnn_f32_minmax_params unused_params;
+    std::memset(&unused_params, 0, sizeof(unused_params));
+    gemm(m(), n_, kc_ * sizeof(float), a.data(), a_stride() * sizeof(float), w.data(), c.data(),
+         cm_stride() * sizeof(float), nr_ * sizeof(float), &unused_params);
+
+    for (size_t i = 0; i < m(); i++) {
+      for (size_t j = 0; j < n_; j++) {
+        float expected = bias[j];
+        float magnitude = std::abs(bias[j]);
+        for (size_t k = 0; k < kc_; k++) {
+          expected += a[i * a_stride() + k] * b[k * n_ + j];
+          magnitude += std::abs(a[i * a_stride() + k] * b[k * n_ + j]);
+        }
+        expected = std::min(std::max(expected, min_), max_);
+        ASSERT_NEAR(c[i * cm_stride() + j], expected, magnitude * 1.0e-5f)
+          << "row " << i << " / " << m() << ", column " << j << " / " << n_ << ", ISA " << isa_ << ", MR " << mr_
+          << ", NR " << nr_ << ", K " << kc_;
+      }
+      // Columns past N are not written.
+      if (i + 1 == m() || cm_stride() > n_) {
+        ASSERT_EQ(c[i * cm_stride() + n_], sentinel)
+          << "row " << i << ", ISA " << isa_ << ", MR " << mr_ << ", NR " << nr_;
+      }
+    }
+  }
+
+ private:
+  xnn_jit_x64_isa isa_ = xnn_jit_x64_isa_avx2;
+  size_t mr_ = 1;
+  size_t nr_ = 8;
+  size_t kc_ = 1;
+  size_t m_ = 0;
+  size_t n_ = 8;
+  size_t a_stride_ = 0;
+  size_t cm_stride_ = 0;
+  float min_ = -std::numeric_limits<float>::infinity();
+  float max_ = std::numeric_limits<float>::infinity();
+};
+
+class JitTest : public ::testing::TestWithParam<xnn_jit_x64_isa> {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+    if (!xnn_jit_x64_isa_supported(GetParam())) {
+      GTEST_SKIP() << "instruction set is not supported";
+    }
+    ASSERT_EQ(xnn_status_success, xnn_init_code_cache(&code_cache_));
+    initialized_ = true;
+  }
+
+  void TearDown() override {
+    if (initialized_) {
+      EXPECT_EQ(xnn_status_success, xnn_release_code_cache(&code_cache_));
+    }
+  }
+
+  std::array<size_t, 3> NRs() const {
+    if (GetParam() == xnn_jit_x64_isa_avx512f) {
+      return {16, 32, 64};
+    }
+    return {8, 16, 32};
+  }
+
+  JitGemmTester Tester() const { return JitGemmTester().isa(GetParam()); }
+
+  xnn_code_cache code_cache_;
+  bool initialized_ = false;
+};
+
+}  // namespace
+
+TEST(JIT_F32_GEMM, max_mr) {
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx2, 4), 0);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx2, 8), 8);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx2, 16), 6);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx2, 32), 2);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx2, 128), 0);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx512f, 8), 0);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx512f, 16), 8);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx512f, 32), 8);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx512f, 64), 7);
+  EXPECT_EQ(xnn_jit_f32_gemm_max_mr(xnn_jit_x64_isa_avx512f, 80), 0);
+}
+
+TEST_P(JitTest, full_tile) {
+  for (size_t nr : NRs()) {
+    for (size_t mr = 1; mr <= xnn_jit_f32_gemm_max_mr(GetParam(), nr); mr++) {
+      for (size_t kc : {1, 2, 7, 16, 33}) {
+        Tester().mr(mr).nr(nr).kc(kc).n(nr).Test(&code_cache_);
+      }
+    }
+  }
+}
+
+TEST_P(JitTest, fewer_rows) {
+  for (size_t nr : NRs()) {
+    const size_t mr = xnn_jit_f32_gemm_max_mr(GetParam(), nr);
+    for (size_t m = 1; m < mr; m++) {
+      Tester().mr(mr).nr(nr).kc(5).m(m).n(nr).Test(&code_cache_);
+    }
+  }
+}
+
+TEST_P(JitTest, partial_and_multiple_tiles) {
+  for (size_t nr : NRs()) {
+    const size_t mr = xnn_jit_f32_gemm_max_mr(GetParam(), nr);
+    for (size_t n = 1; n <= 3 * nr; n++) {
+      Tester().mr(mr).nr(nr).kc(3).n(n).Test(&code_cache_);
+      Tester().mr(mr).nr(nr).kc(3).m(1).n(n).Test(&code_cache_);
+    }
+  }
+}
+
+TEST_P(JitTest, k_loop) {
+  for (size_t nr : NRs()) {
+    const size_t mr = xnn_jit_f32_gemm_max_mr(GetParam(), nr);
+    for (size_t kc : {XNN_JIT_GEMM_MAX_UNROLLED_KC, XNN_JIT_GEMM_MAX_UNROLLED_KC + 1,
+                      XNN_JIT_GEMM_MAX_UNROLLED_KC + XNN_JIT_GEMM_K_UNROLL, 1000}) {
+      Tester().mr(mr).nr(nr).kc(kc).n(2 * nr + 3).Test(&code_cache_);
+    }
+  }
+}
+
+TEST_P(JitTest, strides) {
+  for (size_t nr : NRs()) {
+    const size_t mr = xnn_jit_f32_gemm_max_mr(GetParam(), nr);
+    Tester().mr(mr).nr(nr).kc(11).a_stride(17).n(nr + 5).cm_stride(3 * nr).Test(&code_cache_);
+    Tester().mr(mr).nr(nr).kc(300).a_stride(311).n(nr - 1).cm_stride(nr + 7).Test(&code_cache_);
+  }
+}
+
+TEST_P(JitTest, clamp) {
+  for (size_t nr : NRs()) {
+    const size_t mr = xnn_jit_f32_gemm_max_mr(GetParam(), nr);
+    Tester().mr(mr).nr(nr).kc(13).n(nr + 3).min(-0.5f).Test(&code_cache_);
+    Tester().mr(mr).nr(nr).kc(13).n(nr + 3).max(0.25f).Test(&code_cache_);
+    Tester().mr(mr).nr(nr).kc(13).n(nr + 3).min(-0.5f).max(0.25f).Test(&code_cache_);
+  }
+}
+
+TEST_P(JitTest, code_cache_reuses_kernels) {
+  xnn_jit_f32_gemm_params params = {};
+  params.isa = GetParam();
+  params.mr = 4;
+  params.nr = 16;
+  params.kc = 64;
+  params.a_stride = 64 * sizeof(float);
+  params.cm_stride = 16 * sizeof(float);
+  params.min = -1.0f;
+  params.max = 1.0f;
+  const xnn_f32_gemm_minmax_ukernel_fn gemm = xnn_jit_f32_gemm_minmax(&code_cache_, &params);
+  if (gemm == nullptr) {
+    GTEST_SKIP() << "code generation is not supported";
+  }
+  EXPECT_EQ(code_cache_.num_entries, 1);
+  EXPECT_EQ(gemm, xnn_jit_f32_gemm_minmax(&code_cache_, &params));
+  EXPECT_EQ(code_cache_.num_entries, 1);
+  EXPECT_EQ(code_cache_.hits, 1);
+
+  params.kc = 65;
+  EXPECT_NE(gemm, xnn_jit_f32_gemm_minmax(&code_cache_, &params));
+  EXPECT_EQ(code_cache_.num_entries, 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  JIT_F32_GEMM, JitTest, testing::Values(xnn_jit_x64_isa_avx2, xnn_jit_x64_isa_avx512f),
+  [](const testing::TestParamInfo<xnn_jit_x64_isa>& info) {
+    return info.param == xnn_jit_x64_isa_avx512f ? "avx512f" : "avx2";
+  });
+
+namespace {
+
+// Runs a subgraph with a single F32 Fully Connected node.
+std::vector<float> RunFullyConnected(
+  size_t batch_size, size_t input_channels, size_t output_channels, float output_min, float output_max,
+  const std::vector<float>& input, const std::vector<float>& filter, const std::vector<float>& bias, uint32_t flags)
+{
+  xnn_subgraph_t subgraph = nullptr;
+  EXPECT_EQ(xnn_status_success, xnn_create_subgraph(/*external_value_ids=*/2, /*flags=*/0, &subgraph));
+  const size_t input_dims[2] = {batch_size, input_channels};
+  const size_t filter_dims[2] = {output_channels, input_channels};
+  const size_t bias_dims[1] = {output_channels};
+  const size_t output_dims[2] = {batch_size, output_channels};
+  uint32_t input_id = XNN_INVALID_VALUE_ID;
+  uint32_t filter_id = XNN_INVALID_VALUE_ID;
+  uint32_t bias_id = XNN_INVALID_VALUE_ID;
+  uint32_t output_id = XNN_INVALID_VALUE_ID;
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 2, input_dims, nullptr,
+                                                        /*external_id=*/0, XNN_VALUE_FLAG_EXTERNAL_INPUT, &input_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 2, filter_dims, filter.data(),
+                                                        XNN_INVALID_VALUE_ID, /*flags=*/0, &filter_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 1, bias_dims, bias.data(),
+                                                        XNN_INVALID_VALUE_ID, /*flags=*/0, &bias_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_tensor_value(subgraph, xnn_datatype_fp32, 2, output_dims, nullptr,
+                                                        /*external_id=*/1, XNN_VALUE_FLAG_EXTERNAL_OUTPUT, &output_id));
+  EXPECT_EQ(xnn_status_success, xnn_define_fully_connected(subgraph, output_min, output_max, input_id, filter_id,
+                                                           bias_id, output_id, /*flags=*/0));
+
+  xnn_runtime_t runtime = nullptr;
+  EXPECT_EQ(xnn_status_success, xnn_create_runtime_v3(subgraph, nullptr, nullptr, flags, &runtime));
+  std::vector<float> output(batch_size * output_channels);
+  const std::array<xnn_external_value, 2> external = {
+    xnn_external_value{input_id, const_cast<float*>(input.data())},
+    xnn_external_value{output_id, output.data()},
+  };
+  EXPECT_EQ(xnn_status_success, xnn_setup_runtime(runtime, external.size(), external.data()));
+  EXPECT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+  xnn_delete_runtime(runtime);
+  xnn_delete_subgraph(subgraph);
+  return output;
+}
+
+}  // namespace
+
+TEST(JIT_RUNTIME, fully_connected_matches_static_microkernels) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  xnnpack::ReplicableRandomDevice rng;
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (size_t batch_size : {1, 3, 17}) {
+    for (size_t input_channels : {5, 64, 301}) {
+      const size_t output_channels = 37;
+      std::vector<float> input(batch_size * input_channels);
+      std::vector<float> filter(output_channels * input_channels);
+      std::vector<float> bias(output_channels);
+      std::generate(input.begin(), input.end(), [&]() { return dist(rng); });
+      std::generate(filter.begin(), filter.end(), [&]() { return dist(rng); });
+      std::generate(bias.begin(), bias.end(), [&]() { return dist(rng); });
+
+      const std::vector<float> expected = RunFullyConnected(
+        batch_size, input_channels, output_channels, -2.0f, 2.0f, input, filter, bias, /*flags=*/0);
+      const std::vector<float> actual = RunFullyConnected(
+        batch_size, input_channels, output_channels, -2.0f, 2.0f, input, filter, bias, XNN_FLAG_JIT);
+      for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_NEAR(actual[i], expected[i], 1.0e-4f * input_channels)
+          << "batch " << batch_size << ", input channels " << input_channels << ", index " << i;
+      }
+    }
+  }
+}
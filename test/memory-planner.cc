@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "xnnpack.h"
@@ -17,6 +18,15 @@
 
 namespace xnnpack {
 
+namespace {
+
+// The tests below check the planning of intermediate tensors, which fusion of elementwise operators would remove.
+uint32_t RuntimeFlags() {
+  return XNN_FLAG_NO_OPERATOR_FUSION | xnn_test_runtime_flags();
+}
+
+}  // namespace
+
 TEST(MemoryPlanner, ValueLiveInfo) {
   EXPECT_EQ(xnn_status_success, xnn_initialize(nullptr /* allocator */));
   // Create simple runtime where it has 2 nodes and 4 tensors as illustrated below:
@@ -179,6 +189,90 @@ TEST(MemoryPlanner, GeneralPlanning) {
   xnn_release_value_allocation_tracker(&tracker);
 }
 
+#if XNN_ENABLE_MEMOPT
+namespace {
+struct UsageStub {
+  uint32_t first_node;
+  uint32_t last_node;
+  size_t tensor_size;
+};
+
+// Plans the given values with the given strategy, checks that values live at the same time do not overlap, and returns
+// the size of the memory arena.
+size_t PlanUsage(const std::vector<UsageStub>& stubs, xnn_memory_planner_strategy strategy, size_t* lower_bound) {
+  struct xnn_runtime runtime;
+  runtime.num_ops = 0;
+  runtime.num_values = stubs.size();
+  struct xnn_value_allocation_tracker tracker;
+  xnn_init_value_allocation_tracker(&tracker, &runtime);
+  tracker.strategy = strategy;
+  for (uint32_t i = 0; i < stubs.size(); i++) {
+    tracker.usage[i].first_node = stubs[i].first_node;
+    tracker.usage[i].last_node = stubs[i].last_node;
+    tracker.usage[i].reuse_value_id = XNN_INVALID_VALUE_ID;
+    xnn_add_value_allocation_tracker(&tracker, i, stubs[i].tensor_size);
+  }
+  xnn_plan_value_allocation_tracker(&tracker);
+
+  for (size_t i = 0; i < stubs.size(); i++) {
+    const xnn_usage_record& a = tracker.usage[i];
+    EXPECT_LE(a.alloc_offset + a.tensor_size, tracker.mem_arena_size);
+    for (size_t j = i + 1; j < stubs.size(); j++) {
+      const xnn_usage_record& b = tracker.usage[j];
+      const bool live_together = a.first_node <= b.last_node && b.first_node <= a.last_node;
+      const bool overlap = a.alloc_offset < b.alloc_offset + b.tensor_size && b.alloc_offset < a.alloc_offset + a.tensor_size;
+      EXPECT_FALSE(live_together && overlap) << "values " << i << " and " << j << " overlap";
+    }
+  }
+  const size_t mem_arena_size = tracker.mem_arena_size;
+  *lower_bound = tracker.lower_bound;
+  xnn_release_value_allocation_tracker(&tracker);
+  return mem_arena_size;
+}
+}  // namespace
+
+TEST(MemoryPlanner, Strategies) {
+  EXPECT_EQ(xnn_status_success, xnn_initialize(nullptr /* allocator */));
+  // Allocating in order of decreasing size leaves a gap that the 40 byte value can not use.
+  const std::vector<UsageStub> stubs = {
+    {3, 3, 48}, {2, 3, 16}, {0, 2, 8}, {0, 2, 24}, {1, 4, 40},
+  };
+
+  size_t lower_bound = 0;
+  const size_t greedy_by_size = PlanUsage(stubs, xnn_memory_planner_strategy_greedy_by_size, &lower_bound);
+  EXPECT_EQ(104, lower_bound);
+  EXPECT_EQ(136, greedy_by_size);
+
+  const size_t greedy_by_breadth = PlanUsage(stubs, xnn_memory_planner_strategy_greedy_by_breadth, &lower_bound);
+  EXPECT_EQ(104, lower_bound);
+  EXPECT_GE(greedy_by_breadth, lower_bound);
+
+  const size_t best_fit = PlanUsage(stubs, xnn_memory_planner_strategy_best_fit, &lower_bound);
+  EXPECT_EQ(104, lower_bound);
+  EXPECT_GE(best_fit, lower_bound);
+  EXPECT_LE(best_fit, greedy_by_size);
+
+  const size_t exhaustive = PlanUsage(stubs, xnn_memory_planner_strategy_exhaustive, &lower_bound);
+  EXPECT_EQ(104, lower_bound);
+  EXPECT_EQ(104, exhaustive);
+}
+
+TEST(MemoryPlanner, ExhaustiveMatchesBestFitOnLargeGraphs) {
+  EXPECT_EQ(xnn_status_success, xnn_initialize(nullptr /* allocator */));
+  // Too many values to search all allocation orders.
+  std::vector<UsageStub> stubs;
+  for (uint32_t i = 0; i < 32; i++) {
+    stubs.push_back(UsageStub{i, i + 1 + i % 3, 8 * (1 + (i * 7) % 11)});
+  }
+
+  size_t lower_bound = 0;
+  const size_t best_fit = PlanUsage(stubs, xnn_memory_planner_strategy_best_fit, &lower_bound);
+  const size_t exhaustive = PlanUsage(stubs, xnn_memory_planner_strategy_exhaustive, &lower_bound);
+  EXPECT_EQ(best_fit, exhaustive);
+  EXPECT_GE(exhaustive, lower_bound);
+}
+#endif  // XNN_ENABLE_MEMOPT
+
 // Extra space for memory arena due to sparse microkernels reading extra. Should be in sync with runtime.c
 namespace {
 constexpr size_t MEMORY_ARENA_EXTRA_BYTES = 2 * XNN_EXTRA_BYTES;
@@ -213,7 +307,7 @@ TEST(MemoryPlanner, LeakyReluInPlaceAfterConv) {
         input_id, filter_id, bias_id, conv_out)
     .AddLeakyRelu(1.0f, conv_out, leaky_relu_out)
     .AddClamp(0.0f, 1.0f, leaky_relu_out, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
 
   xnn_runtime_t runtime = tester.Runtime();
@@ -257,7 +351,7 @@ TEST(MemoryPlanner, LeakyReluWithTwoConsumersCannotBeInPlace) {
     .AddLeakyRelu(1.0f, conv_out, leaky_relu_out)
     .AddClamp(0.0f, 1.0f, leaky_relu_out, output_id)
     .AddClamp(1.0f, 2.0f, leaky_relu_out, output_id2);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
 
   xnn_runtime_t runtime = tester.Runtime();
@@ -303,7 +397,7 @@ TEST(MemoryPlanner, HardSwishAndLeakyReluInPlaceAfterConv) {
     .AddLeakyRelu(1.0f, conv_out, leaky_relu_out)
     .AddHardSwish(leaky_relu_out, hard_swish_out)
     .AddClamp(0.0f, 1.0f, hard_swish_out, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
 
   xnn_runtime_t runtime = tester.Runtime();
@@ -328,7 +422,7 @@ TEST(MemoryPlanner, ExternalInputsCannotBeInPlace) {
       .AddOutputTensorF32({1, 3, 3, 3}, output_id)
       .AddLeakyRelu(1.0f, input_id, leaky_relu_out)
       .AddClamp(0.0f, 1.0f, leaky_relu_out, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
 
   xnn_runtime_t runtime = tester.Runtime();
@@ -354,7 +448,7 @@ TEST(MemoryPlanner, PersistentValuesCannotReuseInternalValues) {
       .AddClamp(0.0f, 1.0f, input_id, clamp_out_id)
       .AddLeakyRelu(1.0f, clamp_out_id, leaky_relu_out_id)
       .AddClamp(0.0f, 1.0f, leaky_relu_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
 
   xnn_runtime_t runtime = tester.Runtime();
@@ -380,7 +474,7 @@ TEST(MemoryPlanner, CannotReuseStaticValues) {
       .AddOutputTensorF32({1, 3, 3, 3}, output_id)
       .AddClamp(0.0f, 1.0f, static_id, clamp_out_id)
       .AddLeakyRelu(1.0f, clamp_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
 
   xnn_runtime_t runtime = tester.Runtime();
@@ -421,7 +515,7 @@ TEST(MemoryPlanner, Add2WithLHSConstantInPlace) {
         input_id, filter_id, bias_id, conv_out)
     .AddAddition(add_constant_input_id, conv_out, add_out_id)
     .AddLeakyRelu(1.0f, add_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -463,7 +557,7 @@ TEST(MemoryPlanner, Add2WithLHSConstant) {
         input_id, filter_id, bias_id, conv_out)
     .AddAddition(add_constant_input_id, conv_out, add_out_id)
     .AddLeakyRelu(1.0f, add_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -505,7 +599,7 @@ TEST(MemoryPlanner, Add2WithRHSConstantInPlace) {
         input_id, filter_id, bias_id, conv_out)
     .AddAddition(conv_out, add_constant_input_id, add_out_id)
     .AddLeakyRelu(1.0f, add_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -546,7 +640,7 @@ TEST(MemoryPlanner, Mul2WithLHSConstant) {
         input_id, filter_id, bias_id, conv_out)
     .AddMultiply(mul_constant_input_id, conv_out, mul_out_id)
     .AddLeakyRelu(1.0f, mul_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -587,7 +681,7 @@ TEST(MemoryPlanner, Mul2WithRHSConstant) {
         input_id, filter_id, bias_id, conv_out)
     .AddMultiply(conv_out, mul_constant_input_id, mul_out_id)
     .AddLeakyRelu(1.0f, mul_out_id, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -640,7 +734,7 @@ TEST(MemoryPlanner, Add2WithImplicitBroadcast) {
         input2_id, filter_id, bias_id, conv_out)
     .AddAddition(hard_swish_out, conv_out, add_out)
     .AddLeakyRelu(1.0f, add_out, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -708,7 +802,7 @@ TEST(MemoryPlanner, Add2WithInputMultipleConsumers) {
         /*output_id=*/max_pooling_2d_out)
     .AddAddition(conv_out, max_pooling_2d_out, add_out)
     .AddLeakyRelu(1.0f, add_out, output_id);
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
 
@@ -750,7 +844,7 @@ TEST(MemoryPlanner, FullyConnectedDynamicFilterDynamicBias) {
       .AddConstantPad({1}, {0}, 0.0f, input3_id, bias_id)
       .AddFullyConnected(input1_id, filter_id, bias_id, output_id);
 
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
   xnn_operator_data* fc_opdata = &runtime->opdata[2];
@@ -788,7 +882,7 @@ TEST(MemoryPlanner, FullyConnectedDynamicFilterStaticBias) {
       .AddConstantPad({0, 0, 0, 1}, {0, 0, 0, 0}, 0.0f, input2_id, filter_id)
       .AddFullyConnected(input1_id, filter_id, bias_id, output_id);
 
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
   xnn_operator_data* fc_opdata = &runtime->opdata[1];
@@ -824,7 +918,7 @@ TEST(MemoryPlanner, FullyConnectedDynamicFilterNoBias) {
       .AddConstantPad({0, 0, 0, 1}, {0, 0, 0, 0}, 0.0f, input2_id, filter_id)
       .AddFullyConnected(input1_id, filter_id, bias_id, output_id);
 
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
   xnn_operator_data* fc_opdata = &runtime->opdata[1];
@@ -861,7 +955,7 @@ TEST(MemoryPlanner, FullyConnectedStaticFilterDynamicBias) {
       .AddConstantPad({1}, {0}, 0.0f, input3_id, bias_id)
       .AddFullyConnected(input1_id, filter_id, bias_id, output_id);
 
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
   xnn_operator_data* fc_opdata = &runtime->opdata[1];
@@ -892,7 +986,7 @@ TEST(MemoryPlanner, FullyConnectedExternalFilterExternalBias) {
       .AddOutputTensorF32({2, 3, 3, 2}, output_id)
       .AddFullyConnected(input_id, filter_id, bias_id, output_id);
 
-  tester.CreateRuntime(xnn_test_runtime_flags());
+  tester.CreateRuntime(RuntimeFlags());
   tester.SetupRuntime();
   xnn_runtime_t runtime = tester.Runtime();
   xnn_operator_data* fc_opdata = &runtime->opdata[0];
@@ -904,4 +998,49 @@ TEST(MemoryPlanner, FullyConnectedExternalFilterExternalBias) {
             + MEMORY_ARENA_EXTRA_BYTES);
 }
 
+
+TEST(MemoryPlanner, RuntimeMemoryPlanInfo) {
+  uint32_t input_id = 0;
+  uint32_t clamp1_out = 1;
+  uint32_t clamp2_out = 2;
+  uint32_t add_out = 3;
+  uint32_t output_id = 4;
+
+  // input -> clamp1 -> clamp2 -> add -> clamp3 -> output
+  //            \------------------/
+  RuntimeTester tester(5);
+  tester
+    .AddInputTensorF32({1, 4, 4, 8}, input_id)
+    .AddDynamicTensorF32({1, 4, 4, 8}, clamp1_out, /*flags=*/0)
+    .AddDynamicTensorF32({1, 4, 4, 8}, clamp2_out, /*flags=*/0)
+    .AddDynamicTensorF32({1, 4, 4, 8}, add_out, /*flags=*/0)
+    .AddOutputTensorF32({1, 4, 4, 8}, output_id)
+    .AddClamp(-1.0f, 1.0f, input_id, clamp1_out)
+    .AddClamp(0.0f, 1.0f, clamp1_out, clamp2_out)
+    .AddAddition(clamp1_out, clamp2_out, add_out)
+    .AddClamp(0.0f, 1.5f, add_out, output_id);
+  tester.CreateRuntime(RuntimeFlags());
+  xnn_runtime_t runtime = tester.Runtime();
+
+  size_t arena_size = 0;
+  size_t lower_bound = 0;
+  EXPECT_EQ(xnn_status_invalid_state, xnn_get_runtime_memory_plan_info(runtime, &arena_size, &lower_bound));
+
+  for (xnn_memory_planner_strategy strategy : {
+         xnn_memory_planner_strategy_greedy_by_size, xnn_memory_planner_strategy_greedy_by_breadth,
+         xnn_memory_planner_strategy_best_fit, xnn_memory_planner_strategy_exhaustive}) {
+    ASSERT_EQ(xnn_status_success, xnn_set_runtime_memory_planner(runtime, strategy));
+    ASSERT_EQ(xnn_status_success, xnn_reshape_runtime(runtime));
+    ASSERT_EQ(xnn_status_success, xnn_get_runtime_memory_plan_info(runtime, &arena_size, &lower_bound));
+    EXPECT_NE(0, lower_bound);
+    EXPECT_GE(arena_size, lower_bound);
+    EXPECT_GE(runtime->workspace->size, arena_size);
+    tester.SetupRuntimeV2();
+    ASSERT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+  }
+
+  EXPECT_EQ(xnn_status_invalid_parameter,
+            xnn_set_runtime_memory_planner(runtime, static_cast<xnn_memory_planner_strategy>(-1)));
+}
+
 } // namespace xnnpack
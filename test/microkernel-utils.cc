@@ -63,6 +63,61 @@ TEST(GEMM_BEST_NC, min_tiles_per_thread) {
   }
 }
 
+TEST(GEMM_BEST_KC, no_blocking_if_panel_fits) {
+  const size_t l2_cache_bytes = 1024 * 1024;
+  EXPECT_EQ(64, xnn_gemm_best_kc(64, 16, 1, 2, l2_cache_bytes));
+  EXPECT_EQ(2048, xnn_gemm_best_kc(2048, 16, 1, 2, l2_cache_bytes));
+  // Unknown cache size.
+  EXPECT_EQ(16384, xnn_gemm_best_kc(16384, 16, 1, 2, 0));
+}
+
+TEST(GEMM_BEST_KC, balanced_blocks) {
+  xnnpack::ReplicableRandomDevice rnd;
+  std::uniform_int_distribution<size_t> rnd_nr(1, 8);
+  std::uniform_int_distribution<size_t> rnd_kr_sr(0, 3);
+  std::uniform_int_distribution<size_t> rnd_k(1, 65536);
+  const size_t l2_cache_bytes = 1024 * 1024;
+
+  for (size_t trial = 0; trial < 1000; trial++) {
+    const size_t nr = 8 * rnd_nr(rnd);
+    const size_t kr_sr = size_t(1) << rnd_kr_sr(rnd);
+    const size_t k = round_up_po2(rnd_k(rnd), kr_sr);
+    const size_t kc = xnn_gemm_best_kc(k, nr, kr_sr, 2, l2_cache_bytes);
+    if (kc == k) {
+      continue;
+    }
+
+    EXPECT_EQ(0, kc % kr_sr);
+    // A panel of the block fits in half of L2.
+    EXPECT_LE(XNN_GEMM_K_BLOCK_MIN_NR_TILES * nr * kc * sizeof(float), l2_cache_bytes / 2)
+        << "k=" << k << ", nr=" << nr << ", kc=" << kc;
+    // The last block is not much smaller than the others.
+    const size_t num_blocks = divide_round_up(k, kc);
+    EXPECT_LE(kc * (num_blocks - 1), k);
+    EXPECT_GE(k - kc * (num_blocks - 1) + num_blocks * kr_sr, kc)
+        << "k=" << k << ", nr=" << nr << ", kc=" << kc;
+  }
+}
+
+TEST(GEMM_K_BLOCKED_TILE, panel_fits_in_l2) {
+  const size_t l2_cache_bytes = 1024 * 1024;
+  for (size_t num_threads : {1, 2, 4, 16}) {
+    for (size_t m : {1, 7, 64, 1000}) {
+      size_t mc = 0;
+      size_t nc = 0;
+      xnn_gemm_k_blocked_tile(m, 4096, 6, 16, 2048, 2, l2_cache_bytes, num_threads, &mc, &nc);
+      EXPECT_EQ(0, mc % 6);
+      EXPECT_GE(mc, 6);
+      EXPECT_EQ(0, nc % 16);
+      EXPECT_LE(nc * 2048 * sizeof(float), l2_cache_bytes / 2);
+      if (num_threads == 1) {
+        // A single tile of rows reuses each panel for all of them.
+        EXPECT_GE(mc, m);
+      }
+    }
+  }
+}
+
 TEST(MULTIPASS_DWCONV_WEIGHTS_COUNT, channels_le_channel_tile) {
   ASSERT_EQ((1 + 1) * 4, xnn_dwconv_multipass_weights_size(1, 1, 8, 4, 4, 1, 0, 0));
   ASSERT_EQ((1 + 1) * 4, xnn_dwconv_multipass_weights_size(1, 2, 8, 4, 4, 1, 0, 0));
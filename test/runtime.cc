@@ -1,9 +1,92 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "xnnpack.h"
+#include "xnnpack/subgraph.h"
+#include "replicable_random_device.h"
+#include "runtime-flags.h"
 #include "runtime-tester.h"
+#include "pthreadpool.h"
+
+namespace {
+
+// input -> abs ------> add -> add -> output
+//       -> neg ----/       /
+//       -> square -> add -/
+//       -> hardswish -/
+void DefineBranchyGraph(xnn_subgraph_t* subgraph, std::array<size_t, 4> dims) {
+  ASSERT_EQ(xnn_status_success, xnn_create_subgraph(/*external_value_ids=*/2, /*flags=*/0, subgraph));
+  uint32_t input_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(xnn_status_success,
+            xnn_define_tensor_value(*subgraph, xnn_datatype_fp32, dims.size(), dims.data(), nullptr, 0,
+                                    XNN_VALUE_FLAG_EXTERNAL_INPUT, &input_id));
+  uint32_t output_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(xnn_status_success,
+            xnn_define_tensor_value(*subgraph, xnn_datatype_fp32, dims.size(), dims.data(), nullptr, 1,
+                                    XNN_VALUE_FLAG_EXTERNAL_OUTPUT, &output_id));
+  std::array<uint32_t, 6> internal_ids;
+  for (uint32_t& id : internal_ids) {
+    ASSERT_EQ(xnn_status_success,
+              xnn_define_tensor_value(*subgraph, xnn_datatype_fp32, dims.size(), dims.data(), nullptr,
+                                      XNN_INVALID_VALUE_ID, /*flags=*/0, &id));
+  }
+  const std::array<xnn_unary_operator, 4> branches = {xnn_unary_abs, xnn_unary_negate, xnn_unary_square,
+                                                      xnn_unary_hardswish};
+  for (size_t i = 0; i < branches.size(); i++) {
+    ASSERT_EQ(xnn_status_success,
+              xnn_define_unary(*subgraph, branches[i], /*params=*/nullptr, input_id, internal_ids[i], /*flags=*/0));
+  }
+  ASSERT_EQ(xnn_status_success, xnn_define_binary(*subgraph, xnn_binary_add, /*params=*/nullptr, internal_ids[0],
+                                                  internal_ids[1], internal_ids[4], /*flags=*/0));
+  ASSERT_EQ(xnn_status_success, xnn_define_binary(*subgraph, xnn_binary_add, /*params=*/nullptr, internal_ids[2],
+                                                  internal_ids[3], internal_ids[5], /*flags=*/0));
+  ASSERT_EQ(xnn_status_success, xnn_define_binary(*subgraph, xnn_binary_add, /*params=*/nullptr, internal_ids[4],
+                                                  internal_ids[5], output_id, /*flags=*/0));
+}
+
+// input -> max pooling 3x3 -> hardswish -> add -> output
+//       \-----------------------------------/
+void DefinePoolingGraph(xnn_subgraph_t* subgraph) {
+  ASSERT_EQ(xnn_status_success, xnn_create_subgraph(/*external_value_ids=*/2, /*flags=*/0, subgraph));
+  const std::array<size_t, 4> dims = {1, 1, 1, 3};
+  uint32_t input_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(xnn_status_success,
+            xnn_define_tensor_value(*subgraph, xnn_datatype_fp32, dims.size(), dims.data(), nullptr, 0,
+                                    XNN_VALUE_FLAG_EXTERNAL_INPUT, &input_id));
+  uint32_t output_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(xnn_status_success,
+            xnn_define_tensor_value(*subgraph, xnn_datatype_fp32, dims.size(), dims.data(), nullptr, 1,
+                                    XNN_VALUE_FLAG_EXTERNAL_OUTPUT, &output_id));
+  std::array<uint32_t, 2> internal_ids;
+  for (uint32_t& id : internal_ids) {
+    ASSERT_EQ(xnn_status_success,
+              xnn_define_tensor_value(*subgraph, xnn_datatype_fp32, dims.size(), dims.data(), nullptr,
+                                      XNN_INVALID_VALUE_ID, /*flags=*/0, &id));
+  }
+  ASSERT_EQ(xnn_status_success,
+            xnn_define_max_pooling_2d(*subgraph, /*input_padding_top=*/1, /*input_padding_right=*/1,
+                                      /*input_padding_bottom=*/1, /*input_padding_left=*/1, /*pooling_height=*/3,
+                                      /*pooling_width=*/3, /*stride_height=*/1, /*stride_width=*/1,
+                                      /*dilation_height=*/1, /*dilation_width=*/1, -INFINITY, INFINITY, input_id,
+                                      internal_ids[0], /*flags=*/0));
+  ASSERT_EQ(xnn_status_success, xnn_define_unary(*subgraph, xnn_unary_hardswish, /*params=*/nullptr,
+                                                 internal_ids[0], internal_ids[1], /*flags=*/0));
+  ASSERT_EQ(xnn_status_success, xnn_define_binary(*subgraph, xnn_binary_add, /*params=*/nullptr, internal_ids[1],
+                                                  input_id, output_id, /*flags=*/0));
+}
+
+}  // namespace
 
 TEST(RUNTIME, reshape_runtime) {
   xnnpack::RuntimeTester tester(4);
@@ -60,3 +143,251 @@ TEST(RUNTIME, reshape_runtime) {
   }
   ASSERT_EQ(expected, output);
 }
+
+TEST(RUNTIME, inter_op_parallelism) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  std::array<size_t, 4> dims = {2, 17, 19, 5};
+  const size_t num_elements = dims[0] * dims[1] * dims[2] * dims[3];
+  xnnpack::ReplicableRandomDevice rng;
+  std::uniform_real_distribution<float> f32dist(-10.0f, 10.0f);
+  std::vector<float> input(num_elements + XNN_EXTRA_BYTES / sizeof(float));
+  std::generate(input.begin(), input.end(), [&]() { return f32dist(rng); });
+  std::vector<float> expected(num_elements);
+  std::vector<float> output(num_elements);
+
+  // With 2 threads, concurrent operators run without a thread pool. With 8 threads, they get thread pools of their own.
+  for (size_t num_threads : {2, 8}) {
+    std::unique_ptr<pthreadpool, decltype(&pthreadpool_destroy)> threadpool(
+      pthreadpool_create(num_threads), pthreadpool_destroy);
+    ASSERT_NE(nullptr, threadpool);
+
+    for (uint32_t flags : {0u, (uint32_t) (XNN_FLAG_INTER_OP_PARALLELISM | XNN_FLAG_BASIC_PROFILING)}) {
+      xnn_subgraph_t subgraph = nullptr;
+      DefineBranchyGraph(&subgraph, dims);
+      std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> auto_subgraph(subgraph, xnn_delete_subgraph);
+      xnn_runtime_t runtime = nullptr;
+      // Without fusion, so that the unary operators and the additions remain separate operators.
+      ASSERT_EQ(xnn_status_success,
+                xnn_create_runtime_v3(subgraph, nullptr, threadpool.get(),
+                                      flags | XNN_FLAG_NO_OPERATOR_FUSION | xnn_test_runtime_flags(), &runtime));
+      std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> auto_runtime(runtime, xnn_delete_runtime);
+      ASSERT_EQ(xnn_status_success, xnn_reshape_runtime(runtime));
+      std::vector<float>& result = flags == 0 ? expected : output;
+      const std::array<xnn_external_value, 2> external = {
+        xnn_external_value{0, input.data()}, xnn_external_value{1, result.data()}};
+      ASSERT_EQ(xnn_status_success, xnn_setup_runtime_v2(runtime, external.size(), external.data()));
+      ASSERT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+      if (flags == 0) {
+        EXPECT_EQ(0, runtime->num_stages);
+        continue;
+      }
+
+      // The four unary operators and the two first additions run concurrently.
+      ASSERT_EQ(3, runtime->num_stages);
+      EXPECT_EQ(4, runtime->stages[0].num_ops);
+      EXPECT_EQ(2, runtime->stages[1].num_ops);
+      EXPECT_EQ(1, runtime->stages[2].num_ops);
+      for (size_t i = 0; i < runtime->stages[0].num_ops; i++) {
+        for (size_t j = 0; j < i; j++) {
+          const xnn_value* a = &runtime->values[runtime->opdata[runtime->stage_ops[i]].outputs[0]];
+          const xnn_value* b = &runtime->values[runtime->opdata[runtime->stage_ops[j]].outputs[0]];
+          EXPECT_TRUE((uintptr_t) a->data + a->size <= (uintptr_t) b->data ||
+                      (uintptr_t) b->data + b->size <= (uintptr_t) a->data);
+        }
+      }
+
+      size_t num_operators = 0;
+      size_t required_size = 0;
+      ASSERT_EQ(xnn_status_success, xnn_get_runtime_profiling_info(runtime, xnn_profile_info_num_operators,
+                                                                   sizeof(num_operators), &num_operators,
+                                                                   &required_size));
+      EXPECT_EQ(7, num_operators);
+      std::vector<uint64_t> timing(num_operators);
+      ASSERT_EQ(xnn_status_success, xnn_get_runtime_profiling_info(runtime, xnn_profile_info_operator_timing,
+                                                                   timing.size() * sizeof(uint64_t), timing.data(),
+                                                                   &required_size));
+    }
+    EXPECT_EQ(expected, output);
+  }
+}
+
+TEST(RUNTIME, hardware_counter_profiling) {
+  // ---input--> (Fully Connected) ---fc_out--> (Abs) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t filter_id = 1;
+  const uint32_t bias_id = 2;
+  const uint32_t fc_out = 3;
+  const uint32_t output_id = 4;
+  xnnpack::RuntimeTester tester(5);
+  tester.AddInputTensorF32({4, 16}, input_id)
+      .AddStaticTensorF32({8, 16}, xnnpack::TensorType::kDense, filter_id)
+      .AddStaticTensorF32({8}, xnnpack::TensorType::kDense, bias_id)
+      .AddDynamicTensorF32({4, 8}, fc_out)
+      .AddOutputTensorF32({4, 8}, output_id)
+      .AddFullyConnected(input_id, filter_id, bias_id, fc_out)
+      .AddUnary(xnn_unary_abs, nullptr, fc_out, output_id);
+  tester.CreateRuntime(XNN_FLAG_HARDWARE_COUNTER_PROFILING | XNN_FLAG_NO_OPERATOR_FUSION | xnn_test_runtime_flags());
+  tester.SetupRuntime();
+  xnn_runtime_t runtime = tester.Runtime();
+  ASSERT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+
+  size_t num_operators = 0;
+  size_t required_size = 0;
+  ASSERT_EQ(xnn_status_success, xnn_get_runtime_profiling_info(runtime, xnn_profile_info_num_operators,
+                                                               sizeof(num_operators), &num_operators, &required_size));
+  ASSERT_EQ(2, num_operators);
+
+  // Estimates only depend on the shapes.
+  std::vector<uint64_t> flops(num_operators);
+  ASSERT_EQ(xnn_status_success, xnn_get_runtime_profiling_info(runtime, xnn_profile_info_operator_flops,
+                                                               flops.size() * sizeof(uint64_t), flops.data(),
+                                                               &required_size));
+  EXPECT_EQ(2 * 4 * 8 * 16, flops[0]);
+  EXPECT_EQ(4 * 8, flops[1]);
+  std::vector<uint64_t> bytes(num_operators);
+  ASSERT_EQ(xnn_status_success, xnn_get_runtime_profiling_info(runtime, xnn_profile_info_operator_bytes,
+                                                               bytes.size() * sizeof(uint64_t), bytes.data(),
+                                                               &required_size));
+  EXPECT_EQ((4 * 16 + 8 * 16 + 8 + 4 * 8) * sizeof(float), bytes[0]);
+  EXPECT_EQ((4 * 8 + 4 * 8) * sizeof(float), bytes[1]);
+
+  // Counters are not available in all environments, e.g. in containers that do not permit perf_event_open.
+  std::vector<uint64_t> instructions(num_operators);
+  const xnn_status status = xnn_get_runtime_profiling_info(runtime, xnn_profile_info_operator_instructions,
+                                                           instructions.size() * sizeof(uint64_t),
+                                                           instructions.data(), &required_size);
+  if (status == xnn_status_unsupported_hardware) {
+    GTEST_SKIP() << "hardware performance counters are not available";
+  }
+  ASSERT_EQ(xnn_status_success, status);
+  std::vector<uint64_t> cycles(num_operators);
+  ASSERT_EQ(xnn_status_success, xnn_get_runtime_profiling_info(runtime, xnn_profile_info_operator_cycles,
+                                                               cycles.size() * sizeof(uint64_t), cycles.data(),
+                                                               &required_size));
+  for (size_t i = 0; i < num_operators; i++) {
+    EXPECT_NE(0, cycles[i] + instructions[i]);
+  }
+}
+
+TEST(RUNTIME, parallel_tracing) {
+  // ---input--> (Fully Connected) ---output-->
+  const uint32_t input_id = 0;
+  const uint32_t filter_id = 1;
+  const uint32_t output_id = 2;
+  xnnpack::RuntimeTester tester(3);
+  tester.AddInputTensorF32({4, 16}, input_id)
+      .AddStaticTensorF32({8, 16}, xnnpack::TensorType::kDense, filter_id)
+      .AddOutputTensorF32({4, 8}, output_id)
+      .AddFullyConnected(input_id, filter_id, XNN_INVALID_VALUE_ID, output_id);
+  tester.CreateRuntime(XNN_FLAG_PARALLEL_TRACING | xnn_test_runtime_flags());
+  tester.SetupRuntime();
+  xnn_runtime_t runtime = tester.Runtime();
+  ASSERT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+  ASSERT_EQ(1, runtime->trace.num_events);
+  const xnn_trace_event& event = runtime->trace.events[0];
+  size_t num_tiles = 0;
+  for (size_t i = 0; i < event.num_spans; i++) {
+    num_tiles += event.spans[i].num_tiles;
+    EXPECT_LE(event.spans[i].busy_ns, event.spans[i].end_ns - event.spans[i].start_ns);
+  }
+  EXPECT_EQ(event.num_tiles, num_tiles);
+
+  const std::string filename = testing::TempDir() + "runtime_trace.json";
+  ASSERT_EQ(xnn_status_success, xnn_write_runtime_trace(runtime, filename.c_str()));
+  EXPECT_EQ(0, runtime->trace.num_events);
+  std::ifstream file(filename);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  std::remove(filename.c_str());
+  EXPECT_NE(std::string::npos, contents.str().find("\"traceEvents\""));
+  EXPECT_NE(std::string::npos, contents.str().find("\"Fully Connected (NC, F32)\""));
+  EXPECT_NE(std::string::npos, contents.str().find("\"busy_us\""));
+}
+
+TEST(RUNTIME, parallel_tracing_requires_flag) {
+  const uint32_t input_id = 0;
+  const uint32_t output_id = 1;
+  xnnpack::RuntimeTester tester(2);
+  tester.AddInputTensorF32({4, 8}, input_id)
+      .AddOutputTensorF32({4, 8}, output_id)
+      .AddUnary(xnn_unary_abs, nullptr, input_id, output_id);
+  tester.CreateRuntime(xnn_test_runtime_flags());
+  EXPECT_EQ(xnn_status_invalid_state,
+            xnn_write_runtime_trace(tester.Runtime(), (testing::TempDir() + "runtime_trace.json").c_str()));
+}
+
+TEST(RUNTIME, reshape_cache) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  xnnpack::ReplicableRandomDevice rng;
+  std::uniform_real_distribution<float> f32dist(-10.0f, 10.0f);
+
+  for (xnn_reshape_cache_eviction_policy policy :
+       {xnn_reshape_cache_eviction_policy_lru, xnn_reshape_cache_eviction_policy_fifo}) {
+    xnn_subgraph_t subgraph = nullptr;
+    DefinePoolingGraph(&subgraph);
+    std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> auto_subgraph(subgraph, xnn_delete_subgraph);
+    xnn_runtime_t reference_runtime = nullptr;
+    ASSERT_EQ(xnn_status_success,
+              xnn_create_runtime_v3(subgraph, nullptr, nullptr, xnn_test_runtime_flags(), &reference_runtime));
+    std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> auto_reference_runtime(reference_runtime,
+                                                                                       xnn_delete_runtime);
+    xnn_runtime_t runtime = nullptr;
+    ASSERT_EQ(xnn_status_success, xnn_create_runtime_v3(subgraph, nullptr, nullptr, xnn_test_runtime_flags(), &runtime));
+    std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> auto_runtime(runtime, xnn_delete_runtime);
+    ASSERT_EQ(xnn_status_success, xnn_set_runtime_reshape_cache(runtime, /*max_entries=*/2, policy));
+
+    // With 2 entries, LRU evicts B when C is inserted after A is used again, and FIFO evicts A.
+    const std::array<size_t, 4> a = {1, 5, 7, 3};
+    const std::array<size_t, 4> b = {2, 9, 4, 3};
+    const std::array<size_t, 4> c = {1, 3, 3, 3};
+    const std::vector<std::array<size_t, 4>> shapes = {a, b, a, c, a, b};
+    const std::vector<bool> lru_hits = {false, false, true, false, true, false};
+    const std::vector<bool> fifo_hits = {false, false, true, false, false, false};
+    const std::vector<bool>& expected_hits = policy == xnn_reshape_cache_eviction_policy_lru ? lru_hits : fifo_hits;
+    for (size_t i = 0; i < shapes.size(); i++) {
+      const std::array<size_t, 4>& dims = shapes[i];
+      const size_t num_elements = dims[0] * dims[1] * dims[2] * dims[3];
+      std::vector<float> input(num_elements + XNN_EXTRA_BYTES / sizeof(float));
+      std::generate(input.begin(), input.end(), [&]() { return f32dist(rng); });
+      std::vector<float> expected(num_elements);
+      std::vector<float> output(num_elements);
+
+      const size_t hits = runtime->reshape_cache.hits;
+      for (xnn_runtime_t r : {reference_runtime, runtime}) {
+        ASSERT_EQ(xnn_status_success, xnn_reshape_external_value(r, 0, dims.size(), dims.data()));
+        ASSERT_EQ(xnn_status_success, xnn_reshape_runtime(r));
+        std::vector<float>& result = r == runtime ? output : expected;
+        const std::array<xnn_external_value, 2> external = {
+          xnn_external_value{0, input.data()}, xnn_external_value{1, result.data()}};
+        ASSERT_EQ(xnn_status_success, xnn_setup_runtime_v2(r, external.size(), external.data()));
+        ASSERT_EQ(xnn_status_success, xnn_invoke_runtime(r));
+      }
+      EXPECT_EQ(expected_hits[i], runtime->reshape_cache.hits != hits) << "reshape " << i;
+      EXPECT_EQ(expected, output) << "reshape " << i;
+
+      size_t num_dims = 0;
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> output_dims;
+      ASSERT_EQ(xnn_status_success, xnn_get_external_value_shape(runtime, 1, &num_dims, output_dims.data()));
+      ASSERT_EQ(dims.size(), num_dims);
+      EXPECT_TRUE(std::equal(dims.begin(), dims.end(), output_dims.begin()));
+    }
+    EXPECT_EQ(2, runtime->reshape_cache.num_entries);
+
+    // The max pooling operator owns an indirection buffer, so it is reshaped even when the shapes are cached.
+    const xnn_reshape_cache_entry* entry = &runtime->reshape_cache.entries[0];
+    size_t num_restorable = 0;
+    for (size_t i = 0; i < runtime->num_ops; i++) {
+      if (runtime->opdata[i].operator_objects[0] == nullptr) {
+        continue;
+      }
+      const bool is_pooling = runtime->opdata[i].type == xnn_node_type_max_pooling_2d;
+      EXPECT_EQ(is_pooling, entry->first_operator[i] == SIZE_MAX);
+      num_restorable += entry->first_operator[i] != SIZE_MAX;
+    }
+    EXPECT_NE(0, num_restorable);
+
+    // Disabling the cache releases the entries.
+    ASSERT_EQ(xnn_status_success, xnn_set_runtime_reshape_cache(runtime, 0, policy));
+    EXPECT_EQ(0, runtime->reshape_cache.num_entries);
+  }
+}
@@ -167,6 +167,44 @@ TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F16, multi_head_cross_attention_multithre
       .TestF16();
 }
 
+TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F16, online_softmax_self_attention) {
+  ScaledDotProductAttentionOperatorTester()
+      .query_tokens(19)
+      .key_value_tokens(1031)
+      .query_key_channels(37)
+      .value_channels(23)
+      .flags(XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+      .TestF16();
+}
+
+TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F16, online_softmax_multi_query_with_cap) {
+  ScaledDotProductAttentionOperatorTester()
+      .batch_size(2)
+      .query_heads(3)
+      .key_value_heads(1)
+      .query_tokens(7)
+      .key_value_tokens(1024)
+      .query_key_channels(16)
+      .value_channels(29)
+      .cap_tanh(30.0f)
+      .flags(XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+      .TestF16();
+}
+
+TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F16, online_softmax_multi_head_multithreaded) {
+  ScaledDotProductAttentionOperatorTester()
+      .batch_size(3)
+      .query_heads(5)
+      .key_value_heads(5)
+      .query_tokens(11)
+      .key_value_tokens(777)
+      .query_key_channels(19)
+      .value_channels(13)
+      .multithreaded(true)
+      .flags(XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+      .TestF16();
+}
+
 TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F32, unit_batch) {
   ScaledDotProductAttentionOperatorTester()
       .batch_size(1)
@@ -333,3 +371,41 @@ TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F32, multi_head_cross_attention_multithre
       .multithreaded(true)
       .TestF32();
 }
+
+TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F32, online_softmax_self_attention) {
+  ScaledDotProductAttentionOperatorTester()
+      .query_tokens(19)
+      .key_value_tokens(1031)
+      .query_key_channels(37)
+      .value_channels(23)
+      .flags(XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+      .TestF32();
+}
+
+TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F32, online_softmax_multi_query_with_cap) {
+  ScaledDotProductAttentionOperatorTester()
+      .batch_size(2)
+      .query_heads(3)
+      .key_value_heads(1)
+      .query_tokens(7)
+      .key_value_tokens(1024)
+      .query_key_channels(16)
+      .value_channels(29)
+      .cap_tanh(30.0f)
+      .flags(XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+      .TestF32();
+}
+
+TEST(SCALED_DOT_PRODUCT_ATTENTION_NHTC_F32, online_softmax_multi_head_multithreaded) {
+  ScaledDotProductAttentionOperatorTester()
+      .batch_size(3)
+      .query_heads(5)
+      .key_value_heads(5)
+      .query_tokens(11)
+      .key_value_tokens(777)
+      .query_key_channels(19)
+      .value_channels(13)
+      .multithreaded(true)
+      .flags(XNN_FLAG_ATTENTION_ONLINE_SOFTMAX)
+      .TestF32();
+}
@@ -129,6 +129,15 @@ class ScaledDotProductAttentionOperatorTester {
     return this->iterations_;
   }
 
+  ScaledDotProductAttentionOperatorTester& flags(uint32_t flags) {
+    this->flags_ = flags;
+    return *this;
+  }
+
+  uint32_t flags() const {
+    return this->flags_;
+  }
+
   void TestF16() const {
     xnnpack::ReplicableRandomDevice rng;
     std::uniform_real_distribution<float> f32dist(0.1, 1.0f);
@@ -241,7 +250,7 @@ class ScaledDotProductAttentionOperatorTester {
       const xnn_status status = xnn_create_scaled_dot_product_attention_nhtc_f16(
           cap_type(),
           &cap_tanh_params,
-          /*flags=*/0,
+          flags(),
           &attention_op);
 
       if (status == xnn_status_unsupported_hardware) {
@@ -399,7 +408,7 @@ class ScaledDotProductAttentionOperatorTester {
       const xnn_status status = xnn_create_scaled_dot_product_attention_nhtc_f32(
           cap_type(),
           &cap_tanh_params,
-          /*flags=*/0,
+          flags(),
           &attention_op);
 
       if (status == xnn_status_unsupported_hardware) {
@@ -463,4 +472,5 @@ class ScaledDotProductAttentionOperatorTester {
   size_t key_value_tokens_{0};
   bool multithreaded_{false};
   size_t iterations_{1};
+  uint32_t flags_{0};
 };
@@ -978,6 +978,258 @@ TEST_F(ScaledDotProductAttentionTestF32, matches_operator_api_dynamic_shape_requ
   }
 }
 
+TEST_F(ScaledDotProductAttentionTestF32, kv_cache_decode_matches_operator_api)
+{
+  /*
+   * This test runs a prefill step followed by single token decoding steps through a subgraph with a key/value cache,
+   * and checks that every step matches the operator API computing attention over the whole key/value history.
+   */
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+
+  const size_t N = 2;           // batch size
+  const size_t H = 3;           // num heads
+  const size_t C = 5;           // channels
+  const size_t D = 7;           // value channels
+  const size_t prefill = 4;     // tokens in the first step
+  const size_t max_tokens = 9;  // cache capacity
+
+  for (const bool multi_query : {false, true}) {
+    const size_t K = multi_query ? 1 : H;  // key/value heads
+    std::vector<size_t> query_dims = {N, H, prefill, C};
+    std::vector<size_t> key_dims = {N, K, prefill, C};
+    std::vector<size_t> value_dims = {N, K, prefill, D};
+    std::vector<size_t> key_cache_dims = {N, K, max_tokens, C};
+    std::vector<size_t> value_cache_dims = {N, K, max_tokens, D};
+    if (multi_query) {
+      key_dims.erase(key_dims.begin() + 1);
+      value_dims.erase(value_dims.begin() + 1);
+      key_cache_dims.erase(key_cache_dims.begin() + 1);
+      value_cache_dims.erase(value_cache_dims.begin() + 1);
+    }
+    std::vector<size_t> scale_dims = {C};
+    std::vector<size_t> mask_dims = {prefill, prefill};
+    std::vector<size_t> output_dims = {N, H, prefill, D};
+
+    xnn_subgraph_t subgraph = nullptr;
+    ASSERT_EQ(xnn_status_success, xnn_create_subgraph(6, /*flags=*/0, &subgraph));
+    std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> auto_subgraph(subgraph, xnn_delete_subgraph);
+
+    uint32_t query_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, query_dims.size(), query_dims.data(), nullptr, /*external_id=*/0,
+        XNN_VALUE_FLAG_EXTERNAL_INPUT, &query_id));
+    uint32_t key_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, key_dims.size(), key_dims.data(), nullptr, /*external_id=*/1,
+        XNN_VALUE_FLAG_EXTERNAL_INPUT, &key_id));
+    uint32_t value_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, value_dims.size(), value_dims.data(), nullptr, /*external_id=*/2,
+        XNN_VALUE_FLAG_EXTERNAL_INPUT, &value_id));
+    uint32_t scale_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, scale_dims.size(), scale_dims.data(), nullptr, /*external_id=*/3,
+        XNN_VALUE_FLAG_EXTERNAL_INPUT, &scale_id));
+    uint32_t mask_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, mask_dims.size(), mask_dims.data(), nullptr, /*external_id=*/4,
+        XNN_VALUE_FLAG_EXTERNAL_INPUT, &mask_id));
+    uint32_t output_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, output_dims.size(), output_dims.data(), nullptr, /*external_id=*/5,
+        XNN_VALUE_FLAG_EXTERNAL_OUTPUT, &output_id));
+    uint32_t key_cache_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, key_cache_dims.size(), key_cache_dims.data(), nullptr,
+        XNN_INVALID_VALUE_ID, XNN_VALUE_FLAG_PERSISTENT, &key_cache_id));
+    uint32_t value_cache_id = XNN_INVALID_VALUE_ID;
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, value_cache_dims.size(), value_cache_dims.data(), nullptr,
+        XNN_INVALID_VALUE_ID, XNN_VALUE_FLAG_PERSISTENT, &value_cache_id));
+
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_scaled_dot_product_attention_with_kv_cache(
+        subgraph, xnn_attention_logits_cap_type_none, &cap_params, query_id, key_id, value_id, scale_id, mask_id,
+        key_cache_id, value_cache_id, output_id, /*flags=*/0));
+    ASSERT_EQ(subgraph->num_nodes, 1);
+    ASSERT_EQ(subgraph->nodes[0].num_outputs, 3);
+
+    xnn_runtime_t runtime = nullptr;
+    ASSERT_EQ(
+      xnn_status_success, xnn_create_runtime_v3(subgraph, nullptr, nullptr, xnn_test_runtime_flags(), &runtime));
+    ASSERT_NE(nullptr, runtime);
+    std::unique_ptr<xnn_runtime, decltype(&xnn_delete_runtime)> auto_runtime(runtime, xnn_delete_runtime);
+
+    scale.resize(XNN_EXTRA_BYTES / sizeof(float) + C);
+    std::generate(scale.begin(), scale.end(), [&]() { return f32dist(rng); });
+
+    // Key/value history as [N * K, tokens, C/D], used as input of the operator API.
+    std::vector<std::vector<float>> key_history(N * K);
+    std::vector<std::vector<float>> value_history(N * K);
+
+    size_t valid_tokens = 0;
+    for (size_t new_tokens = prefill; valid_tokens + new_tokens <= max_tokens; new_tokens = 1) {
+      valid_tokens += new_tokens;
+      const size_t query_tokens = new_tokens;
+
+      query_dims[2] = query_tokens;
+      key_dims[key_dims.size() - 2] = new_tokens;
+      value_dims[value_dims.size() - 2] = new_tokens;
+      mask_dims = {query_tokens, valid_tokens};
+      output_dims[2] = query_tokens;
+
+      query.resize(XNN_EXTRA_BYTES / sizeof(float) + NumElements(query_dims));
+      key.resize(XNN_EXTRA_BYTES / sizeof(float) + NumElements(key_dims));
+      value.resize(XNN_EXTRA_BYTES / sizeof(float) + NumElements(value_dims));
+      mask.resize(XNN_EXTRA_BYTES / sizeof(float) + NumElements(mask_dims));
+      subgraph_output.resize(NumElements(output_dims));
+      operator_output.resize(NumElements(output_dims));
+      std::generate(query.begin(), query.end(), [&]() { return f32dist(rng); });
+      std::generate(key.begin(), key.end(), [&]() { return f32dist(rng); });
+      std::generate(value.begin(), value.end(), [&]() { return f32dist(rng); });
+      std::generate(mask.begin(), mask.end(), [&]() { return f32dist(rng); });
+
+      for (size_t i = 0; i < N * K; i++) {
+        key_history[i].insert(
+          key_history[i].end(), key.begin() + i * new_tokens * C, key.begin() + (i + 1) * new_tokens * C);
+        value_history[i].insert(
+          value_history[i].end(), value.begin() + i * new_tokens * D, value.begin() + (i + 1) * new_tokens * D);
+      }
+      std::vector<float> full_key(XNN_EXTRA_BYTES / sizeof(float));
+      std::vector<float> full_value(XNN_EXTRA_BYTES / sizeof(float));
+      for (size_t i = 0; i < N * K; i++) {
+        full_key.insert(full_key.end() - XNN_EXTRA_BYTES / sizeof(float), key_history[i].begin(), key_history[i].end());
+        full_value.insert(
+          full_value.end() - XNN_EXTRA_BYTES / sizeof(float), value_history[i].begin(), value_history[i].end());
+      }
+
+      // Call operator API over the whole history.
+      xnn_operator_t op = nullptr;
+      ASSERT_EQ(
+        xnn_status_success,
+        xnn_create_scaled_dot_product_attention_nhtc_f32(
+          xnn_attention_logits_cap_type_none, &cap_params, /*flags=*/0, &op));
+      std::unique_ptr<xnn_operator, decltype(&xnn_delete_operator)> auto_op(op, xnn_delete_operator);
+      size_t workspace_size = 0;
+      size_t workspace_alignment = 0;
+      ASSERT_EQ(
+        xnn_status_success,
+        xnn_reshape_scaled_dot_product_attention_nhtc_f32(
+          op, N, H, query_tokens, K, valid_tokens, C, D, &workspace_size, &workspace_alignment,
+          /*threadpool=*/nullptr));
+      std::vector<char, AlignedAllocator<char, XNN_ALLOCATION_ALIGNMENT>> workspace(workspace_size);
+      ASSERT_EQ(
+        xnn_status_success,
+        xnn_setup_scaled_dot_product_attention_nhtc_f32(
+          op, workspace.data(), query.data(), full_key.data(), full_value.data(), scale.data(), mask.data(),
+          operator_output.data()));
+      ASSERT_EQ(xnn_status_success, xnn_run_operator(op, /*threadpool=*/nullptr));
+
+      // Call subgraph API with only the new tokens.
+      ASSERT_EQ(
+        xnn_status_success, xnn_reshape_external_value(runtime, query_id, query_dims.size(), query_dims.data()));
+      ASSERT_EQ(xnn_status_success, xnn_reshape_external_value(runtime, key_id, key_dims.size(), key_dims.data()));
+      ASSERT_EQ(
+        xnn_status_success, xnn_reshape_external_value(runtime, value_id, value_dims.size(), value_dims.data()));
+      ASSERT_EQ(xnn_status_success, xnn_reshape_external_value(runtime, mask_id, mask_dims.size(), mask_dims.data()));
+      ASSERT_EQ(
+        xnn_status_success, xnn_reshape_external_value(runtime, output_id, output_dims.size(), output_dims.data()));
+      ASSERT_EQ(xnn_status_success, xnn_reshape_runtime(runtime));
+      std::array<xnn_external_value, 6> external = {
+        xnn_external_value{query_id, query.data()}, xnn_external_value{key_id, key.data()},
+        xnn_external_value{value_id, value.data()}, xnn_external_value{scale_id, scale.data()},
+        xnn_external_value{mask_id, mask.data()},   xnn_external_value{output_id, subgraph_output.data()}};
+      ASSERT_EQ(xnn_status_success, xnn_setup_runtime_v2(runtime, external.size(), external.data()));
+      ASSERT_EQ(xnn_status_success, xnn_invoke_runtime(runtime));
+
+      for (size_t i = 0; i < operator_output.size(); i++) {
+        ASSERT_NEAR(subgraph_output[i], operator_output[i],
+                    std::abs(operator_output[i]) * 5 * std::numeric_limits<float>::epsilon())
+            << "at offset " << i << " with " << valid_tokens << " valid tokens"
+            << (multi_query ? " (multi-query)" : "");
+      }
+    }
+    ASSERT_EQ(valid_tokens, max_tokens);
+  }
+}
+
+TEST_F(ScaledDotProductAttentionTestF32, kv_cache_must_be_persistent)
+{
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+
+  xnn_subgraph_t subgraph = nullptr;
+  ASSERT_EQ(xnn_status_success, xnn_create_subgraph(6, /*flags=*/0, &subgraph));
+  std::unique_ptr<xnn_subgraph, decltype(&xnn_delete_subgraph)> auto_subgraph(subgraph, xnn_delete_subgraph);
+
+  std::vector<size_t> query_dims = {1, 2, 1, 5};
+  std::vector<size_t> key_dims = {1, 2, 1, 5};
+  std::vector<size_t> cache_dims = {1, 2, 8, 5};
+  std::vector<size_t> scale_dims = {5};
+  std::vector<size_t> mask_dims = {1, 4};
+  std::vector<uint32_t> ids(5, XNN_INVALID_VALUE_ID);
+  const std::vector<size_t>* dims[5] = {&query_dims, &key_dims, &key_dims, &scale_dims, &mask_dims};
+  for (size_t i = 0; i < ids.size(); i++) {
+    ASSERT_EQ(
+      xnn_status_success,
+      xnn_define_tensor_value(
+        subgraph, xnn_datatype_fp32, dims[i]->size(), dims[i]->data(), nullptr, /*external_id=*/i,
+        XNN_VALUE_FLAG_EXTERNAL_INPUT, &ids[i]));
+  }
+  uint32_t output_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(
+    xnn_status_success,
+    xnn_define_tensor_value(
+      subgraph, xnn_datatype_fp32, query_dims.size(), query_dims.data(), nullptr, /*external_id=*/5,
+      XNN_VALUE_FLAG_EXTERNAL_OUTPUT, &output_id));
+  uint32_t internal_cache_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(
+    xnn_status_success,
+    xnn_define_tensor_value(
+      subgraph, xnn_datatype_fp32, cache_dims.size(), cache_dims.data(), nullptr, XNN_INVALID_VALUE_ID,
+      /*flags=*/0, &internal_cache_id));
+  uint32_t key_cache_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(
+    xnn_status_success,
+    xnn_define_tensor_value(
+      subgraph, xnn_datatype_fp32, cache_dims.size(), cache_dims.data(), nullptr, XNN_INVALID_VALUE_ID,
+      XNN_VALUE_FLAG_PERSISTENT, &key_cache_id));
+  uint32_t value_cache_id = XNN_INVALID_VALUE_ID;
+  ASSERT_EQ(
+    xnn_status_success,
+    xnn_define_tensor_value(
+      subgraph, xnn_datatype_fp32, cache_dims.size(), cache_dims.data(), nullptr, XNN_INVALID_VALUE_ID,
+      XNN_VALUE_FLAG_PERSISTENT, &value_cache_id));
+
+  EXPECT_EQ(
+    xnn_status_invalid_parameter,
+    xnn_define_scaled_dot_product_attention_with_kv_cache(
+      subgraph, xnn_attention_logits_cap_type_none, &cap_params, ids[0], ids[1], ids[2], ids[3], ids[4],
+      key_cache_id, internal_cache_id, output_id, /*flags=*/0));
+  EXPECT_EQ(
+    xnn_status_success,
+    xnn_define_scaled_dot_product_attention_with_kv_cache(
+      subgraph, xnn_attention_logits_cap_type_none, &cap_params, ids[0], ids[1], ids[2], ids[3], ids[4],
+      key_cache_id, value_cache_id, output_id, /*flags=*/0));
+}
+
+
 namespace {
 void DefineScaledDotProductAttentionSubgraph(
   xnn_status* status_out,
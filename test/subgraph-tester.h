@@ -543,6 +543,14 @@ class SubgraphTester {
     return *this;
   }
 
+  SubgraphTester& AddUnary(xnn_unary_operator op, const xnn_unary_params* params, uint32_t input_id,
+                           uint32_t output_id) {
+    const xnn_status status = xnn_define_unary(subgraph_.get(), op, params, input_id, output_id, /*flags=*/0);
+    EXPECT_EQ(status, xnn_status_success);
+
+    return *this;
+  }
+
   SubgraphTester& Optimize() {
     const xnn_status status = xnn_subgraph_optimize(subgraph_.get(), 0 /* flags */);
     EXPECT_EQ(status, xnn_status_success);
@@ -4,7 +4,9 @@
 // LICENSE file in the root directory of this source tree.
 
 #include <algorithm>  // For std::rotate.
+#include <cmath>      // For INFINITY.
 #include <cstdint>    // For uintptr_t.
+#include <cstdio>     // For std::remove.
 #include <cstring>    // For memcpy.
 #include <string>
 #include <thread>
@@ -366,3 +368,191 @@ TEST(WEIGHTS_CACHE, insert_into_finalized_cache_soft) {
 
   ASSERT_EQ(xnn_status_success, xnn_internal_release_weights_cache(&cache));
 }
+
+TEST(WEIGHTS_CACHE, look_up_by_source_key) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  struct xnn_internal_weights_cache cache;
+  ASSERT_EQ(xnn_status_success, xnn_internal_init_weights_cache_with_size(&cache, XNN_DEFAULT_WEIGHTS_BUFFER_SIZE));
+
+  const std::vector<char> source(64);
+  const std::vector<char> other(64);
+  struct xnn_weights_cache_look_up_key key;
+  key.seed = 42;
+  key.kernel = source.data() + 8;
+  key.bias = source.data() + 32;
+
+  // Keys are not recorded without a source buffer.
+  write_weights(&cache, "1234");
+  ASSERT_EQ(0, xnn_internal_get_or_insert_weights_cache(&cache, &key, cache.cache.weights.start, 4));
+  ASSERT_EQ(XNN_CACHE_NOT_FOUND, xnn_internal_weights_cache_look_up(&cache, &key));
+
+  ASSERT_EQ(xnn_status_success, xnn_internal_set_weights_cache_source(&cache, source.data(), source.size()));
+  void* span2_weights = cache_end(&cache);
+  write_weights(&cache, "5678");
+  ASSERT_EQ(4, xnn_internal_get_or_insert_weights_cache(&cache, &key, span2_weights, 4));
+  ASSERT_EQ(4, xnn_internal_weights_cache_look_up(&cache, &key));
+  ASSERT_EQ(1, cache.num_keys);
+
+  // Any part of the key that differs is a miss.
+  struct xnn_weights_cache_look_up_key other_key = key;
+  other_key.seed = 43;
+  ASSERT_EQ(XNN_CACHE_NOT_FOUND, xnn_internal_weights_cache_look_up(&cache, &other_key));
+  other_key = key;
+  other_key.bias = nullptr;
+  ASSERT_EQ(XNN_CACHE_NOT_FOUND, xnn_internal_weights_cache_look_up(&cache, &other_key));
+  other_key = key;
+  other_key.kernel = other.data() + 8;
+  other_key.bias = other.data() + 32;
+  ASSERT_EQ(XNN_CACHE_NOT_FOUND, xnn_internal_weights_cache_look_up(&cache, &other_key));
+
+  // Keys are relative to the source buffer.
+  ASSERT_EQ(xnn_status_success, xnn_internal_set_weights_cache_source(&cache, other.data(), other.size()));
+  ASSERT_EQ(4, xnn_internal_weights_cache_look_up(&cache, &other_key));
+
+  ASSERT_EQ(xnn_status_success, xnn_internal_release_weights_cache(&cache));
+}
+
+#if XNN_HAS_MMAP
+
+TEST(WEIGHTS_CACHE, save_and_load) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  struct xnn_internal_weights_cache cache;
+  ASSERT_EQ(xnn_status_success, xnn_internal_init_weights_cache_with_size(&cache, XNN_DEFAULT_WEIGHTS_BUFFER_SIZE));
+
+  const std::vector<char> source(64);
+  ASSERT_EQ(xnn_status_success, xnn_internal_set_weights_cache_source(&cache, source.data(), source.size()));
+  struct xnn_weights_cache_look_up_key key1 = {1, source.data(), nullptr};
+  struct xnn_weights_cache_look_up_key key2 = {2, source.data() + 16, source.data() + 48};
+  write_weights(&cache, "1234");
+  ASSERT_EQ(0, xnn_internal_get_or_insert_weights_cache(&cache, &key1, cache.cache.weights.start, 4));
+  void* span2_weights = cache_end(&cache);
+  write_weights(&cache, "abcdefgh");
+  ASSERT_EQ(4, xnn_internal_get_or_insert_weights_cache(&cache, &key2, span2_weights, 8));
+  ASSERT_EQ(xnn_status_success, xnn_internal_finalize_weights_cache(&cache, xnn_weights_cache_finalization_kind_soft));
+
+  const std::string path = testing::TempDir() + "weights-cache-save-and-load.bin";
+  ASSERT_EQ(xnn_status_success, xnn_internal_save_weights_cache(&cache, path.c_str()));
+  ASSERT_EQ(xnn_status_success, xnn_internal_release_weights_cache(&cache));
+
+  struct xnn_internal_weights_cache loaded;
+  ASSERT_EQ(xnn_status_success, xnn_internal_init_weights_cache_from_file(&loaded, path.c_str()));
+  std::remove(path.c_str());
+  ASSERT_TRUE(xnn_internal_weights_cache_is_finalized(&loaded));
+  ASSERT_EQ(12, loaded.cache.weights.size);
+  ASSERT_EQ(2, loaded.cache.num_entries);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(loaded.cache.weights.start) % XNN_ALLOCATION_ALIGNMENT);
+
+  // Look up keys are relative to the new source buffer.
+  const std::vector<char> new_source(64);
+  ASSERT_EQ(xnn_status_success, xnn_internal_set_weights_cache_source(&loaded, new_source.data(), new_source.size()));
+  key1.kernel = new_source.data();
+  key2.kernel = new_source.data() + 16;
+  key2.bias = new_source.data() + 48;
+  ASSERT_EQ(0, xnn_internal_weights_cache_look_up(&loaded, &key1));
+  ASSERT_EQ(4, xnn_internal_weights_cache_look_up(&loaded, &key2));
+  ASSERT_EQ(0, std::memcmp(xnn_internal_weights_cache_offset_to_addr(&loaded, 4), "abcdefgh", 8));
+
+  // The loaded cache behaves like a soft finalized cache: cached weights are found by their contents.
+  void* span3_weights = cache_end(&loaded);
+  write_weights(&loaded, "abcdefgh");
+  ASSERT_EQ(4, xnn_internal_get_or_insert_weights_cache(&loaded, nullptr, span3_weights, 8));
+  write_weights(&loaded, "5678");
+  ASSERT_EQ(XNN_CACHE_NOT_FOUND, xnn_internal_get_or_insert_weights_cache(&loaded, nullptr, span3_weights, 4));
+  ASSERT_EQ(12, loaded.cache.weights.size);
+
+  ASSERT_EQ(xnn_status_success, xnn_internal_release_weights_cache(&loaded));
+}
+
+TEST(WEIGHTS_CACHE, save_hard_finalized_cache) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  struct xnn_internal_weights_cache cache;
+  ASSERT_EQ(xnn_status_success, xnn_internal_init_weights_cache_with_size(&cache, XNN_DEFAULT_WEIGHTS_BUFFER_SIZE));
+  ASSERT_EQ(xnn_status_success, xnn_internal_finalize_weights_cache(&cache, xnn_weights_cache_finalization_kind_hard));
+
+  const std::string path = testing::TempDir() + "weights-cache-hard-finalized.bin";
+  ASSERT_EQ(xnn_status_invalid_state, xnn_internal_save_weights_cache(&cache, path.c_str()));
+  ASSERT_EQ(xnn_status_success, xnn_internal_release_weights_cache(&cache));
+}
+
+TEST(WEIGHTS_CACHE, load_invalid_file) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  struct xnn_internal_weights_cache cache;
+  const std::string path = testing::TempDir() + "weights-cache-invalid.bin";
+  ASSERT_EQ(xnn_status_invalid_parameter, xnn_internal_init_weights_cache_from_file(&cache, path.c_str()));
+
+  FILE* file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  const std::string junk(4096, 'x');
+  ASSERT_EQ(junk.size(), std::fwrite(junk.data(), 1, junk.size(), file));
+  std::fclose(file);
+  ASSERT_EQ(xnn_status_invalid_parameter, xnn_internal_init_weights_cache_from_file(&cache, path.c_str()));
+  std::remove(path.c_str());
+}
+
+TEST(WEIGHTS_CACHE, fully_connected_with_loaded_cache) {
+  ASSERT_EQ(xnn_status_success, xnn_initialize(/*allocator=*/nullptr));
+  constexpr size_t batch_size = 3;
+  constexpr size_t input_channels = 17;
+  constexpr size_t output_channels = 9;
+  // The original weights, as if memory-mapped from a model file: kernel followed by bias.
+  std::vector<float> model(output_channels * input_channels + output_channels);
+  for (size_t i = 0; i < model.size(); i++) {
+    model[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * 0.25f;
+  }
+  std::vector<float> input(batch_size * input_channels);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.5f;
+  }
+
+  auto run = [&](const std::vector<float>& weights, xnn_weights_cache_t weights_cache, std::vector<float>& output) {
+    output.assign(batch_size * output_channels, 0.0f);
+    xnn_operator_t op = nullptr;
+    ASSERT_EQ(xnn_status_success,
+              xnn_create_fully_connected_nc_f32(
+                input_channels, output_channels, input_channels, output_channels, weights.data(),
+                weights.data() + output_channels * input_channels, -INFINITY, INFINITY, /*flags=*/0,
+                /*code_cache=*/nullptr, weights_cache, &op));
+    if (!xnn_weights_cache_is_finalized(weights_cache)) {
+      ASSERT_EQ(xnn_status_success,
+                xnn_finalize_weights_cache(weights_cache, xnn_weights_cache_finalization_kind_soft));
+    }
+    ASSERT_EQ(xnn_status_success, xnn_reshape_fully_connected_nc_f32(op, batch_size, /*threadpool=*/nullptr));
+    ASSERT_EQ(xnn_status_success, xnn_setup_fully_connected_nc_f32(op, input.data(), output.data()));
+    ASSERT_EQ(xnn_status_success, xnn_run_operator(op, /*threadpool=*/nullptr));
+    ASSERT_EQ(xnn_status_success, xnn_delete_operator(op));
+  };
+
+  const std::string path = testing::TempDir() + "weights-cache-fully-connected.bin";
+  std::vector<float> expected;
+  {
+    xnn_weights_cache_t weights_cache = nullptr;
+    ASSERT_EQ(xnn_status_success, xnn_create_weights_cache(&weights_cache));
+    ASSERT_EQ(xnn_status_success,
+              xnn_set_weights_cache_source(weights_cache, model.data(), model.size() * sizeof(float)));
+    run(model, weights_cache, expected);
+    ASSERT_EQ(xnn_status_success, xnn_save_weights_cache(weights_cache, path.c_str()));
+    ASSERT_EQ(xnn_status_success, xnn_delete_weights_cache(weights_cache));
+  }
+
+  // Reload with the model at a different address.
+  const std::vector<float> reloaded_model = model;
+  xnn_weights_cache_t weights_cache = nullptr;
+  ASSERT_EQ(xnn_status_success, xnn_create_weights_cache_from_file(path.c_str(), &weights_cache));
+  std::remove(path.c_str());
+  ASSERT_EQ(xnn_status_success,
+            xnn_set_weights_cache_source(weights_cache, reloaded_model.data(), reloaded_model.size() * sizeof(float)));
+  const struct xnn_internal_weights_cache* cache =
+    static_cast<const struct xnn_internal_weights_cache*>(weights_cache->context);
+  const size_t misses = cache->cache.misses;
+  const size_t hits = cache->cache.hits;
+
+  std::vector<float> output;
+  run(reloaded_model, weights_cache, output);
+  EXPECT_EQ(expected, output);
+  // Found by key, so the weights were not packed and compared.
+  EXPECT_EQ(hits, cache->cache.hits);
+  EXPECT_EQ(misses, cache->cache.misses);
+  ASSERT_EQ(xnn_status_success, xnn_delete_weights_cache(weights_cache));
+}
+
+#endif  // XNN_HAS_MMAP
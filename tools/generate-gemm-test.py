@@ -710,6 +710,11 @@ def generate_test_cases(
         "_", 5
     )
     datatype = datatype + "_" + kerneltype
+  if datatype == "bf16" and ukernel_type == "f32":
+    _, datatype, outputtype, ukernel_type, activation, _ = ukernel.split(
+        "_", 5
+    )
+    datatype = datatype + "_" + outputtype
   if (
       datatype in ("qd8", "qp8")
       and ukernel_type in ["f16", "f32"]
@@ -41,6 +41,7 @@ _ISA_LIST = frozenset({
     'avx512vbmi',
     'avx512vnni',
     'avx512vnnigfni',
+    'avx512bf16',
     'avx512amx',
     'avx512fp16',
     'avxvnni',
@@ -174,6 +175,7 @@ def main(args):
       src_dir,
       os.path.join(src_dir, 'configs'),
       os.path.join(src_dir, 'enums'),
+      os.path.join(src_dir, 'jit'),
       os.path.join(src_dir, 'operators'),
       os.path.join(src_dir, 'subgraph'),
       os.path.join(src_dir, 'tables'),
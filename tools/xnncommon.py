@@ -61,6 +61,7 @@ _ISA_TO_MACRO_MAP = {
   "avx512vbmi": "XNN_ENABLE_AVX512VBMI",
   "avx512vnni": "XNN_ENABLE_AVX512VNNI",
   "avx512vnnigfni": "XNN_ENABLE_AVX512VNNIGFNI",
+  "avx512bf16": "XNN_ENABLE_AVX512BF16",
   "avx512amx": "XNN_ENABLE_AVX512AMX",
   "avx512fp16": "XNN_ENABLE_AVX512FP16",
   "hvx": "XNN_ENABLE_HVX",
@@ -91,6 +92,7 @@ _ISA_TO_ARCH_MAP = {
   "avx512vbmi": ["x86-32", "x86-64"],
   "avx512vnni": ["x86-32", "x86-64"],
   "avx512vnnigfni": ["x86-32", "x86-64"],
+  "avx512bf16": ["x86-32", "x86-64"],
   "avx512amx": ["x86-32", "x86-64"],
   "avx512fp16": ["x86-32", "x86-64"],
   "avxvnni": ["x86-32", "x86-64"],
@@ -135,6 +137,7 @@ _ISA_TO_UTILCHECK_MAP = {
   "avx512vbmi": "CheckAVX512VBMI",
   "avx512vnni": "CheckAVX512VNNI",
   "avx512vnnigfni": "CheckAVX512VNNIGFNI",
+  "avx512bf16": "CheckAVX512BF16",
   "avx512amx": "CheckAVX512AMX",
   "avx512fp16": "CheckAVX512FP16",
   "avxvnni": "CheckAVXVNNI",
@@ -176,6 +179,7 @@ _ISA_TO_CHECK_MAP = {
   "avx512vbmi": "TEST_REQUIRES_X86_AVX512VBMI",
   "avx512vnni": "TEST_REQUIRES_X86_AVX512VNNI",
   "avx512vnnigfni": "TEST_REQUIRES_X86_AVX512VNNIGFNI",
+  "avx512bf16": "TEST_REQUIRES_X86_AVX512BF16",
   "avx512amx": "TEST_REQUIRES_X86_AVX512AMX",
   "avx512fp16": "TEST_REQUIRES_X86_AVX512FP16",
   "avxvnni": "TEST_REQUIRES_X86_AVXVNNI",
@@ -266,6 +270,7 @@ _ISA_HIERARCHY = [
   "avx512skx",
   "avx512vnni",
   "avx512vnnigfni",
+  "avx512bf16",
   "avx512fp16",
   "avx512amx",
   "armsimd32",